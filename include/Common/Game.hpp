@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Game/Snapshot.hpp"
 #include "Game/WorldEntity.hpp"
 #include "Game/WorldEntityName.hpp"
 #include "Game/WorldEntityPosition.hpp"
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include "Common/Game/WorldEntityPosition.hpp"
+#include "Common/Game/WorldEntityStats.hpp"
+#include <array>
+#include <cstdint>
+#include <entt/entity/entity.hpp>
+#include <unordered_map>
+
+namespace Common::Game
+{
+
+	/**
+	 * \struct EntitySnapshot Snapshot.hpp <Common/Game/Snapshot.hpp>
+	 * \brief The replicated state of a single world entity at the time a snapshot was taken
+	 */
+	struct COMMON_API EntitySnapshot
+	{
+		WorldEntityPosition position;
+		WorldEntityStats stats;
+
+		auto operator==(const EntitySnapshot&) const -> bool = default;
+	};
+
+	/**
+	 * \struct Snapshot Snapshot.hpp <Common/Game/Snapshot.hpp>
+	 * \brief The replicated state of every world entity visible to a client, keyed by the entity's ID on the server
+	 */
+	struct COMMON_API Snapshot
+	{
+		std::uint32_t id = 0;
+		std::unordered_map<entt::entity, EntitySnapshot> entities;
+	};
+
+	/**
+	 * \brief How an entity in a Server_Snapshot message differs from the snapshot it's relative to
+	 */
+	enum class SnapshotEntry : std::uint8_t
+	{
+		// Followed by the whole entity, as written by serialiseWorldEntity, after aligning the bit stream to a byte
+		Created,
+		// Followed by the delta of each replicated component, packed into the bit stream
+		Updated,
+		Destroyed
+	};
+
+	/// \brief The number of bits a SnapshotEntry is packed into
+	const std::uint8_t SNAPSHOT_ENTRY_BITS = 2;
+
+	/**
+	 * \class SnapshotHistory Snapshot.hpp <Common/Game/Snapshot.hpp>
+	 * \brief Remembers the most recent snapshots, so later ones can be encoded or decoded relative to them
+	 */
+	class COMMON_API SnapshotHistory
+	{
+	public:
+		static constexpr auto LENGTH = std::size_t(32);
+
+		/**
+		 * \brief Remember a snapshot, replacing the one stored LENGTH snapshots ago
+		 *
+		 * \param snapshot The snapshot, which must have a non-zero ID
+		 * \return const Snapshot& The stored snapshot
+		 */
+		auto store(Snapshot&& snapshot) -> const Snapshot&;
+
+		/**
+		 * \brief Find a snapshot which is still remembered
+		 *
+		 * \param id The ID of the snapshot
+		 * \return const Snapshot* The snapshot, or nullptr if it's never been stored or has been replaced
+		 */
+		[[nodiscard]] auto find(std::uint32_t id) const -> const Snapshot*;
+
+		/**
+		 * \brief Forget every snapshot
+		 *
+		 */
+		auto clear() -> void;
+
+	private:
+		std::array<Snapshot, LENGTH> m_snapshots;
+	};
+
+} // namespace Common::Game
\ No newline at end of file
@@ -12,11 +12,29 @@ namespace Common::Game
 	 */
 	struct COMMON_API WorldEntityPosition : public Network::SerialisedComponent<WorldEntityPosition>
 	{
+		/// \brief Coordinates are sent in bit streams to a sixteenth of a unit, which is finer than a pixel
+		static const Network::QuantisedRange COORDINATE_RANGE;
+
 		std::uint32_t instanceID = 0;
 		sf::Vector2f position;
 
 		auto serialise(Network::MessageData& data) -> void;
 		auto deserialise(Network::MessageData& data) -> void;
+		auto serialiseDelta(const WorldEntityPosition& baseline, Network::MessageData& data) -> void;
+		auto deserialiseDelta(Network::MessageData& data) -> void;
+
+		auto serialise(Network::BitWriter& writer) -> void;
+		auto deserialise(Network::BitReader& reader) -> void;
+		auto serialiseDelta(const WorldEntityPosition& baseline, Network::BitWriter& writer) -> void;
+		auto deserialiseDelta(Network::BitReader& reader) -> void;
+
+		/**
+		 * \brief Get a copy of the position with its coordinates rounded the way a bit stream sends them, so the sender can
+		 * remember exactly what the receiver holds
+		 */
+		[[nodiscard]] auto quantised() const -> WorldEntityPosition;
+
+		auto operator==(const WorldEntityPosition&) const -> bool = default;
 	};
 
 } // namespace Common::Game
\ No newline at end of file
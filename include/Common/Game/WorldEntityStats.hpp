@@ -16,6 +16,15 @@ namespace Common::Game
 
 		auto serialise(Network::MessageData& data) -> void;
 		auto deserialise(Network::MessageData& data) -> void;
+		auto serialiseDelta(const StatBlock& baseline, Network::MessageData& data) -> void;
+		auto deserialiseDelta(Network::MessageData& data) -> void;
+
+		auto serialise(Network::BitWriter& writer) -> void;
+		auto deserialise(Network::BitReader& reader) -> void;
+		auto serialiseDelta(const StatBlock& baseline, Network::BitWriter& writer) -> void;
+		auto deserialiseDelta(Network::BitReader& reader) -> void;
+
+		auto operator==(const StatBlock&) const -> bool = default;
 	};
 
 	/**
@@ -29,6 +38,15 @@ namespace Common::Game
 
 		auto serialise(Network::MessageData& data) -> void;
 		auto deserialise(Network::MessageData& data) -> void;
+		auto serialiseDelta(const WorldEntityStats& baseline, Network::MessageData& data) -> void;
+		auto deserialiseDelta(Network::MessageData& data) -> void;
+
+		auto serialise(Network::BitWriter& writer) -> void;
+		auto deserialise(Network::BitReader& reader) -> void;
+		auto serialiseDelta(const WorldEntityStats& baseline, Network::BitWriter& writer) -> void;
+		auto deserialiseDelta(Network::BitReader& reader) -> void;
+
+		auto operator==(const WorldEntityStats&) const -> bool = default;
 	};
 
 } // namespace Common::Game
\ No newline at end of file
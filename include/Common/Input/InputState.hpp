@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common/Export.hpp"
+#include "Common/Network/BitStream.hpp"
 #include "Common/Network/MessageData.hpp"
 
 namespace Common::Input
@@ -18,5 +19,7 @@ namespace Common::Input
 
 	COMMON_API auto operator<<(Common::Network::MessageData& data, InputState state) -> Network::MessageData&;
 	COMMON_API auto operator>>(Common::Network::MessageData& data, InputState& state) -> Network::MessageData&;
+	COMMON_API auto operator<<(Common::Network::BitWriter& writer, InputState state) -> Network::BitWriter&;
+	COMMON_API auto operator>>(Common::Network::BitReader& reader, InputState& state) -> Network::BitReader&;
 
 } // namespace Common::Input
\ No newline at end of file
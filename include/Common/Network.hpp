@@ -1,11 +1,22 @@
 #pragma once
 
+#include "Common/Network/BitStream.hpp"
+#include "Common/Network/BufferPool.hpp"
 #include "Common/Network/Crypto.hpp"
+#include "Common/Network/DatagramBatcher.hpp"
+#include "Common/Network/EndpointTable.hpp"
+#include "Common/Network/FrameAssembler.hpp"
+#include "Common/Network/GatherBuffer.hpp"
+#include "Common/Network/HeaderCodec.hpp"
 #include "Common/Network/Message.hpp"
 #include "Common/Network/MessageData.hpp"
 #include "Common/Network/MessageHeader.hpp"
 #include "Common/Network/MessageQueue.hpp"
 #include "Common/Network/MessageType.hpp"
+#include "Common/Network/PayloadCompressor.hpp"
 #include "Common/Network/Protocol.hpp"
+#include "Common/Network/ReceiveBufferPool.hpp"
+#include "Common/Network/ReliableEndpoint.hpp"
 #include "Common/Network/SerialisedComponent.hpp"
+#include "Common/Network/SocketReactor.hpp"
 #include "Common/Network/ServerProperties.hpp"
\ No newline at end of file
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include "Common/Network/MessageData.hpp"
+#include <cstdint>
+#include <type_traits>
+
+namespace Common::Network
+{
+
+	/**
+	 * \brief Map a signed value onto an unsigned one, keeping values close to zero small whatever their sign
+	 */
+	constexpr auto zigzagEncode(const std::int64_t value) -> std::uint64_t
+	{
+		return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+	}
+
+	/**
+	 * \brief Reverse zigzagEncode
+	 */
+	constexpr auto zigzagDecode(const std::uint64_t value) -> std::int64_t
+	{
+		return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+	}
+
+	/**
+	 * \struct QuantisedRange BitStream.hpp <Common/Network/BitStream.hpp>
+	 * \brief Describes how a float is sent as a fixed-point value. Values outside the range are clamped to it
+	 */
+	struct COMMON_API QuantisedRange
+	{
+		float min;
+		float max;
+		std::uint8_t bits;
+
+		/**
+		 * \brief Convert a value to the nearest step in the range
+		 */
+		[[nodiscard]] auto quantise(float value) const -> std::uint32_t;
+
+		/**
+		 * \brief Convert a step in the range back to a value
+		 */
+		[[nodiscard]] auto dequantise(std::uint32_t value) const -> float;
+	};
+
+	/**
+	 * \class BitWriter BitStream.hpp <Common/Network/BitStream.hpp>
+	 * \brief Packs values into a MessageData using only as many bits as they need
+	 *
+	 * Bits are appended to the message data a byte at a time as they fill up. Call flush before writing to the message data
+	 * directly, which pads the last byte with zeroes. The writer also flushes itself when it's destroyed
+	 */
+	class COMMON_API BitWriter
+	{
+	public:
+		/**
+		 * \brief Construct a new Bit Writer object
+		 *
+		 * \param data The message data to append to
+		 */
+		explicit BitWriter(MessageData& data);
+
+		~BitWriter();
+
+		BitWriter(const BitWriter&)                    = delete;
+		auto operator=(const BitWriter&) -> BitWriter& = delete;
+
+		/**
+		 * \brief Write the lowest bits of a value
+		 *
+		 * \param value The value to write
+		 * \param count The number of bits to write, up to 32
+		 */
+		auto writeBits(std::uint64_t value, std::uint8_t count) -> void;
+
+		/**
+		 * \brief Write a bool as a single bit
+		 */
+		auto writeBool(bool value) -> void;
+
+		/**
+		 * \brief Write an enum using only as many bits as its largest value needs
+		 *
+		 * \param value The value to write
+		 * \param count The number of bits to write
+		 */
+		template<class Enum>
+		auto writeEnum(const Enum value, const std::uint8_t count) -> void
+		{
+			static_assert(std::is_enum_v<Enum>);
+			writeBits(static_cast<std::uint64_t>(value), count);
+		}
+
+		/**
+		 * \brief Write an unsigned value in groups of seven bits, so small values take fewer bits
+		 */
+		auto writeVarint(std::uint64_t value) -> void;
+
+		/**
+		 * \brief Write a signed value as a zigzag encoded varint, so values of either sign close to zero take fewer bits
+		 */
+		auto writeSignedVarint(std::int64_t value) -> void;
+
+		/**
+		 * \brief Write a float as a fixed-point value
+		 *
+		 * \param value The value to write
+		 * \param range The range and precision to write it with
+		 */
+		auto writeQuantised(float value, const QuantisedRange& range) -> void;
+
+		/**
+		 * \brief Append any bits still waiting for a full byte to the message data
+		 *
+		 */
+		auto flush() -> void;
+
+	private:
+		MessageData& m_data;
+		std::uint64_t m_scratch     = 0;
+		std::uint8_t m_scratchCount = 0;
+	};
+
+	/**
+	 * \class BitReader BitStream.hpp <Common/Network/BitStream.hpp>
+	 * \brief Reads values packed by a BitWriter out of a MessageData
+	 *
+	 * Bytes are taken from the message data as they're needed. Call align before reading from the message data directly, at the
+	 * same point the writer was flushed, to skip the padding of the last byte
+	 */
+	class COMMON_API BitReader
+	{
+	public:
+		/**
+		 * \brief Construct a new Bit Reader object
+		 *
+		 * \param data The message data to read from
+		 */
+		explicit BitReader(MessageData& data);
+
+		/**
+		 * \brief Read a value written by BitWriter::writeBits
+		 *
+		 * \param count The number of bits to read, up to 32
+		 */
+		auto readBits(std::uint8_t count) -> std::uint64_t;
+
+		/**
+		 * \brief Read a bool written by BitWriter::writeBool
+		 */
+		auto readBool() -> bool;
+
+		/**
+		 * \brief Read an enum written by BitWriter::writeEnum
+		 *
+		 * \param count The number of bits it was written with
+		 */
+		template<class Enum>
+		auto readEnum(const std::uint8_t count) -> Enum
+		{
+			static_assert(std::is_enum_v<Enum>);
+			return static_cast<Enum>(readBits(count));
+		}
+
+		/**
+		 * \brief Read a value written by BitWriter::writeVarint
+		 */
+		auto readVarint() -> std::uint64_t;
+
+		/**
+		 * \brief Read a value written by BitWriter::writeSignedVarint
+		 */
+		auto readSignedVarint() -> std::int64_t;
+
+		/**
+		 * \brief Read a value written by BitWriter::writeQuantised
+		 *
+		 * \param range The range and precision it was written with
+		 */
+		auto readQuantised(const QuantisedRange& range) -> float;
+
+		/**
+		 * \brief Discard the rest of the current byte
+		 *
+		 */
+		auto align() -> void;
+
+	private:
+		MessageData& m_data;
+		std::uint64_t m_scratch     = 0;
+		std::uint8_t m_scratchCount = 0;
+	};
+
+} // namespace Common::Network
\ No newline at end of file
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Common::Network
+{
+
+	/**
+	 * \brief The capacities buffers are pooled at, chosen to fit our traffic: inputs and acknowledgements, small component updates,
+	 * a full datagram, world state replies, and the longest message
+	 */
+	const std::array<std::size_t, 5> BUFFER_SIZE_CLASSES = {64, 256, 1200, 4096, 1 << 15};
+
+	/// \brief The most free buffers kept in each size class, so a burst doesn't pin its memory forever
+	const std::array<std::size_t, 5> BUFFER_CLASS_LIMITS = {4096, 2048, 1024, 256, 64};
+
+	/**
+	 * \struct BufferPoolStatistics BufferPool.hpp <Common/Network/BufferPool.hpp>
+	 * \brief Counts how well the pool has served requests since it was created
+	 */
+	struct BufferPoolStatistics
+	{
+		/// \brief Requests served by a free buffer
+		std::uint64_t hits = 0;
+
+		/// \brief Requests which had to allocate a new buffer for a size class
+		std::uint64_t misses = 0;
+
+		/// \brief Requests longer than the largest size class, which are allocated on their own
+		std::uint64_t oversized = 0;
+
+		/// \brief Buffers given back which were freed, because they were too short or their size class was full
+		std::uint64_t discarded = 0;
+
+		/// \brief Free buffers waiting to be acquired
+		std::size_t available = 0;
+	};
+
+	/**
+	 * \class BufferPool BufferPool.hpp <Common/Network/BufferPool.hpp>
+	 * \brief Recycles the byte vectors which messages are built and packed into, so sending doesn't allocate once warmed up
+	 *
+	 * Buffers are handed out empty, with at least the capacity asked for, rounded up to a size class. Giving a buffer back files it
+	 * under the largest size class its capacity covers. Every size class has its own lock, so buffers can be acquired and released
+	 * on any thread
+	 */
+	class COMMON_API BufferPool
+	{
+	public:
+		/**
+		 * \brief Gets the pool shared by the whole process, which is never destroyed so buffers can be released at any time
+		 */
+		[[nodiscard]] static auto get() -> BufferPool&;
+
+		BufferPool();
+
+		BufferPool(const BufferPool&)                    = delete;
+		auto operator=(const BufferPool&) -> BufferPool& = delete;
+
+		/**
+		 * \brief Take an empty buffer from the pool
+		 *
+		 * \param capacity The number of bytes the buffer must be able to hold without growing
+		 * \return std::vector<std::uint8_t> An empty buffer with at least the given capacity
+		 */
+		auto acquire(std::size_t capacity) -> std::vector<std::uint8_t>;
+
+		/**
+		 * \brief Give a buffer back to the pool, leaving it empty. Buffers which didn't come from the pool may be given too
+		 *
+		 * \param buffer The buffer to give back
+		 */
+		auto release(std::vector<std::uint8_t>&& buffer) -> void;
+
+		/**
+		 * \brief Get the statistics of every size class combined
+		 */
+		[[nodiscard]] auto getStatistics() const -> BufferPoolStatistics;
+
+		/**
+		 * \brief Get the statistics of one size class
+		 *
+		 * \param sizeClass The index of the size class in BUFFER_SIZE_CLASSES
+		 */
+		[[nodiscard]] auto getStatistics(std::size_t sizeClass) const -> BufferPoolStatistics;
+
+	private:
+		struct SizeClass
+		{
+			mutable std::mutex mutex;
+			std::vector<std::vector<std::uint8_t>> available;
+			std::atomic<std::uint64_t> hits      = 0;
+			std::atomic<std::uint64_t> misses    = 0;
+			std::atomic<std::uint64_t> discarded = 0;
+		};
+
+		std::array<SizeClass, BUFFER_SIZE_CLASSES.size()> m_sizeClasses;
+		std::atomic<std::uint64_t> m_oversizedCount = 0;
+		std::atomic<std::uint64_t> m_discardedCount = 0;
+	};
+
+} // namespace Common::Network
\ No newline at end of file
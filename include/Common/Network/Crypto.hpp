@@ -1,7 +1,11 @@
 #pragma once
 
 #include "Common/Export.hpp"
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <vector>
 
 using EVP_PKEY     = struct evp_pkey_st;
 using EVP_PKEY_CTX = struct evp_pkey_ctx_st;
@@ -45,6 +49,20 @@ namespace Common::Network
 		 */
 		auto decryptFromLocal(std::vector<uint8_t>& data) const -> void;
 
+		/**
+		 * \brief Decrypt bytes in-place using the cryptographer's remote public key, such as a message in a receive buffer
+		 *
+		 * \param data The bytes to decrypt
+		 */
+		auto decryptFromRemote(std::span<std::uint8_t> data) const -> void;
+
+		/**
+		 * \brief Decrypt bytes in-place using the cryptographer's local public key
+		 *
+		 * \param data The bytes to decrypt
+		 */
+		auto decryptFromLocal(std::span<std::uint8_t> data) const -> void;
+
 		/**
 		 * \brief Generate a local key-pair to use in public key encryption
 		 *
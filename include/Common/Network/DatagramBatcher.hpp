@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include "Common/Network/GatherBuffer.hpp"
+#include "Common/Network/Message.hpp"
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using mmsghdr_t     = struct mmsghdr;
+using iovec_t       = struct iovec;
+using sockaddr_in_t = struct sockaddr_in;
+
+namespace Common::Network
+{
+
+	/**
+	 * \struct Datagram DatagramBatcher.hpp <Common/Network/DatagramBatcher.hpp>
+	 * \brief A datagram received by a DatagramBatcher. The data points into the batcher's receive ring
+	 */
+	struct Datagram
+	{
+		const std::uint8_t* data = nullptr;
+		std::size_t length       = 0;
+		sf::IpAddress address    = sf::IpAddress::Any;
+		std::uint16_t port       = 0;
+	};
+
+	/**
+	 * \class DatagramBatcher DatagramBatcher.hpp <Common/Network/DatagramBatcher.hpp>
+	 * \brief Sends and receives datagrams on a UDP socket in batches
+	 *
+	 * On Linux, queued datagrams are flushed with sendmmsg and received with recvmmsg into a ring of pre-allocated buffers,
+	 * so a batch costs one system call rather than one per datagram. Each datagram is gathered from the segments of a GatherBuffer
+	 * without copying them together. Other platforms fall back to one call per datagram.
+	 * The socket must be non-blocking.
+	 */
+	class COMMON_API DatagramBatcher
+	{
+	public:
+		/**
+		 * \brief Construct a new Datagram Batcher object
+		 *
+		 * \param batchSize The maximum number of datagrams sent or received by a single system call
+		 * \param maxDatagramLength The size of each receive buffer. Longer datagrams are truncated
+		 */
+		DatagramBatcher(std::size_t batchSize = 64, std::size_t maxDatagramLength = MAX_MESSAGE_LENGTH);
+
+		/**
+		 * \brief Destroy the Datagram Batcher object
+		 *
+		 */
+		~DatagramBatcher();
+
+		DatagramBatcher(const DatagramBatcher&)                    = delete;
+		auto operator=(const DatagramBatcher&) -> DatagramBatcher& = delete;
+
+		/**
+		 * \brief Queue a datagram to be sent on the next flush
+		 *
+		 * \param buffer The contents of the datagram, which are kept alive until the datagram has been sent
+		 * \param address The address to send the datagram to
+		 * \param port The port to send the datagram to
+		 */
+		auto queue(GatherBuffer&& buffer, sf::IpAddress address, std::uint16_t port) -> void;
+
+		/**
+		 * \brief Send every queued datagram. Datagrams the socket has no room for are dropped, as they would be on the network
+		 *
+		 * \param socket The socket to send the datagrams with
+		 */
+		auto flush(sf::UdpSocket& socket) -> void;
+
+		/**
+		 * \brief Receive up to a batch of datagrams with a single system call
+		 *
+		 * \param socket The socket to receive from
+		 * \return const std::vector<Datagram>& The datagrams received, valid until the next call to receive. Empty once the socket is drained
+		 */
+		auto receive(sf::UdpSocket& socket) -> const std::vector<Datagram>&;
+
+		/**
+		 * \brief Get the number of datagrams which failed to send since the batcher was created
+		 */
+		[[nodiscard]] auto getDroppedCount() const -> std::uint64_t;
+
+		/**
+		 * \brief Get the number of system calls made to send and receive since the batcher was created
+		 */
+		[[nodiscard]] auto getSyscallCount() const -> std::uint64_t;
+
+	private:
+		struct PendingDatagram
+		{
+			GatherBuffer buffer;
+			sf::IpAddress address;
+			std::uint16_t port;
+		};
+
+		std::size_t m_batchSize;
+		std::size_t m_maxDatagramLength;
+		std::uint64_t m_droppedCount = 0;
+		std::uint64_t m_syscallCount = 0;
+
+		std::vector<PendingDatagram> m_pending;
+		std::vector<std::uint8_t> m_receiveRing;
+		std::vector<Datagram> m_received;
+
+#if defined(__linux__)
+		std::unique_ptr<mmsghdr_t[]> m_headers;
+		std::unique_ptr<iovec_t[]> m_vectors;
+		std::unique_ptr<iovec_t[]> m_sendVectors;
+		std::size_t m_sendVectorCapacity = 0;
+		std::unique_ptr<sockaddr_in_t[]> m_addresses;
+#endif
+	};
+
+} // namespace Common::Network
\ No newline at end of file
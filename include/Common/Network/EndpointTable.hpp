@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include <cstdint>
+#include <entt/entity/entity.hpp>
+#include <optional>
+#include <vector>
+
+namespace Common::Network
+{
+
+	/**
+	 * \struct EndpointAddress EndpointTable.hpp <Common/Network/EndpointTable.hpp>
+	 * \brief The address and port a datagram was sent from
+	 *
+	 * Addresses are stored as IPv6, with IPv4 addresses mapped into ::ffff:0:0/96, so both can live in the same table. The address is
+	 * kept as two integers rather than bytes so building an endpoint and hashing it straight after doesn't stall on the stores
+	 */
+	struct COMMON_API EndpointAddress
+	{
+		/**
+		 * \brief Make the endpoint of an IPv4 address
+		 *
+		 * \param address The IPv4 address, in host byte order
+		 * \param port The port
+		 * \return EndpointAddress The endpoint, with the address mapped into IPv6
+		 */
+		[[nodiscard]] static auto fromIPv4(std::uint32_t address, std::uint16_t port) -> EndpointAddress;
+
+		/**
+		 * \brief Gets the hash used to place the endpoint in an EndpointTable
+		 */
+		[[nodiscard]] auto hash() const -> std::uint64_t;
+
+		auto operator==(const EndpointAddress& other) const -> bool = default;
+
+		/// \brief The first and last eight bytes of the IPv6 address, each read as a big-endian integer
+		std::uint64_t addressHigh = 0;
+		std::uint64_t addressLow  = 0;
+
+		std::uint16_t port = 0;
+	};
+
+	/**
+	 * \class EndpointTable EndpointTable.hpp <Common/Network/EndpointTable.hpp>
+	 * \brief Maps the endpoints clients send datagrams from to their IDs, and back again
+	 *
+	 * Endpoints are kept in an open-addressed table with linear probing, which is never more than three quarters full, and removed
+	 * by shifting the rest of their run back so there are no tombstones to probe past. Every client also records its endpoint in a
+	 * vector indexed by its entity, so a client's endpoint can be found and removed without searching
+	 */
+	class COMMON_API EndpointTable
+	{
+	public:
+		/**
+		 * \brief Construct an empty endpoint table
+		 *
+		 * \param capacity The number of clients to make room for before the table has to grow
+		 */
+		explicit EndpointTable(std::size_t capacity = 64);
+
+		/**
+		 * \brief Map an endpoint to a client, replacing the endpoint the client had before
+		 *
+		 * \param endpoint The endpoint
+		 * \param entityID The ID of the client
+		 * \return true The endpoint now maps to the client
+		 * \return false The endpoint already belongs to another client, and nothing was changed
+		 */
+		auto insert(const EndpointAddress& endpoint, entt::entity entityID) -> bool;
+
+		/**
+		 * \brief Find the client an endpoint belongs to
+		 *
+		 * \param endpoint The endpoint
+		 * \return entt::entity The ID of the client, or entt::null if the endpoint isn't known
+		 */
+		[[nodiscard]] auto find(const EndpointAddress& endpoint) const -> entt::entity;
+
+		/**
+		 * \brief Find the endpoint a client was mapped from
+		 *
+		 * \param entityID The ID of the client
+		 * \return std::optional<EndpointAddress> The endpoint, if the client has one
+		 */
+		[[nodiscard]] auto find(entt::entity entityID) const -> std::optional<EndpointAddress>;
+
+		/**
+		 * \brief Remove a client's endpoint
+		 *
+		 * \param entityID The ID of the client
+		 * \return true The client's endpoint was removed
+		 * \return false The client had no endpoint
+		 */
+		auto erase(entt::entity entityID) -> bool;
+
+		/**
+		 * \brief Remove every endpoint
+		 *
+		 */
+		auto clear() -> void;
+
+		/**
+		 * \brief Gets the number of endpoints in the table
+		 */
+		[[nodiscard]] auto size() const -> std::size_t;
+
+		/**
+		 * \brief Gets the number of slots in the table
+		 */
+		[[nodiscard]] auto capacity() const -> std::size_t;
+
+	private:
+		struct Entry
+		{
+			EndpointAddress endpoint;
+			entt::entity entityID = entt::null;
+		};
+
+		/**
+		 * \brief Find the slot holding an endpoint, or the empty slot it would be placed in
+		 */
+		[[nodiscard]] auto findSlot(const EndpointAddress& endpoint) const -> std::size_t;
+
+		/**
+		 * \brief Empty a slot, shifting back any entries further along its run which would no longer be reachable
+		 */
+		auto eraseSlot(std::size_t index) -> void;
+
+		/**
+		 * \brief Move every entry into a table with twice as many slots
+		 */
+		auto grow() -> void;
+
+		/**
+		 * \brief Gets the slot an endpoint is placed in when there's nothing in the way
+		 */
+		[[nodiscard]] auto getHomeSlot(const EndpointAddress& endpoint) const -> std::size_t;
+
+		/**
+		 * \brief Gets the entry recording a client's endpoint, or nullptr if it has none
+		 */
+		[[nodiscard]] auto findClient(entt::entity entityID) -> Entry*;
+
+		std::vector<Entry> m_slots;
+		std::size_t m_mask  = 0;
+		std::size_t m_shift = 0;
+		std::size_t m_size  = 0;
+
+		// Indexed by the entity part of a client's ID, as client IDs are allocated densely
+		std::vector<Entry> m_clients;
+	};
+
+} // namespace Common::Network
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include "Common/Network/Message.hpp"
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Common::Network
+{
+
+	/**
+	 * \class FrameAssembler FrameAssembler.hpp <Common/Network/FrameAssembler.hpp>
+	 * \brief Splits a TCP byte stream back into the messages that were written to it
+	 *
+	 * Every message sent over a stream, or packed into a datagram, is prefixed with its length as a little-endian 32-bit integer. A stream read may contain
+	 * several messages, or only part of one, so received bytes are appended to a growable buffer and complete frames are taken
+	 * from the front of it.
+	 */
+	class COMMON_API FrameAssembler
+	{
+	public:
+		using FrameLength                   = std::uint32_t;
+		static constexpr auto PREFIX_LENGTH = sizeof(FrameLength);
+
+		/**
+		 * \brief Construct a new Frame Assembler object
+		 *
+		 * \param maxFrameLength The longest frame the stream may carry. A longer length prefix marks the stream as corrupt
+		 */
+		FrameAssembler(std::size_t maxFrameLength = MAX_MESSAGE_LENGTH);
+
+		/**
+		 * \brief Encode the length prefix for a frame
+		 *
+		 * \param length The length of the frame, not including the prefix
+		 * \return std::array<std::uint8_t, PREFIX_LENGTH> The encoded prefix
+		 */
+		static auto makePrefix(std::size_t length) -> std::array<std::uint8_t, PREFIX_LENGTH>;
+
+		/**
+		 * \brief Decode a length prefix
+		 *
+		 * \param data The start of the prefix, which must have at least PREFIX_LENGTH bytes
+		 * \return FrameLength The length of the frame which follows the prefix
+		 */
+		static auto readPrefix(const std::uint8_t* data) -> FrameLength;
+
+		/**
+		 * \brief Find the next frame in a buffer which only holds whole frames, such as a datagram
+		 *
+		 * \param data The buffer
+		 * \param length The length of the buffer
+		 * \param offset The offset to read the next frame from, which is moved past it
+		 * \return std::optional<std::span<const std::uint8_t>> An optional which may contain the frame, without its length prefix.
+		 * Empty at the end of the buffer, or if the frame runs past it
+		 */
+		static auto readFrame(const std::uint8_t* data, std::size_t length, std::size_t& offset) -> std::optional<std::span<const std::uint8_t>>;
+
+		/**
+		 * \brief Prefix a packed message with its length, ready to be written to a stream
+		 *
+		 * \param buffer The packed message, which the prefix is inserted in front of
+		 */
+		static auto frame(std::vector<std::uint8_t>& buffer) -> void;
+
+		/**
+		 * \brief Append bytes read from the stream
+		 *
+		 * \param data The bytes that were read
+		 * \param length The number of bytes that were read
+		 */
+		auto append(const std::uint8_t* data, std::size_t length) -> void;
+
+		/**
+		 * \brief Take the next complete frame from the front of the buffer
+		 *
+		 * \return std::optional<std::vector<std::uint8_t>> An optional which may contain the frame, without its length prefix
+		 */
+		auto next() -> std::optional<std::vector<std::uint8_t>>;
+
+		/**
+		 * \brief Take the next complete frame from the front of the buffer without copying it
+		 *
+		 * \return std::optional<std::span<const std::uint8_t>> An optional which may contain the frame, without its length prefix.
+		 * It points into the buffer, so is only valid until the next call to append or clear
+		 */
+		auto nextView() -> std::optional<std::span<const std::uint8_t>>;
+
+		/**
+		 * \brief Check whether the stream announced a frame longer than the maximum frame length, in which case it can't be resynchronised
+		 */
+		[[nodiscard]] auto isCorrupt() const -> bool;
+
+		/**
+		 * \brief Get the number of buffered bytes which haven't been taken as a frame yet
+		 */
+		[[nodiscard]] auto getBufferedLength() const -> std::size_t;
+
+		/**
+		 * \brief Discard everything in the buffer
+		 *
+		 */
+		auto clear() -> void;
+
+	private:
+		std::vector<std::uint8_t> m_buffer;
+		std::size_t m_readOffset = 0;
+		std::size_t m_maxFrameLength;
+		bool m_isCorrupt = false;
+	};
+
+} // namespace Common::Network
\ No newline at end of file
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include "Common/Network/BufferPool.hpp"
+#include "Common/Network/Message.hpp"
+#include <SFML/Network/TcpSocket.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Common::Network
+{
+
+	/**
+	 * \class GatherBuffer GatherBuffer.hpp <Common/Network/GatherBuffer.hpp>
+	 * \brief A sequence of bytes to be written in one go, made of copied bytes and references to shared payloads
+	 *
+	 * Small pieces are copied into the buffer's own storage, and consecutive copies are merged into a single segment. Shared payloads
+	 * are referenced rather than copied, so the segments can be handed to a gathering system call as they are. The copied bytes
+	 * are held in a vector taken from the BufferPool.
+	 */
+	class COMMON_API GatherBuffer
+	{
+	public:
+		/// \brief Shared payloads shorter than this are copied, since an extra segment costs more than the copy
+		static constexpr auto COPY_THRESHOLD = std::size_t(128);
+
+		GatherBuffer()                              = default;
+		GatherBuffer(const GatherBuffer& other)     = default;
+		GatherBuffer(GatherBuffer&& other) noexcept = default;
+		~GatherBuffer();
+
+		auto operator=(const GatherBuffer& other) -> GatherBuffer& = default;
+		auto operator=(GatherBuffer&& other) noexcept -> GatherBuffer&;
+
+		/**
+		 * \brief Copy bytes onto the end of the buffer
+		 *
+		 * \param data The bytes to copy
+		 * \param length The number of bytes to copy
+		 */
+		auto append(const std::uint8_t* data, std::size_t length) -> void;
+
+		/**
+		 * \brief Append a shared payload to the buffer, which is kept alive until the buffer is cleared
+		 *
+		 * \param payload The payload to append
+		 */
+		auto append(const SharedPayload& payload) -> void;
+
+		/**
+		 * \brief Gets the total number of bytes in the buffer
+		 */
+		[[nodiscard]] auto size() const -> std::size_t;
+
+		/**
+		 * \brief Check whether the buffer holds no bytes
+		 */
+		[[nodiscard]] auto empty() const -> bool;
+
+		/**
+		 * \brief Gets the number of separate segments the buffer is made of
+		 */
+		[[nodiscard]] auto getSegmentCount() const -> std::size_t;
+
+		/**
+		 * \brief Gets a pointer to the bytes of a segment, valid until the buffer is next modified
+		 *
+		 * \param index The index of the segment
+		 */
+		[[nodiscard]] auto getSegmentData(std::size_t index) const -> const std::uint8_t*;
+
+		/**
+		 * \brief Gets the number of bytes in a segment
+		 *
+		 * \param index The index of the segment
+		 */
+		[[nodiscard]] auto getSegmentLength(std::size_t index) const -> std::size_t;
+
+		/**
+		 * \brief Copy every segment into one contiguous vector of bytes, taken from the BufferPool
+		 *
+		 * \return std::vector<std::uint8_t> The contents of the buffer
+		 */
+		[[nodiscard]] auto flatten() const -> std::vector<std::uint8_t>;
+
+		/**
+		 * \brief Write the buffer to a non-blocking TCP socket with as few system calls as possible
+		 *
+		 * The buffer is left as it is, so whatever was written should be consumed before the rest is sent again
+		 *
+		 * \param socket The socket to write to
+		 * \param sent The number of bytes written
+		 * \return sf::Socket::Status Done if everything was written, NotReady if nothing was, or Partial if only part of it was
+		 */
+		auto send(sf::TcpSocket& socket, std::size_t& sent) const -> sf::Socket::Status;
+
+		/**
+		 * \brief Remove bytes from the front of the buffer, such as those already written, which may end part way through a segment
+		 *
+		 * \param length The number of bytes to remove
+		 */
+		auto consume(std::size_t length) -> void;
+
+		/**
+		 * \brief Empty the buffer and release its shared payloads
+		 *
+		 */
+		auto clear() -> void;
+
+	private:
+		struct Segment
+		{
+			std::size_t offset = 0;
+			std::size_t length = 0;
+			SharedPayload payload;
+		};
+
+		std::vector<std::uint8_t> m_bytes;
+		std::vector<Segment> m_segments;
+		std::size_t m_size = 0;
+	};
+
+} // namespace Common::Network
\ No newline at end of file
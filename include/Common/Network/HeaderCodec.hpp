@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include "Common/Network/MessageHeader.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace Common::Network
+{
+	/// \brief The header version which encodes each field compactly, and the one both sides start with
+	const std::uint8_t COMPACT_HEADER_VERSION = 1;
+
+	/// \brief The compact header with a flag saying whether the payload is compressed, and the newest version this build can speak
+	const std::uint8_t COMPRESSED_HEADER_VERSION = 2;
+
+	/**
+	 * \brief Choose the header version to use with a peer
+	 *
+	 * \param requestedVersion The newest version the peer can speak
+	 * \return std::uint8_t The newest version both sides can speak, never older than the one they started with
+	 */
+	constexpr auto negotiateHeaderVersion(const std::uint8_t requestedVersion) -> std::uint8_t
+	{
+		return std::clamp(requestedVersion, COMPACT_HEADER_VERSION, COMPRESSED_HEADER_VERSION);
+	}
+
+	/**
+	 * \class HeaderCodec HeaderCodec.hpp <Common/Network/HeaderCodec.hpp>
+	 * \brief Encodes and decodes the message headers exchanged with a single peer
+	 *
+	 * The compact header is a version byte, followed by varints for the message type and channel and for the entity ID, and
+	 * then whichever of the identifier and sequence number the channel needs. From COMPRESSED_HEADER_VERSION the message flags sit
+	 * between the message type and channel. The transport is known from the socket the
+	 * message arrived on, so TCP is implied. On TCP the identifier is sent as the difference from the last one on the stream,
+	 * on plain UDP only its low 16 bits are sent, and sequenced channels send only their sequence number. The low bits are enough as
+	 * long as each peer numbers the messages it sends the other on their own, rather than sharing one count between many peers.
+	 *
+	 * Both sides start with COMPACT_HEADER_VERSION, and switch once the version has been agreed at Client_Connect. Messages must be
+	 * encoded in the order they're sent, and decoded in the order they arrive, as the TCP identifier depends on the one before it
+	 */
+	class COMMON_API HeaderCodec
+	{
+	public:
+		/**
+		 * \brief Set the header version used to encode outgoing messages
+		 *
+		 * \param version The header version
+		 */
+		auto setEncodingVersion(std::uint8_t version) -> void;
+
+		/**
+		 * \brief Set the header version expected on incoming messages
+		 *
+		 * \param version The header version
+		 */
+		auto setDecodingVersion(std::uint8_t version) -> void;
+
+		/**
+		 * \brief Get the header version used to encode outgoing messages
+		 */
+		[[nodiscard]] auto getEncodingVersion() const -> std::uint8_t;
+
+		/**
+		 * \brief Get the header version expected on incoming messages
+		 */
+		[[nodiscard]] auto getDecodingVersion() const -> std::uint8_t;
+
+		/**
+		 * \brief Go back to the header version both sides start with, and forget the identifiers seen so far
+		 *
+		 */
+		auto reset() -> void;
+
+		/**
+		 * \brief Append an encoded header to a buffer
+		 *
+		 * \param header The header to encode
+		 * \param buffer The buffer to append the header to
+		 */
+		auto encode(const MessageHeader& header, std::vector<std::uint8_t>& buffer) -> void;
+
+		/**
+		 * \brief Decode the header at the start of a message
+		 *
+		 * \param data The received message
+		 * \param length The length of the received message
+		 * \param transport The protocol of the socket the message arrived on, TCP or UDP
+		 * \param header The header to decode into
+		 * \return std::optional<std::size_t> The length of the header, or nothing if the message doesn't start with a valid one
+		 */
+		auto decode(const std::uint8_t* data, std::size_t length, Protocol transport, MessageHeader& header) -> std::optional<std::size_t>;
+
+	private:
+		std::uint8_t m_encodingVersion = COMPACT_HEADER_VERSION;
+		std::uint8_t m_decodingVersion = COMPACT_HEADER_VERSION;
+
+		std::uint64_t m_lastEncodedStreamIdentifier = 0;
+		std::uint64_t m_lastDecodedStreamIdentifier = 0;
+		std::uint64_t m_lastDecodedIdentifier       = 0;
+	};
+
+} // namespace Common::Network
\ No newline at end of file
@@ -1,44 +1,106 @@
 #pragma once
 
 #include "Common/Export.hpp"
+#include "Common/Network/HeaderCodec.hpp"
 #include "Common/Network/MessageData.hpp"
 #include "Common/Network/MessageHeader.hpp"
+#include <memory>
 
 namespace Common::Network
 {
 	const std::size_t MAX_MESSAGE_LENGTH = 1 << 15;
 
+	/// \brief The most bytes packed into one datagram, chosen to stay under the path MTU once IP and UDP headers are added
+	const std::size_t MAX_DATAGRAM_LENGTH = 1200;
+
+	/// \brief An immutable packed payload which can be shared between the messages sent to many recipients
+	using SharedPayload = std::shared_ptr<const std::vector<std::uint8_t>>;
+
 	/**
 	 * \struct Message Message.hpp <Common/Network/Message.hpp>
 	 * \brief A piece, or pieces, of data that is sent over the network
 	 *
+	 * Outbound messages may carry a shared payload instead of their own data, in which case only the header belongs to the message.
+	 * Packed messages are taken from the BufferPool, and should be given back to it once they've been sent
 	 */
 	struct COMMON_API Message
 	{
 		MessageHeader header;
 		MessageData data;
+		SharedPayload sharedPayload;
+
+		/// \brief How urgently an outbound message should be sent, relative to the others waiting for the same peer. Never sent
+		float priority = 1.F;
+
+		/// \brief The entity an outbound message is about, if any, so messages about one entity wait their turn together. Never sent
+		entt::entity subject = entt::null;
+
+		/**
+		 * \brief Copy message data into a payload which can be shared between many messages
+		 *
+		 * \param data The message data to copy
+		 * \return SharedPayload The shared payload
+		 */
+		[[nodiscard]] static auto makeSharedPayload(const MessageData& data) -> SharedPayload;
+
+		/**
+		 * \brief Turn bytes into a payload which can be shared between many messages, giving them back to the BufferPool once it's sent
+		 *
+		 * \param bytes The bytes of the payload
+		 * \return SharedPayload The shared payload
+		 */
+		[[nodiscard]] static auto makeSharedPayload(std::vector<std::uint8_t>&& bytes) -> SharedPayload;
+
+		/**
+		 * \brief Gets a pointer to the bytes sent after the header, which are either the shared payload or the message data
+		 */
+		[[nodiscard]] auto getPayloadData() const -> const std::uint8_t*;
+
+		/**
+		 * \brief Gets the number of bytes sent after the header
+		 */
+		[[nodiscard]] auto getPayloadSize() const -> std::size_t;
+
+		/**
+		 * \brief Packs only the header into a vector of bytes using a peer's header codec, to be sent followed by the payload
+		 *
+		 * \param codec The header codec of the peer the message is sent to
+		 * \return A vector of bytes representing the message header, taken from the BufferPool
+		 */
+		[[nodiscard]] auto packHeader(HeaderCodec& codec) const -> std::vector<std::uint8_t>;
 
 		/**
-		 * \brief Packs the message into a vector of bytes
+		 * \brief Packs the message into a vector of bytes using a peer's header codec
 		 *
-		 * \return A vector of bytes representing the message data
+		 * \param codec The header codec of the peer the message is sent to
+		 * \return A vector of bytes representing the message data, taken from the BufferPool
 		 */
-		[[nodiscard]] auto pack() const -> std::vector<std::uint8_t>;
+		[[nodiscard]] auto pack(HeaderCodec& codec) const -> std::vector<std::uint8_t>;
 
 		/**
-		 * \brief Unpacks a byte vector into the message
+		 * \brief Unpacks a byte vector into the message using a peer's header codec
 		 *
 		 * \param buffer The byte vector to unpack
+		 * \param codec The header codec of the peer the message came from
+		 * \param transport The protocol of the socket the message arrived on, TCP or UDP
+		 * \return true The message was unpacked
+		 * \return false The message doesn't start with a valid header
 		 */
-		auto unpack(std::vector<std::uint8_t>& buffer) -> void;
+		auto unpack(const std::vector<std::uint8_t>& buffer, HeaderCodec& codec, Protocol transport) -> bool;
 
 		/**
-		 * \brief Unpacks a byte array of length MAX_MESSAGE_LENGTH into the message
+		 * \brief Unpacks a message from a receive buffer using a peer's header codec. The message data is left as a view over the
+		 * buffer, which is kept alive until the message is destroyed
 		 *
-		 * \param buffer The byte array to unpack
-		 * \param length The actual length of the message inside the buffer
+		 * \param buffer The receive buffer holding the message
+		 * \param offset The offset of the message in the buffer
+		 * \param length The length of the message
+		 * \param codec The header codec of the peer the message came from
+		 * \param transport The protocol of the socket the message arrived on, TCP or UDP
+		 * \return true The message was unpacked
+		 * \return false The message doesn't start with a valid header
 		 */
-		auto unpack(std::array<std::uint8_t, MAX_MESSAGE_LENGTH>& buffer, std::size_t length) -> void;
+		auto unpack(const ReceiveBuffer& buffer, std::size_t offset, std::size_t length, HeaderCodec& codec, Protocol transport) -> bool;
 	};
 
 } // namespace Common::Network
\ No newline at end of file
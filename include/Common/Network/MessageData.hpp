@@ -1,8 +1,11 @@
 #pragma once
 
 #include "Common/Export.hpp"
+#include "Common/Network/BufferPool.hpp"
+#include "Common/Network/ReceiveBufferPool.hpp"
 #include <cstdint>
 #include <entt/entity/entity.hpp>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -13,12 +16,38 @@ namespace Common::Network
 	 * \struct MessageData MessageData.hpp <Common/Network/MessageData.hpp>
 	 * \brief Allows for data of any type to be conveniently bundled into a vector of bytes
 	 *
+	 * Received messages are instead a view over the buffer they were received into, which is read from without being copied.
+	 * Writing to a view copies its data into a vector of its own first. Vectors are taken from the BufferPool, and given back
+	 * when the message data is destroyed
 	 */
 	class COMMON_API MessageData
 	{
 	public:
 		MessageData();
 
+		/**
+		 * \brief Construct a view over part of a receive buffer, which is kept alive as long as the view is
+		 *
+		 * \param buffer The buffer holding the data
+		 * \param offset The offset of the data in the buffer
+		 * \param length The length of the data
+		 */
+		MessageData(ReceiveBuffer buffer, std::size_t offset, std::size_t length);
+
+		/**
+		 * \brief Construct message data holding bytes which have already been packed, which is given back to the BufferPool with them
+		 *
+		 * \param bytes The bytes to hold
+		 */
+		explicit MessageData(std::vector<std::uint8_t>&& bytes);
+
+		MessageData(const MessageData& other);
+		MessageData(MessageData&& other) noexcept;
+		~MessageData();
+
+		auto operator=(const MessageData& other) -> MessageData&;
+		auto operator=(MessageData&& other) noexcept -> MessageData&;
+
 		auto operator<<(bool value) -> MessageData&;
 		auto operator<<(std::uint8_t value) -> MessageData&;
 		auto operator<<(std::uint16_t value) -> MessageData&;
@@ -44,6 +73,11 @@ namespace Common::Network
 		 */
 		[[nodiscard]] auto size() const -> std::size_t;
 
+		/**
+		 * \brief Gets the number of bytes which haven't been read yet
+		 */
+		[[nodiscard]] auto remaining() const -> std::size_t;
+
 		/**
 		 * \brief Gets a const void pointer to the contained data
 		 */
@@ -61,9 +95,40 @@ namespace Common::Network
 		 */
 		auto resize(std::size_t newSize) -> void;
 
+		/**
+		 * \brief Check whether the data is a view over a receive buffer
+		 */
+		[[nodiscard]] auto isView() const -> bool;
+
 	private:
+		/**
+		 * \brief Gets the contained bytes, wherever they're held
+		 */
+		[[nodiscard]] auto bytes() const -> std::span<const std::uint8_t>;
+
+		/**
+		 * \brief Gets the byte at an index, throwing std::out_of_range if it's past the end
+		 */
+		[[nodiscard]] auto at(std::size_t index) const -> std::uint8_t;
+
+		/**
+		 * \brief Copy a view's data into a vector of its own, so it can be written to
+		 *
+		 */
+		auto materialise() -> void;
+
+		/**
+		 * \brief Make room for more bytes, moving into a larger pooled vector if they don't fit
+		 *
+		 * \param additional The number of bytes about to be written
+		 */
+		auto reserve(std::size_t additional) -> void;
+
 		std::vector<std::uint8_t> m_data;
 		std::size_t m_readHead;
+
+		ReceiveBuffer m_buffer;
+		std::span<const std::uint8_t> m_view;
 	};
 
 } // namespace Common::Network
\ No newline at end of file
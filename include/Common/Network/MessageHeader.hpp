@@ -7,6 +7,8 @@
 
 namespace Common::Network
 {
+	/// \brief Set in MessageHeader::flags when the payload has been compressed by a PayloadCompressor
+	const std::uint8_t MESSAGE_FLAG_COMPRESSED = 1 << 0;
 
 	/**
 	 * \struct MessageHeader MessageHeader.hpp <Common/Network/MessageHeader.hpp>
@@ -18,7 +20,16 @@ namespace Common::Network
 		entt::entity entityID    = entt::null;
 		std::uint64_t identifier = 0;
 		Protocol protocol        = Protocol::TCP;
-		MessageType type         = MessageType::None;
+
+		// Describes how the payload is encoded. Fits in what would otherwise be padding
+		std::uint8_t flags = 0;
+
+		MessageType type = MessageType::None;
+
+		// The message's position in its channel, for the protocols that need one. Fits in what would otherwise be padding
+		std::uint16_t sequence = 0;
 	};
 
+	static_assert(sizeof(MessageHeader) == 24, "Packed headers are given room for one the size of this struct, which no encoded header is longer than");
+
 } // namespace Common::Network
\ No newline at end of file
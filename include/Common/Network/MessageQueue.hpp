@@ -2,6 +2,7 @@
 
 #include "Common/Export.hpp"
 #include "Common/Network/Message.hpp"
+#include "Common/Util/DoubleBufferedQueue.hpp"
 #include "Common/Util/ThreadSafeQueue.hpp"
 
 namespace Common::Network
@@ -11,8 +12,9 @@ namespace Common::Network
 	 * \brief A templated queue utility class containing both an inbound and outbound queue
 	 *
 	 * \tparam T The type the queues should contain
+	 * \tparam Queue The queue used for each direction. Util::DoubleBufferedQueue suits a queue which is drained in bulk every tick
 	 */
-	template<typename T>
+	template<typename T, template<typename> class Queue = Util::ThreadSafeQueue>
 	class MessageQueue
 	{
 	public:
@@ -46,6 +48,16 @@ namespace Common::Network
 			return m_inbound.clear();
 		}
 
+		/**
+		 * \brief Clears the inbound queue, moving the contained values into a vector which can be reused every time
+		 *
+		 * \param values The vector to move the values into, whose previous contents are discarded
+		 */
+		auto clearInbound(std::vector<T>& values) -> void
+		{
+			m_inbound.drainInto(values);
+		}
+
 		/**
 		 * \brief Pushes an rvalue of type T onto the outbound queue
 		 *
@@ -76,9 +88,19 @@ namespace Common::Network
 			return m_outbound.clear();
 		}
 
+		/**
+		 * \brief Clears the outbound queue, moving the contained values into a vector which can be reused every time
+		 *
+		 * \param values The vector to move the values into, whose previous contents are discarded
+		 */
+		auto clearOutbound(std::vector<T>& values) -> void
+		{
+			m_outbound.drainInto(values);
+		}
+
 	private:
-		Util::ThreadSafeQueue<T> m_inbound;
-		Util::ThreadSafeQueue<T> m_outbound;
+		Queue<T> m_inbound;
+		Queue<T> m_outbound;
 	};
 
 } // namespace Common::Network
\ No newline at end of file
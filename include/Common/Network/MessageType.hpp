@@ -23,6 +23,7 @@ namespace Common::Network
 		Client_Action,
 		Client_InputState,
 		Client_GetWorldState,
+		Client_SnapshotAck,
 
 		Server_PublicKey,
 		Server_Authenticate,
@@ -32,6 +33,7 @@ namespace Common::Network
 		Server_DestroyEntity,
 		Server_InputState,
 		Server_WorldState,
+		Server_Snapshot,
 	};
 
 	COMMON_API auto operator<<(MessageData& messageData, MessageType messageType) -> MessageData&;
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include "Common/Network/Message.hpp"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Common::Network
+{
+	/// \brief The zstd level used unless a policy asks for another, which favours speed as every message is compressed as it's sent
+	const int DEFAULT_COMPRESSION_LEVEL = 3;
+
+	/// \brief The default capacity of a trained dictionary, which zstd recommends keeping around a hundred times smaller than the samples
+	const std::size_t DEFAULT_DICTIONARY_CAPACITY = 16 * 1024;
+
+	/**
+	 * \struct CompressionPolicy PayloadCompressor.hpp <Common/Network/PayloadCompressor.hpp>
+	 * \brief Decides which messages of a type are compressed
+	 */
+	struct COMMON_API CompressionPolicy
+	{
+		/// \brief Payloads shorter than this are sent as they are, since they'd barely shrink
+		std::size_t threshold = 0;
+
+		/// \brief The zstd compression level
+		int level = DEFAULT_COMPRESSION_LEVEL;
+	};
+
+	/**
+	 * \struct CompressionStatistics PayloadCompressor.hpp <Common/Network/PayloadCompressor.hpp>
+	 * \brief Counts the work done compressing and decompressing one message type
+	 */
+	struct COMMON_API CompressionStatistics
+	{
+		/// \brief Messages which were long enough to compress
+		std::uint64_t attempted = 0;
+
+		/// \brief Messages which were sent compressed, because compressing them made them shorter
+		std::uint64_t compressed = 0;
+
+		/// \brief Payload bytes before and after compression, over the messages which were sent compressed
+		std::uint64_t bytesIn  = 0;
+		std::uint64_t bytesOut = 0;
+
+		/// \brief Time spent compressing every attempted message
+		std::uint64_t compressNanoseconds = 0;
+
+		/// \brief Messages received compressed, and the bytes they decompressed to
+		std::uint64_t decompressed      = 0;
+		std::uint64_t decompressedBytes = 0;
+
+		/// \brief Time spent decompressing
+		std::uint64_t decompressNanoseconds = 0;
+	};
+
+	/**
+	 * \class PayloadCompressor PayloadCompressor.hpp <Common/Network/PayloadCompressor.hpp>
+	 * \brief Compresses the payloads of large messages with zstd before they're packed, and decompresses them once unpacked
+	 *
+	 * Each message type is compressed only if it has a policy, and only once its payload reaches the policy's threshold. A compressed
+	 * message has MESSAGE_FLAG_COMPRESSED set in its header, so it must only be sent to peers speaking COMPRESSED_HEADER_VERSION.
+	 *
+	 * A message type may have a dictionary trained from captured payloads of that type, which both sides must load, as a payload
+	 * compressed with a dictionary can only be decompressed with the same one. Compressing and decompressing must happen on one thread
+	 * at a time, but the statistics may be read, and samples captured and trained, from any thread
+	 */
+	class COMMON_API PayloadCompressor
+	{
+	public:
+		PayloadCompressor();
+		~PayloadCompressor();
+
+		PayloadCompressor(const PayloadCompressor&)                    = delete;
+		auto operator=(const PayloadCompressor&) -> PayloadCompressor& = delete;
+
+		/**
+		 * \brief Compress the payloads of a message type from now on. Only call this before messages are sent
+		 *
+		 * \param type The message type
+		 * \param policy Which payloads to compress, and how hard
+		 */
+		auto setPolicy(MessageType type, const CompressionPolicy& policy) -> void;
+
+		/**
+		 * \brief Compress the messages which carry bulk entity data, which are mostly names, repeated stat blocks and nearby positions
+		 *
+		 */
+		auto useDefaultPolicies() -> void;
+
+		/**
+		 * \brief Use a dictionary for a message type. Only call this before messages are sent or received
+		 *
+		 * \param type The message type
+		 * \param dictionary The dictionary, as saved by saveDictionaries
+		 * \return true The dictionary was loaded
+		 * \return false The dictionary isn't valid
+		 */
+		auto setDictionary(MessageType type, std::span<const std::uint8_t> dictionary) -> bool;
+
+		/**
+		 * \brief Load every dictionary saved in a directory by saveDictionaries
+		 *
+		 * \param directory The directory to load from
+		 * \return std::size_t The number of dictionaries loaded
+		 */
+		auto loadDictionaries(const std::filesystem::path& directory) -> std::size_t;
+
+		/**
+		 * \brief Compress a message's payload if its type has a policy and it's long enough, and set its compressed flag if it shrank
+		 *
+		 * Shared payloads are compressed once however many messages carry them, provided the messages are compressed one after another
+		 *
+		 * \param message The message to compress, before it's packed
+		 */
+		auto compress(Message& message) -> void;
+
+		/**
+		 * \brief Decompress a message's data if its compressed flag is set
+		 *
+		 * \param message The message to decompress, once it's been unpacked
+		 * \return true The message is ready to be read
+		 * \return false The message claimed to be compressed but couldn't be decompressed, and should be dropped
+		 */
+		auto decompress(Message& message) -> bool;
+
+		/**
+		 * \brief Keep copies of the payloads compressed from now on, to train dictionaries from
+		 *
+		 * \param samplesPerType The most payloads to keep of each message type, or zero to stop capturing
+		 */
+		auto setCaptureLimit(std::size_t samplesPerType) -> void;
+
+		/**
+		 * \brief Train a dictionary for every message type with captured payloads, and save them to a directory
+		 *
+		 * The dictionaries aren't used until they're loaded, by both sides, as peers already connected don't have them
+		 *
+		 * \param directory The directory to save the dictionaries in
+		 * \param capacity The largest each dictionary may be
+		 * \return std::size_t The number of dictionaries saved
+		 */
+		auto saveDictionaries(const std::filesystem::path& directory, std::size_t capacity = DEFAULT_DICTIONARY_CAPACITY) -> std::size_t;
+
+		/**
+		 * \brief Get the statistics of every message type which has been compressed or decompressed
+		 */
+		[[nodiscard]] auto getStatistics() const -> std::unordered_map<MessageType, CompressionStatistics>;
+
+	private:
+		struct Contexts;
+
+		struct TypeStatistics
+		{
+			std::atomic<std::uint64_t> attempted             = 0;
+			std::atomic<std::uint64_t> compressed            = 0;
+			std::atomic<std::uint64_t> bytesIn               = 0;
+			std::atomic<std::uint64_t> bytesOut              = 0;
+			std::atomic<std::uint64_t> compressNanoseconds   = 0;
+			std::atomic<std::uint64_t> decompressed          = 0;
+			std::atomic<std::uint64_t> decompressedBytes     = 0;
+			std::atomic<std::uint64_t> decompressNanoseconds = 0;
+		};
+
+		/**
+		 * \brief Compress bytes with a message type's policy and dictionary
+		 *
+		 * \return std::vector<std::uint8_t> The compressed bytes taken from the BufferPool, or an empty vector if they didn't shrink
+		 */
+		auto compressBytes(MessageType type, const CompressionPolicy& policy, const std::uint8_t* data, std::size_t length) -> std::vector<std::uint8_t>;
+
+		/**
+		 * \brief Keep a copy of a payload to train from, if there's room for another sample of its type
+		 */
+		auto capture(MessageType type, const std::uint8_t* data, std::size_t length) -> void;
+
+		/**
+		 * \brief Get the statistics of a message type, creating them if it has none yet
+		 */
+		auto getTypeStatistics(MessageType type) -> TypeStatistics&;
+
+		std::unique_ptr<Contexts> m_contexts;
+		std::unordered_map<MessageType, CompressionPolicy> m_policies;
+
+		// The last shared payload compressed, and what it compressed to, or nothing if it didn't shrink
+		SharedPayload m_lastSharedPayload;
+		SharedPayload m_lastCompressedPayload;
+
+		mutable std::mutex m_statisticsMutex;
+		std::unordered_map<MessageType, std::unique_ptr<TypeStatistics>> m_statistics;
+
+		std::mutex m_captureMutex;
+		std::size_t m_captureLimit = 0;
+		std::unordered_map<MessageType, std::vector<std::vector<std::uint8_t>>> m_samples;
+	};
+
+} // namespace Common::Network
\ No newline at end of file
@@ -6,10 +6,37 @@
 namespace Common::Network
 {
 
+	/**
+	 * \enum Protocol
+	 * \brief How a message is delivered. Everything other than TCP is carried over the UDP socket
+	 *
+	 * ReliableOrdered messages are resent until acknowledged and delivered in the order they were sent.
+	 * ReliableUnordered messages are resent until acknowledged and delivered as soon as they arrive.
+	 * UnreliableSequenced messages are never resent, and are dropped if a newer message on the same channel has already arrived.
+	 */
 	enum class Protocol : std::uint8_t
 	{
 		TCP,
-		UDP
+		UDP,
+		ReliableOrdered,
+		ReliableUnordered,
+		UnreliableSequenced
 	};
 
+	/**
+	 * \brief Check whether messages using a protocol are resent until they're acknowledged
+	 */
+	constexpr auto isReliable(const Protocol protocol) -> bool
+	{
+		return protocol == Protocol::ReliableOrdered || protocol == Protocol::ReliableUnordered;
+	}
+
+	/**
+	 * \brief Check whether messages using a protocol carry a channel sequence number
+	 */
+	constexpr auto isSequenced(const Protocol protocol) -> bool
+	{
+		return isReliable(protocol) || protocol == Protocol::UnreliableSequenced;
+	}
+
 } // namespace Common::Network
\ No newline at end of file
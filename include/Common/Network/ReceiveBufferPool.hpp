@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Common::Network
+{
+
+	/**
+	 * \class ReceiveBuffer ReceiveBufferPool.hpp <Common/Network/ReceiveBufferPool.hpp>
+	 * \brief A reference counted handle on a buffer taken from a ReceiveBufferPool
+	 *
+	 * Every message unpacked from a received datagram or frame holds a handle on the buffer it was received into, and reads its
+	 * data from there. The buffer goes back to its pool once the last handle is dropped, which may happen on any thread
+	 */
+	class COMMON_API ReceiveBuffer
+	{
+	public:
+		ReceiveBuffer() = default;
+		ReceiveBuffer(const ReceiveBuffer& other);
+		ReceiveBuffer(ReceiveBuffer&& other) noexcept;
+		~ReceiveBuffer();
+
+		auto operator=(const ReceiveBuffer& other) -> ReceiveBuffer&;
+		auto operator=(ReceiveBuffer&& other) noexcept -> ReceiveBuffer&;
+
+		/**
+		 * \brief Gets a pointer to the start of the buffer
+		 */
+		[[nodiscard]] auto data() -> std::uint8_t*;
+
+		/**
+		 * \brief Gets a const pointer to the start of the buffer
+		 */
+		[[nodiscard]] auto data() const -> const std::uint8_t*;
+
+		/**
+		 * \brief Gets the number of bytes the buffer was acquired with
+		 */
+		[[nodiscard]] auto size() const -> std::size_t;
+
+		/**
+		 * \brief Check whether the handle refers to a buffer
+		 */
+		explicit operator bool() const;
+
+	private:
+		friend class ReceiveBufferPool;
+
+		struct Block;
+
+		explicit ReceiveBuffer(Block* block);
+
+		/**
+		 * \brief Drop this handle's reference, returning the buffer to its pool if it was the last one
+		 *
+		 */
+		auto release() -> void;
+
+		Block* m_block = nullptr;
+	};
+
+	/**
+	 * \class ReceiveBufferPool ReceiveBufferPool.hpp <Common/Network/ReceiveBufferPool.hpp>
+	 * \brief Hands out buffers to receive into, and takes them back once nothing reads from them
+	 *
+	 * Buffers are all the same capacity, so once the pool has warmed up receiving allocates nothing. Longer buffers are allocated
+	 * on their own and freed when they're released. Buffers may be released after the pool has been destroyed
+	 */
+	class COMMON_API ReceiveBufferPool
+	{
+	public:
+		/**
+		 * \brief Construct a new Receive Buffer Pool object
+		 *
+		 * \param bufferCapacity The capacity of each pooled buffer
+		 */
+		explicit ReceiveBufferPool(std::size_t bufferCapacity);
+
+		/**
+		 * \brief Take a buffer from the pool
+		 *
+		 * \param length The number of bytes needed
+		 * \return ReceiveBuffer A handle on a buffer of the given length
+		 */
+		auto acquire(std::size_t length) -> ReceiveBuffer;
+
+		/**
+		 * \brief Get the number of pooled buffers which have been allocated
+		 */
+		[[nodiscard]] auto getAllocatedCount() const -> std::uint64_t;
+
+		/**
+		 * \brief Get the number of pooled buffers waiting to be acquired
+		 */
+		[[nodiscard]] auto getAvailableCount() const -> std::size_t;
+
+		/**
+		 * \brief Get the number of buffers which were too long to come from the pool
+		 */
+		[[nodiscard]] auto getOversizedCount() const -> std::uint64_t;
+
+	private:
+		friend class ReceiveBuffer;
+
+		/**
+		 * \brief The free list, which lives as long as any buffer taken from it
+		 */
+		struct State
+		{
+			std::mutex mutex;
+			std::vector<ReceiveBuffer::Block*> available;
+			std::size_t bufferCapacity = 0;
+			std::atomic<std::uint64_t> allocatedCount = 0;
+			std::atomic<std::uint64_t> oversizedCount = 0;
+
+			~State();
+		};
+
+		std::shared_ptr<State> m_state;
+	};
+
+} // namespace Common::Network
\ No newline at end of file
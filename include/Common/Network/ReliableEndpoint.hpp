@@ -0,0 +1,183 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include "Common/Network/GatherBuffer.hpp"
+#include "Common/Network/Message.hpp"
+#include "Common/Network/Protocol.hpp"
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Common::Network
+{
+
+	/**
+	 * \struct PacketHeader ReliableEndpoint.hpp <Common/Network/ReliableEndpoint.hpp>
+	 * \brief Sent at the start of every datagram, so each side can acknowledge the datagrams the other has sent
+	 */
+	struct PacketHeader
+	{
+		static constexpr auto LENGTH = std::size_t(8);
+
+		std::uint16_t sequence = 0;
+		std::uint16_t ack      = 0;
+		std::uint32_t ackBits  = 0;
+	};
+
+	/**
+	 * \brief Compare two wrapping 16-bit sequence numbers
+	 *
+	 * \return true a is more recent than b
+	 */
+	constexpr auto isSequenceNewer(const std::uint16_t a, const std::uint16_t b) -> bool
+	{
+		return ((a > b) && (a - b <= 0x8000)) || ((a < b) && (b - a > 0x8000));
+	}
+
+	/**
+	 * \class ReliableEndpoint ReliableEndpoint.hpp <Common/Network/ReliableEndpoint.hpp>
+	 * \brief One side of the datagram traffic with a single peer, implementing the channels described by Protocol
+	 *
+	 * Messages are packed into datagrams of at most MAX_DATAGRAM_LENGTH bytes, each starting with a PacketHeader. The header
+	 * acknowledges the latest datagram received from the peer and, in a bitfield, the 32 before it. Reliable messages are kept
+	 * until a datagram carrying them is acknowledged, and are resent whenever the retransmission timeout, derived from the
+	 * measured round trip time, passes without that happening.
+	 */
+	class COMMON_API ReliableEndpoint
+	{
+	public:
+		/**
+		 * \brief Construct a new Reliable Endpoint object
+		 *
+		 * \param maxDatagramLength The longest datagram to build. Messages which don't fit in one are sent in a datagram of their own
+		 */
+		ReliableEndpoint(std::size_t maxDatagramLength = MAX_DATAGRAM_LENGTH);
+
+		/**
+		 * \brief Give a message the next sequence number on its channel. Must be called before the message is packed
+		 *
+		 * \param header The header of the message
+		 */
+		auto stampHeader(MessageHeader& header) -> void;
+
+		/**
+		 * \brief Pack a message into the current datagram
+		 *
+		 * \param protocol The protocol the message is sent with
+		 * \param packed The packed and encrypted message, or just its header if it has a shared payload
+		 * \param payload The message's shared payload, which may be empty
+		 */
+		auto send(Protocol protocol, std::vector<std::uint8_t>&& packed, const SharedPayload& payload) -> void;
+
+		/**
+		 * \brief Resend any reliable messages whose timeout has passed, and close the current datagram.
+		 * A datagram carrying only acknowledgements is built if anything has been received since the last flush
+		 *
+		 * \return std::vector<GatherBuffer> The datagrams which are ready to be sent
+		 */
+		auto flush() -> std::vector<GatherBuffer>;
+
+		/**
+		 * \brief Read the packet header at the start of a received datagram, and apply its acknowledgements
+		 *
+		 * \param data The datagram
+		 * \param length The length of the datagram
+		 * \return std::optional<std::size_t> The offset of the datagram's first message, or nothing if it should be dropped
+		 */
+		auto receivePacket(const std::uint8_t* data, std::size_t length) -> std::optional<std::size_t>;
+
+		/**
+		 * \brief Pass a message from a received datagram through its channel
+		 *
+		 * \param message The message
+		 * \param delivered The messages which are ready to be handled, in order, are appended to this
+		 */
+		auto receiveMessage(Message&& message, std::vector<Message>& delivered) -> void;
+
+		/**
+		 * \brief Forget everything about the peer, ready for a new connection
+		 *
+		 */
+		auto reset() -> void;
+
+		/**
+		 * \brief Get the smoothed round trip time to the peer
+		 */
+		[[nodiscard]] auto getRoundTripTime() const -> sf::Time;
+
+		/**
+		 * \brief Get the current retransmission timeout
+		 */
+		[[nodiscard]] auto getRetransmissionTimeout() const -> sf::Time;
+
+		/**
+		 * \brief Get the number of reliable messages which haven't been acknowledged yet
+		 */
+		[[nodiscard]] auto getPendingReliableCount() const -> std::size_t;
+
+		/**
+		 * \brief Get the number of times a reliable message has been resent
+		 */
+		[[nodiscard]] auto getResentCount() const -> std::uint64_t;
+
+	private:
+		static constexpr auto SENT_PACKET_WINDOW = std::size_t(1024);
+		static constexpr auto RECEIVE_WINDOW     = std::size_t(1024);
+
+		struct SentPacket
+		{
+			std::uint16_t sequence = 0;
+			bool isValid           = false;
+			sf::Time sendTime;
+			std::vector<std::uint32_t> reliableMessages;
+		};
+
+		struct PendingReliable
+		{
+			std::vector<std::uint8_t> packed;
+			SharedPayload payload;
+			sf::Time lastSendTime;
+		};
+
+		auto appendFrame(const std::vector<std::uint8_t>& packed, const SharedPayload& payload) -> void;
+		auto openDatagram() -> void;
+		auto closeDatagram() -> void;
+		auto acknowledge(std::uint16_t sequence, sf::Time now, bool isLatest) -> void;
+
+		std::size_t m_maxDatagramLength;
+		sf::Clock m_clock;
+
+		// Sending
+		std::uint16_t m_nextPacketSequence = 0;
+		std::array<std::uint16_t, 3> m_nextChannelSequence{};
+		GatherBuffer m_currentDatagram;
+		std::vector<std::uint32_t> m_currentReliableMessages;
+		std::vector<GatherBuffer> m_readyDatagrams;
+		std::vector<SentPacket> m_sentPackets;
+		std::map<std::uint32_t, PendingReliable> m_pendingReliable;
+		std::uint32_t m_nextReliableID = 0;
+		std::uint64_t m_resentCount    = 0;
+
+		sf::Time m_smoothedRoundTripTime;
+		sf::Time m_roundTripTimeVariance;
+		bool m_hasRoundTripTime = false;
+
+		// Receiving. Until something is received, acknowledge a sequence number that won't have been used yet
+		std::uint16_t m_remoteSequence = 0xFFFF;
+		std::uint32_t m_receivedBits   = 0;
+		bool m_hasReceivedPacket       = false;
+		bool m_isAckPending            = false;
+
+		std::uint16_t m_nextOrderedSequence = 0;
+		std::unordered_map<std::uint16_t, Message> m_orderedBuffer;
+		std::vector<std::optional<std::uint16_t>> m_unorderedReceived;
+		std::uint16_t m_lastSequenced = 0;
+		bool m_hasSequenced           = false;
+	};
+
+} // namespace Common::Network
\ No newline at end of file
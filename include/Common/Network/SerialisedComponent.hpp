@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common/Export.hpp"
+#include "Common/Network/BitStream.hpp"
 #include "Common/Network/MessageData.hpp"
 
 namespace Common::Network
@@ -10,6 +11,9 @@ namespace Common::Network
 	 * \class SerialisedComponent SerialisedComponent.hpp <Common/Network/SerialisedComponent.hpp>
 	 * \brief A base class for any component which should be serialisable
 	 *
+	 * Components opt into bit packing by also implementing the BitWriter and BitReader overloads, which are used where payload
+	 * size matters, such as snapshots
+	 *
 	 * \tparam DerivedComponent The type of a class deriving this, in order to support static polymorphism
 	 */
 	template<class DerivedComponent>
@@ -35,6 +39,71 @@ namespace Common::Network
 		{
 			static_cast<DerivedComponent*>(this)->deserialise(data);
 		}
+
+		/**
+		 * \brief Serialise only the fields which differ from a baseline, preceded by a mask of which fields they are.
+		 * Components which are replicated in snapshots implement this
+		 *
+		 * \param baseline The state of the component the receiver already has
+		 * \param data The MessageData struct to serialise in to
+		 */
+		auto serialiseDelta(const DerivedComponent& baseline, MessageData& data) -> void
+		{
+			static_cast<DerivedComponent*>(this)->serialiseDelta(baseline, data);
+		}
+
+		/**
+		 * \brief Apply fields serialised by serialiseDelta on top of the component, which must hold the same baseline
+		 *
+		 * \param data The MessageData struct to deserialise from
+		 */
+		auto deserialiseDelta(MessageData& data) -> void
+		{
+			static_cast<DerivedComponent*>(this)->deserialiseDelta(data);
+		}
+
+		/**
+		 * \brief Serialise the component into a bit stream
+		 *
+		 * \param writer The BitWriter to serialise in to
+		 */
+		auto serialise(BitWriter& writer) -> void
+		{
+			static_cast<DerivedComponent*>(this)->serialise(writer);
+		}
+
+		/**
+		 * \brief Deserialise the component from a bit stream
+		 *
+		 * \param reader The BitReader to deserialise from
+		 */
+		auto deserialise(BitReader& reader) -> void
+		{
+			static_cast<DerivedComponent*>(this)->deserialise(reader);
+		}
+
+		/**
+		 * \brief Serialise only the fields which differ from a baseline into a bit stream, preceded by a mask of which fields they are
+		 *
+		 * \param baseline The state of the component the receiver already has
+		 * \param writer The BitWriter to serialise in to
+		 */
+		auto serialiseDelta(const DerivedComponent& baseline, BitWriter& writer) -> void
+		{
+			static_cast<DerivedComponent*>(this)->serialiseDelta(baseline, writer);
+		}
+
+		/**
+		 * \brief Apply fields serialised by serialiseDelta into a bit stream on top of the component, which must hold the same baseline
+		 *
+		 * \param reader The BitReader to deserialise from
+		 */
+		auto deserialiseDelta(BitReader& reader) -> void
+		{
+			static_cast<DerivedComponent*>(this)->deserialiseDelta(reader);
+		}
+
+		auto operator==(const SerialisedComponent&) const -> bool = default;
 	};
 
 } // namespace Common::Network
\ No newline at end of file
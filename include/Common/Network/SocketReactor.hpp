@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include <SFML/Network/Socket.hpp>
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Time.hpp>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using epoll_event_t = struct epoll_event;
+
+namespace Common::Network
+{
+
+	/**
+	 * \struct SocketEvent SocketReactor.hpp <Common/Network/SocketReactor.hpp>
+	 * \brief A readiness notification for a socket registered with a SocketReactor
+	 */
+	struct SocketEvent
+	{
+		std::uint64_t token = 0;
+		bool readable       = false;
+		bool writable       = false;
+		bool hangup         = false;
+	};
+
+	/**
+	 * \class SocketReactor SocketReactor.hpp <Common/Network/SocketReactor.hpp>
+	 * \brief Waits on a set of sockets and reports only the ones which became ready
+	 *
+	 * On Linux this is an edge-triggered epoll instance, so a wakeup costs O(ready sockets) rather than O(registered sockets),
+	 * and there is no FD_SETSIZE limit. Because it is edge-triggered, registered sockets must be non-blocking and the caller must
+	 * read each reported socket until it would block, otherwise no further event will be raised for it.
+	 * Other platforms fall back to an sf::SocketSelector with the same interface.
+	 */
+	class COMMON_API SocketReactor
+	{
+	public:
+		/// \brief The token used internally to wake the reactor, which can't be used to register a socket
+		static constexpr auto INTERRUPT_TOKEN = std::numeric_limits<std::uint64_t>::max();
+
+		/// \brief Whether sockets registered for it are reported when they can be written to again. If not, writes have to be retried
+#if defined(__linux__)
+		static constexpr auto REPORTS_WRITABLE = true;
+#else
+		static constexpr auto REPORTS_WRITABLE = false;
+#endif
+
+		/**
+		 * \brief Construct a new Socket Reactor object
+		 *
+		 * \param maxEventsPerWait The maximum number of events to report from a single call to wait
+		 */
+		SocketReactor(std::size_t maxEventsPerWait = 1024);
+
+		/**
+		 * \brief Destroy the Socket Reactor object
+		 *
+		 */
+		~SocketReactor();
+
+		SocketReactor(const SocketReactor&)                    = delete;
+		auto operator=(const SocketReactor&) -> SocketReactor& = delete;
+
+		/**
+		 * \brief Register a socket with the reactor
+		 *
+		 * \param socket The socket to watch. It must outlive its registration
+		 * \param token The value reported in a SocketEvent when the socket becomes ready
+		 * \param watchWritable Also report when the socket's send buffer has room again, after a write which would have blocked
+		 * \return true The socket was registered
+		 * \return false The socket could not be registered
+		 */
+		auto add(sf::Socket& socket, std::uint64_t token, bool watchWritable = false) -> bool;
+
+		/**
+		 * \brief Stop watching a socket
+		 *
+		 * \param socket The socket to stop watching
+		 */
+		auto remove(sf::Socket& socket) -> void;
+
+		/**
+		 * \brief Stop watching every socket
+		 *
+		 */
+		auto clear() -> void;
+
+		/**
+		 * \brief Wait until at least one registered socket is ready, or the timeout expires
+		 *
+		 * \param timeout The maximum amount of time to wait
+		 * \return const std::vector<SocketEvent>& The sockets which became ready. Valid until the next call to wait
+		 */
+		auto wait(sf::Time timeout) -> const std::vector<SocketEvent>&;
+
+		/**
+		 * \brief Wake up a call to wait which is in progress on another thread, or make the next call return immediately
+		 *
+		 */
+		auto interrupt() -> void;
+
+		/**
+		 * \brief Get the number of sockets currently registered
+		 */
+		[[nodiscard]] auto size() const -> std::size_t;
+
+	private:
+		std::vector<SocketEvent> m_events;
+		std::size_t m_socketCount = 0;
+
+#if defined(__linux__)
+		int m_epollDescriptor     = -1;
+		int m_interruptDescriptor = -1;
+		std::unique_ptr<epoll_event_t[]> m_epollEvents;
+		std::size_t m_maxEvents = 0;
+#else
+		sf::SocketSelector m_selector;
+		std::vector<std::pair<sf::Socket*, std::uint64_t>> m_sockets;
+		sf::UdpSocket m_interruptSocket;
+#endif
+	};
+
+} // namespace Common::Network
\ No newline at end of file
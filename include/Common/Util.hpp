@@ -1,3 +1,8 @@
 #pragma once
 
+#include "Common/Util/CacheLine.hpp"
+#include "Common/Util/DoubleBufferedQueue.hpp"
+#include "Common/Util/JobSystem.hpp"
+#include "Common/Util/MultiProducerQueue.hpp"
+#include "Common/Util/SingleProducerQueue.hpp"
 #include "Common/Util/ThreadSafeQueue.hpp"
\ No newline at end of file
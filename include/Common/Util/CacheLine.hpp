@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Common::Util
+{
+	/// \brief The alignment which keeps values written by different threads from sharing a cache line
+	const std::size_t CACHE_LINE_SIZE = 64;
+
+} // namespace Common::Util
\ No newline at end of file
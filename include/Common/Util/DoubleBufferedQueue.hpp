@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Common::Util
+{
+
+	/**
+	 * \class DoubleBufferedQueue DoubleBufferedQueue.hpp <Common/Util/DoubleBufferedQueue.hpp>
+	 * \brief A queue which producers append to under a lock, and which is emptied by swapping its buffer for the consumer's
+	 *
+	 * The lock is only held for one append or one swap, whatever the number of values, and the two buffers keep their capacity as
+	 * they're handed back and forth, so a queue which is drained every tick stops allocating once it's warmed up. Any number of threads
+	 * may push, but only one may pop or drain
+	 *
+	 * \tparam T The type the queue should contain
+	 */
+	template<typename T>
+	class DoubleBufferedQueue
+	{
+	public:
+		/**
+		 * \brief Pushes an rvalue of type T into the queue
+		 *
+		 * \param value The rvalue to push into the queue
+		 */
+		auto push(T&& value) -> void
+		{
+			std::scoped_lock<std::mutex> lock{m_mutex};
+			m_writeBuffer.emplace_back(std::move(value));
+		}
+
+		/**
+		 * \brief Pops the value at the front of the queue and returns it, if it exists
+		 *
+		 * \return std::optional<T> An optional which may contain a value of type T
+		 */
+		auto pop() -> std::optional<T>
+		{
+			if (m_readIndex == m_readBuffer.size())
+			{
+				m_readBuffer.clear();
+				m_readIndex = 0;
+
+				std::scoped_lock<std::mutex> lock{m_mutex};
+				std::swap(m_readBuffer, m_writeBuffer);
+			}
+
+			if (m_readIndex == m_readBuffer.size())
+			{
+				return {};
+			}
+			return std::move(m_readBuffer[m_readIndex++]);
+		}
+
+		/**
+		 * \brief Clears the queue and returns all the values previously contained in it
+		 *
+		 * \return std::vector<T> A vector containing all the previous contained values
+		 */
+		auto clear() -> std::vector<T>
+		{
+			auto values = std::vector<T>();
+			drainInto(values);
+			return values;
+		}
+
+		/**
+		 * \brief Replace the contents of a vector with every value in the queue, giving the vector's storage to the queue to reuse
+		 *
+		 * \param values The vector to swap the values into, whose previous contents are discarded
+		 */
+		auto drainInto(std::vector<T>& values) -> void
+		{
+			values.clear();
+			if (m_readIndex < m_readBuffer.size())
+			{
+				// Values left over from pop come first, so they keep their order
+				values.insert(values.end(), std::make_move_iterator(m_readBuffer.begin() + m_readIndex), std::make_move_iterator(m_readBuffer.end()));
+				m_readBuffer.clear();
+				m_readIndex = 0;
+
+				std::scoped_lock<std::mutex> lock{m_mutex};
+				values.insert(values.end(), std::make_move_iterator(m_writeBuffer.begin()), std::make_move_iterator(m_writeBuffer.end()));
+				m_writeBuffer.clear();
+				return;
+			}
+
+			std::scoped_lock<std::mutex> lock{m_mutex};
+			std::swap(values, m_writeBuffer);
+		}
+
+	private:
+		std::vector<T> m_writeBuffer;
+		std::mutex m_mutex;
+
+		std::vector<T> m_readBuffer;
+		std::size_t m_readIndex = 0;
+	};
+
+} // namespace Common::Util
\ No newline at end of file
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include "Common/Util/CacheLine.hpp"
+#include "Common/Util/ThreadSafeQueue.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Common::Util
+{
+
+	/**
+	 * \class JobGroup JobSystem.hpp <Common/Util/JobSystem.hpp>
+	 * \brief Jobs which are waited on together. Waiting on a group with JobSystem::wait is a fence, after which every job run in the
+	 * group has finished and everything it wrote is visible
+	 */
+	class JobGroup
+	{
+	public:
+		JobGroup() = default;
+
+		JobGroup(const JobGroup&)                    = delete;
+		auto operator=(const JobGroup&) -> JobGroup& = delete;
+
+		/**
+		 * \brief Check whether every job run in the group has finished
+		 */
+		[[nodiscard]] auto isDone() const -> bool
+		{
+			return m_pending.load(std::memory_order_acquire) == 0;
+		}
+
+	private:
+		friend class JobSystem;
+
+		std::atomic<std::size_t> m_pending = 0;
+		// The last job finishes while holding the lock, so a thread sleeping on the group can't miss it
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+	};
+
+	/**
+	 * \class JobSystem JobSystem.hpp <Common/Util/JobSystem.hpp>
+	 * \brief Runs jobs on a fixed set of worker threads, which steal work from each other when they run out
+	 *
+	 * Every worker has its own deque. A worker runs the newest job on its own deque first, as whatever it just queued is most likely still
+	 * in its cache, and steals the oldest job from another's when its own is empty, so big pieces of work are split up before small ones.
+	 * Jobs queued by any other thread go on a deque shared by them. A thread waiting on a group runs jobs while it waits, so waiting from
+	 * inside a job never deadlocks. A worker runs any job, but any other thread only runs jobs in the group it's waiting on, so a shard
+	 * waiting on its systems can't end up running something slow like a password hash. Once there's nothing left for it to run, the
+	 * waiting thread spins briefly then sleeps until the group is done.
+	 *
+	 * Jobs with main thread affinity, such as anything touching a window, a database connection or a registry owned by the main loop, are
+	 * queued separately and only run when the main thread calls runMainThreadJobs. The main thread is the thread which constructed the
+	 * job system
+	 */
+	class COMMON_API JobSystem
+	{
+	public:
+		using Job           = std::function<void()>;
+		using RangeFunction = std::function<void(std::size_t begin, std::size_t end)>;
+
+		/**
+		 * \brief Construct a new Job System object, starting its workers
+		 *
+		 * \param workerCount The number of worker threads, which may be zero, in which case jobs run on the thread which queues them
+		 */
+		explicit JobSystem(std::size_t workerCount = getDefaultWorkerCount());
+
+		/**
+		 * \brief Destroy the Job System object, finishing every job already queued and stopping its workers. Main thread jobs which
+		 * haven't been run are discarded
+		 *
+		 */
+		~JobSystem();
+
+		JobSystem(const JobSystem&)                    = delete;
+		auto operator=(const JobSystem&) -> JobSystem& = delete;
+
+		/**
+		 * \brief Get the number of workers which keeps every hardware thread busy alongside the thread queueing the work
+		 */
+		[[nodiscard]] static auto getDefaultWorkerCount() -> std::size_t;
+
+		/**
+		 * \brief Queue a job which nothing waits on. Safe to call from any thread
+		 *
+		 * \param job The job
+		 */
+		auto run(Job&& job) -> void;
+
+		/**
+		 * \brief Queue a job as part of a group. Safe to call from any thread
+		 *
+		 * \param group The group, which must outlive the job
+		 * \param job The job
+		 */
+		auto run(JobGroup& group, Job&& job) -> void;
+
+		/**
+		 * \brief Queue a job to be run by the main thread, the next time it calls runMainThreadJobs. Safe to call from any thread
+		 *
+		 * \param job The job
+		 */
+		auto runOnMainThread(Job&& job) -> void;
+
+		/**
+		 * \brief Queue a job to be run by the main thread as part of a group. Safe to call from any thread
+		 *
+		 * \param group The group, which must outlive the job
+		 * \param job The job
+		 */
+		auto runOnMainThread(JobGroup& group, Job&& job) -> void;
+
+		/**
+		 * \brief Run jobs until every job in a group has finished, then sleep until the ones running elsewhere have too. Workers run any
+		 * job, other threads only jobs in the group. On the main thread, this runs main thread jobs too, so waiting on a group holding any
+		 * can't deadlock. Safe to call from any thread, including from inside a job
+		 *
+		 * \param group The group
+		 */
+		auto wait(JobGroup& group) -> void;
+
+		/**
+		 * \brief Split a range of indices into chunks, run a function over each, possibly at the same time, and wait for them all to finish.
+		 * Safe to call from any thread, including from inside a job
+		 *
+		 * \param count The number of indices, from zero
+		 * \param minChunkSize The fewest indices in a chunk, so small ranges aren't split into work that's cheaper than handing it over
+		 * \param function The function, given the start and end of a chunk
+		 */
+		auto parallelFor(std::size_t count, std::size_t minChunkSize, const RangeFunction& function) -> void;
+
+		/**
+		 * \brief Run every main thread job queued so far. Only call this from the main thread, once per iteration of its loop
+		 *
+		 * \return std::size_t The number of jobs which were run
+		 */
+		auto runMainThreadJobs() -> std::size_t;
+
+		/**
+		 * \brief Get the number of worker threads, not counting the threads queueing work
+		 */
+		[[nodiscard]] auto getWorkerCount() const -> std::size_t;
+
+		/**
+		 * \brief Check whether the calling thread is the main thread
+		 */
+		[[nodiscard]] auto isMainThread() const -> bool;
+
+	private:
+		struct QueuedJob
+		{
+			Job job;
+			JobGroup* group = nullptr;
+		};
+
+		/**
+		 * \struct JobQueue
+		 * \brief The deque belonging to one worker, or shared by every other thread. Each is on its own cache line, so workers taking
+		 * from their own don't contend with each other
+		 */
+		struct alignas(CACHE_LINE_SIZE) JobQueue
+		{
+			std::mutex mutex;
+			std::deque<QueuedJob> jobs;
+		};
+
+		/**
+		 * \brief The body of each worker thread
+		 *
+		 * \param index The worker's index, which is also the index of its deque
+		 */
+		auto runWorker(std::size_t index) -> void;
+
+		/**
+		 * \brief Put a job on the calling thread's deque, and wake a sleeping worker to take it
+		 *
+		 * \param job The job and its group
+		 */
+		auto push(QueuedJob&& job) -> void;
+
+		/**
+		 * \brief Take a job, from the calling thread's own deque first, then from the shared deque, then from the other workers'
+		 *
+		 * \param job The job taken, if there was one
+		 * \return true A job was taken
+		 * \return false Every deque was empty
+		 */
+		auto take(QueuedJob& job) -> bool;
+
+		/**
+		 * \brief Take a job to run while waiting on a group. Workers take any job, as with take, while other threads only take jobs in the
+		 * group, starting with the shared deque
+		 *
+		 * \param group The group being waited on
+		 * \param job The job taken, if there was one
+		 * \return true A job was taken
+		 * \return false There was no job the calling thread could take
+		 */
+		auto take(const JobGroup& group, QueuedJob& job) -> bool;
+
+		/**
+		 * \brief Take the oldest job from a deque
+		 *
+		 * \param queue The deque
+		 * \param job The job taken, if there was one
+		 * \return true A job was taken
+		 * \return false The deque was empty
+		 */
+		auto steal(JobQueue& queue, QueuedJob& job) -> bool;
+
+		/**
+		 * \brief Take the oldest job in a group from a deque
+		 *
+		 * \param queue The deque
+		 * \param group The group
+		 * \param job The job taken, if there was one
+		 * \return true A job was taken
+		 * \return false The deque held no jobs in the group
+		 */
+		auto steal(JobQueue& queue, const JobGroup& group, QueuedJob& job) -> bool;
+
+		/**
+		 * \brief Run a job, and mark it finished in its group
+		 *
+		 * \param job The job and its group
+		 */
+		static auto execute(QueuedJob& job) -> void;
+
+		/**
+		 * \brief Mark one of a group's jobs finished, waking any thread sleeping on the group once it's done
+		 *
+		 * \param group The group
+		 */
+		static auto finish(JobGroup& group) -> void;
+
+		/**
+		 * \brief Get the index of the calling thread's deque
+		 */
+		[[nodiscard]] auto getQueueIndex() const -> std::size_t;
+
+		std::thread::id m_mainThreadID;
+		// Known before the workers start, which read it while the rest are still being started
+		std::size_t m_workerCount;
+
+		// One per worker, followed by the deque shared by every other thread
+		std::vector<std::unique_ptr<JobQueue>> m_queues;
+		std::vector<std::thread> m_workers;
+
+		// Changed while holding the lock of the deque the job goes on or comes off, so it's never less than the jobs queued
+		std::atomic<std::size_t> m_queuedJobs      = 0;
+		std::atomic<std::size_t> m_sleepingWorkers = 0;
+		std::atomic<bool> m_stopping               = false;
+		std::mutex m_sleepMutex;
+		std::condition_variable m_sleepCondition;
+
+		ThreadSafeQueue<QueuedJob> m_mainThreadJobs;
+	};
+
+} // namespace Common::Util
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "Common/Util/CacheLine.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Common::Util
+{
+
+	/**
+	 * \class MultiProducerQueue MultiProducerQueue.hpp <Common/Util/MultiProducerQueue.hpp>
+	 * \brief A bounded lock-free queue with any number of threads pushing and one thread popping
+	 *
+	 * Values are held in a ring of slots allocated up front. Producers claim slots by advancing the tail, and each slot carries a
+	 * sequence number which says whether it's waiting to be written, holds a value, or is waiting for the consumer to empty it.
+	 * A value pushed by one producer may only be popped once every value claimed before it has been written
+	 *
+	 * \tparam T The type the queue should contain
+	 */
+	template<typename T>
+	class MultiProducerQueue
+	{
+	public:
+		/**
+		 * \brief Construct a new Multi Producer Queue object
+		 *
+		 * \param capacity The most values the queue can hold, rounded up to a power of two
+		 */
+		explicit MultiProducerQueue(const std::size_t capacity) :
+		    m_capacity(std::bit_ceil(std::max<std::size_t>(capacity, 2))),
+		    m_mask(m_capacity - 1),
+		    m_slots(std::make_unique<Slot[]>(m_capacity))
+		{
+			for (auto i = std::size_t(0); i < m_capacity; ++i)
+			{
+				m_slots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		MultiProducerQueue(const MultiProducerQueue&)                    = delete;
+		auto operator=(const MultiProducerQueue&) -> MultiProducerQueue& = delete;
+
+		/**
+		 * \brief Pushes an rvalue of type T into the queue, if there's room
+		 *
+		 * \param value The rvalue to push into the queue
+		 * \return true The value was pushed
+		 * \return false The queue was full, and the value was left alone
+		 */
+		auto tryPush(T&& value) -> bool
+		{
+			auto tail = m_tail.load(std::memory_order_relaxed);
+			while (true)
+			{
+				auto& slot     = m_slots[tail & m_mask];
+				auto sequence  = slot.sequence.load(std::memory_order_acquire);
+				auto available = static_cast<std::ptrdiff_t>(sequence - tail);
+				if (available < 0)
+				{
+					return false;
+				}
+
+				if (available == 0 && m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+				{
+					slot.value.emplace(std::move(value));
+					slot.sequence.store(tail + 1, std::memory_order_release);
+					return true;
+				}
+
+				if (available > 0)
+				{
+					tail = m_tail.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/**
+		 * \brief Moves as many values as fit into the queue, claiming their slots together
+		 *
+		 * \param first The first value to push
+		 * \param last One past the last value to push
+		 * \return Iterator One past the last value which was pushed
+		 */
+		template<typename Iterator>
+		auto pushBatch(Iterator first, const Iterator last) -> Iterator
+		{
+			auto wanted = static_cast<std::size_t>(std::distance(first, last));
+			auto tail   = m_tail.load(std::memory_order_relaxed);
+			auto count  = std::size_t(0);
+			do
+			{
+				// The consumer empties slots in order, so every slot before its head is free to claim
+				// If the tail has gone stale the consumer may be past it, in which case the exchange fails and reloads it
+				auto head = m_head.load(std::memory_order_acquire);
+				auto used = tail > head ? std::min(tail - head, m_capacity) : 0;
+				count     = std::min(wanted, m_capacity - used);
+				if (count == 0)
+				{
+					return first;
+				}
+			} while (!m_tail.compare_exchange_weak(tail, tail + count, std::memory_order_relaxed));
+
+			for (auto i = std::size_t(0); i < count; ++i, ++first)
+			{
+				auto& slot = m_slots[(tail + i) & m_mask];
+				slot.value.emplace(std::move(*first));
+				slot.sequence.store(tail + i + 1, std::memory_order_release);
+			}
+			return first;
+		}
+
+		/**
+		 * \brief Pops the value at the front of the queue and returns it, if it's been written. Only call this from the consuming thread
+		 *
+		 * \return std::optional<T> An optional which may contain a value of type T
+		 */
+		auto tryPop() -> std::optional<T>
+		{
+			auto head  = m_head.load(std::memory_order_relaxed);
+			auto& slot = m_slots[head & m_mask];
+			if (slot.sequence.load(std::memory_order_acquire) != head + 1)
+			{
+				return {};
+			}
+
+			auto value = std::move(slot.value);
+			slot.value.reset();
+			slot.sequence.store(head + m_capacity, std::memory_order_release);
+			m_head.store(head + 1, std::memory_order_release);
+			return value;
+		}
+
+		/**
+		 * \brief Moves every written value at the front of the queue onto the end of a vector. Only call this from the consuming thread
+		 *
+		 * \param values The vector to append the values to
+		 * \return std::size_t The number of values moved
+		 */
+		auto drainInto(std::vector<T>& values) -> std::size_t
+		{
+			auto head  = m_head.load(std::memory_order_relaxed);
+			auto count = std::size_t(0);
+			while (true)
+			{
+				auto& slot = m_slots[(head + count) & m_mask];
+				if (slot.sequence.load(std::memory_order_acquire) != head + count + 1)
+				{
+					break;
+				}
+
+				values.emplace_back(std::move(*slot.value));
+				slot.value.reset();
+				slot.sequence.store(head + count + m_capacity, std::memory_order_release);
+				++count;
+			}
+
+			m_head.store(head + count, std::memory_order_release);
+			return count;
+		}
+
+		/**
+		 * \brief Gets the most values the queue can hold
+		 */
+		[[nodiscard]] auto capacity() const -> std::size_t
+		{
+			return m_capacity;
+		}
+
+	private:
+		struct Slot
+		{
+			std::atomic<std::size_t> sequence = 0;
+			std::optional<T> value;
+		};
+
+		const std::size_t m_capacity;
+		const std::size_t m_mask;
+		std::unique_ptr<Slot[]> m_slots;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail = 0;
+		alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head = 0;
+	};
+
+} // namespace Common::Util
\ No newline at end of file
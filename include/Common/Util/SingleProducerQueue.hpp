@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Common/Util/CacheLine.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Common::Util
+{
+
+	/**
+	 * \class SingleProducerQueue SingleProducerQueue.hpp <Common/Util/SingleProducerQueue.hpp>
+	 * \brief A bounded lock-free queue with one thread pushing and one thread popping
+	 *
+	 * Values are held in a ring of slots allocated up front, so neither side ever allocates or waits on the other. Each side keeps
+	 * its own copy of the other's position, and only reloads it when the ring looks full or empty
+	 *
+	 * \tparam T The type the queue should contain
+	 */
+	template<typename T>
+	class SingleProducerQueue
+	{
+	public:
+		/**
+		 * \brief Construct a new Single Producer Queue object
+		 *
+		 * \param capacity The most values the queue can hold, rounded up to a power of two
+		 */
+		explicit SingleProducerQueue(const std::size_t capacity) :
+		    m_capacity(std::bit_ceil(std::max<std::size_t>(capacity, 2))),
+		    m_mask(m_capacity - 1),
+		    m_slots(std::make_unique<std::optional<T>[]>(m_capacity))
+		{
+		}
+
+		SingleProducerQueue(const SingleProducerQueue&)                    = delete;
+		auto operator=(const SingleProducerQueue&) -> SingleProducerQueue& = delete;
+
+		/**
+		 * \brief Pushes an rvalue of type T into the queue, if there's room. Only call this from the producing thread
+		 *
+		 * \param value The rvalue to push into the queue
+		 * \return true The value was pushed
+		 * \return false The queue was full, and the value was left alone
+		 */
+		auto tryPush(T&& value) -> bool
+		{
+			auto tail = m_tail.load(std::memory_order_relaxed);
+			if (tail - m_cachedHead == m_capacity)
+			{
+				m_cachedHead = m_head.load(std::memory_order_acquire);
+				if (tail - m_cachedHead == m_capacity)
+				{
+					return false;
+				}
+			}
+
+			m_slots[tail & m_mask].emplace(std::move(value));
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * \brief Moves as many values as fit into the queue, publishing them all at once. Only call this from the producing thread
+		 *
+		 * \param first The first value to push
+		 * \param last One past the last value to push
+		 * \return Iterator One past the last value which was pushed
+		 */
+		template<typename Iterator>
+		auto pushBatch(Iterator first, const Iterator last) -> Iterator
+		{
+			auto tail = m_tail.load(std::memory_order_relaxed);
+			auto room = m_capacity - (tail - m_cachedHead);
+			if (room < static_cast<std::size_t>(std::distance(first, last)))
+			{
+				m_cachedHead = m_head.load(std::memory_order_acquire);
+				room         = m_capacity - (tail - m_cachedHead);
+			}
+
+			auto pushed = std::size_t(0);
+			for (; first != last && pushed < room; ++first, ++pushed)
+			{
+				m_slots[(tail + pushed) & m_mask].emplace(std::move(*first));
+			}
+
+			m_tail.store(tail + pushed, std::memory_order_release);
+			return first;
+		}
+
+		/**
+		 * \brief Pops the value at the front of the queue and returns it, if it exists. Only call this from the consuming thread
+		 *
+		 * \return std::optional<T> An optional which may contain a value of type T
+		 */
+		auto tryPop() -> std::optional<T>
+		{
+			auto head = m_head.load(std::memory_order_relaxed);
+			if (head == m_cachedTail)
+			{
+				m_cachedTail = m_tail.load(std::memory_order_acquire);
+				if (head == m_cachedTail)
+				{
+					return {};
+				}
+			}
+
+			auto& slot = m_slots[head & m_mask];
+			auto value = std::move(slot);
+			slot.reset();
+			m_head.store(head + 1, std::memory_order_release);
+			return value;
+		}
+
+		/**
+		 * \brief Moves every value in the queue onto the end of a vector. Only call this from the consuming thread
+		 *
+		 * \param values The vector to append the values to
+		 * \return std::size_t The number of values moved
+		 */
+		auto drainInto(std::vector<T>& values) -> std::size_t
+		{
+			auto head    = m_head.load(std::memory_order_relaxed);
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+			auto count = m_cachedTail - head;
+			values.reserve(values.size() + count);
+			for (auto i = std::size_t(0); i < count; ++i)
+			{
+				auto& slot = m_slots[(head + i) & m_mask];
+				values.emplace_back(std::move(*slot));
+				slot.reset();
+			}
+
+			m_head.store(head + count, std::memory_order_release);
+			return count;
+		}
+
+		/**
+		 * \brief Gets the most values the queue can hold
+		 */
+		[[nodiscard]] auto capacity() const -> std::size_t
+		{
+			return m_capacity;
+		}
+
+	private:
+		const std::size_t m_capacity;
+		const std::size_t m_mask;
+		std::unique_ptr<std::optional<T>[]> m_slots;
+
+		// Each side's position shares a cache line with its copy of the other's, and nothing else
+		alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail = 0;
+		std::size_t m_cachedHead                                 = 0;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head = 0;
+		std::size_t m_cachedTail                                 = 0;
+	};
+
+} // namespace Common::Util
\ No newline at end of file
@@ -43,11 +43,20 @@ namespace Common::Util
 				return {};
 			}
 
-			auto value = m_queue.front();
+			auto value = std::move(m_queue.front());
 			m_queue.pop();
 			return value;
 		}
 
+		/**
+		 * \brief Check whether the queue has nothing in it
+		 */
+		[[nodiscard]] auto empty() -> bool
+		{
+			std::scoped_lock<std::mutex> lock{m_mutex};
+			return m_queue.empty();
+		}
+
 		/**
 		 * \brief Clears the queue and returns all the values previously contained in it
 		 *
@@ -63,7 +72,7 @@ namespace Common::Util
 
 			std::vector<T> vec;
 			vec.reserve(m_queue.size());
-			for (auto i = 0; i < m_queue.size(); ++i)
+			while (!m_queue.empty())
 			{
 				vec.emplace_back(std::move(m_queue.front()));
 				m_queue.pop();
@@ -72,6 +81,24 @@ namespace Common::Util
 			return vec;
 		}
 
+		/**
+		 * \brief Replace the contents of a vector with every value in the queue, and clear the queue
+		 *
+		 * \param values The vector to move the values into, whose previous contents are discarded
+		 */
+		auto drainInto(std::vector<T>& values) -> void
+		{
+			values.clear();
+
+			std::scoped_lock<std::mutex> lock{m_mutex};
+			values.reserve(m_queue.size());
+			while (!m_queue.empty())
+			{
+				values.emplace_back(std::move(m_queue.front()));
+				m_queue.pop();
+			}
+		}
+
 	private:
 		std::queue<T> m_queue;
 		std::mutex m_mutex;
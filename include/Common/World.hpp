@@ -1,4 +1,5 @@
 #pragma once
 
+#include "Common/World/InterestGrid.hpp"
 #include "Common/World/Level.hpp"
 #include "Common/World/Tile.hpp"
\ No newline at end of file
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Common/Export.hpp"
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <entt/entity/entity.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace Common::World
+{
+
+	/**
+	 * \struct InterestEvent InterestGrid.hpp <Common/World/InterestGrid.hpp>
+	 * \brief Raised when an entity comes into or goes out of a subscriber's area of interest
+	 */
+	struct InterestEvent
+	{
+		entt::entity subscriber = entt::null;
+		entt::entity entity     = entt::null;
+		bool isEnter            = false;
+	};
+
+	/**
+	 * \class InterestGrid InterestGrid.hpp <Common/World/InterestGrid.hpp>
+	 * \brief Divides each instance into a uniform grid of cells, so each subscriber only hears about the entities near it
+	 *
+	 * Every tracked entity is in the cell containing its position. A subscriber is also tracked, and watches every cell within the
+	 * view radius of its own, so finding who's interested in an entity only costs a lookup of the entity's cell. Subscribers always
+	 * see themselves, so they never get events about themselves.
+	 */
+	class COMMON_API InterestGrid
+	{
+	public:
+		/**
+		 * \brief Construct a new Interest Grid object
+		 *
+		 * \param cellSize The width and height of each cell, in world units
+		 * \param viewRadius How many cells around its own a subscriber watches
+		 */
+		InterestGrid(float cellSize = 512.F, std::int32_t viewRadius = 1);
+
+		/**
+		 * \brief Start tracking an entity, or move one which is already tracked. Raises events for any subscriber which starts or
+		 * stops seeing the entity, or, if it's a subscriber, for any entity it starts or stops seeing
+		 *
+		 * \param entity The entity
+		 * \param instanceID The instance the entity is in
+		 * \param position The position of the entity within the instance
+		 * \param isSubscriber Whether the entity watches the cells around it
+		 */
+		auto update(entt::entity entity, std::uint32_t instanceID, sf::Vector2f position, bool isSubscriber = false) -> void;
+
+		/**
+		 * \brief Stop tracking an entity, raising a leave event for every subscriber which could see it
+		 *
+		 * \param entity The entity
+		 */
+		auto remove(entt::entity entity) -> void;
+
+		/**
+		 * \brief Stop tracking every entity which hasn't been updated since the last sweep
+		 *
+		 */
+		auto sweep() -> void;
+
+		/**
+		 * \brief Get the subscribers which can see an entity
+		 *
+		 * \param entity The entity
+		 * \return const std::vector<entt::entity>& The subscribers, which is empty if the entity isn't tracked
+		 */
+		[[nodiscard]] auto getSubscribers(entt::entity entity) const -> const std::vector<entt::entity>&;
+
+		/**
+		 * \brief Get every entity a subscriber can see, including itself
+		 *
+		 * \param subscriber The subscriber
+		 * \param entities The entities are appended to this
+		 */
+		auto getVisibleEntities(entt::entity subscriber, std::vector<entt::entity>& entities) const -> void;
+
+		/**
+		 * \brief Take the events raised since this was last called
+		 */
+		auto takeEvents() -> std::vector<InterestEvent>;
+
+		/**
+		 * \brief Get the number of cells with at least one entity or subscriber in them
+		 */
+		[[nodiscard]] auto getCellCount() const -> std::size_t;
+
+	private:
+		struct CellKey
+		{
+			std::uint32_t instanceID = 0;
+			std::int32_t x           = 0;
+			std::int32_t y           = 0;
+
+			auto operator==(const CellKey&) const -> bool = default;
+		};
+
+		struct CellKeyHash
+		{
+			auto operator()(const CellKey& key) const -> std::size_t;
+		};
+
+		struct Cell
+		{
+			std::vector<entt::entity> entities;
+			std::vector<entt::entity> subscribers;
+		};
+
+		struct TrackedEntity
+		{
+			CellKey cell;
+			bool isSubscriber      = false;
+			std::uint32_t lastSeen = 0;
+		};
+
+		auto getCellKey(std::uint32_t instanceID, sf::Vector2f position) const -> CellKey;
+		auto isWatching(const CellKey& centre, const CellKey& cell) const -> bool;
+		auto moveEntity(entt::entity entity, const CellKey* from, const CellKey* to) -> void;
+		auto moveSubscriber(entt::entity subscriber, const CellKey* from, const CellKey* to) -> void;
+		auto releaseCell(const CellKey& key) -> void;
+
+		float m_cellSize;
+		std::int32_t m_viewRadius;
+		std::uint32_t m_sweepCount = 0;
+
+		std::unordered_map<CellKey, Cell, CellKeyHash> m_cells;
+		std::unordered_map<entt::entity, TrackedEntity> m_entities;
+		std::vector<InterestEvent> m_events;
+	};
+
+} // namespace Common::World
\ No newline at end of file
@@ -15,6 +15,8 @@ namespace Client
 		window.setVerticalSyncEnabled(true);
 		window.setKeyRepeatEnabled(false);
 		m_clock.restart();
+
+		networkManager.loadCompressionDictionaries(executableDir / "assets" / "dictionaries");
 	}
 
 	auto Engine::pushState(std::unique_ptr<State>&& state) -> void
@@ -68,6 +70,7 @@ namespace Client
 			auto deltaTime = m_clock.restart();
 
 			DiscordManager::get().update();
+			jobSystem.runMainThreadJobs();
 
 			networkManager.update();
 			auto inboundMessages = networkManager.getMessages();
@@ -3,6 +3,7 @@
 #include "Assets/AssetManager.hpp"
 #include "Input/InputManager.hpp"
 #include "Network/NetworkManager.hpp"
+#include <Common/Util/JobSystem.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <memory>
 #include <stack>
@@ -47,7 +48,7 @@ namespace Client
 		auto setShouldPopState(bool shouldPopState = true) -> void;
 
 		/**
-		 * \brief Runs the game loop until the engine is set to exit
+		 * \brief Runs the game loop until the engine is set to exit. Main thread jobs queued on the job system are run once a frame
 		 *
 		 */
 		auto run() -> void;
@@ -62,6 +63,7 @@ namespace Client
 		NetworkManager networkManager;
 		InputManager inputManager;
 		sf::RenderWindow window;
+		Common::Util::JobSystem jobSystem;
 
 	private:
 		/**
@@ -1,5 +1,7 @@
 #include "NetworkManager.hpp"
 #include <array>
+#include <cstring>
+#include <span>
 #include <thread>
 
 namespace Client
@@ -8,7 +10,8 @@ namespace Client
 	    m_currentMessageIdentifier(0),
 	    m_lastServerMessageIdentifier(0),
 	    m_clientID(entt::null),
-	    m_isConnected(false)
+	    m_isConnected(false),
+	    m_receivePool(Common::Network::MAX_MESSAGE_LENGTH)
 	{
 		auto status = m_udpSocket.bind(sf::Socket::AnyPort);
 		if (status != sf::Socket::Status::Done)
@@ -25,6 +28,12 @@ namespace Client
 		disconnect();
 	}
 
+	auto NetworkManager::loadCompressionDictionaries(const std::filesystem::path& directory) -> void
+	{
+		auto loaded = m_compressor.loadDictionaries(directory);
+		spdlog::debug("Loaded {} compression dictionaries from {}", loaded, directory.string());
+	}
+
 	auto NetworkManager::connect() -> void
 	{
 		if (m_isConnected)
@@ -45,13 +54,15 @@ namespace Client
 
 		m_messageQueue.clearInbound();
 		m_messageQueue.clearOutbound();
+		m_endpoint.reset();
+		m_headerCodec.reset();
 
 		auto message              = Common::Network::Message();
 		message.header.entityID   = getClientID();
 		message.header.identifier = getNextMessageIdentifier();
 		message.header.protocol   = Common::Network::Protocol::TCP;
 		message.header.type       = Common::Network::MessageType::Client_Connect;
-		message.data << std::uint16_t(m_udpSocket.getLocalPort());
+		message.data << std::uint16_t(m_udpSocket.getLocalPort()) << Common::Network::COMPRESSED_HEADER_VERSION;
 
 		const std::size_t MAX_CONNECTION_ATTEMPTS = 5;
 		for (auto attemptNumber = 1; attemptNumber <= MAX_CONNECTION_ATTEMPTS; ++attemptNumber)
@@ -98,11 +109,16 @@ namespace Client
 		message.header.protocol   = Common::Network::Protocol::TCP;
 		message.header.type       = Common::Network::MessageType::Client_Disconnect;
 
-		auto buffer = message.pack();
+		auto buffer = message.pack(m_headerCodec);
+		Common::Network::FrameAssembler::frame(buffer);
 		auto status = m_tcpSocket.send(buffer.data(), buffer.size());
+		Common::Network::BufferPool::get().release(std::move(buffer));
 
 		m_tcpSocket.disconnect();
 		m_socketSelector.clear();
+		m_frameAssembler.clear();
+		m_endpoint.reset();
+		m_headerCodec.reset();
 
 		m_isConnected                 = false;
 		m_clientID                    = entt::null;
@@ -131,7 +147,7 @@ namespace Client
 		}
 
 		auto outboundMessages = m_messageQueue.clearOutbound();
-		for (const auto& message : outboundMessages)
+		for (auto& message : outboundMessages)
 		{
 			switch (message.header.protocol)
 			{
@@ -139,10 +155,19 @@ namespace Client
 					sendTCP(message);
 					break;
 				case Common::Network::Protocol::UDP:
+				case Common::Network::Protocol::ReliableOrdered:
+				case Common::Network::Protocol::ReliableUnordered:
+				case Common::Network::Protocol::UnreliableSequenced:
 					sendUDP(message);
 					break;
 			}
 		}
+
+		// Flushed every update, even without new messages, so lost reliable messages are resent and acknowledgements go out
+		if (m_isConnected)
+		{
+			flushUDP();
+		}
 	}
 
 	auto NetworkManager::pushMessage(const Common::Network::Protocol protocol, const Common::Network::MessageType type, Common::Network::MessageData& messageData) -> void
@@ -179,6 +204,13 @@ namespace Client
 
 	auto NetworkManager::validateMessage(Common::Network::Message& message) -> bool
 	{
+		// Only plain UDP can arrive out of order or twice. TCP is a stream and can't, while sequenced messages are ordered and
+		// deduplicated on their own channel by the endpoint instead
+		if (message.header.protocol != Common::Network::Protocol::UDP)
+		{
+			return true;
+		}
+
 		if (message.header.identifier <= m_lastServerMessageIdentifier)
 		{
 			return false;
@@ -187,24 +219,49 @@ namespace Client
 		return true;
 	}
 
-	auto NetworkManager::sendUDP(const Common::Network::Message& message) -> void
+	auto NetworkManager::applyHeaderVersion(Common::Network::MessageData data) -> void
 	{
-		auto buffer = message.pack();
+		auto clientID      = entt::entity(entt::null);
+		auto headerVersion = Common::Network::COMPACT_HEADER_VERSION;
+		data >> clientID >> headerVersion;
+
+		m_headerCodec.setEncodingVersion(headerVersion);
+		m_headerCodec.setDecodingVersion(headerVersion);
+		spdlog::debug("Using header version {}", headerVersion);
+	}
+
+	auto NetworkManager::sendUDP(Common::Network::Message& message) -> void
+	{
+		// The sequence number is part of the header, so it has to be stamped before the message is packed
+		m_endpoint.stampHeader(message.header);
+
+		auto buffer = message.pack(m_headerCodec);
 		m_cryptographer.encrypt(buffer);
+		m_endpoint.send(message.header.protocol, std::move(buffer), nullptr);
+	}
 
-		auto status = m_udpSocket.send(buffer.data(), buffer.size(), Common::Network::SERVER_ADDRESS, Common::Network::UDP_PORT);
-		switch (status)
+	auto NetworkManager::flushUDP() -> void
+	{
+		for (const auto& datagram : m_endpoint.flush())
 		{
-			case sf::Socket::Status::Done:
-				// Success
-			default:
-				break;
+			auto buffer = datagram.flatten();
+
+			auto status = m_udpSocket.send(buffer.data(), buffer.size(), Common::Network::SERVER_ADDRESS, Common::Network::UDP_PORT);
+			Common::Network::BufferPool::get().release(std::move(buffer));
+			switch (status)
+			{
+				case sf::Socket::Status::Done:
+					// Success
+				default:
+					break;
+			}
 		}
 	}
 
 	auto NetworkManager::receiveUDP() -> void
 	{
-		auto buffer = std::array<std::uint8_t, Common::Network::MAX_MESSAGE_LENGTH>();
+		// Datagrams are received straight into a pooled buffer, which the messages in them read their data from
+		auto buffer = m_receivePool.acquire(Common::Network::MAX_MESSAGE_LENGTH);
 
 		std::size_t length = 0;
 		std::optional<sf::IpAddress> optAddress;
@@ -226,13 +283,40 @@ namespace Client
 			return;
 		}
 
-		auto vBuffer = std::vector<std::uint8_t>(buffer.data(), buffer.data() + length);
-		m_cryptographer.decryptFromRemote(vBuffer);
+		// The packet header carries the server's acknowledgements, and duplicate datagrams are dropped here
+		auto offset = m_endpoint.receivePacket(buffer.data(), length);
+		if (!offset.has_value())
+		{
+			return;
+		}
+
+		// The server packs all of a tick's messages into as few datagrams as it can
+		m_deliveredMessages.clear();
+		auto frameOffset = *offset;
+		while (auto frame = Common::Network::FrameAssembler::readFrame(buffer.data(), length, frameOffset))
+		{
+			auto messageOffset = static_cast<std::size_t>(frame->data() - buffer.data());
+			m_cryptographer.decryptFromRemote(std::span<std::uint8_t>(buffer.data() + messageOffset, frame->size()));
 
-		auto message = Common::Network::Message();
-		message.unpack(vBuffer);
+			auto message = Common::Network::Message();
+			if (!message.unpack(buffer, messageOffset, frame->size(), m_headerCodec, Common::Network::Protocol::UDP))
+			{
+				continue;
+			}
 
-		if (validateMessage(message))
+			if (!m_compressor.decompress(message))
+			{
+				spdlog::warn("Dropped a compressed message which couldn't be decompressed");
+				continue;
+			}
+
+			if (validateMessage(message))
+			{
+				m_endpoint.receiveMessage(std::move(message), m_deliveredMessages);
+			}
+		}
+
+		for (auto& message : m_deliveredMessages)
 		{
 			m_messageQueue.pushInbound(std::move(message));
 		}
@@ -240,10 +324,12 @@ namespace Client
 
 	auto NetworkManager::sendTCP(const Common::Network::Message& message) -> void
 	{
-		auto buffer = message.pack();
+		auto buffer = message.pack(m_headerCodec);
 		m_cryptographer.encrypt(buffer);
+		Common::Network::FrameAssembler::frame(buffer);
 
 		auto status = m_tcpSocket.send(buffer.data(), buffer.size());
+		Common::Network::BufferPool::get().release(std::move(buffer));
 		switch (status)
 		{
 			case sf::Socket::Status::Disconnected:
@@ -267,15 +353,43 @@ namespace Client
 		{
 			case sf::Socket::Status::Done:
 			{
-				auto vBuffer = std::vector<std::uint8_t>(buffer.data(), buffer.data() + length);
-				m_cryptographer.decryptFromRemote(vBuffer);
-
-				auto message = Common::Network::Message();
-				message.unpack(vBuffer);
+				// The server may have sent several messages since the last read, and the last may not have fully arrived
+				m_frameAssembler.append(buffer.data(), length);
+				while (auto frame = m_frameAssembler.nextView())
+				{
+					// Each frame is copied once out of the stream into a pooled buffer, which its message reads its data from
+					auto frameBuffer = m_receivePool.acquire(frame->size());
+					std::memcpy(frameBuffer.data(), frame->data(), frame->size());
+					m_cryptographer.decryptFromRemote(std::span<std::uint8_t>(frameBuffer.data(), frameBuffer.size()));
+
+					auto message = Common::Network::Message();
+					if (!message.unpack(frameBuffer, 0, frameBuffer.size(), m_headerCodec, Common::Network::Protocol::TCP))
+					{
+						continue;
+					}
+
+					if (!m_compressor.decompress(message))
+					{
+						spdlog::warn("Dropped a compressed TCP message which couldn't be decompressed");
+						continue;
+					}
+
+					// Everything after the reply to Client_Connect uses the header version it carries, so switch before the next frame
+					if (message.header.type == Common::Network::MessageType::Server_SetClientID)
+					{
+						applyHeaderVersion(message.data);
+					}
+
+					if (validateMessage(message))
+					{
+						m_messageQueue.pushInbound(std::move(message));
+					}
+				}
 
-				if (validateMessage(message))
+				if (m_frameAssembler.isCorrupt())
 				{
-					m_messageQueue.pushInbound(std::move(message));
+					spdlog::warn("Server sent a malformed TCP stream");
+					disconnect();
 				}
 			}
 			// Success
@@ -4,6 +4,7 @@
 #include <SFML/Network/SocketSelector.hpp>
 #include <SFML/Network/TcpSocket.hpp>
 #include <SFML/Network/UdpSocket.hpp>
+#include <filesystem>
 
 namespace Client
 {
@@ -39,6 +40,13 @@ namespace Client
 		 */
 		auto disconnect() -> void;
 
+		/**
+		 * \brief Load the dictionaries the server compresses messages with, which must match the server's own
+		 *
+		 * \param directory The directory to load dictionaries from
+		 */
+		auto loadCompressionDictionaries(const std::filesystem::path& directory) -> void;
+
 		/**
 		 * \brief Get whether the client is connected to the server or not
 		 *
@@ -97,14 +105,27 @@ namespace Client
 		auto validateMessage(Common::Network::Message& message) -> bool;
 
 		/**
-		 * \brief Send a message using the UDP socket
+		 * \brief Switch to the header version the server agreed to in its reply to Client_Connect
+		 *
+		 * \param data The data of the server's Server_SetClientID message
+		 */
+		auto applyHeaderVersion(Common::Network::MessageData data) -> void;
+
+		/**
+		 * \brief Pack a message into the endpoint, which sends it on the channel given by its protocol
 		 *
 		 * \param message The message to send
 		 */
-		auto sendUDP(const Common::Network::Message& message) -> void;
+		auto sendUDP(Common::Network::Message& message) -> void;
+
+		/**
+		 * \brief Send every datagram the endpoint has ready using the UDP socket
+		 *
+		 */
+		auto flushUDP() -> void;
 
 		/**
-		 * \brief Receive a message using the UDP socket, and push it into the inbound queue
+		 * \brief Receive a datagram using the UDP socket, and push every message it contains into the inbound queue
 		 *
 		 */
 		auto receiveUDP() -> void;
@@ -117,7 +138,7 @@ namespace Client
 		auto sendTCP(const Common::Network::Message& message) -> void;
 
 		/**
-		 * \brief Receive a message using the TCP socket, and push it into the inbound queue
+		 * \brief Receive from the TCP socket, and push every complete message into the inbound queue
 		 *
 		 */
 		auto receiveTCP() -> void;
@@ -131,6 +152,12 @@ namespace Client
 		sf::SocketSelector m_socketSelector;
 		sf::UdpSocket m_udpSocket;
 		sf::TcpSocket m_tcpSocket;
+		Common::Network::FrameAssembler m_frameAssembler;
+		Common::Network::ReceiveBufferPool m_receivePool;
+		Common::Network::HeaderCodec m_headerCodec;
+		Common::Network::PayloadCompressor m_compressor;
+		Common::Network::ReliableEndpoint m_endpoint;
+		std::vector<Common::Network::Message> m_deliveredMessages;
 
 		Common::Network::PublicKeyCryptographer m_cryptographer;
 
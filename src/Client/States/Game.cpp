@@ -57,17 +57,19 @@ namespace Client::States
 #undef LOAD_TILE_TEXTURE
 #undef LOAD_TILE_DATA
 
-		loadTile(engine.assetManager.getAsset("tile_data_grass_centre"));
-		loadTile(engine.assetManager.getAsset("tile_data_stone_centre"));
-		loadTile(engine.assetManager.getAsset("tile_data_water_centre"));
-		loadTile(engine.assetManager.getAsset("tile_data_grass_stone_east"));
-		loadTile(engine.assetManager.getAsset("tile_data_grass_stone_west"));
-		loadTile(engine.assetManager.getAsset("tile_data_grass_stone_north"));
-		loadTile(engine.assetManager.getAsset("tile_data_grass_stone_south"));
-		loadTile(engine.assetManager.getAsset("tile_data_grass_water_east"));
-		loadTile(engine.assetManager.getAsset("tile_data_grass_water_west"));
-		loadTile(engine.assetManager.getAsset("tile_data_grass_water_north"));
-		loadTile(engine.assetManager.getAsset("tile_data_grass_water_south"));
+		auto tileGroup = Common::Util::JobGroup();
+		loadTile(engine.assetManager.getAsset("tile_data_grass_centre"), tileGroup);
+		loadTile(engine.assetManager.getAsset("tile_data_stone_centre"), tileGroup);
+		loadTile(engine.assetManager.getAsset("tile_data_water_centre"), tileGroup);
+		loadTile(engine.assetManager.getAsset("tile_data_grass_stone_east"), tileGroup);
+		loadTile(engine.assetManager.getAsset("tile_data_grass_stone_west"), tileGroup);
+		loadTile(engine.assetManager.getAsset("tile_data_grass_stone_north"), tileGroup);
+		loadTile(engine.assetManager.getAsset("tile_data_grass_stone_south"), tileGroup);
+		loadTile(engine.assetManager.getAsset("tile_data_grass_water_east"), tileGroup);
+		loadTile(engine.assetManager.getAsset("tile_data_grass_water_west"), tileGroup);
+		loadTile(engine.assetManager.getAsset("tile_data_grass_water_north"), tileGroup);
+		loadTile(engine.assetManager.getAsset("tile_data_grass_water_south"), tileGroup);
+		engine.jobSystem.wait(tileGroup);
 
 		m_camera.setCenter(sf::Vector2f(0.0F, 0.0F));
 		m_camera.setSize(sf::Vector2f(1280.0F, 720.0F));
@@ -99,15 +101,11 @@ namespace Client::States
 		const auto& testLevel = engine.assetManager.getAsset("test_level");
 		m_level               = Common::World::Level(testLevel);
 
-		m_terrainRenderer.addLevel(entt::hashed_string("test_level").value(), m_level, m_textureAtlas);
+		m_terrainRenderer.addLevel(entt::hashed_string("test_level").value(), m_level, m_textureAtlas, engine.jobSystem);
 
+		// The world around the player arrives in snapshots once they've spawned, so there's no need to ask for the world state
 		auto data = Common::Network::MessageData();
-		engine.networkManager.pushMessage(Common::Network::Protocol::UDP, Common::Network::MessageType::Client_Spawn, data);
-
-		// TODO - change this to the actual tile identifier
-		data = Common::Network::MessageData();
-		data << std::uint32_t(0);
-		engine.networkManager.pushMessage(Common::Network::Protocol::UDP, Common::Network::MessageType::Client_GetWorldState, data);
+		engine.networkManager.pushMessage(Common::Network::Protocol::ReliableOrdered, Common::Network::MessageType::Client_Spawn, data);
 	}
 
 	Game::~Game()
@@ -149,6 +147,95 @@ namespace Client::States
 		}
 	}
 
+	auto findPlayer(entt::registry& registry, entt::entity serverEntityID) -> entt::entity
+	{
+		for (const auto entity : registry.view<entt::entity>())
+		{
+			if (registry.get<entt::entity>(entity) == serverEntityID)
+			{
+				return entity;
+			}
+		}
+		return entt::null;
+	}
+
+	auto Game::applySnapshot(Common::Network::Message& message) -> void
+	{
+		auto snapshotID = std::uint32_t(0);
+		auto baselineID = std::uint32_t(0);
+		message.data >> snapshotID >> baselineID;
+
+		// The snapshot only describes how the world differs from the baseline, so it can't be applied if that's been forgotten
+		const auto EMPTY_SNAPSHOT = Common::Game::Snapshot();
+		const auto* baseline      = baselineID == 0 ? &EMPTY_SNAPSHOT : m_snapshots.find(baselineID);
+		if (baseline == nullptr)
+		{
+			return;
+		}
+
+		auto snapshot = *baseline;
+		snapshot.id   = snapshotID;
+
+		auto reader         = Common::Network::BitReader(message.data);
+		auto previousEntity = std::int64_t(0);
+		while (reader.readBool())
+		{
+			previousEntity += reader.readSignedVarint();
+			auto serverEntityID = static_cast<entt::entity>(static_cast<std::uint32_t>(previousEntity));
+			auto entry          = reader.readEnum<Common::Game::SnapshotEntry>(Common::Game::SNAPSHOT_ENTRY_BITS);
+
+			auto localEntity = findPlayer(m_registry, serverEntityID);
+			switch (entry)
+			{
+				case Common::Game::SnapshotEntry::Created:
+				{
+					reader.align();
+					auto entityData = Common::Game::deserialiseWorldEntity(message.data);
+					snapshot.entities.insert_or_assign(serverEntityID, Common::Game::EntitySnapshot{entityData.position, entityData.stats});
+					if (localEntity == entt::null)
+					{
+						createPlayer(m_registry, serverEntityID, engine.networkManager.getClientID(), entityData, m_playerTexture);
+						continue;
+					}
+				}
+				break;
+				case Common::Game::SnapshotEntry::Updated:
+				{
+					auto iterator = snapshot.entities.find(serverEntityID);
+					if (iterator == snapshot.entities.end())
+					{
+						spdlog::warn("Received a snapshot which updates an entity that isn't in its baseline");
+						return;
+					}
+					iterator->second.position.deserialiseDelta(reader);
+					iterator->second.stats.deserialiseDelta(reader);
+				}
+				break;
+				case Common::Game::SnapshotEntry::Destroyed:
+					snapshot.entities.erase(serverEntityID);
+					if (localEntity != entt::null)
+					{
+						m_registry.destroy(localEntity);
+					}
+					continue;
+			}
+
+			if (localEntity != entt::null)
+			{
+				const auto& entitySnapshot = snapshot.entities.at(serverEntityID);
+				m_registry.get<sf::Sprite>(localEntity).setPosition(entitySnapshot.position.position);
+				m_registry.get<Common::Game::WorldEntityStats>(localEntity) = entitySnapshot.stats;
+			}
+		}
+
+		m_snapshots.store(std::move(snapshot));
+
+		// Acknowledging the snapshot lets the server send the next one relative to it
+		auto data = Common::Network::MessageData();
+		data << snapshotID;
+		engine.networkManager.pushMessage(Common::Network::Protocol::UnreliableSequenced, Common::Network::MessageType::Client_SnapshotAck, data);
+	}
+
 	auto Game::parseUDP(Common::Network::Message& message) -> void
 	{
 		switch (message.header.type)
@@ -158,9 +245,17 @@ namespace Client::States
 				auto entityID = entt::entity(entt::null);
 				message.data >> entityID;
 				auto entityData = Common::Game::deserialiseWorldEntity(message.data);
-				createPlayer(m_registry, message.header.entityID, engine.networkManager.getClientID(), entityData, m_playerTexture);
+
+				// The entity may already have arrived in a snapshot
+				if (findPlayer(m_registry, entityID) == entt::null)
+				{
+					createPlayer(m_registry, entityID, engine.networkManager.getClientID(), entityData, m_playerTexture);
+				}
 			}
 			break;
+			case Common::Network::MessageType::Server_Snapshot:
+				applySnapshot(message);
+				break;
 			case Common::Network::MessageType::Server_InputState:
 			{
 				auto serverEntity = entt::entity();
@@ -172,7 +267,7 @@ namespace Client::States
 						continue;
 					}
 					auto& inputState = m_registry.get<Common::Input::InputState>(entity);
-					message.data >> inputState.forwards >> inputState.backwards >> inputState.left >> inputState.right;
+					message.data >> inputState;
 					break;
 				}
 			}
@@ -241,6 +336,9 @@ namespace Client::States
 					parseTCP(message);
 					break;
 				case Common::Network::Protocol::UDP:
+				case Common::Network::Protocol::ReliableOrdered:
+				case Common::Network::Protocol::ReliableUnordered:
+				case Common::Network::Protocol::UnreliableSequenced:
 					parseUDP(message);
 					break;
 			}
@@ -256,7 +354,7 @@ namespace Client::States
 		auto data = Common::Network::MessageData();
 		data << action;
 
-		networkManager.pushMessage(Common::Network::Protocol::UDP, Common::Network::MessageType::Client_Action, data);
+		networkManager.pushMessage(Common::Network::Protocol::ReliableOrdered, Common::Network::MessageType::Client_Action, data);
 	}
 
 	auto Game::handleEvents(sf::Event& event) -> void
@@ -369,30 +467,37 @@ namespace Client::States
 	{
 	}
 
-	auto Game::loadTile(const std::vector<char>& data) -> void
+	auto Game::loadTile(const std::vector<char>& data, Common::Util::JobGroup& group) -> void
 	{
 		if (data.empty())
 		{
 			spdlog::debug("Tried to load a tile but the data is empty");
 			return;
 		}
-		auto json = nlohmann::json::parse(data);
 
-		auto identifier  = json.at("identifier");
-		auto textureData = engine.assetManager.getAsset(json.at("texture_path"));
+		engine.jobSystem.run(group, [this, &data, &group]() {
+			auto json = nlohmann::json::parse(data);
 
-		auto image = sf::Image();
-		{
-			auto success = image.loadFromMemory(textureData.data(), textureData.size());
-			if (!success)
+			auto identifier         = json.at("identifier").get<std::uint32_t>();
+			auto texturePath        = json.at("texture_path").get<std::string>();
+			const auto& textureData = engine.assetManager.getAsset(texturePath);
+
+			auto image = sf::Image();
 			{
-				spdlog::warn("Failed to load tile {}", json.at("texture_path"));
-				return;
+				auto success = image.loadFromMemory(textureData.data(), textureData.size());
+				if (!success)
+				{
+					spdlog::warn("Failed to load tile {}", texturePath);
+					return;
+				}
 			}
-		}
 
-		m_textureAtlas.addTexture(identifier, image);
-		spdlog::debug("Loaded tile {}", static_cast<std::uint32_t>(identifier));
+			// Adding to the atlas uploads the image to its texture, which only the main thread may touch
+			engine.jobSystem.runOnMainThread(group, [this, identifier, image = std::move(image)]() mutable {
+				m_textureAtlas.addTexture(identifier, image);
+				spdlog::debug("Loaded tile {}", identifier);
+			});
+		});
 	}
 
 } // namespace Client::States
\ No newline at end of file
@@ -3,7 +3,9 @@
 #include "Engine/State.hpp"
 #include "UI/UI.hpp"
 #include "World/TerrainRenderer.hpp"
+#include <Common/Game/Snapshot.hpp>
 #include <Common/Network/Message.hpp>
+#include <Common/Util/JobSystem.hpp>
 #include <Common/World/Level.hpp>
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/Texture.hpp>
@@ -83,11 +85,20 @@ namespace Client::States
 		auto parseUDP(Common::Network::Message& message) -> void;
 
 		/**
-		 * \brief Loads a tile into the texture atlas
+		 * \brief Applies a snapshot from the server to the registry, and acknowledges it
 		 *
-		 * \param data A vector of bytes representing the tile data
+		 * \param message The Server_Snapshot message
 		 */
-		auto loadTile(const std::vector<char>& data) -> void;
+		auto applySnapshot(Common::Network::Message& message) -> void;
+
+		/**
+		 * \brief Loads a tile into the texture atlas. The tile's texture is decoded on the job system, then added to the atlas on the main
+		 * thread, which owns the atlas's texture
+		 *
+		 * \param data A vector of bytes representing the tile data, which must stay loaded until the group is done
+		 * \param group The group to wait on for the tile to be in the atlas
+		 */
+		auto loadTile(const std::vector<char>& data, Common::Util::JobGroup& group) -> void;
 
 		Common::World::Level m_level;
 		World::TerrainRenderer m_terrainRenderer;
@@ -100,6 +111,7 @@ namespace Client::States
 		sf::View m_camera;
 
 		entt::registry m_registry;
+		Common::Game::SnapshotHistory m_snapshots;
 		sf::Texture m_playerTexture;
 		sf::Font m_font;
 	};
@@ -35,7 +35,7 @@ namespace Client::States
 			                                                                          {
 				                                                                          auto data = Common::Network::MessageData();
 				                                                                          data << m_registry.get<UI::TextInputData>(m_usernameTextEntity).input << m_registry.get<UI::TextInputData>(m_passwordTextEntity).input;
-				                                                                          engine.networkManager.pushMessage(Common::Network::Protocol::UDP, Common::Network::MessageType::Client_Authenticate, data);
+				                                                                          engine.networkManager.pushMessage(Common::Network::Protocol::ReliableOrdered, Common::Network::MessageType::Client_Authenticate, data);
 			                                                                          }
 		                                                                          }});
 		UI::createElement(m_registry, "button_quit", 0, UI::RectButtonCreateInfo{sf::Vector2f(670.0F, 320.0F), sf::Vector2f(160.0F, 60.0F), "Quit", m_font, {}, [&](sf::Mouse::Button b) {
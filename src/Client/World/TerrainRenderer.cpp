@@ -3,9 +3,9 @@
 namespace Client::World
 {
 
-	auto TerrainRenderer::addLevel(std::uint32_t identifier, Common::World::Level& level, Graphics::TextureAtlas& textureAtlas) -> void
+	auto TerrainRenderer::addLevel(std::uint32_t identifier, Common::World::Level& level, Graphics::TextureAtlas& textureAtlas, Common::Util::JobSystem& jobSystem) -> void
 	{
-		auto tile = TerrainTile(level, textureAtlas);
+		auto tile = TerrainTile(level, textureAtlas, jobSystem);
 		m_tiles.emplace(identifier, std::move(tile));
 	}
 
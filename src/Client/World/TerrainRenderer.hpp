@@ -20,8 +20,9 @@ namespace Client::World
 		 * \param identifier The identifier to be given to the terrain tile
 		 * \param level The level data to create a terrain tile from
 		 * \param textureAtlas The atlas containing the textures used by the level
+		 * \param jobSystem The job system to build the terrain tile's mesh on
 		 */
-		auto addLevel(std::uint32_t identifier, Common::World::Level& level, Graphics::TextureAtlas& textureAtlas) -> void;
+		auto addLevel(std::uint32_t identifier, Common::World::Level& level, Graphics::TextureAtlas& textureAtlas, Common::Util::JobSystem& jobSystem) -> void;
 
 		/**
 		 * \brief Render all terrain tiles to the target
@@ -16,42 +16,46 @@ namespace Client::World
 	const auto xOffsets = std::array<float, 6>{0.0F, 0.0F, 1.0F, 0.0F, 1.0F, 1.0F};
 	const auto yOffsets = std::array<float, 6>{0.0F, 1.0F, 1.0F, 0.0F, 1.0F, 0.0F};
 
-	TerrainTile::TerrainTile(const Common::World::Level& level, const Graphics::TextureAtlas& textureAtlas)
+	TerrainTile::TerrainTile(const Common::World::Level& level, const Graphics::TextureAtlas& textureAtlas, Common::Util::JobSystem& jobSystem)
 	{
-		auto levelData = level.data();
+		// Fewer rows than this aren't worth handing to another thread
+		const auto MIN_ROWS_PER_JOB = std::size_t(16);
 
 		m_vertexArray.setPrimitiveType(sf::PrimitiveType::Triangles);
 		m_vertexArray.resize(Common::World::LEVEL_WIDTH * Common::World::LEVEL_HEIGHT * VERTICES_PER_TILE);
 
-		for (auto yPos = std::size_t(0); yPos < Common::World::LEVEL_HEIGHT; ++yPos)
-		{
-			for (auto xPos = std::size_t(0); xPos < Common::World::LEVEL_WIDTH; ++xPos)
+		// Each row only writes its own vertices, so rows can be built at the same time
+		jobSystem.parallelFor(Common::World::LEVEL_HEIGHT, MIN_ROWS_PER_JOB, [&](const std::size_t firstRow, const std::size_t lastRow) {
+			for (auto yPos = firstRow; yPos < lastRow; ++yPos)
 			{
-				auto index  = (xPos + yPos * Common::World::LEVEL_WIDTH) * VERTICES_PER_TILE;
-				auto floatX = static_cast<float>(xPos);
-				auto floatY = static_cast<float>(yPos);
-
-				for (auto i = std::size_t(0); i < VERTICES_PER_TILE; ++i)
+				for (auto xPos = std::size_t(0); xPos < Common::World::LEVEL_WIDTH; ++xPos)
 				{
-					m_vertexArray[index + i].position = sf::Vector2f(floatX + xOffsets.at(i), floatY + yOffsets.at(i)) * TILE_SCALE;
-				}
+					auto index  = (xPos + yPos * Common::World::LEVEL_WIDTH) * VERTICES_PER_TILE;
+					auto floatX = static_cast<float>(xPos);
+					auto floatY = static_cast<float>(yPos);
 
-				auto textureCoordinates = textureAtlas.getTextureCoordinates(level.getTile(xPos, yPos));
+					for (auto i = std::size_t(0); i < VERTICES_PER_TILE; ++i)
+					{
+						m_vertexArray[index + i].position = sf::Vector2f(floatX + xOffsets.at(i), floatY + yOffsets.at(i)) * TILE_SCALE;
+					}
 
-				auto topLeft     = sf::Vector2f(textureCoordinates.left, textureCoordinates.top);
-				auto bottomLeft  = sf::Vector2f(textureCoordinates.left, textureCoordinates.top + textureCoordinates.height);
-				auto topRight    = sf::Vector2f(textureCoordinates.left + textureCoordinates.width, textureCoordinates.top);
-				auto bottomRight = sf::Vector2f(textureCoordinates.left + textureCoordinates.width, textureCoordinates.top + textureCoordinates.height);
+					auto textureCoordinates = textureAtlas.getTextureCoordinates(level.getTile(xPos, yPos));
 
-				m_vertexArray[index + 0].texCoords = topLeft;
-				m_vertexArray[index + 1].texCoords = bottomLeft;
-				m_vertexArray[index + 2].texCoords = bottomRight;
+					auto topLeft     = sf::Vector2f(textureCoordinates.left, textureCoordinates.top);
+					auto bottomLeft  = sf::Vector2f(textureCoordinates.left, textureCoordinates.top + textureCoordinates.height);
+					auto topRight    = sf::Vector2f(textureCoordinates.left + textureCoordinates.width, textureCoordinates.top);
+					auto bottomRight = sf::Vector2f(textureCoordinates.left + textureCoordinates.width, textureCoordinates.top + textureCoordinates.height);
 
-				m_vertexArray[index + 3].texCoords = topLeft;
-				m_vertexArray[index + 4].texCoords = bottomRight;
-				m_vertexArray[index + 5].texCoords = topRight;
+					m_vertexArray[index + 0].texCoords = topLeft;
+					m_vertexArray[index + 1].texCoords = bottomLeft;
+					m_vertexArray[index + 2].texCoords = bottomRight;
+
+					m_vertexArray[index + 3].texCoords = topLeft;
+					m_vertexArray[index + 4].texCoords = bottomRight;
+					m_vertexArray[index + 5].texCoords = topRight;
+				}
 			}
-		}
+		});
 	}
 
 	auto TerrainTile::update(std::size_t xPosition, std::size_t yPosition, sf::FloatRect textureCoordinates) -> void
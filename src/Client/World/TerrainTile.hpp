@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Graphics/TextureAtlas.hpp"
+#include <Common/Util/JobSystem.hpp>
 #include <Common/World/Level.hpp>
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
@@ -20,8 +21,9 @@ namespace Client::World
 		 *
 		 * \param level The level to construct the terrain tile from
 		 * \param textureAtlas The atlas containing the textures used by the level
+		 * \param jobSystem The job system to build the rows of the tile's mesh on
 		 */
-		TerrainTile(const Common::World::Level& level, const Graphics::TextureAtlas& textureAtlas);
+		TerrainTile(const Common::World::Level& level, const Graphics::TextureAtlas& textureAtlas, Common::Util::JobSystem& jobSystem);
 
 		/**
 		 * \brief Update a quad of the terrain tile with a new texture
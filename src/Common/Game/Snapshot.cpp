@@ -0,0 +1,28 @@
+#include "Common/Game/Snapshot.hpp"
+
+namespace Common::Game
+{
+
+	auto SnapshotHistory::store(Snapshot&& snapshot) -> const Snapshot&
+	{
+		auto& slot = m_snapshots[snapshot.id % LENGTH];
+		slot       = std::move(snapshot);
+		return slot;
+	}
+
+	auto SnapshotHistory::find(const std::uint32_t id) const -> const Snapshot*
+	{
+		const auto& slot = m_snapshots[id % LENGTH];
+		if (id == 0 || slot.id != id)
+		{
+			return nullptr;
+		}
+		return &slot;
+	}
+
+	auto SnapshotHistory::clear() -> void
+	{
+		m_snapshots = {};
+	}
+
+} // namespace Common::Game
\ No newline at end of file
@@ -3,6 +3,13 @@
 namespace Common::Game
 {
 
+	const auto POSITION_INSTANCE_ID = std::uint8_t(1 << 0);
+	const auto POSITION_X           = std::uint8_t(1 << 1);
+	const auto POSITION_Y           = std::uint8_t(1 << 2);
+	const auto POSITION_MASK_BITS   = std::uint8_t(3);
+
+	const Network::QuantisedRange WorldEntityPosition::COORDINATE_RANGE = {-32'768.0F, 32'768.0F, 20};
+
 	auto WorldEntityPosition::serialise(Network::MessageData& data) -> void
 	{
 		data << instanceID << position.x << position.y;
@@ -13,4 +20,111 @@ namespace Common::Game
 		data >> instanceID >> position.x >> position.y;
 	}
 
+	auto WorldEntityPosition::serialiseDelta(const WorldEntityPosition& baseline, Network::MessageData& data) -> void
+	{
+		auto changed = std::uint8_t(0);
+		changed |= instanceID != baseline.instanceID ? POSITION_INSTANCE_ID : 0;
+		changed |= position.x != baseline.position.x ? POSITION_X : 0;
+		changed |= position.y != baseline.position.y ? POSITION_Y : 0;
+
+		data << changed;
+		if ((changed & POSITION_INSTANCE_ID) != 0)
+		{
+			data << instanceID;
+		}
+		if ((changed & POSITION_X) != 0)
+		{
+			data << position.x;
+		}
+		if ((changed & POSITION_Y) != 0)
+		{
+			data << position.y;
+		}
+	}
+
+	auto WorldEntityPosition::deserialiseDelta(Network::MessageData& data) -> void
+	{
+		auto changed = std::uint8_t(0);
+		data >> changed;
+		if ((changed & POSITION_INSTANCE_ID) != 0)
+		{
+			data >> instanceID;
+		}
+		if ((changed & POSITION_X) != 0)
+		{
+			data >> position.x;
+		}
+		if ((changed & POSITION_Y) != 0)
+		{
+			data >> position.y;
+		}
+	}
+
+	auto WorldEntityPosition::serialise(Network::BitWriter& writer) -> void
+	{
+		writer.writeVarint(instanceID);
+		writer.writeQuantised(position.x, COORDINATE_RANGE);
+		writer.writeQuantised(position.y, COORDINATE_RANGE);
+	}
+
+	auto WorldEntityPosition::deserialise(Network::BitReader& reader) -> void
+	{
+		instanceID = static_cast<std::uint32_t>(reader.readVarint());
+		position.x = reader.readQuantised(COORDINATE_RANGE);
+		position.y = reader.readQuantised(COORDINATE_RANGE);
+	}
+
+	auto WorldEntityPosition::serialiseDelta(const WorldEntityPosition& baseline, Network::BitWriter& writer) -> void
+	{
+		// Coordinates are sent as the number of steps moved since the baseline, which is small between snapshots
+		auto xSteps = static_cast<std::int64_t>(COORDINATE_RANGE.quantise(position.x)) - COORDINATE_RANGE.quantise(baseline.position.x);
+		auto ySteps = static_cast<std::int64_t>(COORDINATE_RANGE.quantise(position.y)) - COORDINATE_RANGE.quantise(baseline.position.y);
+
+		auto changed = std::uint8_t(0);
+		changed |= instanceID != baseline.instanceID ? POSITION_INSTANCE_ID : 0;
+		changed |= xSteps != 0 ? POSITION_X : 0;
+		changed |= ySteps != 0 ? POSITION_Y : 0;
+
+		writer.writeBits(changed, POSITION_MASK_BITS);
+		if ((changed & POSITION_INSTANCE_ID) != 0)
+		{
+			writer.writeVarint(instanceID);
+		}
+		if ((changed & POSITION_X) != 0)
+		{
+			writer.writeSignedVarint(xSteps);
+		}
+		if ((changed & POSITION_Y) != 0)
+		{
+			writer.writeSignedVarint(ySteps);
+		}
+	}
+
+	auto WorldEntityPosition::deserialiseDelta(Network::BitReader& reader) -> void
+	{
+		auto changed = static_cast<std::uint8_t>(reader.readBits(POSITION_MASK_BITS));
+		if ((changed & POSITION_INSTANCE_ID) != 0)
+		{
+			instanceID = static_cast<std::uint32_t>(reader.readVarint());
+		}
+		if ((changed & POSITION_X) != 0)
+		{
+			auto steps = static_cast<std::int64_t>(COORDINATE_RANGE.quantise(position.x)) + reader.readSignedVarint();
+			position.x = COORDINATE_RANGE.dequantise(static_cast<std::uint32_t>(steps));
+		}
+		if ((changed & POSITION_Y) != 0)
+		{
+			auto steps = static_cast<std::int64_t>(COORDINATE_RANGE.quantise(position.y)) + reader.readSignedVarint();
+			position.y = COORDINATE_RANGE.dequantise(static_cast<std::uint32_t>(steps));
+		}
+	}
+
+	auto WorldEntityPosition::quantised() const -> WorldEntityPosition
+	{
+		auto result       = *this;
+		result.position.x = COORDINATE_RANGE.dequantise(COORDINATE_RANGE.quantise(position.x));
+		result.position.y = COORDINATE_RANGE.dequantise(COORDINATE_RANGE.quantise(position.y));
+		return result;
+	}
+
 } // namespace Common::Game
\ No newline at end of file
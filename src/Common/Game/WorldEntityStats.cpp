@@ -3,6 +3,15 @@
 namespace Common::Game
 {
 
+	const auto STAT_MAX        = std::uint8_t(1 << 0);
+	const auto STAT_CURRENT    = std::uint8_t(1 << 1);
+	const auto STAT_REGEN_RATE = std::uint8_t(1 << 2);
+	const auto STAT_MASK_BITS  = std::uint8_t(3);
+
+	const auto STATS_HEALTH    = std::uint8_t(1 << 0);
+	const auto STATS_POWER     = std::uint8_t(1 << 1);
+	const auto STATS_MASK_BITS = std::uint8_t(2);
+
 	auto StatBlock::serialise(Network::MessageData& data) -> void
 	{
 		data << max << current << regenRate;
@@ -13,6 +22,46 @@ namespace Common::Game
 		data >> max >> current >> regenRate;
 	}
 
+	auto StatBlock::serialiseDelta(const StatBlock& baseline, Network::MessageData& data) -> void
+	{
+		auto changed = std::uint8_t(0);
+		changed |= max != baseline.max ? STAT_MAX : 0;
+		changed |= current != baseline.current ? STAT_CURRENT : 0;
+		changed |= regenRate != baseline.regenRate ? STAT_REGEN_RATE : 0;
+
+		data << changed;
+		if ((changed & STAT_MAX) != 0)
+		{
+			data << max;
+		}
+		if ((changed & STAT_CURRENT) != 0)
+		{
+			data << current;
+		}
+		if ((changed & STAT_REGEN_RATE) != 0)
+		{
+			data << regenRate;
+		}
+	}
+
+	auto StatBlock::deserialiseDelta(Network::MessageData& data) -> void
+	{
+		auto changed = std::uint8_t(0);
+		data >> changed;
+		if ((changed & STAT_MAX) != 0)
+		{
+			data >> max;
+		}
+		if ((changed & STAT_CURRENT) != 0)
+		{
+			data >> current;
+		}
+		if ((changed & STAT_REGEN_RATE) != 0)
+		{
+			data >> regenRate;
+		}
+	}
+
 	auto WorldEntityStats::serialise(Network::MessageData& data) -> void
 	{
 		health.serialise(data);
@@ -25,4 +74,131 @@ namespace Common::Game
 		power.deserialise(data);
 	}
 
+	auto WorldEntityStats::serialiseDelta(const WorldEntityStats& baseline, Network::MessageData& data) -> void
+	{
+		auto changed = std::uint8_t(0);
+		changed |= health != baseline.health ? STATS_HEALTH : 0;
+		changed |= power != baseline.power ? STATS_POWER : 0;
+
+		data << changed;
+		if ((changed & STATS_HEALTH) != 0)
+		{
+			health.serialiseDelta(baseline.health, data);
+		}
+		if ((changed & STATS_POWER) != 0)
+		{
+			power.serialiseDelta(baseline.power, data);
+		}
+	}
+
+	auto WorldEntityStats::deserialiseDelta(Network::MessageData& data) -> void
+	{
+		auto changed = std::uint8_t(0);
+		data >> changed;
+		if ((changed & STATS_HEALTH) != 0)
+		{
+			health.deserialiseDelta(data);
+		}
+		if ((changed & STATS_POWER) != 0)
+		{
+			power.deserialiseDelta(data);
+		}
+	}
+
+	auto StatBlock::serialise(Network::BitWriter& writer) -> void
+	{
+		writer.writeVarint(max);
+		writer.writeVarint(current);
+		writer.writeVarint(regenRate);
+	}
+
+	auto StatBlock::deserialise(Network::BitReader& reader) -> void
+	{
+		max       = static_cast<std::uint32_t>(reader.readVarint());
+		current   = static_cast<std::uint32_t>(reader.readVarint());
+		regenRate = static_cast<std::uint32_t>(reader.readVarint());
+	}
+
+	auto StatBlock::serialiseDelta(const StatBlock& baseline, Network::BitWriter& writer) -> void
+	{
+		auto changed = std::uint8_t(0);
+		changed |= max != baseline.max ? STAT_MAX : 0;
+		changed |= current != baseline.current ? STAT_CURRENT : 0;
+		changed |= regenRate != baseline.regenRate ? STAT_REGEN_RATE : 0;
+
+		writer.writeBits(changed, STAT_MASK_BITS);
+		if ((changed & STAT_MAX) != 0)
+		{
+			writer.writeVarint(max);
+		}
+		if ((changed & STAT_CURRENT) != 0)
+		{
+			// The current value changes a little at a time as it regenerates, so the difference is much smaller than the value
+			writer.writeSignedVarint(static_cast<std::int64_t>(current) - baseline.current);
+		}
+		if ((changed & STAT_REGEN_RATE) != 0)
+		{
+			writer.writeVarint(regenRate);
+		}
+	}
+
+	auto StatBlock::deserialiseDelta(Network::BitReader& reader) -> void
+	{
+		auto changed = static_cast<std::uint8_t>(reader.readBits(STAT_MASK_BITS));
+		if ((changed & STAT_MAX) != 0)
+		{
+			max = static_cast<std::uint32_t>(reader.readVarint());
+		}
+		if ((changed & STAT_CURRENT) != 0)
+		{
+			current = static_cast<std::uint32_t>(current + reader.readSignedVarint());
+		}
+		if ((changed & STAT_REGEN_RATE) != 0)
+		{
+			regenRate = static_cast<std::uint32_t>(reader.readVarint());
+		}
+	}
+
+	auto WorldEntityStats::serialise(Network::BitWriter& writer) -> void
+	{
+		health.serialise(writer);
+		power.serialise(writer);
+	}
+
+	auto WorldEntityStats::deserialise(Network::BitReader& reader) -> void
+	{
+		health.deserialise(reader);
+		power.deserialise(reader);
+	}
+
+	auto WorldEntityStats::serialiseDelta(const WorldEntityStats& baseline, Network::BitWriter& writer) -> void
+	{
+		auto changed = std::uint8_t(0);
+		changed |= health != baseline.health ? STATS_HEALTH : 0;
+		changed |= power != baseline.power ? STATS_POWER : 0;
+
+		writer.writeBits(changed, STATS_MASK_BITS);
+		if ((changed & STATS_HEALTH) != 0)
+		{
+			health.serialiseDelta(baseline.health, writer);
+		}
+		if ((changed & STATS_POWER) != 0)
+		{
+			power.serialiseDelta(baseline.power, writer);
+		}
+	}
+
+	auto WorldEntityStats::deserialiseDelta(Network::BitReader& reader) -> void
+	{
+		auto changed = static_cast<std::uint8_t>(reader.readBits(STATS_MASK_BITS));
+		if ((changed & STATS_HEALTH) != 0)
+		{
+			health.deserialiseDelta(reader);
+		}
+		if ((changed & STATS_POWER) != 0)
+		{
+			power.deserialiseDelta(reader);
+		}
+	}
+
 } // namespace Common::Game
\ No newline at end of file
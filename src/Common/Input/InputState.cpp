@@ -5,14 +5,35 @@ namespace Common::Input
 
 	auto operator<<(Common::Network::MessageData& data, const InputState state) -> Network::MessageData&
 	{
-		data << state.forwards << state.backwards << state.left << state.right;
+		// The flags share a single byte
+		auto writer = Network::BitWriter(data);
+		writer << state;
 		return data;
 	}
 
 	auto operator>>(Common::Network::MessageData& data, InputState& state) -> Network::MessageData&
 	{
-		data >> state.forwards >> state.backwards >> state.left >> state.right;
+		auto reader = Network::BitReader(data);
+		reader >> state;
 		return data;
 	}
 
+	auto operator<<(Common::Network::BitWriter& writer, const InputState state) -> Network::BitWriter&
+	{
+		writer.writeBool(state.forwards);
+		writer.writeBool(state.backwards);
+		writer.writeBool(state.left);
+		writer.writeBool(state.right);
+		return writer;
+	}
+
+	auto operator>>(Common::Network::BitReader& reader, InputState& state) -> Network::BitReader&
+	{
+		state.forwards  = reader.readBool();
+		state.backwards = reader.readBool();
+		state.left      = reader.readBool();
+		state.right     = reader.readBool();
+		return reader;
+	}
+
 } // namespace Common::Input
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "Common/Network/BitStream.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Common::Network
+{
+
+	const std::uint8_t MAX_BITS_PER_CALL = 32;
+	const std::uint8_t VARINT_GROUP_BITS = 7;
+
+	// No varint is longer than a 64-bit value needs
+	const std::size_t MAX_VARINT_GROUPS = 10;
+
+	auto getMask(const std::uint8_t count) -> std::uint64_t
+	{
+		return (std::uint64_t(1) << count) - 1;
+	}
+
+	auto QuantisedRange::quantise(const float value) const -> std::uint32_t
+	{
+		auto steps      = static_cast<double>(getMask(bits));
+		auto normalised = (static_cast<double>(std::clamp(value, min, max)) - min) / (static_cast<double>(max) - min);
+		return static_cast<std::uint32_t>(std::lround(normalised * steps));
+	}
+
+	auto QuantisedRange::dequantise(const std::uint32_t value) const -> float
+	{
+		auto steps = static_cast<double>(getMask(bits));
+		return static_cast<float>(min + (static_cast<double>(value) / steps) * (static_cast<double>(max) - min));
+	}
+
+	BitWriter::BitWriter(MessageData& data) :
+	    m_data(data)
+	{
+	}
+
+	BitWriter::~BitWriter()
+	{
+		flush();
+	}
+
+	auto BitWriter::writeBits(const std::uint64_t value, const std::uint8_t count) -> void
+	{
+		m_scratch |= (value & getMask(std::min(count, MAX_BITS_PER_CALL))) << m_scratchCount;
+		m_scratchCount += std::min(count, MAX_BITS_PER_CALL);
+
+		while (m_scratchCount >= 8)
+		{
+			m_data << static_cast<std::uint8_t>(m_scratch);
+			m_scratch >>= 8;
+			m_scratchCount -= 8;
+		}
+	}
+
+	auto BitWriter::writeBool(const bool value) -> void
+	{
+		writeBits(value ? 1 : 0, 1);
+	}
+
+	auto BitWriter::writeVarint(std::uint64_t value) -> void
+	{
+		// Each group is followed by a bit saying whether another follows it
+		while (value > getMask(VARINT_GROUP_BITS))
+		{
+			writeBits((value & getMask(VARINT_GROUP_BITS)) | (1 << VARINT_GROUP_BITS), VARINT_GROUP_BITS + 1);
+			value >>= VARINT_GROUP_BITS;
+		}
+		writeBits(value, VARINT_GROUP_BITS + 1);
+	}
+
+	auto BitWriter::writeSignedVarint(const std::int64_t value) -> void
+	{
+		writeVarint(zigzagEncode(value));
+	}
+
+	auto BitWriter::writeQuantised(const float value, const QuantisedRange& range) -> void
+	{
+		writeBits(range.quantise(value), range.bits);
+	}
+
+	auto BitWriter::flush() -> void
+	{
+		if (m_scratchCount > 0)
+		{
+			m_data << static_cast<std::uint8_t>(m_scratch);
+		}
+		m_scratch      = 0;
+		m_scratchCount = 0;
+	}
+
+	BitReader::BitReader(MessageData& data) :
+	    m_data(data)
+	{
+	}
+
+	auto BitReader::readBits(const std::uint8_t count) -> std::uint64_t
+	{
+		auto bitCount = std::min(count, MAX_BITS_PER_CALL);
+		while (m_scratchCount < bitCount)
+		{
+			auto byte = std::uint8_t(0);
+			m_data >> byte;
+			m_scratch |= static_cast<std::uint64_t>(byte) << m_scratchCount;
+			m_scratchCount += 8;
+		}
+
+		auto value = m_scratch & getMask(bitCount);
+		m_scratch >>= bitCount;
+		m_scratchCount -= bitCount;
+		return value;
+	}
+
+	auto BitReader::readBool() -> bool
+	{
+		return readBits(1) != 0;
+	}
+
+	auto BitReader::readVarint() -> std::uint64_t
+	{
+		auto value = std::uint64_t(0);
+		for (auto group = std::size_t(0); group < MAX_VARINT_GROUPS; ++group)
+		{
+			auto bits = readBits(VARINT_GROUP_BITS + 1);
+			value |= (bits & getMask(VARINT_GROUP_BITS)) << (group * VARINT_GROUP_BITS);
+			if ((bits >> VARINT_GROUP_BITS) == 0)
+			{
+				break;
+			}
+		}
+		return value;
+	}
+
+	auto BitReader::readSignedVarint() -> std::int64_t
+	{
+		return zigzagDecode(readVarint());
+	}
+
+	auto BitReader::readQuantised(const QuantisedRange& range) -> float
+	{
+		return range.dequantise(static_cast<std::uint32_t>(readBits(range.bits)));
+	}
+
+	auto BitReader::align() -> void
+	{
+		m_scratch      = 0;
+		m_scratchCount = 0;
+	}
+
+} // namespace Common::Network
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "Common/Network/BufferPool.hpp"
+#include <algorithm>
+
+namespace Common::Network
+{
+
+	auto BufferPool::get() -> BufferPool&
+	{
+		// Leaked on purpose, as messages held by other statics may still release their buffers during shutdown
+		static auto* pool = new BufferPool();
+		return *pool;
+	}
+
+	BufferPool::BufferPool()
+	{
+		// The free lists never grow past their limit, so giving a buffer back doesn't allocate either
+		for (auto i = std::size_t(0); i < m_sizeClasses.size(); ++i)
+		{
+			m_sizeClasses[i].available.reserve(BUFFER_CLASS_LIMITS[i]);
+		}
+	}
+
+	auto BufferPool::acquire(const std::size_t capacity) -> std::vector<std::uint8_t>
+	{
+		auto iterator = std::lower_bound(BUFFER_SIZE_CLASSES.begin(), BUFFER_SIZE_CLASSES.end(), capacity);
+		if (iterator == BUFFER_SIZE_CLASSES.end())
+		{
+			++m_oversizedCount;
+			auto buffer = std::vector<std::uint8_t>();
+			buffer.reserve(capacity);
+			return buffer;
+		}
+
+		auto& sizeClass = m_sizeClasses[iterator - BUFFER_SIZE_CLASSES.begin()];
+		{
+			auto lock = std::scoped_lock(sizeClass.mutex);
+			if (!sizeClass.available.empty())
+			{
+				auto buffer = std::move(sizeClass.available.back());
+				sizeClass.available.pop_back();
+				++sizeClass.hits;
+				return buffer;
+			}
+		}
+
+		++sizeClass.misses;
+		auto buffer = std::vector<std::uint8_t>();
+		buffer.reserve(*iterator);
+		return buffer;
+	}
+
+	auto BufferPool::release(std::vector<std::uint8_t>&& buffer) -> void
+	{
+		// File the buffer under the largest size class it can serve, as it might have grown past the one it came from
+		auto iterator = std::upper_bound(BUFFER_SIZE_CLASSES.begin(), BUFFER_SIZE_CLASSES.end(), buffer.capacity());
+		if (iterator == BUFFER_SIZE_CLASSES.begin())
+		{
+			if (buffer.capacity() > 0)
+			{
+				++m_discardedCount;
+			}
+			buffer = std::vector<std::uint8_t>();
+			return;
+		}
+
+		auto index      = static_cast<std::size_t>(iterator - BUFFER_SIZE_CLASSES.begin()) - 1;
+		auto& sizeClass = m_sizeClasses[index];
+		buffer.clear();
+		{
+			auto lock = std::scoped_lock(sizeClass.mutex);
+			if (sizeClass.available.size() < BUFFER_CLASS_LIMITS[index])
+			{
+				sizeClass.available.emplace_back(std::move(buffer));
+				return;
+			}
+		}
+
+		++sizeClass.discarded;
+		buffer = std::vector<std::uint8_t>();
+	}
+
+	auto BufferPool::getStatistics() const -> BufferPoolStatistics
+	{
+		auto statistics      = BufferPoolStatistics();
+		statistics.oversized = m_oversizedCount.load();
+		statistics.discarded = m_discardedCount.load();
+
+		for (auto i = std::size_t(0); i < m_sizeClasses.size(); ++i)
+		{
+			auto sizeClassStatistics = getStatistics(i);
+			statistics.hits += sizeClassStatistics.hits;
+			statistics.misses += sizeClassStatistics.misses;
+			statistics.discarded += sizeClassStatistics.discarded;
+			statistics.available += sizeClassStatistics.available;
+		}
+		return statistics;
+	}
+
+	auto BufferPool::getStatistics(const std::size_t sizeClass) const -> BufferPoolStatistics
+	{
+		const auto& selected = m_sizeClasses.at(sizeClass);
+
+		auto statistics      = BufferPoolStatistics();
+		statistics.hits      = selected.hits.load();
+		statistics.misses    = selected.misses.load();
+		statistics.discarded = selected.discarded.load();
+
+		auto lock            = std::scoped_lock(selected.mutex);
+		statistics.available = selected.available.size();
+		return statistics;
+	}
+
+} // namespace Common::Network
\ No newline at end of file
@@ -13,9 +13,19 @@ namespace Common::Network
 
 	auto PublicKeyCryptographer::decryptFromRemote(std::vector<uint8_t>& data) const -> void
 	{
+		decryptFromRemote(std::span<std::uint8_t>(data));
 	}
 
 	auto PublicKeyCryptographer::decryptFromLocal(std::vector<uint8_t>& data) const -> void
+	{
+		decryptFromLocal(std::span<std::uint8_t>(data));
+	}
+
+	auto PublicKeyCryptographer::decryptFromRemote(std::span<std::uint8_t> data) const -> void
+	{
+	}
+
+	auto PublicKeyCryptographer::decryptFromLocal(std::span<std::uint8_t> data) const -> void
 	{
 	}
 
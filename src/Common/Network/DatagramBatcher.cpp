@@ -0,0 +1,223 @@
+#include "Common/Network/DatagramBatcher.hpp"
+#include "Network/NativeHandle.hpp"
+#include <algorithm>
+#include <cerrno>
+
+#if defined(__linux__)
+#	include <arpa/inet.h>
+#	include <netinet/in.h>
+#	include <sys/socket.h>
+#endif
+
+namespace Common::Network
+{
+
+#if defined(__linux__)
+
+	DatagramBatcher::DatagramBatcher(const std::size_t batchSize, const std::size_t maxDatagramLength) :
+	    m_batchSize(batchSize),
+	    m_maxDatagramLength(maxDatagramLength),
+	    m_receiveRing(batchSize * maxDatagramLength),
+	    m_headers(std::make_unique<mmsghdr[]>(batchSize)),
+	    m_vectors(std::make_unique<iovec[]>(batchSize)),
+	    m_addresses(std::make_unique<sockaddr_in[]>(batchSize))
+	{
+		m_pending.reserve(batchSize);
+		m_received.reserve(batchSize);
+	}
+
+	DatagramBatcher::~DatagramBatcher() = default;
+
+	auto DatagramBatcher::flush(sf::UdpSocket& socket) -> void
+	{
+		auto handle = NativeHandleAccessor::get(socket);
+
+		for (auto batchStart = std::size_t(0); batchStart < m_pending.size(); batchStart += m_batchSize)
+		{
+			auto batchLength = std::min(m_batchSize, m_pending.size() - batchStart);
+
+			auto segmentCount = std::size_t(0);
+			for (auto i = std::size_t(0); i < batchLength; ++i)
+			{
+				segmentCount += m_pending[batchStart + i].buffer.getSegmentCount();
+			}
+			if (segmentCount > m_sendVectorCapacity)
+			{
+				m_sendVectors        = std::make_unique<iovec[]>(segmentCount);
+				m_sendVectorCapacity = segmentCount;
+			}
+
+			auto* vectors = m_sendVectors.get();
+			for (auto i = std::size_t(0); i < batchLength; ++i)
+			{
+				auto& datagram = m_pending[batchStart + i];
+
+				auto& address           = m_addresses[i];
+				address                 = sockaddr_in();
+				address.sin_family      = AF_INET;
+				address.sin_addr.s_addr = htonl(datagram.address.toInteger());
+				address.sin_port        = htons(datagram.port);
+
+				// Each datagram gathers its own run of vectors, one per segment of its buffer
+				auto vectorCount = datagram.buffer.getSegmentCount();
+				for (auto segment = std::size_t(0); segment < vectorCount; ++segment)
+				{
+					vectors[segment].iov_base = const_cast<std::uint8_t*>(datagram.buffer.getSegmentData(segment));
+					vectors[segment].iov_len  = datagram.buffer.getSegmentLength(segment);
+				}
+
+				auto& header               = m_headers[i];
+				header                     = mmsghdr();
+				header.msg_hdr.msg_name    = &address;
+				header.msg_hdr.msg_namelen = sizeof(address);
+				header.msg_hdr.msg_iov     = vectors;
+				header.msg_hdr.msg_iovlen  = vectorCount;
+
+				vectors += vectorCount;
+			}
+
+			// sendmmsg stops at the first datagram which fails, so keep going from there until the batch is sent or the socket is full
+			auto sent = std::size_t(0);
+			while (sent < batchLength)
+			{
+				auto result = sendmmsg(handle, &m_headers[sent], static_cast<unsigned int>(batchLength - sent), MSG_DONTWAIT);
+				++m_syscallCount;
+
+				if (result > 0)
+				{
+					sent += static_cast<std::size_t>(result);
+				}
+				else if (errno == EINTR)
+				{
+					continue;
+				}
+				else if (errno == EAGAIN || errno == EWOULDBLOCK)
+				{
+					m_droppedCount += batchLength - sent;
+					break;
+				}
+				else
+				{
+					// Skip the datagram that failed, e.g. because its destination is unreachable
+					++m_droppedCount;
+					++sent;
+				}
+			}
+		}
+
+		m_pending.clear();
+	}
+
+	auto DatagramBatcher::receive(sf::UdpSocket& socket) -> const std::vector<Datagram>&
+	{
+		m_received.clear();
+
+		for (auto i = std::size_t(0); i < m_batchSize; ++i)
+		{
+			m_vectors[i].iov_base = m_receiveRing.data() + i * m_maxDatagramLength;
+			m_vectors[i].iov_len  = m_maxDatagramLength;
+
+			auto& header               = m_headers[i];
+			header                     = mmsghdr();
+			header.msg_hdr.msg_name    = &m_addresses[i];
+			header.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+			header.msg_hdr.msg_iov     = &m_vectors[i];
+			header.msg_hdr.msg_iovlen  = 1;
+		}
+
+		auto result = recvmmsg(NativeHandleAccessor::get(socket), m_headers.get(), static_cast<unsigned int>(m_batchSize), MSG_DONTWAIT, nullptr);
+		++m_syscallCount;
+		for (auto i = 0; i < result; ++i)
+		{
+			const auto& address = m_addresses[i];
+
+			auto& datagram   = m_received.emplace_back();
+			datagram.data    = m_receiveRing.data() + i * m_maxDatagramLength;
+			datagram.length  = m_headers[i].msg_len;
+			datagram.address = sf::IpAddress(ntohl(address.sin_addr.s_addr));
+			datagram.port    = ntohs(address.sin_port);
+		}
+
+		return m_received;
+	}
+
+#else
+
+	DatagramBatcher::DatagramBatcher(const std::size_t batchSize, const std::size_t maxDatagramLength) :
+	    m_batchSize(batchSize),
+	    m_maxDatagramLength(maxDatagramLength),
+	    m_receiveRing(batchSize * maxDatagramLength)
+	{
+		m_pending.reserve(batchSize);
+		m_received.reserve(batchSize);
+	}
+
+	DatagramBatcher::~DatagramBatcher() = default;
+
+	auto DatagramBatcher::flush(sf::UdpSocket& socket) -> void
+	{
+		for (auto& datagram : m_pending)
+		{
+			auto buffer = datagram.buffer.flatten();
+
+			++m_syscallCount;
+			if (socket.send(buffer.data(), buffer.size(), datagram.address, datagram.port) != sf::Socket::Status::Done)
+			{
+				++m_droppedCount;
+			}
+			BufferPool::get().release(std::move(buffer));
+		}
+
+		m_pending.clear();
+	}
+
+	auto DatagramBatcher::receive(sf::UdpSocket& socket) -> const std::vector<Datagram>&
+	{
+		m_received.clear();
+
+		for (auto i = std::size_t(0); i < m_batchSize; ++i)
+		{
+			auto* buffer       = m_receiveRing.data() + i * m_maxDatagramLength;
+			auto length        = std::size_t(0);
+			auto remoteAddress = std::optional<sf::IpAddress>();
+			auto remotePort    = std::uint16_t(0);
+
+			auto status = socket.receive(buffer, m_maxDatagramLength, length, remoteAddress, remotePort);
+			++m_syscallCount;
+			if (status == sf::Socket::Status::NotReady)
+			{
+				break;
+			}
+			if (status != sf::Socket::Status::Done || !remoteAddress.has_value())
+			{
+				continue;
+			}
+
+			auto& datagram   = m_received.emplace_back();
+			datagram.data    = buffer;
+			datagram.length  = length;
+			datagram.address = *remoteAddress;
+			datagram.port    = remotePort;
+		}
+
+		return m_received;
+	}
+
+#endif
+
+	auto DatagramBatcher::queue(GatherBuffer&& buffer, const sf::IpAddress address, const std::uint16_t port) -> void
+	{
+		m_pending.emplace_back(PendingDatagram{std::move(buffer), address, port});
+	}
+
+	auto DatagramBatcher::getDroppedCount() const -> std::uint64_t
+	{
+		return m_droppedCount;
+	}
+
+	auto DatagramBatcher::getSyscallCount() const -> std::uint64_t
+	{
+		return m_syscallCount;
+	}
+
+} // namespace Common::Network
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "Common/Network/EndpointTable.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace Common::Network
+{
+
+	auto EndpointAddress::fromIPv4(const std::uint32_t address, const std::uint16_t port) -> EndpointAddress
+	{
+		auto endpoint       = EndpointAddress();
+		endpoint.addressLow = 0xffff00000000ull | address;
+		endpoint.port       = port;
+		return endpoint;
+	}
+
+	auto EndpointAddress::hash() const -> std::uint64_t
+	{
+		// The port lands on the two bytes which are always zero in a mapped IPv4 address, so every IPv4 endpoint gets its own key.
+		// Fibonacci hashing then spreads every bit of the key into the high bits, which the table takes slot indices from
+		auto key = addressLow ^ std::rotl(addressHigh, 32) ^ (static_cast<std::uint64_t>(port) << 48);
+		return key * 0x9e3779b97f4a7c15ull;
+	}
+
+	EndpointTable::EndpointTable(const std::size_t capacity)
+	{
+		// Leave enough room that the table is no more than three quarters full at the capacity asked for
+		auto slotCount = std::bit_ceil(std::max(capacity + capacity / 3 + 1, std::size_t(8)));
+		m_slots.resize(slotCount);
+		m_mask  = slotCount - 1;
+		m_shift = 64 - std::countr_zero(slotCount);
+	}
+
+	auto EndpointTable::insert(const EndpointAddress& endpoint, const entt::entity entityID) -> bool
+	{
+		auto index = findSlot(endpoint);
+		if (m_slots[index].entityID != entt::null)
+		{
+			return m_slots[index].entityID == entityID;
+		}
+
+		auto entityIndex = static_cast<std::size_t>(entt::to_entity(entityID));
+		if (entityIndex >= m_clients.size())
+		{
+			m_clients.resize(std::max(entityIndex + 1, m_clients.size() * 2));
+		}
+
+		// Drop the client's old endpoint, or one left behind by an earlier client whose entity has since been recycled
+		auto& client = m_clients[entityIndex];
+		if (client.entityID != entt::null)
+		{
+			eraseSlot(findSlot(client.endpoint));
+			--m_size;
+		}
+
+		if ((m_size + 1) * 4 > m_slots.size() * 3)
+		{
+			grow();
+		}
+
+		auto& slot    = m_slots[findSlot(endpoint)];
+		slot.endpoint = endpoint;
+		slot.entityID = entityID;
+		++m_size;
+
+		client = Entry{endpoint, entityID};
+		return true;
+	}
+
+	auto EndpointTable::find(const EndpointAddress& endpoint) const -> entt::entity
+	{
+		return m_slots[findSlot(endpoint)].entityID;
+	}
+
+	auto EndpointTable::find(const entt::entity entityID) const -> std::optional<EndpointAddress>
+	{
+		auto entityIndex = static_cast<std::size_t>(entt::to_entity(entityID));
+		if (entityIndex >= m_clients.size() || m_clients[entityIndex].entityID != entityID)
+		{
+			return {};
+		}
+
+		return m_clients[entityIndex].endpoint;
+	}
+
+	auto EndpointTable::erase(const entt::entity entityID) -> bool
+	{
+		auto* client = findClient(entityID);
+		if (client == nullptr)
+		{
+			return false;
+		}
+
+		eraseSlot(findSlot(client->endpoint));
+		--m_size;
+		*client = Entry();
+		return true;
+	}
+
+	auto EndpointTable::clear() -> void
+	{
+		for (auto& slot : m_slots)
+		{
+			slot = Entry();
+		}
+		m_clients.clear();
+		m_size = 0;
+	}
+
+	auto EndpointTable::size() const -> std::size_t
+	{
+		return m_size;
+	}
+
+	auto EndpointTable::capacity() const -> std::size_t
+	{
+		return m_slots.size();
+	}
+
+	auto EndpointTable::findSlot(const EndpointAddress& endpoint) const -> std::size_t
+	{
+		// The table is never full, so the probe always reaches the endpoint or an empty slot
+		auto index = getHomeSlot(endpoint);
+		while (m_slots[index].entityID != entt::null && m_slots[index].endpoint != endpoint)
+		{
+			index = (index + 1) & m_mask;
+		}
+		return index;
+	}
+
+	auto EndpointTable::eraseSlot(std::size_t index) -> void
+	{
+		// Pull back every later entry in the run whose home slot is at or before the gap, so lookups never stop short of it
+		auto next = (index + 1) & m_mask;
+		while (m_slots[next].entityID != entt::null)
+		{
+			auto home = getHomeSlot(m_slots[next].endpoint);
+			if (((next - home) & m_mask) >= ((next - index) & m_mask))
+			{
+				m_slots[index] = m_slots[next];
+				index          = next;
+			}
+			next = (next + 1) & m_mask;
+		}
+		m_slots[index] = Entry();
+	}
+
+	auto EndpointTable::grow() -> void
+	{
+		auto slots = std::vector<Entry>(m_slots.size() * 2);
+		std::swap(slots, m_slots);
+		m_mask  = m_slots.size() - 1;
+		m_shift = 64 - std::countr_zero(m_slots.size());
+
+		for (const auto& slot : slots)
+		{
+			if (slot.entityID != entt::null)
+			{
+				m_slots[findSlot(slot.endpoint)] = slot;
+			}
+		}
+	}
+
+	auto EndpointTable::getHomeSlot(const EndpointAddress& endpoint) const -> std::size_t
+	{
+		return static_cast<std::size_t>(endpoint.hash() >> m_shift);
+	}
+
+	auto EndpointTable::findClient(const entt::entity entityID) -> Entry*
+	{
+		auto entityIndex = static_cast<std::size_t>(entt::to_entity(entityID));
+		if (entityIndex >= m_clients.size() || m_clients[entityIndex].entityID != entityID)
+		{
+			return nullptr;
+		}
+		return &m_clients[entityIndex];
+	}
+
+} // namespace Common::Network
\ No newline at end of file
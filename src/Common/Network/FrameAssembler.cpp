@@ -0,0 +1,122 @@
+#include "Common/Network/FrameAssembler.hpp"
+
+namespace Common::Network
+{
+
+	FrameAssembler::FrameAssembler(const std::size_t maxFrameLength) :
+	    m_maxFrameLength(maxFrameLength)
+	{
+	}
+
+	auto FrameAssembler::makePrefix(const std::size_t length) -> std::array<std::uint8_t, PREFIX_LENGTH>
+	{
+		auto prefix = std::array<std::uint8_t, PREFIX_LENGTH>();
+		for (auto i = std::size_t(0); i < PREFIX_LENGTH; ++i)
+		{
+			prefix[i] = static_cast<std::uint8_t>(static_cast<FrameLength>(length) >> (i * 8));
+		}
+		return prefix;
+	}
+
+	auto FrameAssembler::readPrefix(const std::uint8_t* data) -> FrameLength
+	{
+		auto length = FrameLength(0);
+		for (auto i = std::size_t(0); i < PREFIX_LENGTH; ++i)
+		{
+			length |= static_cast<FrameLength>(data[i]) << (i * 8);
+		}
+		return length;
+	}
+
+	auto FrameAssembler::readFrame(const std::uint8_t* data, const std::size_t length, std::size_t& offset) -> std::optional<std::span<const std::uint8_t>>
+	{
+		if (offset + PREFIX_LENGTH > length)
+		{
+			return {};
+		}
+
+		auto frameLength = readPrefix(data + offset);
+		if (frameLength > length - offset - PREFIX_LENGTH)
+		{
+			return {};
+		}
+
+		auto frame = std::span<const std::uint8_t>(data + offset + PREFIX_LENGTH, frameLength);
+		offset += PREFIX_LENGTH + frameLength;
+		return {frame};
+	}
+
+	auto FrameAssembler::frame(std::vector<std::uint8_t>& buffer) -> void
+	{
+		auto prefix = makePrefix(buffer.size());
+		buffer.insert(buffer.begin(), prefix.begin(), prefix.end());
+	}
+
+	auto FrameAssembler::append(const std::uint8_t* data, const std::size_t length) -> void
+	{
+		// Drop the frames that have already been taken once they make up most of the buffer, so it doesn't grow without bound
+		if (m_readOffset > 0 && m_readOffset >= m_buffer.size() / 2)
+		{
+			m_buffer.erase(m_buffer.begin(), m_buffer.begin() + static_cast<std::ptrdiff_t>(m_readOffset));
+			m_readOffset = 0;
+		}
+
+		m_buffer.insert(m_buffer.end(), data, data + length);
+	}
+
+	auto FrameAssembler::next() -> std::optional<std::vector<std::uint8_t>>
+	{
+		auto frame = nextView();
+		if (!frame.has_value())
+		{
+			return {};
+		}
+
+		return {std::vector<std::uint8_t>(frame->begin(), frame->end())};
+	}
+
+	auto FrameAssembler::nextView() -> std::optional<std::span<const std::uint8_t>>
+	{
+		if (m_isCorrupt || getBufferedLength() < PREFIX_LENGTH)
+		{
+			return {};
+		}
+
+		auto length = readPrefix(m_buffer.data() + m_readOffset);
+		if (length > m_maxFrameLength)
+		{
+			m_isCorrupt = true;
+			return {};
+		}
+
+		if (getBufferedLength() < PREFIX_LENGTH + length)
+		{
+			// The rest of the frame hasn't arrived yet
+			return {};
+		}
+
+		auto frame = std::span<const std::uint8_t>(m_buffer.data() + m_readOffset + PREFIX_LENGTH, length);
+		// Frames which have been taken are only dropped by the next append, so the frame remains valid until then
+		m_readOffset += PREFIX_LENGTH + length;
+
+		return {frame};
+	}
+
+	auto FrameAssembler::isCorrupt() const -> bool
+	{
+		return m_isCorrupt;
+	}
+
+	auto FrameAssembler::getBufferedLength() const -> std::size_t
+	{
+		return m_buffer.size() - m_readOffset;
+	}
+
+	auto FrameAssembler::clear() -> void
+	{
+		m_buffer.clear();
+		m_readOffset = 0;
+		m_isCorrupt  = false;
+	}
+
+} // namespace Common::Network
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include "Common/Network/GatherBuffer.hpp"
+#include "Network/NativeHandle.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+
+#if defined(__linux__)
+#	include <sys/socket.h>
+#	include <sys/uio.h>
+#endif
+
+namespace Common::Network
+{
+
+	GatherBuffer::~GatherBuffer()
+	{
+		BufferPool::get().release(std::move(m_bytes));
+	}
+
+	auto GatherBuffer::operator=(GatherBuffer&& other) noexcept -> GatherBuffer&
+	{
+		if (this != &other)
+		{
+			BufferPool::get().release(std::move(m_bytes));
+			m_bytes    = std::move(other.m_bytes);
+			m_segments = std::move(other.m_segments);
+			m_size     = std::exchange(other.m_size, 0);
+		}
+		return *this;
+	}
+
+	auto GatherBuffer::append(const std::uint8_t* data, const std::size_t length) -> void
+	{
+		if (length == 0)
+		{
+			return;
+		}
+
+		if (m_bytes.size() + length > m_bytes.capacity())
+		{
+			auto grown = BufferPool::get().acquire(std::max(m_bytes.size() + length, m_bytes.capacity() * 2));
+			grown.assign(m_bytes.begin(), m_bytes.end());
+			BufferPool::get().release(std::exchange(m_bytes, std::move(grown)));
+		}
+
+		// Extend the last segment if it ends where these bytes will start
+		if (!m_segments.empty() && !m_segments.back().payload && m_segments.back().offset + m_segments.back().length == m_bytes.size())
+		{
+			m_segments.back().length += length;
+		}
+		else
+		{
+			m_segments.emplace_back(Segment{m_bytes.size(), length, nullptr});
+		}
+
+		m_bytes.insert(m_bytes.end(), data, data + length);
+		m_size += length;
+	}
+
+	auto GatherBuffer::append(const SharedPayload& payload) -> void
+	{
+		if (!payload || payload->empty())
+		{
+			return;
+		}
+
+		if (payload->size() < COPY_THRESHOLD)
+		{
+			append(payload->data(), payload->size());
+			return;
+		}
+
+		m_segments.emplace_back(Segment{0, payload->size(), payload});
+		m_size += payload->size();
+	}
+
+	auto GatherBuffer::size() const -> std::size_t
+	{
+		return m_size;
+	}
+
+	auto GatherBuffer::empty() const -> bool
+	{
+		return m_size == 0;
+	}
+
+	auto GatherBuffer::getSegmentCount() const -> std::size_t
+	{
+		return m_segments.size();
+	}
+
+	auto GatherBuffer::getSegmentData(const std::size_t index) const -> const std::uint8_t*
+	{
+		const auto& segment = m_segments[index];
+		return (segment.payload ? segment.payload->data() : m_bytes.data()) + segment.offset;
+	}
+
+	auto GatherBuffer::getSegmentLength(const std::size_t index) const -> std::size_t
+	{
+		return m_segments[index].length;
+	}
+
+	auto GatherBuffer::flatten() const -> std::vector<std::uint8_t>
+	{
+		auto buffer = BufferPool::get().acquire(m_size);
+		for (auto i = std::size_t(0); i < m_segments.size(); ++i)
+		{
+			buffer.insert(buffer.end(), getSegmentData(i), getSegmentData(i) + getSegmentLength(i));
+		}
+		return buffer;
+	}
+
+#if defined(__linux__)
+
+	auto GatherBuffer::send(sf::TcpSocket& socket, std::size_t& sent) const -> sf::Socket::Status
+	{
+		// The kernel won't gather more than IOV_MAX segments per call
+		const auto MAX_SEGMENTS_PER_CALL = std::size_t(IOV_MAX);
+
+		auto handle  = NativeHandleAccessor::get(socket);
+		auto vectors = std::vector<iovec>(std::min(m_segments.size(), MAX_SEGMENTS_PER_CALL));
+
+		sent               = 0;
+		auto segment       = std::size_t(0);
+		auto segmentOffset = std::size_t(0);
+		while (segment < m_segments.size())
+		{
+			auto vectorCount = std::min(m_segments.size() - segment, MAX_SEGMENTS_PER_CALL);
+			for (auto i = std::size_t(0); i < vectorCount; ++i)
+			{
+				auto skip           = (i == 0) ? segmentOffset : 0;
+				vectors[i].iov_base = const_cast<std::uint8_t*>(getSegmentData(segment + i) + skip);
+				vectors[i].iov_len  = getSegmentLength(segment + i) - skip;
+			}
+
+			auto message       = msghdr();
+			message.msg_iov    = vectors.data();
+			message.msg_iovlen = vectorCount;
+
+			// sendmsg rather than writev, so a closed connection reports EPIPE instead of raising SIGPIPE
+			auto result = sendmsg(handle, &message, MSG_NOSIGNAL | MSG_DONTWAIT);
+			if (result < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				if (errno == EAGAIN || errno == EWOULDBLOCK)
+				{
+					return sent == 0 ? sf::Socket::Status::NotReady : sf::Socket::Status::Partial;
+				}
+				if (errno == EPIPE || errno == ECONNRESET)
+				{
+					return sf::Socket::Status::Disconnected;
+				}
+				return sf::Socket::Status::Error;
+			}
+
+			// Advance past everything that was written, which may end part way through a segment
+			auto written = static_cast<std::size_t>(result);
+			sent += written;
+			while (written > 0 && segment < m_segments.size())
+			{
+				auto remaining = getSegmentLength(segment) - segmentOffset;
+				if (written < remaining)
+				{
+					segmentOffset += written;
+					break;
+				}
+
+				written -= remaining;
+				segmentOffset = 0;
+				++segment;
+			}
+		}
+
+		return sf::Socket::Status::Done;
+	}
+
+#else
+
+	auto GatherBuffer::send(sf::TcpSocket& socket, std::size_t& sent) const -> sf::Socket::Status
+	{
+		auto buffer = flatten();
+		auto status = socket.send(buffer.data(), buffer.size(), sent);
+		BufferPool::get().release(std::move(buffer));
+		return status;
+	}
+
+#endif
+
+	auto GatherBuffer::consume(std::size_t length) -> void
+	{
+		if (length >= m_size)
+		{
+			clear();
+			return;
+		}
+
+		m_size -= length;
+		auto consumed = std::size_t(0);
+		while (length > 0)
+		{
+			auto& segment = m_segments[consumed];
+			if (length < segment.length)
+			{
+				segment.offset += length;
+				segment.length -= length;
+				break;
+			}
+
+			length -= segment.length;
+			++consumed;
+		}
+		m_segments.erase(m_segments.begin(), m_segments.begin() + static_cast<std::ptrdiff_t>(consumed));
+
+		// Copied bytes are only ever appended, so drop the ones already consumed once they're most of the storage, rather than letting a
+		// buffer which never quite empties grow forever
+		auto firstCopied = std::find_if(m_segments.begin(), m_segments.end(), [](const Segment& segment) {
+			return !segment.payload;
+		});
+		auto unused = firstCopied == m_segments.end() ? m_bytes.size() : firstCopied->offset;
+		if (unused > m_bytes.size() / 2)
+		{
+			m_bytes.erase(m_bytes.begin(), m_bytes.begin() + static_cast<std::ptrdiff_t>(unused));
+			for (auto& segment : m_segments)
+			{
+				if (!segment.payload)
+				{
+					segment.offset -= unused;
+				}
+			}
+		}
+	}
+
+	auto GatherBuffer::clear() -> void
+	{
+		m_bytes.clear();
+		m_segments.clear();
+		m_size = 0;
+	}
+
+} // namespace Common::Network
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "Common/Network/HeaderCodec.hpp"
+#include "Common/Network/BitStream.hpp"
+#include <algorithm>
+
+namespace Common::Network
+{
+	// The channel occupies the low bits of the varint holding the message type, followed by the flags from COMPRESSED_HEADER_VERSION
+	const std::uint64_t CHANNEL_BITS = 2;
+	const std::uint64_t CHANNEL_MASK = (1 << CHANNEL_BITS) - 1;
+	const std::uint64_t FLAG_BITS    = 1;
+	const std::uint64_t FLAG_MASK    = (1 << FLAG_BITS) - 1;
+
+	// No varint this codec writes is longer than a 64-bit value needs
+	const std::size_t MAX_VARINT_LENGTH = 10;
+
+	auto writeVarint(std::vector<std::uint8_t>& buffer, std::uint64_t value) -> void
+	{
+		while (value >= 0x80)
+		{
+			buffer.emplace_back(static_cast<std::uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		buffer.emplace_back(static_cast<std::uint8_t>(value));
+	}
+
+	auto readVarint(const std::uint8_t* data, const std::size_t length, std::size_t& offset) -> std::optional<std::uint64_t>
+	{
+		auto value = std::uint64_t(0);
+		for (auto i = std::size_t(0); i < MAX_VARINT_LENGTH && offset < length; ++i)
+		{
+			auto byte = data[offset++];
+			value |= static_cast<std::uint64_t>(byte & 0x7F) << (7 * i);
+			if ((byte & 0x80) == 0)
+			{
+				return value;
+			}
+		}
+		return {};
+	}
+
+	/**
+	 * \brief Get the channel a protocol is sent on over the UDP socket
+	 */
+	auto getChannel(const Protocol protocol) -> std::uint64_t
+	{
+		switch (protocol)
+		{
+			case Protocol::ReliableOrdered:
+				return 1;
+			case Protocol::ReliableUnordered:
+				return 2;
+			case Protocol::UnreliableSequenced:
+				return 3;
+			default:
+				return 0;
+		}
+	}
+
+	auto getChannelProtocol(const std::uint64_t channel) -> Protocol
+	{
+		switch (channel)
+		{
+			case 1:
+				return Protocol::ReliableOrdered;
+			case 2:
+				return Protocol::ReliableUnordered;
+			case 3:
+				return Protocol::UnreliableSequenced;
+			default:
+				return Protocol::UDP;
+		}
+	}
+
+	auto HeaderCodec::setEncodingVersion(const std::uint8_t version) -> void
+	{
+		m_encodingVersion             = version;
+		m_lastEncodedStreamIdentifier = 0;
+	}
+
+	auto HeaderCodec::setDecodingVersion(const std::uint8_t version) -> void
+	{
+		m_decodingVersion             = version;
+		m_lastDecodedStreamIdentifier = 0;
+	}
+
+	auto HeaderCodec::getEncodingVersion() const -> std::uint8_t
+	{
+		return m_encodingVersion;
+	}
+
+	auto HeaderCodec::getDecodingVersion() const -> std::uint8_t
+	{
+		return m_decodingVersion;
+	}
+
+	auto HeaderCodec::reset() -> void
+	{
+		setEncodingVersion(COMPACT_HEADER_VERSION);
+		setDecodingVersion(COMPACT_HEADER_VERSION);
+		m_lastDecodedIdentifier = 0;
+	}
+
+	auto HeaderCodec::encode(const MessageHeader& header, std::vector<std::uint8_t>& buffer) -> void
+	{
+		auto typeAndChannel = static_cast<std::uint64_t>(header.type);
+		if (m_encodingVersion >= COMPRESSED_HEADER_VERSION)
+		{
+			typeAndChannel = (typeAndChannel << FLAG_BITS) | (header.flags & FLAG_MASK);
+		}
+
+		buffer.emplace_back(m_encodingVersion);
+		writeVarint(buffer, (typeAndChannel << CHANNEL_BITS) | getChannel(header.protocol));
+
+		// Adding one lets the null entity, which every message from a client without an ID carries, fit in a single byte
+		writeVarint(buffer, static_cast<std::uint32_t>(static_cast<std::uint32_t>(header.entityID) + 1));
+
+		if (header.protocol == Protocol::TCP)
+		{
+			auto difference = static_cast<std::int64_t>(header.identifier - m_lastEncodedStreamIdentifier);
+			writeVarint(buffer, zigzagEncode(difference));
+			m_lastEncodedStreamIdentifier = header.identifier;
+		}
+		else if (isSequenced(header.protocol))
+		{
+			writeVarint(buffer, header.sequence);
+		}
+		else
+		{
+			buffer.emplace_back(static_cast<std::uint8_t>(header.identifier));
+			buffer.emplace_back(static_cast<std::uint8_t>(header.identifier >> 8));
+		}
+	}
+
+	auto HeaderCodec::decode(const std::uint8_t* data, const std::size_t length, const Protocol transport, MessageHeader& header) -> std::optional<std::size_t>
+	{
+		auto offset = std::size_t(0);
+		if (length < 1 || data[offset++] != m_decodingVersion)
+		{
+			return {};
+		}
+
+		auto typeAndChannel = readVarint(data, length, offset);
+		auto entityID       = readVarint(data, length, offset);
+		if (!typeAndChannel.has_value() || !entityID.has_value())
+		{
+			return {};
+		}
+
+		auto typeAndFlags = *typeAndChannel >> CHANNEL_BITS;
+		header            = MessageHeader();
+		if (m_decodingVersion >= COMPRESSED_HEADER_VERSION)
+		{
+			header.flags = static_cast<std::uint8_t>(typeAndFlags & FLAG_MASK);
+			typeAndFlags >>= FLAG_BITS;
+		}
+
+		header.type     = static_cast<MessageType>(typeAndFlags);
+		header.protocol = transport == Protocol::TCP ? Protocol::TCP : getChannelProtocol(*typeAndChannel & CHANNEL_MASK);
+		header.entityID = static_cast<entt::entity>(static_cast<std::uint32_t>(*entityID - 1));
+
+		if (header.protocol == Protocol::TCP)
+		{
+			auto difference = readVarint(data, length, offset);
+			if (!difference.has_value())
+			{
+				return {};
+			}
+
+			header.identifier             = m_lastDecodedStreamIdentifier + static_cast<std::uint64_t>(zigzagDecode(*difference));
+			m_lastDecodedStreamIdentifier = header.identifier;
+		}
+		else if (isSequenced(header.protocol))
+		{
+			auto sequence = readVarint(data, length, offset);
+			if (!sequence.has_value())
+			{
+				return {};
+			}
+
+			header.sequence = static_cast<std::uint16_t>(*sequence);
+		}
+		else
+		{
+			if (offset + 2 > length)
+			{
+				return {};
+			}
+
+			// Pick the identifier with these low bits which is closest to the newest one received
+			auto lowBits   = static_cast<std::uint64_t>(data[offset]) | (static_cast<std::uint64_t>(data[offset + 1]) << 8);
+			auto candidate = (m_lastDecodedIdentifier & ~std::uint64_t(0xFFFF)) | lowBits;
+			if (candidate + 0x8000 < m_lastDecodedIdentifier)
+			{
+				candidate += 0x10000;
+			}
+			else if (candidate > m_lastDecodedIdentifier + 0x8000 && candidate >= 0x10000)
+			{
+				candidate -= 0x10000;
+			}
+			offset += 2;
+
+			header.identifier = candidate;
+		}
+
+		m_lastDecodedIdentifier = std::max(m_lastDecodedIdentifier, header.identifier);
+		return offset;
+	}
+
+} // namespace Common::Network
\ No newline at end of file
@@ -1,36 +1,84 @@
 #include "Common/Network/Message.hpp"
+#include "Common/Network/BufferPool.hpp"
 #include "Common/Network/MessageHeader.hpp"
 
 namespace Common::Network
 {
 
-	auto Message::pack() const -> std::vector<std::uint8_t>
+	auto Message::makeSharedPayload(const MessageData& data) -> SharedPayload
 	{
-		auto buffer = std::vector<std::uint8_t>();
-		buffer.resize(data.size() + sizeof(Common::Network::MessageHeader));
+		const auto* bytes = static_cast<const std::uint8_t*>(data.data());
 
-		std::memcpy(buffer.data(), &header, sizeof(MessageHeader));
-		std::memcpy(buffer.data() + sizeof(MessageHeader), data.data(), data.size());
+		auto payload = BufferPool::get().acquire(data.size());
+		payload.assign(bytes, bytes + data.size());
+		return makeSharedPayload(std::move(payload));
+	}
+
+	auto Message::makeSharedPayload(std::vector<std::uint8_t>&& bytes) -> SharedPayload
+	{
+		// The bytes go back to the pool once the last message sharing them has been sent
+		auto* payload = new std::vector<std::uint8_t>(std::move(bytes));
+		return SharedPayload(payload, [](const std::vector<std::uint8_t>* released) {
+			auto* buffer = const_cast<std::vector<std::uint8_t>*>(released);
+			BufferPool::get().release(std::move(*buffer));
+			delete buffer;
+		});
+	}
+
+	auto Message::getPayloadData() const -> const std::uint8_t*
+	{
+		if (sharedPayload)
+		{
+			return sharedPayload->data();
+		}
+		return static_cast<const std::uint8_t*>(data.data());
+	}
+
+	auto Message::getPayloadSize() const -> std::size_t
+	{
+		return sharedPayload ? sharedPayload->size() : data.size();
+	}
+
+	auto Message::packHeader(HeaderCodec& codec) const -> std::vector<std::uint8_t>
+	{
+		auto buffer = BufferPool::get().acquire(sizeof(MessageHeader));
+		codec.encode(header, buffer);
+		return buffer;
+	}
+
+	auto Message::pack(HeaderCodec& codec) const -> std::vector<std::uint8_t>
+	{
+		auto buffer = BufferPool::get().acquire(getPayloadSize() + sizeof(MessageHeader));
+
+		codec.encode(header, buffer);
+		buffer.insert(buffer.end(), getPayloadData(), getPayloadData() + getPayloadSize());
 
 		return buffer;
 	}
 
-	auto Message::unpack(std::vector<std::uint8_t>& buffer) -> void
+	auto Message::unpack(const std::vector<std::uint8_t>& buffer, HeaderCodec& codec, const Protocol transport) -> bool
 	{
-		auto dataLength = buffer.size() - sizeof(MessageHeader);
-		data.resize(dataLength);
+		auto headerLength = codec.decode(buffer.data(), buffer.size(), transport, header);
+		if (!headerLength.has_value())
+		{
+			return false;
+		}
 
-		std::memcpy(&header, buffer.data(), sizeof(MessageHeader));
-		std::memcpy(data.data(), buffer.data() + sizeof(MessageHeader), data.size());
+		data.resize(buffer.size() - *headerLength);
+		std::memcpy(data.data(), buffer.data() + *headerLength, data.size());
+		return true;
 	}
 
-	auto Message::unpack(std::array<std::uint8_t, MAX_MESSAGE_LENGTH>& buffer, const std::size_t length) -> void
+	auto Message::unpack(const ReceiveBuffer& buffer, const std::size_t offset, const std::size_t length, HeaderCodec& codec, const Protocol transport) -> bool
 	{
-		auto dataLength = length - sizeof(MessageHeader);
-		data.resize(dataLength);
+		auto headerLength = codec.decode(buffer.data() + offset, length, transport, header);
+		if (!headerLength.has_value())
+		{
+			return false;
+		}
 
-		std::memcpy(&header, buffer.data(), sizeof(MessageHeader));
-		std::memcpy(data.data(), buffer.data() + sizeof(MessageHeader), data.size());
+		data = MessageData(buffer, offset + *headerLength, length - *headerLength);
+		return true;
 	}
 
 } // namespace Common::Network
\ No newline at end of file
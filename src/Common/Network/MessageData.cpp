@@ -1,8 +1,11 @@
 #include "Common/Network/MessageData.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
 
 #define PACK_MULTIPLE(VALUE_T, VALUE)                                                          \
 	{                                                                                            \
-		m_data.reserve(m_data.size() + sizeof(VALUE_T));                                           \
+		reserve(sizeof(VALUE_T));                                                                  \
 		for (auto i = 0; i < sizeof(VALUE_T); ++i)                                                 \
 		{                                                                                          \
 			m_data.emplace_back(static_cast<std::uint8_t>((VALUE) >> sizeof(std::uint8_t) * i * 8)); \
@@ -16,7 +19,7 @@
 		auto packedValueCount = (sizeof(value_t) / sizeof(std::uint8_t));                               \
 		for (auto i = 0; i < packedValueCount; ++i)                                                     \
 		{                                                                                               \
-			(VALUE) |= static_cast<value_t>(m_data.at(m_readHead + i)) << (sizeof(std::uint8_t) * i * 8); \
+			(VALUE) |= static_cast<value_t>(at(m_readHead + i)) << (sizeof(std::uint8_t) * i * 8);       \
 		}                                                                                               \
 		m_readHead += packedValueCount;                                                                 \
 	}
@@ -27,14 +30,89 @@ namespace Common::Network
 	MessageData::MessageData() :
 	    m_readHead(0) {}
 
+	MessageData::MessageData(ReceiveBuffer buffer, const std::size_t offset, const std::size_t length) :
+	    m_readHead(0),
+	    m_buffer(std::move(buffer))
+	{
+		m_view = std::span<const std::uint8_t>(m_buffer.data() + offset, length);
+	}
+
+	MessageData::MessageData(std::vector<std::uint8_t>&& bytes) :
+	    m_data(std::move(bytes)),
+	    m_readHead(0)
+	{
+	}
+
+	MessageData::MessageData(const MessageData& other) :
+	    m_readHead(other.m_readHead),
+	    m_buffer(other.m_buffer),
+	    m_view(other.m_view)
+	{
+		if (!other.m_data.empty())
+		{
+			m_data = BufferPool::get().acquire(other.m_data.size());
+			m_data.assign(other.m_data.begin(), other.m_data.end());
+		}
+	}
+
+	MessageData::MessageData(MessageData&& other) noexcept :
+	    m_data(std::move(other.m_data)),
+	    m_readHead(other.m_readHead),
+	    m_buffer(std::move(other.m_buffer)),
+	    m_view(other.m_view)
+	{
+		other.m_view = {};
+	}
+
+	MessageData::~MessageData()
+	{
+		BufferPool::get().release(std::move(m_data));
+	}
+
+	auto MessageData::operator=(const MessageData& other) -> MessageData&
+	{
+		if (this != &other)
+		{
+			m_data.clear();
+			if (m_data.capacity() < other.m_data.size())
+			{
+				BufferPool::get().release(std::move(m_data));
+				m_data = BufferPool::get().acquire(other.m_data.size());
+			}
+			m_data.assign(other.m_data.begin(), other.m_data.end());
+
+			m_readHead = other.m_readHead;
+			m_buffer   = other.m_buffer;
+			m_view     = other.m_view;
+		}
+		return *this;
+	}
+
+	auto MessageData::operator=(MessageData&& other) noexcept -> MessageData&
+	{
+		if (this != &other)
+		{
+			BufferPool::get().release(std::move(m_data));
+			m_data = std::move(other.m_data);
+
+			m_readHead   = other.m_readHead;
+			m_buffer     = std::move(other.m_buffer);
+			m_view       = other.m_view;
+			other.m_view = {};
+		}
+		return *this;
+	}
+
 	auto MessageData::operator<<(const bool value) -> MessageData&
 	{
+		reserve(1);
 		m_data.emplace_back(static_cast<std::uint8_t>(value));
 		return *this;
 	}
 
 	auto MessageData::operator<<(const std::uint8_t value) -> MessageData&
 	{
+		reserve(1);
 		m_data.emplace_back(value);
 		return *this;
 	}
@@ -82,7 +160,7 @@ namespace Common::Network
 
 	auto MessageData::operator<<(const std::string& value) -> MessageData&
 	{
-		m_data.reserve(m_data.size() + value.size() + sizeof(std::uint16_t));
+		reserve(value.size() + sizeof(std::uint16_t));
 
 		auto length = std::uint16_t(value.size());
 		operator<<(length);
@@ -97,14 +175,14 @@ namespace Common::Network
 
 	auto MessageData::operator>>(bool& value) -> MessageData&
 	{
-		value = static_cast<bool>(m_data.at(m_readHead));
+		value = static_cast<bool>(at(m_readHead));
 		m_readHead += 1;
 		return *this;
 	}
 
 	auto MessageData::operator>>(std::uint8_t& value) -> MessageData&
 	{
-		value = m_data.at(m_readHead);
+		value = at(m_readHead);
 		m_readHead += 1;
 		return *this;
 	}
@@ -178,26 +256,79 @@ namespace Common::Network
 
 	auto MessageData::size() const -> std::size_t
 	{
-		return m_data.size();
+		return bytes().size();
+	}
+
+	auto MessageData::remaining() const -> std::size_t
+	{
+		return m_readHead < size() ? size() - m_readHead : 0;
 	}
 
 	auto MessageData::data() const -> const void*
 	{
-		return m_data.data();
+		return bytes().data();
 	}
 
 	auto MessageData::data() -> void*
 	{
+		materialise();
 		return m_data.data();
 	}
 
 	auto MessageData::resize(std::size_t newSize) -> void
 	{
+		reserve(newSize > size() ? newSize - size() : 0);
 		m_data.resize(newSize);
 	}
 
+	auto MessageData::isView() const -> bool
+	{
+		return static_cast<bool>(m_buffer);
+	}
+
+	auto MessageData::bytes() const -> std::span<const std::uint8_t>
+	{
+		return m_buffer ? m_view : std::span<const std::uint8_t>(m_data);
+	}
+
+	auto MessageData::at(const std::size_t index) const -> std::uint8_t
+	{
+		auto contained = bytes();
+		if (index >= contained.size())
+		{
+			throw std::out_of_range("Read past the end of the message data");
+		}
+		return contained[index];
+	}
+
+	auto MessageData::materialise() -> void
+	{
+		if (!m_buffer)
+		{
+			return;
+		}
+
+		if (m_data.capacity() < m_view.size())
+		{
+			BufferPool::get().release(std::exchange(m_data, BufferPool::get().acquire(m_view.size())));
+		}
+		m_data.assign(m_view.begin(), m_view.end());
+		m_view   = {};
+		m_buffer = ReceiveBuffer();
+	}
+
+	auto MessageData::reserve(const std::size_t additional) -> void
+	{
+		materialise();
+		if (m_data.size() + additional <= m_data.capacity())
+		{
+			return;
+		}
 
-} // namespace Common::Network
+		// Grow geometrically, so appending a byte at a time doesn't move between vectors on every write
+		auto grown = BufferPool::get().acquire(std::max(m_data.size() + additional, m_data.capacity() * 2));
+		grown.assign(m_data.begin(), m_data.end());
+		BufferPool::get().release(std::exchange(m_data, std::move(grown)));
+	}
 
-#undef PACK_MULTIPLE
-#undef UNPACK_MULTIPLE
\ No newline at end of file
+} // namespace Common::Network
\ No newline at end of file
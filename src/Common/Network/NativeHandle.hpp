@@ -0,0 +1,19 @@
+#pragma once
+
+#include <SFML/Network/Socket.hpp>
+
+namespace Common::Network
+{
+
+	/**
+	 * \brief Exposes the native handle of an SFML socket, which SFML only makes available to derived classes
+	 */
+	struct NativeHandleAccessor : sf::Socket
+	{
+		static auto get(const sf::Socket& socket) -> sf::SocketHandle
+		{
+			return (socket.*(&NativeHandleAccessor::getNativeHandle))();
+		}
+	};
+
+} // namespace Common::Network
\ No newline at end of file
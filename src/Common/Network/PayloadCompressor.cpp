@@ -0,0 +1,367 @@
+#include "Common/Network/PayloadCompressor.hpp"
+#include "Common/Network/BufferPool.hpp"
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <zdict.h>
+#include <zstd.h>
+
+namespace Common::Network
+{
+	const auto DICTIONARY_EXTENSION = std::string(".dict");
+
+	// zstd can't train a useful dictionary from fewer samples than this
+	const std::size_t MIN_TRAINING_SAMPLES = 16;
+
+	struct PayloadCompressor::Contexts
+	{
+		ZSTD_CCtx* compression   = ZSTD_createCCtx();
+		ZSTD_DCtx* decompression = ZSTD_createDCtx();
+
+		std::unordered_map<MessageType, std::vector<std::uint8_t>> dictionaries;
+		std::unordered_map<MessageType, ZSTD_DDict*> decompressionDictionaries;
+
+		// Compression dictionaries are built for a compression level, so they're built when they're first needed
+		std::unordered_map<MessageType, ZSTD_CDict*> compressionDictionaries;
+
+		~Contexts()
+		{
+			for (auto& [type, dictionary] : compressionDictionaries)
+			{
+				ZSTD_freeCDict(dictionary);
+			}
+			for (auto& [type, dictionary] : decompressionDictionaries)
+			{
+				ZSTD_freeDDict(dictionary);
+			}
+			ZSTD_freeCCtx(compression);
+			ZSTD_freeDCtx(decompression);
+		}
+
+		auto forgetCompressionDictionary(const MessageType type) -> void
+		{
+			auto iterator = compressionDictionaries.find(type);
+			if (iterator != compressionDictionaries.end())
+			{
+				ZSTD_freeCDict(iterator->second);
+				compressionDictionaries.erase(iterator);
+			}
+		}
+
+		auto getCompressionDictionary(const MessageType type, const int level) -> ZSTD_CDict*
+		{
+			auto iterator = compressionDictionaries.find(type);
+			if (iterator != compressionDictionaries.end())
+			{
+				return iterator->second;
+			}
+
+			auto dictionary = dictionaries.find(type);
+			if (dictionary == dictionaries.end())
+			{
+				return nullptr;
+			}
+
+			auto* compressionDictionary = ZSTD_createCDict(dictionary->second.data(), dictionary->second.size(), level);
+			compressionDictionaries.emplace(type, compressionDictionary);
+			return compressionDictionary;
+		}
+	};
+
+	auto elapsedNanoseconds(const std::chrono::steady_clock::time_point start) -> std::uint64_t
+	{
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	PayloadCompressor::PayloadCompressor() :
+	    m_contexts(std::make_unique<Contexts>())
+	{
+	}
+
+	PayloadCompressor::~PayloadCompressor() = default;
+
+	auto PayloadCompressor::setPolicy(const MessageType type, const CompressionPolicy& policy) -> void
+	{
+		m_policies[type] = policy;
+		m_contexts->forgetCompressionDictionary(type);
+	}
+
+	auto PayloadCompressor::useDefaultPolicies() -> void
+	{
+		// Entities are created one at a time, so their payloads are short and only really shrink with a dictionary
+		setPolicy(MessageType::Server_CreateEntity, CompressionPolicy{64});
+		setPolicy(MessageType::Server_WorldState, CompressionPolicy{256});
+	}
+
+	auto PayloadCompressor::setDictionary(const MessageType type, const std::span<const std::uint8_t> dictionary) -> bool
+	{
+		auto* decompressionDictionary = ZSTD_createDDict(dictionary.data(), dictionary.size());
+		if (decompressionDictionary == nullptr)
+		{
+			return false;
+		}
+
+		auto iterator = m_contexts->decompressionDictionaries.find(type);
+		if (iterator != m_contexts->decompressionDictionaries.end())
+		{
+			ZSTD_freeDDict(iterator->second);
+		}
+
+		m_contexts->decompressionDictionaries[type] = decompressionDictionary;
+		m_contexts->dictionaries[type].assign(dictionary.begin(), dictionary.end());
+		m_contexts->forgetCompressionDictionary(type);
+		return true;
+	}
+
+	auto PayloadCompressor::loadDictionaries(const std::filesystem::path& directory) -> std::size_t
+	{
+		auto error = std::error_code();
+		if (!std::filesystem::is_directory(directory, error))
+		{
+			return 0;
+		}
+
+		auto loaded = std::size_t(0);
+		for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+		{
+			if (!entry.is_regular_file() || entry.path().extension() != DICTIONARY_EXTENSION)
+			{
+				continue;
+			}
+
+			// Dictionaries are named after the number of the message type they're for
+			auto type = MessageType_t(0);
+			try
+			{
+				type = static_cast<MessageType_t>(std::stoul(entry.path().stem().string()));
+			}
+			catch (const std::exception&)
+			{
+				spdlog::warn("Ignoring dictionary {} as it isn't named after a message type", entry.path().string());
+				continue;
+			}
+
+			auto reader     = std::ifstream(entry.path(), std::ios::in | std::ios::binary);
+			auto dictionary = std::vector<std::uint8_t>(std::istreambuf_iterator<char>(reader), std::istreambuf_iterator<char>());
+			if (!setDictionary(static_cast<MessageType>(type), dictionary))
+			{
+				spdlog::warn("Ignoring dictionary {} as it isn't valid", entry.path().string());
+				continue;
+			}
+
+			++loaded;
+		}
+
+		return loaded;
+	}
+
+	auto PayloadCompressor::compress(Message& message) -> void
+	{
+		auto policy = m_policies.find(message.header.type);
+		if (policy == m_policies.end() || (message.header.flags & MESSAGE_FLAG_COMPRESSED) != 0 || message.getPayloadSize() < policy->second.threshold)
+		{
+			return;
+		}
+
+		if (message.sharedPayload)
+		{
+			if (message.sharedPayload != m_lastSharedPayload)
+			{
+				capture(message.header.type, message.getPayloadData(), message.getPayloadSize());
+
+				auto compressed         = compressBytes(message.header.type, policy->second, message.getPayloadData(), message.getPayloadSize());
+				m_lastSharedPayload     = message.sharedPayload;
+				m_lastCompressedPayload = compressed.empty() ? nullptr : Message::makeSharedPayload(std::move(compressed));
+			}
+
+			if (m_lastCompressedPayload)
+			{
+				message.sharedPayload = m_lastCompressedPayload;
+				message.header.flags |= MESSAGE_FLAG_COMPRESSED;
+			}
+			return;
+		}
+
+		capture(message.header.type, message.getPayloadData(), message.getPayloadSize());
+
+		auto compressed = compressBytes(message.header.type, policy->second, message.getPayloadData(), message.getPayloadSize());
+		if (!compressed.empty())
+		{
+			message.data = MessageData(std::move(compressed));
+			message.header.flags |= MESSAGE_FLAG_COMPRESSED;
+		}
+	}
+
+	auto PayloadCompressor::decompress(Message& message) -> bool
+	{
+		if ((message.header.flags & MESSAGE_FLAG_COMPRESSED) == 0)
+		{
+			return true;
+		}
+		message.header.flags &= ~MESSAGE_FLAG_COMPRESSED;
+
+		const auto* data = static_cast<const std::uint8_t*>(message.data.data());
+		auto length      = message.data.size();
+
+		// The decompressed length is checked before anything is allocated, so a small message can't claim to be a huge one
+		auto contentSize = ZSTD_getFrameContentSize(data, length);
+		if (contentSize == ZSTD_CONTENTSIZE_ERROR || contentSize == ZSTD_CONTENTSIZE_UNKNOWN || contentSize > MAX_MESSAGE_LENGTH)
+		{
+			return false;
+		}
+
+		auto start        = std::chrono::steady_clock::now();
+		auto decompressed = BufferPool::get().acquire(contentSize);
+		decompressed.resize(contentSize);
+
+		auto dictionary = m_contexts->decompressionDictionaries.find(message.header.type);
+		auto result     = dictionary == m_contexts->decompressionDictionaries.end()
+		                    ? ZSTD_decompressDCtx(m_contexts->decompression, decompressed.data(), decompressed.size(), data, length)
+		                    : ZSTD_decompress_usingDDict(m_contexts->decompression, decompressed.data(), decompressed.size(), data, length, dictionary->second);
+		if (ZSTD_isError(result) || result != contentSize)
+		{
+			spdlog::debug("Couldn't decompress a message of type {}: {}", static_cast<MessageType_t>(message.header.type), ZSTD_isError(result) ? ZSTD_getErrorName(result) : "wrong length");
+			BufferPool::get().release(std::move(decompressed));
+			return false;
+		}
+
+		message.data = MessageData(std::move(decompressed));
+
+		auto& statistics = getTypeStatistics(message.header.type);
+		statistics.decompressed += 1;
+		statistics.decompressedBytes += contentSize;
+		statistics.decompressNanoseconds += elapsedNanoseconds(start);
+		return true;
+	}
+
+	auto PayloadCompressor::setCaptureLimit(const std::size_t samplesPerType) -> void
+	{
+		auto lock      = std::scoped_lock(m_captureMutex);
+		m_captureLimit = samplesPerType;
+	}
+
+	auto PayloadCompressor::saveDictionaries(const std::filesystem::path& directory, const std::size_t capacity) -> std::size_t
+	{
+		auto lock = std::scoped_lock(m_captureMutex);
+
+		auto error = std::error_code();
+		std::filesystem::create_directories(directory, error);
+
+		auto saved = std::size_t(0);
+		for (const auto& [type, samples] : m_samples)
+		{
+			if (samples.size() < MIN_TRAINING_SAMPLES)
+			{
+				spdlog::info("Not training a dictionary for message type {} from only {} samples", static_cast<MessageType_t>(type), samples.size());
+				continue;
+			}
+
+			// zstd trains from the samples laid end to end
+			auto sampleBytes   = std::vector<std::uint8_t>();
+			auto sampleLengths = std::vector<std::size_t>();
+			for (const auto& sample : samples)
+			{
+				sampleBytes.insert(sampleBytes.end(), sample.begin(), sample.end());
+				sampleLengths.emplace_back(sample.size());
+			}
+
+			auto dictionary = std::vector<std::uint8_t>(capacity);
+			auto length     = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), sampleBytes.data(), sampleLengths.data(), static_cast<unsigned>(sampleLengths.size()));
+			if (ZDICT_isError(length))
+			{
+				spdlog::warn("Couldn't train a dictionary for message type {}: {}", static_cast<MessageType_t>(type), ZDICT_getErrorName(length));
+				continue;
+			}
+
+			auto path   = directory / (std::to_string(static_cast<MessageType_t>(type)) + DICTIONARY_EXTENSION);
+			auto writer = std::ofstream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+			writer.write(reinterpret_cast<const char*>(dictionary.data()), static_cast<std::streamsize>(length));
+			if (!writer)
+			{
+				spdlog::warn("Couldn't write the dictionary for message type {} to {}", static_cast<MessageType_t>(type), path.string());
+				continue;
+			}
+
+			spdlog::info("Trained a {} byte dictionary for message type {} from {} samples", length, static_cast<MessageType_t>(type), samples.size());
+			++saved;
+		}
+
+		return saved;
+	}
+
+	auto PayloadCompressor::getStatistics() const -> std::unordered_map<MessageType, CompressionStatistics>
+	{
+		auto lock       = std::scoped_lock(m_statisticsMutex);
+		auto statistics = std::unordered_map<MessageType, CompressionStatistics>();
+		for (const auto& [type, typeStatistics] : m_statistics)
+		{
+			auto& copy                 = statistics[type];
+			copy.attempted             = typeStatistics->attempted.load();
+			copy.compressed            = typeStatistics->compressed.load();
+			copy.bytesIn               = typeStatistics->bytesIn.load();
+			copy.bytesOut              = typeStatistics->bytesOut.load();
+			copy.compressNanoseconds   = typeStatistics->compressNanoseconds.load();
+			copy.decompressed          = typeStatistics->decompressed.load();
+			copy.decompressedBytes     = typeStatistics->decompressedBytes.load();
+			copy.decompressNanoseconds = typeStatistics->decompressNanoseconds.load();
+		}
+		return statistics;
+	}
+
+	auto PayloadCompressor::compressBytes(const MessageType type, const CompressionPolicy& policy, const std::uint8_t* data, const std::size_t length) -> std::vector<std::uint8_t>
+	{
+		auto start      = std::chrono::steady_clock::now();
+		auto compressed = BufferPool::get().acquire(ZSTD_compressBound(length));
+		compressed.resize(ZSTD_compressBound(length));
+
+		auto* dictionary = m_contexts->getCompressionDictionary(type, policy.level);
+		auto result      = dictionary == nullptr
+		                     ? ZSTD_compressCCtx(m_contexts->compression, compressed.data(), compressed.size(), data, length, policy.level)
+		                     : ZSTD_compress_usingCDict(m_contexts->compression, compressed.data(), compressed.size(), data, length, dictionary);
+
+		auto& statistics = getTypeStatistics(type);
+		statistics.attempted += 1;
+		statistics.compressNanoseconds += elapsedNanoseconds(start);
+
+		if (ZSTD_isError(result) || result >= length)
+		{
+			BufferPool::get().release(std::move(compressed));
+			return {};
+		}
+
+		compressed.resize(result);
+		statistics.compressed += 1;
+		statistics.bytesIn += length;
+		statistics.bytesOut += result;
+		return compressed;
+	}
+
+	auto PayloadCompressor::capture(const MessageType type, const std::uint8_t* data, const std::size_t length) -> void
+	{
+		auto lock = std::scoped_lock(m_captureMutex);
+		if (m_captureLimit == 0)
+		{
+			return;
+		}
+
+		auto& samples = m_samples[type];
+		if (samples.size() < m_captureLimit)
+		{
+			samples.emplace_back(data, data + length);
+		}
+	}
+
+	auto PayloadCompressor::getTypeStatistics(const MessageType type) -> TypeStatistics&
+	{
+		auto lock      = std::scoped_lock(m_statisticsMutex);
+		auto& selected = m_statistics[type];
+		if (!selected)
+		{
+			selected = std::make_unique<TypeStatistics>();
+		}
+		return *selected;
+	}
+
+} // namespace Common::Network
\ No newline at end of file
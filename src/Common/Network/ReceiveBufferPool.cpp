@@ -0,0 +1,176 @@
+#include "Common/Network/ReceiveBufferPool.hpp"
+#include <utility>
+
+namespace Common::Network
+{
+
+	struct ReceiveBuffer::Block
+	{
+		std::atomic<std::uint32_t> references = 1;
+		std::vector<std::uint8_t> bytes;
+		std::size_t length = 0;
+
+		// Held only while the block is handed out, so the pool can be destroyed first. Oversized blocks have none, as they're freed
+		std::shared_ptr<ReceiveBufferPool::State> pool;
+	};
+
+	ReceiveBuffer::ReceiveBuffer(Block* block) :
+	    m_block(block)
+	{
+	}
+
+	ReceiveBuffer::ReceiveBuffer(const ReceiveBuffer& other) :
+	    m_block(other.m_block)
+	{
+		if (m_block != nullptr)
+		{
+			m_block->references.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	ReceiveBuffer::ReceiveBuffer(ReceiveBuffer&& other) noexcept :
+	    m_block(other.m_block)
+	{
+		other.m_block = nullptr;
+	}
+
+	ReceiveBuffer::~ReceiveBuffer()
+	{
+		release();
+	}
+
+	auto ReceiveBuffer::operator=(const ReceiveBuffer& other) -> ReceiveBuffer&
+	{
+		if (this != &other)
+		{
+			release();
+			m_block = other.m_block;
+			if (m_block != nullptr)
+			{
+				m_block->references.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+		return *this;
+	}
+
+	auto ReceiveBuffer::operator=(ReceiveBuffer&& other) noexcept -> ReceiveBuffer&
+	{
+		if (this != &other)
+		{
+			release();
+			m_block       = other.m_block;
+			other.m_block = nullptr;
+		}
+		return *this;
+	}
+
+	auto ReceiveBuffer::data() -> std::uint8_t*
+	{
+		return m_block->bytes.data();
+	}
+
+	auto ReceiveBuffer::data() const -> const std::uint8_t*
+	{
+		return m_block->bytes.data();
+	}
+
+	auto ReceiveBuffer::size() const -> std::size_t
+	{
+		return m_block == nullptr ? 0 : m_block->length;
+	}
+
+	ReceiveBuffer::operator bool() const
+	{
+		return m_block != nullptr;
+	}
+
+	auto ReceiveBuffer::release() -> void
+	{
+		if (m_block == nullptr)
+		{
+			return;
+		}
+
+		auto* block = std::exchange(m_block, nullptr);
+		if (block->references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		{
+			return;
+		}
+
+		if (!block->pool)
+		{
+			delete block;
+			return;
+		}
+
+		// The pool is kept alive until the lock has been released
+		auto pool = std::move(block->pool);
+		auto lock = std::scoped_lock(pool->mutex);
+		pool->available.emplace_back(block);
+	}
+
+	ReceiveBufferPool::State::~State()
+	{
+		for (auto* block : available)
+		{
+			delete block;
+		}
+	}
+
+	ReceiveBufferPool::ReceiveBufferPool(const std::size_t bufferCapacity) :
+	    m_state(std::make_shared<State>())
+	{
+		m_state->bufferCapacity = bufferCapacity;
+	}
+
+	auto ReceiveBufferPool::acquire(const std::size_t length) -> ReceiveBuffer
+	{
+		if (length > m_state->bufferCapacity)
+		{
+			auto* block = new ReceiveBuffer::Block();
+			block->bytes.resize(length);
+			block->length = length;
+			++m_state->oversizedCount;
+			return ReceiveBuffer(block);
+		}
+
+		auto* block = static_cast<ReceiveBuffer::Block*>(nullptr);
+		{
+			auto lock = std::scoped_lock(m_state->mutex);
+			if (!m_state->available.empty())
+			{
+				block = m_state->available.back();
+				m_state->available.pop_back();
+			}
+		}
+
+		if (block == nullptr)
+		{
+			block = new ReceiveBuffer::Block();
+			block->bytes.resize(m_state->bufferCapacity);
+			++m_state->allocatedCount;
+		}
+
+		block->pool = m_state;
+		block->references.store(1, std::memory_order_relaxed);
+		block->length = length;
+		return ReceiveBuffer(block);
+	}
+
+	auto ReceiveBufferPool::getAllocatedCount() const -> std::uint64_t
+	{
+		return m_state->allocatedCount.load();
+	}
+
+	auto ReceiveBufferPool::getAvailableCount() const -> std::size_t
+	{
+		auto lock = std::scoped_lock(m_state->mutex);
+		return m_state->available.size();
+	}
+
+	auto ReceiveBufferPool::getOversizedCount() const -> std::uint64_t
+	{
+		return m_state->oversizedCount.load();
+	}
+
+} // namespace Common::Network
\ No newline at end of file
@@ -0,0 +1,350 @@
+#include "Common/Network/ReliableEndpoint.hpp"
+#include "Common/Network/BufferPool.hpp"
+#include "Common/Network/FrameAssembler.hpp"
+#include <algorithm>
+
+namespace Common::Network
+{
+
+	/**
+	 * \brief Get the index of a protocol's sequence counter, for the protocols that have one
+	 */
+	auto getChannelIndex(const Protocol protocol) -> std::size_t
+	{
+		switch (protocol)
+		{
+			case Protocol::ReliableOrdered:
+				return 0;
+			case Protocol::ReliableUnordered:
+				return 1;
+			default:
+				return 2;
+		}
+	}
+
+	auto writePacketHeader(GatherBuffer& buffer, const PacketHeader& header) -> void
+	{
+		auto bytes = std::array<std::uint8_t, PacketHeader::LENGTH>();
+		for (auto i = std::size_t(0); i < 2; ++i)
+		{
+			bytes[i]     = static_cast<std::uint8_t>(header.sequence >> (i * 8));
+			bytes[2 + i] = static_cast<std::uint8_t>(header.ack >> (i * 8));
+		}
+		for (auto i = std::size_t(0); i < 4; ++i)
+		{
+			bytes[4 + i] = static_cast<std::uint8_t>(header.ackBits >> (i * 8));
+		}
+		buffer.append(bytes.data(), bytes.size());
+	}
+
+	auto readPacketHeader(const std::uint8_t* data) -> PacketHeader
+	{
+		auto header = PacketHeader();
+		for (auto i = std::size_t(0); i < 2; ++i)
+		{
+			header.sequence |= static_cast<std::uint16_t>(data[i] << (i * 8));
+			header.ack |= static_cast<std::uint16_t>(data[2 + i] << (i * 8));
+		}
+		for (auto i = std::size_t(0); i < 4; ++i)
+		{
+			header.ackBits |= static_cast<std::uint32_t>(data[4 + i]) << (i * 8);
+		}
+		return header;
+	}
+
+	ReliableEndpoint::ReliableEndpoint(const std::size_t maxDatagramLength) :
+	    m_maxDatagramLength(maxDatagramLength),
+	    m_sentPackets(SENT_PACKET_WINDOW),
+	    m_unorderedReceived(RECEIVE_WINDOW)
+	{
+	}
+
+	auto ReliableEndpoint::stampHeader(MessageHeader& header) -> void
+	{
+		if (isSequenced(header.protocol))
+		{
+			header.sequence = m_nextChannelSequence[getChannelIndex(header.protocol)]++;
+		}
+	}
+
+	auto ReliableEndpoint::send(const Protocol protocol, std::vector<std::uint8_t>&& packed, const SharedPayload& payload) -> void
+	{
+		appendFrame(packed, payload);
+
+		if (isReliable(protocol))
+		{
+			auto reliableID = m_nextReliableID++;
+			m_currentReliableMessages.emplace_back(reliableID);
+			m_pendingReliable.emplace(reliableID, PendingReliable{std::move(packed), payload, m_clock.getElapsedTime()});
+			return;
+		}
+
+		// Unreliable messages are copied into the datagram, so they're done with straight away
+		BufferPool::get().release(std::move(packed));
+	}
+
+	auto ReliableEndpoint::flush() -> std::vector<GatherBuffer>
+	{
+		auto now     = m_clock.getElapsedTime();
+		auto timeout = getRetransmissionTimeout();
+
+		for (auto& [reliableID, pending] : m_pendingReliable)
+		{
+			if (now - pending.lastSendTime < timeout)
+			{
+				continue;
+			}
+
+			appendFrame(pending.packed, pending.payload);
+			m_currentReliableMessages.emplace_back(reliableID);
+			pending.lastSendTime = now;
+			++m_resentCount;
+		}
+
+		if (m_currentDatagram.empty() && m_isAckPending)
+		{
+			openDatagram();
+		}
+		if (!m_currentDatagram.empty())
+		{
+			closeDatagram();
+		}
+
+		auto datagrams = std::move(m_readyDatagrams);
+		m_readyDatagrams.clear();
+		return datagrams;
+	}
+
+	auto ReliableEndpoint::appendFrame(const std::vector<std::uint8_t>& packed, const SharedPayload& payload) -> void
+	{
+		auto frameLength = FrameAssembler::PREFIX_LENGTH + packed.size() + (payload ? payload->size() : 0);
+		if (!m_currentDatagram.empty() && m_currentDatagram.size() + frameLength > m_maxDatagramLength)
+		{
+			closeDatagram();
+		}
+		if (m_currentDatagram.empty())
+		{
+			openDatagram();
+		}
+
+		auto prefix = FrameAssembler::makePrefix(packed.size() + (payload ? payload->size() : 0));
+		m_currentDatagram.append(prefix.data(), prefix.size());
+		m_currentDatagram.append(packed.data(), packed.size());
+		m_currentDatagram.append(payload);
+	}
+
+	auto ReliableEndpoint::openDatagram() -> void
+	{
+		auto header     = PacketHeader();
+		header.sequence = m_nextPacketSequence;
+		header.ack      = m_remoteSequence;
+		header.ackBits  = m_receivedBits;
+		writePacketHeader(m_currentDatagram, header);
+
+		m_isAckPending = false;
+	}
+
+	auto ReliableEndpoint::closeDatagram() -> void
+	{
+		// Remember which reliable messages went out in this datagram, so they can be released when it's acknowledged
+		auto& sentPacket            = m_sentPackets[m_nextPacketSequence % SENT_PACKET_WINDOW];
+		sentPacket.sequence         = m_nextPacketSequence;
+		sentPacket.isValid          = true;
+		sentPacket.sendTime         = m_clock.getElapsedTime();
+		sentPacket.reliableMessages = std::move(m_currentReliableMessages);
+		m_currentReliableMessages.clear();
+
+		m_readyDatagrams.emplace_back(std::move(m_currentDatagram));
+		m_currentDatagram.clear();
+		++m_nextPacketSequence;
+	}
+
+	auto ReliableEndpoint::receivePacket(const std::uint8_t* data, const std::size_t length) -> std::optional<std::size_t>
+	{
+		if (length < PacketHeader::LENGTH)
+		{
+			return {};
+		}
+
+		auto header = readPacketHeader(data);
+
+		// Record the datagram so it's acknowledged in the next one we send, and drop it if it's a duplicate
+		if (!m_hasReceivedPacket || isSequenceNewer(header.sequence, m_remoteSequence))
+		{
+			auto distance = static_cast<std::uint16_t>(header.sequence - m_remoteSequence);
+			if (!m_hasReceivedPacket)
+			{
+				m_receivedBits = 0;
+			}
+			else if (distance > 32)
+			{
+				m_receivedBits = 0;
+			}
+			else
+			{
+				// The previous latest datagram becomes bit (distance - 1)
+				m_receivedBits = (distance == 32 ? 0 : m_receivedBits << distance) | (1u << (distance - 1));
+			}
+			m_remoteSequence    = header.sequence;
+			m_hasReceivedPacket = true;
+		}
+		else
+		{
+			// Drop duplicates, and datagrams too old to be acknowledged any more
+			auto distance = static_cast<std::uint16_t>(m_remoteSequence - header.sequence);
+			if (distance == 0 || distance > 32 || (m_receivedBits & (1u << (distance - 1))) != 0)
+			{
+				return {};
+			}
+			m_receivedBits |= 1u << (distance - 1);
+		}
+
+		// Datagrams carrying only acknowledgements aren't acknowledged themselves, otherwise the two sides would never stop
+		if (length > PacketHeader::LENGTH)
+		{
+			m_isAckPending = true;
+		}
+
+		// Apply the peer's acknowledgements
+		auto now = m_clock.getElapsedTime();
+		acknowledge(header.ack, now, true);
+		for (auto i = std::uint16_t(0); i < 32; ++i)
+		{
+			if ((header.ackBits & (1u << i)) != 0)
+			{
+				acknowledge(static_cast<std::uint16_t>(header.ack - 1 - i), now, false);
+			}
+		}
+
+		return {PacketHeader::LENGTH};
+	}
+
+	auto ReliableEndpoint::acknowledge(const std::uint16_t sequence, const sf::Time now, const bool isLatest) -> void
+	{
+		auto& sentPacket = m_sentPackets[sequence % SENT_PACKET_WINDOW];
+		if (!sentPacket.isValid || sentPacket.sequence != sequence)
+		{
+			return;
+		}
+		sentPacket.isValid = false;
+
+		for (const auto reliableID : sentPacket.reliableMessages)
+		{
+			auto iterator = m_pendingReliable.find(reliableID);
+			if (iterator != m_pendingReliable.end())
+			{
+				BufferPool::get().release(std::move(iterator->second.packed));
+				m_pendingReliable.erase(iterator);
+			}
+		}
+		sentPacket.reliableMessages.clear();
+
+		// Datagrams acknowledged only in the bitfield may have been acknowledged late, so they'd overstate the round trip time
+		if (!isLatest)
+		{
+			return;
+		}
+
+		// Smooth the round trip time the same way TCP does (RFC 6298)
+		auto sample = now - sentPacket.sendTime;
+		if (!m_hasRoundTripTime)
+		{
+			m_smoothedRoundTripTime = sample;
+			m_roundTripTimeVariance = sample / 2.f;
+			m_hasRoundTripTime      = true;
+		}
+		else
+		{
+			auto deviation          = sample > m_smoothedRoundTripTime ? sample - m_smoothedRoundTripTime : m_smoothedRoundTripTime - sample;
+			m_roundTripTimeVariance = m_roundTripTimeVariance * 0.75f + deviation * 0.25f;
+			m_smoothedRoundTripTime = m_smoothedRoundTripTime * 0.875f + sample * 0.125f;
+		}
+	}
+
+	auto ReliableEndpoint::receiveMessage(Message&& message, std::vector<Message>& delivered) -> void
+	{
+		auto sequence = message.header.sequence;
+		switch (message.header.protocol)
+		{
+			case Protocol::ReliableOrdered:
+			{
+				// Drop anything already delivered, or too far ahead to have been sent yet
+				if (sequence != m_nextOrderedSequence && !isSequenceNewer(sequence, m_nextOrderedSequence))
+				{
+					return;
+				}
+				if (static_cast<std::uint16_t>(sequence - m_nextOrderedSequence) >= RECEIVE_WINDOW)
+				{
+					return;
+				}
+
+				m_orderedBuffer.emplace(sequence, std::move(message));
+				for (auto iterator = m_orderedBuffer.find(m_nextOrderedSequence); iterator != m_orderedBuffer.end(); iterator = m_orderedBuffer.find(m_nextOrderedSequence))
+				{
+					delivered.emplace_back(std::move(iterator->second));
+					m_orderedBuffer.erase(iterator);
+					++m_nextOrderedSequence;
+				}
+			}
+			break;
+			case Protocol::ReliableUnordered:
+			{
+				auto& received = m_unorderedReceived[sequence % RECEIVE_WINDOW];
+				if (received == sequence)
+				{
+					return;
+				}
+				received = sequence;
+				delivered.emplace_back(std::move(message));
+			}
+			break;
+			case Protocol::UnreliableSequenced:
+				if (m_hasSequenced && !isSequenceNewer(sequence, m_lastSequenced))
+				{
+					return;
+				}
+				m_lastSequenced = sequence;
+				m_hasSequenced  = true;
+				delivered.emplace_back(std::move(message));
+				break;
+			default:
+				delivered.emplace_back(std::move(message));
+				break;
+		}
+	}
+
+	auto ReliableEndpoint::reset() -> void
+	{
+		*this = ReliableEndpoint(m_maxDatagramLength);
+	}
+
+	auto ReliableEndpoint::getRoundTripTime() const -> sf::Time
+	{
+		return m_smoothedRoundTripTime;
+	}
+
+	auto ReliableEndpoint::getRetransmissionTimeout() const -> sf::Time
+	{
+		const auto MIN_TIMEOUT     = sf::milliseconds(30);
+		const auto MAX_TIMEOUT     = sf::seconds(1);
+		const auto INITIAL_TIMEOUT = sf::milliseconds(200);
+
+		if (!m_hasRoundTripTime)
+		{
+			return INITIAL_TIMEOUT;
+		}
+
+		return std::clamp(m_smoothedRoundTripTime + m_roundTripTimeVariance * 4.f, MIN_TIMEOUT, MAX_TIMEOUT);
+	}
+
+	auto ReliableEndpoint::getPendingReliableCount() const -> std::size_t
+	{
+		return m_pendingReliable.size();
+	}
+
+	auto ReliableEndpoint::getResentCount() const -> std::uint64_t
+	{
+		return m_resentCount;
+	}
+
+} // namespace Common::Network
\ No newline at end of file
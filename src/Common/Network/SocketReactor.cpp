@@ -0,0 +1,214 @@
+#include "Common/Network/SocketReactor.hpp"
+#include "Network/NativeHandle.hpp"
+#include <algorithm>
+#include <cerrno>
+
+#if defined(__linux__)
+#	include <sys/epoll.h>
+#	include <sys/eventfd.h>
+#	include <unistd.h>
+#endif
+
+namespace Common::Network
+{
+
+#if defined(__linux__)
+
+	/**
+	 * \brief Register the eventfd used to interrupt the reactor with an epoll instance
+	 *
+	 */
+	auto addInterruptDescriptor(const int epollDescriptor, const int interruptDescriptor) -> void
+	{
+		auto event     = epoll_event();
+		event.events   = EPOLLIN | EPOLLET;
+		event.data.u64 = SocketReactor::INTERRUPT_TOKEN;
+		epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, interruptDescriptor, &event);
+	}
+
+	SocketReactor::SocketReactor(const std::size_t maxEventsPerWait) :
+	    m_epollDescriptor(epoll_create1(EPOLL_CLOEXEC)),
+	    m_interruptDescriptor(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)),
+	    m_epollEvents(std::make_unique<epoll_event[]>(maxEventsPerWait)),
+	    m_maxEvents(maxEventsPerWait)
+	{
+		if (m_epollDescriptor < 0 || m_interruptDescriptor < 0)
+		{
+			spdlog::error("Failed to create an epoll instance (errno {})", errno);
+		}
+		addInterruptDescriptor(m_epollDescriptor, m_interruptDescriptor);
+		m_events.reserve(maxEventsPerWait);
+	}
+
+	SocketReactor::~SocketReactor()
+	{
+		if (m_epollDescriptor >= 0)
+		{
+			close(m_epollDescriptor);
+		}
+		if (m_interruptDescriptor >= 0)
+		{
+			close(m_interruptDescriptor);
+		}
+	}
+
+	auto SocketReactor::add(sf::Socket& socket, const std::uint64_t token, const bool watchWritable) -> bool
+	{
+		// Being edge-triggered, a writable socket is only reported again once a write has filled its send buffer and it has drained
+		auto event     = epoll_event();
+		event.events   = EPOLLIN | EPOLLRDHUP | EPOLLET | (watchWritable ? EPOLLOUT : 0);
+		event.data.u64 = token;
+
+		if (epoll_ctl(m_epollDescriptor, EPOLL_CTL_ADD, NativeHandleAccessor::get(socket), &event) != 0)
+		{
+			spdlog::warn("Failed to register socket with the reactor (errno {})", errno);
+			return false;
+		}
+
+		++m_socketCount;
+		return true;
+	}
+
+	auto SocketReactor::remove(sf::Socket& socket) -> void
+	{
+		if (epoll_ctl(m_epollDescriptor, EPOLL_CTL_DEL, NativeHandleAccessor::get(socket), nullptr) == 0)
+		{
+			--m_socketCount;
+		}
+	}
+
+	auto SocketReactor::clear() -> void
+	{
+		// Closing the epoll instance drops every registration at once
+		close(m_epollDescriptor);
+		m_epollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+		addInterruptDescriptor(m_epollDescriptor, m_interruptDescriptor);
+		m_socketCount = 0;
+		m_events.clear();
+	}
+
+	auto SocketReactor::wait(const sf::Time timeout) -> const std::vector<SocketEvent>&
+	{
+		m_events.clear();
+
+		auto eventCount = epoll_wait(m_epollDescriptor, m_epollEvents.get(), static_cast<int>(m_maxEvents), timeout.asMilliseconds());
+		for (auto i = 0; i < eventCount; ++i)
+		{
+			const auto& epollEvent = m_epollEvents[i];
+			if (epollEvent.data.u64 == INTERRUPT_TOKEN)
+			{
+				// Reset the eventfd counter so the next interrupt raises a new edge
+				auto counter = std::uint64_t(0);
+				(void)read(m_interruptDescriptor, &counter, sizeof(counter));
+				continue;
+			}
+
+			auto& event    = m_events.emplace_back();
+			event.token    = epollEvent.data.u64;
+			event.readable = (epollEvent.events & EPOLLIN) != 0;
+			event.writable = (epollEvent.events & EPOLLOUT) != 0;
+			event.hangup   = (epollEvent.events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0;
+		}
+
+		return m_events;
+	}
+
+	auto SocketReactor::interrupt() -> void
+	{
+		auto counter = std::uint64_t(1);
+		(void)write(m_interruptDescriptor, &counter, sizeof(counter));
+	}
+
+#else
+
+	SocketReactor::SocketReactor(const std::size_t maxEventsPerWait)
+	{
+		// The selector can only wake up for sockets, so interrupts are a datagram sent to ourselves over loopback
+		if (m_interruptSocket.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) != sf::Socket::Status::Done)
+		{
+			spdlog::error("Failed to bind the reactor's interrupt socket");
+		}
+		m_interruptSocket.setBlocking(false);
+		m_selector.add(m_interruptSocket);
+		m_events.reserve(maxEventsPerWait);
+	}
+
+	SocketReactor::~SocketReactor() = default;
+
+	auto SocketReactor::add(sf::Socket& socket, const std::uint64_t token, [[maybe_unused]] const bool watchWritable) -> bool
+	{
+		// The selector can only wait for sockets to be readable, so writes to a full socket are retried on every wait instead
+		m_selector.add(socket);
+		m_sockets.emplace_back(&socket, token);
+		++m_socketCount;
+		return true;
+	}
+
+	auto SocketReactor::remove(sf::Socket& socket) -> void
+	{
+		auto iterator = std::find_if(m_sockets.begin(), m_sockets.end(), [&](const auto& element) {
+			return element.first == &socket;
+		});
+		if (iterator != m_sockets.end())
+		{
+			m_selector.remove(socket);
+			m_sockets.erase(iterator);
+			--m_socketCount;
+		}
+	}
+
+	auto SocketReactor::clear() -> void
+	{
+		m_selector.clear();
+		m_selector.add(m_interruptSocket);
+		m_sockets.clear();
+		m_socketCount = 0;
+		m_events.clear();
+	}
+
+	auto SocketReactor::wait(const sf::Time timeout) -> const std::vector<SocketEvent>&
+	{
+		m_events.clear();
+
+		// The selector is level-triggered and can't say which sockets are ready, so this path still scans every socket
+		if (m_selector.wait(timeout))
+		{
+			if (m_selector.isReady(m_interruptSocket))
+			{
+				auto byte          = std::uint8_t(0);
+				auto length        = std::size_t(0);
+				auto remoteAddress = std::optional<sf::IpAddress>();
+				auto remotePort    = std::uint16_t(0);
+				while (m_interruptSocket.receive(&byte, sizeof(byte), length, remoteAddress, remotePort) == sf::Socket::Status::Done)
+				{
+				}
+			}
+
+			for (const auto& [socket, token] : m_sockets)
+			{
+				if (m_selector.isReady(*socket))
+				{
+					auto& event    = m_events.emplace_back();
+					event.token    = token;
+					event.readable = true;
+				}
+			}
+		}
+
+		return m_events;
+	}
+
+	auto SocketReactor::interrupt() -> void
+	{
+		auto byte = std::uint8_t(0);
+		(void)m_interruptSocket.send(&byte, sizeof(byte), sf::IpAddress::LocalHost, m_interruptSocket.getLocalPort());
+	}
+
+#endif
+
+	auto SocketReactor::size() const -> std::size_t
+	{
+		return m_socketCount;
+	}
+
+} // namespace Common::Network
\ No newline at end of file
@@ -0,0 +1,350 @@
+#include "Common/Util/JobSystem.hpp"
+#include <algorithm>
+
+namespace Common::Util
+{
+
+	namespace
+	{
+		// Which job system the calling thread is a worker of, if any, and the index of its deque
+		thread_local const JobSystem* t_jobSystem = nullptr;
+		thread_local std::size_t t_queueIndex     = 0;
+	} // namespace
+
+	JobSystem::JobSystem(const std::size_t workerCount) :
+	    m_mainThreadID(std::this_thread::get_id()),
+	    m_workerCount(workerCount)
+	{
+		m_queues.reserve(workerCount + 1);
+		for (auto i = std::size_t(0); i < workerCount + 1; ++i)
+		{
+			m_queues.emplace_back(std::make_unique<JobQueue>());
+		}
+
+		m_workers.reserve(workerCount);
+		for (auto i = std::size_t(0); i < workerCount; ++i)
+		{
+			m_workers.emplace_back(&JobSystem::runWorker, this, i);
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			auto lock  = std::scoped_lock<std::mutex>(m_sleepMutex);
+			m_stopping = true;
+		}
+		m_sleepCondition.notify_all();
+
+		for (auto& worker : m_workers)
+		{
+			worker.join();
+		}
+	}
+
+	auto JobSystem::getDefaultWorkerCount() -> std::size_t
+	{
+		return std::max(std::thread::hardware_concurrency(), 1U) - 1;
+	}
+
+	auto JobSystem::run(Job&& job) -> void
+	{
+		push(QueuedJob{std::move(job), nullptr});
+	}
+
+	auto JobSystem::run(JobGroup& group, Job&& job) -> void
+	{
+		group.m_pending.fetch_add(1, std::memory_order_relaxed);
+		push(QueuedJob{std::move(job), &group});
+	}
+
+	auto JobSystem::runOnMainThread(Job&& job) -> void
+	{
+		m_mainThreadJobs.push(QueuedJob{std::move(job), nullptr});
+	}
+
+	auto JobSystem::runOnMainThread(JobGroup& group, Job&& job) -> void
+	{
+		group.m_pending.fetch_add(1, std::memory_order_relaxed);
+		m_mainThreadJobs.push(QueuedJob{std::move(job), &group});
+
+		// The main thread may be sleeping on the group, and has to wake to run this
+		auto lock = std::scoped_lock<std::mutex>(group.m_mutex);
+		group.m_condition.notify_all();
+	}
+
+	auto JobSystem::wait(JobGroup& group) -> void
+	{
+		// The last jobs are usually close to finishing, so it's worth a few tries before paying for a sleep and a wake up
+		const auto MAX_SPINS = std::size_t(64);
+
+		const auto mainThread = isMainThread();
+		auto spins            = std::size_t(0);
+		while (!group.isDone())
+		{
+			if (mainThread && runMainThreadJobs() > 0)
+			{
+				spins = 0;
+				continue;
+			}
+
+			auto job = QueuedJob();
+			if (take(group, job))
+			{
+				execute(job);
+				spins = 0;
+				continue;
+			}
+
+			if (spins < MAX_SPINS)
+			{
+				++spins;
+				std::this_thread::yield();
+				continue;
+			}
+
+			// Whatever's left is already running on another thread
+			auto lock = std::unique_lock<std::mutex>(group.m_mutex);
+			group.m_condition.wait(lock, [&]() {
+				return group.isDone() || (mainThread && !m_mainThreadJobs.empty());
+			});
+			spins = 0;
+		}
+
+		// The last job finishes while holding the lock, so once this has it, nothing touches the group again and it's safe to destroy
+		auto lock = std::scoped_lock<std::mutex>(group.m_mutex);
+	}
+
+	auto JobSystem::parallelFor(const std::size_t count, const std::size_t minChunkSize, const RangeFunction& function) -> void
+	{
+		// A few chunks per thread, so a thread which finishes early can take another rather than wait on the slowest
+		const auto CHUNKS_PER_THREAD = std::size_t(4);
+
+		auto chunkSize = std::max(minChunkSize, std::size_t(1));
+		chunkSize      = std::max(chunkSize, count / ((m_workerCount + 1) * CHUNKS_PER_THREAD) + 1);
+		if (m_workerCount == 0 || count <= chunkSize)
+		{
+			if (count > 0)
+			{
+				function(0, count);
+			}
+			return;
+		}
+
+		auto group = JobGroup();
+		for (auto begin = chunkSize; begin < count; begin += chunkSize)
+		{
+			const auto end = std::min(begin + chunkSize, count);
+			run(group, [&function, begin, end]() {
+				function(begin, end);
+			});
+		}
+
+		function(0, chunkSize);
+		wait(group);
+	}
+
+	auto JobSystem::runMainThreadJobs() -> std::size_t
+	{
+		// Taken as a batch, so a job queueing another main thread job doesn't keep this from returning
+		auto jobs = m_mainThreadJobs.clear();
+		for (auto& job : jobs)
+		{
+			execute(job);
+		}
+
+		return jobs.size();
+	}
+
+	auto JobSystem::getWorkerCount() const -> std::size_t
+	{
+		return m_workerCount;
+	}
+
+	auto JobSystem::isMainThread() const -> bool
+	{
+		return std::this_thread::get_id() == m_mainThreadID;
+	}
+
+	auto JobSystem::runWorker(const std::size_t index) -> void
+	{
+		t_jobSystem  = this;
+		t_queueIndex = index;
+
+		while (true)
+		{
+			auto job = QueuedJob();
+			if (take(job))
+			{
+				execute(job);
+				continue;
+			}
+
+			if (m_stopping)
+			{
+				return;
+			}
+
+			// Counted as sleeping before checking for jobs, so a job queued after the check always sees this worker and wakes it
+			++m_sleepingWorkers;
+			{
+				auto lock = std::unique_lock<std::mutex>(m_sleepMutex);
+				m_sleepCondition.wait(lock, [&]() {
+					return m_stopping || m_queuedJobs > 0;
+				});
+			}
+			--m_sleepingWorkers;
+		}
+	}
+
+	auto JobSystem::push(QueuedJob&& job) -> void
+	{
+		if (m_workerCount == 0)
+		{
+			execute(job);
+			return;
+		}
+
+		auto& queue = *m_queues[getQueueIndex()];
+		{
+			auto lock = std::scoped_lock<std::mutex>(queue.mutex);
+			queue.jobs.emplace_back(std::move(job));
+			++m_queuedJobs;
+		}
+
+		if (m_sleepingWorkers > 0)
+		{
+			// Taking the lock means a worker between checking for jobs and sleeping has finished going to sleep, so can't miss this
+			{
+				auto lock = std::scoped_lock<std::mutex>(m_sleepMutex);
+			}
+			m_sleepCondition.notify_one();
+		}
+	}
+
+	auto JobSystem::take(QueuedJob& job) -> bool
+	{
+		const auto index       = getQueueIndex();
+		const auto sharedIndex = m_workerCount;
+
+		if (index != sharedIndex)
+		{
+			auto& queue = *m_queues[index];
+			auto lock   = std::scoped_lock<std::mutex>(queue.mutex);
+			if (!queue.jobs.empty())
+			{
+				job = std::move(queue.jobs.back());
+				queue.jobs.pop_back();
+				--m_queuedJobs;
+				return true;
+			}
+		}
+
+		if (steal(*m_queues[sharedIndex], job))
+		{
+			return true;
+		}
+
+		// Start with the next worker along rather than the first, so workers out of jobs don't all steal from the same one
+		for (auto i = std::size_t(1); i <= sharedIndex; ++i)
+		{
+			const auto victim = (index + i) % sharedIndex;
+			if (victim != index && steal(*m_queues[victim], job))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	auto JobSystem::take(const JobGroup& group, QueuedJob& job) -> bool
+	{
+		const auto sharedIndex = m_workerCount;
+		if (getQueueIndex() != sharedIndex)
+		{
+			return take(job);
+		}
+
+		// Jobs in the group were most likely queued by the waiting thread itself, so are on the shared deque unless they've been stolen
+		if (steal(*m_queues[sharedIndex], group, job))
+		{
+			return true;
+		}
+
+		for (auto i = std::size_t(0); i < sharedIndex; ++i)
+		{
+			if (steal(*m_queues[i], group, job))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	auto JobSystem::steal(JobQueue& queue, QueuedJob& job) -> bool
+	{
+		auto lock = std::scoped_lock<std::mutex>(queue.mutex);
+		if (queue.jobs.empty())
+		{
+			return false;
+		}
+
+		job = std::move(queue.jobs.front());
+		queue.jobs.pop_front();
+		--m_queuedJobs;
+		return true;
+	}
+
+	auto JobSystem::steal(JobQueue& queue, const JobGroup& group, QueuedJob& job) -> bool
+	{
+		auto lock = std::scoped_lock<std::mutex>(queue.mutex);
+		auto iterator = std::find_if(queue.jobs.begin(), queue.jobs.end(), [&group](const QueuedJob& queued) {
+			return queued.group == &group;
+		});
+		if (iterator == queue.jobs.end())
+		{
+			return false;
+		}
+
+		job = std::move(*iterator);
+		queue.jobs.erase(iterator);
+		--m_queuedJobs;
+		return true;
+	}
+
+	auto JobSystem::execute(QueuedJob& job) -> void
+	{
+		job.job();
+
+		if (job.group != nullptr)
+		{
+			finish(*job.group);
+		}
+	}
+
+	auto JobSystem::finish(JobGroup& group) -> void
+	{
+		// Any but the last job just counts itself off, as the group can't be done, and so can't be destroyed, until after
+		auto pending = group.m_pending.load(std::memory_order_relaxed);
+		while (pending > 1)
+		{
+			if (group.m_pending.compare_exchange_weak(pending, pending - 1, std::memory_order_release, std::memory_order_relaxed))
+			{
+				return;
+			}
+		}
+
+		// The waiting thread takes the lock before returning, so the group outlives this
+		auto lock = std::scoped_lock<std::mutex>(group.m_mutex);
+		group.m_pending.fetch_sub(1, std::memory_order_release);
+		group.m_condition.notify_all();
+	}
+
+	auto JobSystem::getQueueIndex() const -> std::size_t
+	{
+		return t_jobSystem == this ? t_queueIndex : m_workerCount;
+	}
+
+} // namespace Common::Util
@@ -0,0 +1,261 @@
+#include "Common/World/InterestGrid.hpp"
+#include <cmath>
+#include <cstdlib>
+
+namespace Common::World
+{
+
+	auto InterestGrid::CellKeyHash::operator()(const CellKey& key) const -> std::size_t
+	{
+		auto hash = static_cast<std::uint64_t>(key.instanceID);
+		hash      = hash * 0x9E3779B97F4A7C15ULL + static_cast<std::uint32_t>(key.x);
+		hash      = hash * 0x9E3779B97F4A7C15ULL + static_cast<std::uint32_t>(key.y);
+		return static_cast<std::size_t>(hash ^ (hash >> 32));
+	}
+
+	InterestGrid::InterestGrid(const float cellSize, const std::int32_t viewRadius) :
+	    m_cellSize(cellSize),
+	    m_viewRadius(viewRadius)
+	{
+	}
+
+	auto InterestGrid::update(const entt::entity entity, const std::uint32_t instanceID, const sf::Vector2f position, const bool isSubscriber) -> void
+	{
+		auto key      = getCellKey(instanceID, position);
+		auto iterator = m_entities.find(entity);
+		if (iterator == m_entities.end())
+		{
+			m_entities.emplace(entity, TrackedEntity{key, isSubscriber, m_sweepCount});
+			moveEntity(entity, nullptr, &key);
+			if (isSubscriber)
+			{
+				moveSubscriber(entity, nullptr, &key);
+			}
+			return;
+		}
+
+		auto& tracked    = iterator->second;
+		tracked.lastSeen = m_sweepCount;
+		if (tracked.cell == key && tracked.isSubscriber == isSubscriber)
+		{
+			// Entities only matter to the grid when they change cell
+			return;
+		}
+
+		auto previousCell    = tracked.cell;
+		auto wasSubscriber   = tracked.isSubscriber;
+		tracked.cell         = key;
+		tracked.isSubscriber = isSubscriber;
+
+		if (previousCell != key)
+		{
+			moveEntity(entity, &previousCell, &key);
+		}
+		moveSubscriber(entity, wasSubscriber ? &previousCell : nullptr, isSubscriber ? &key : nullptr);
+		releaseCell(previousCell);
+	}
+
+	auto InterestGrid::remove(const entt::entity entity) -> void
+	{
+		auto iterator = m_entities.find(entity);
+		if (iterator == m_entities.end())
+		{
+			return;
+		}
+
+		auto tracked = iterator->second;
+		moveEntity(entity, &tracked.cell, nullptr);
+
+		// The subscriber is going away, so there's nobody to tell about the entities it stops seeing
+		if (tracked.isSubscriber)
+		{
+			for (auto x = tracked.cell.x - m_viewRadius; x <= tracked.cell.x + m_viewRadius; ++x)
+			{
+				for (auto y = tracked.cell.y - m_viewRadius; y <= tracked.cell.y + m_viewRadius; ++y)
+				{
+					auto key  = CellKey{tracked.cell.instanceID, x, y};
+					auto cell = m_cells.find(key);
+					if (cell != m_cells.end())
+					{
+						std::erase(cell->second.subscribers, entity);
+						releaseCell(key);
+					}
+				}
+			}
+		}
+
+		m_entities.erase(entity);
+		releaseCell(tracked.cell);
+	}
+
+	auto InterestGrid::sweep() -> void
+	{
+		auto staleEntities = std::vector<entt::entity>();
+		for (const auto& [entity, tracked] : m_entities)
+		{
+			if (tracked.lastSeen != m_sweepCount)
+			{
+				staleEntities.emplace_back(entity);
+			}
+		}
+
+		for (const auto entity : staleEntities)
+		{
+			remove(entity);
+		}
+
+		++m_sweepCount;
+	}
+
+	auto InterestGrid::getSubscribers(const entt::entity entity) const -> const std::vector<entt::entity>&
+	{
+		static const auto NO_SUBSCRIBERS = std::vector<entt::entity>();
+
+		auto iterator = m_entities.find(entity);
+		if (iterator == m_entities.end())
+		{
+			return NO_SUBSCRIBERS;
+		}
+
+		auto cell = m_cells.find(iterator->second.cell);
+		return cell == m_cells.end() ? NO_SUBSCRIBERS : cell->second.subscribers;
+	}
+
+	auto InterestGrid::getVisibleEntities(const entt::entity subscriber, std::vector<entt::entity>& entities) const -> void
+	{
+		auto iterator = m_entities.find(subscriber);
+		if (iterator == m_entities.end() || !iterator->second.isSubscriber)
+		{
+			return;
+		}
+
+		const auto& centre = iterator->second.cell;
+		for (auto x = centre.x - m_viewRadius; x <= centre.x + m_viewRadius; ++x)
+		{
+			for (auto y = centre.y - m_viewRadius; y <= centre.y + m_viewRadius; ++y)
+			{
+				auto cell = m_cells.find(CellKey{centre.instanceID, x, y});
+				if (cell != m_cells.end())
+				{
+					entities.insert(entities.end(), cell->second.entities.begin(), cell->second.entities.end());
+				}
+			}
+		}
+	}
+
+	auto InterestGrid::takeEvents() -> std::vector<InterestEvent>
+	{
+		auto events = std::move(m_events);
+		m_events.clear();
+		return events;
+	}
+
+	auto InterestGrid::getCellCount() const -> std::size_t
+	{
+		return m_cells.size();
+	}
+
+	auto InterestGrid::getCellKey(const std::uint32_t instanceID, const sf::Vector2f position) const -> CellKey
+	{
+		return CellKey{instanceID, static_cast<std::int32_t>(std::floor(position.x / m_cellSize)), static_cast<std::int32_t>(std::floor(position.y / m_cellSize))};
+	}
+
+	auto InterestGrid::isWatching(const CellKey& centre, const CellKey& cell) const -> bool
+	{
+		return centre.instanceID == cell.instanceID && std::abs(centre.x - cell.x) <= m_viewRadius && std::abs(centre.y - cell.y) <= m_viewRadius;
+	}
+
+	auto InterestGrid::moveEntity(const entt::entity entity, const CellKey* from, const CellKey* to) -> void
+	{
+		// Subscribers watching the old cell but not the new one stop seeing the entity, and the reverse start seeing it
+		if (from != nullptr)
+		{
+			auto& cell = m_cells[*from];
+			std::erase(cell.entities, entity);
+			for (const auto subscriber : cell.subscribers)
+			{
+				if (subscriber != entity && (to == nullptr || !isWatching(m_entities.at(subscriber).cell, *to)))
+				{
+					m_events.emplace_back(InterestEvent{subscriber, entity, false});
+				}
+			}
+		}
+
+		if (to != nullptr)
+		{
+			auto& cell = m_cells[*to];
+			cell.entities.emplace_back(entity);
+			for (const auto subscriber : cell.subscribers)
+			{
+				if (subscriber != entity && (from == nullptr || !isWatching(m_entities.at(subscriber).cell, *from)))
+				{
+					m_events.emplace_back(InterestEvent{subscriber, entity, true});
+				}
+			}
+		}
+	}
+
+	auto InterestGrid::moveSubscriber(const entt::entity subscriber, const CellKey* from, const CellKey* to) -> void
+	{
+		if (from != nullptr)
+		{
+			for (auto x = from->x - m_viewRadius; x <= from->x + m_viewRadius; ++x)
+			{
+				for (auto y = from->y - m_viewRadius; y <= from->y + m_viewRadius; ++y)
+				{
+					auto key = CellKey{from->instanceID, x, y};
+					if (to != nullptr && isWatching(*to, key))
+					{
+						continue;
+					}
+
+					auto& cell = m_cells[key];
+					std::erase(cell.subscribers, subscriber);
+					for (const auto entity : cell.entities)
+					{
+						if (entity != subscriber)
+						{
+							m_events.emplace_back(InterestEvent{subscriber, entity, false});
+						}
+					}
+					releaseCell(key);
+				}
+			}
+		}
+
+		if (to != nullptr)
+		{
+			for (auto x = to->x - m_viewRadius; x <= to->x + m_viewRadius; ++x)
+			{
+				for (auto y = to->y - m_viewRadius; y <= to->y + m_viewRadius; ++y)
+				{
+					auto key = CellKey{to->instanceID, x, y};
+					if (from != nullptr && isWatching(*from, key))
+					{
+						continue;
+					}
+
+					auto& cell = m_cells[key];
+					cell.subscribers.emplace_back(subscriber);
+					for (const auto entity : cell.entities)
+					{
+						if (entity != subscriber)
+						{
+							m_events.emplace_back(InterestEvent{subscriber, entity, true});
+						}
+					}
+				}
+			}
+		}
+	}
+
+	auto InterestGrid::releaseCell(const CellKey& key) -> void
+	{
+		auto iterator = m_cells.find(key);
+		if (iterator != m_cells.end() && iterator->second.entities.empty() && iterator->second.subscribers.empty())
+		{
+			m_cells.erase(iterator);
+		}
+	}
+
+} // namespace Common::World
\ No newline at end of file
@@ -48,14 +48,16 @@ namespace Server
 		return Login::CreateResult::Created;
 	}
 
-	auto LoginManager::authenticate(const std::string& username, const std::string& password) -> Login::AuthenticationResult
+	auto LoginManager::authenticate(const std::string& username, const std::string& password, Common::Util::JobSystem& jobSystem,
+	                                Login::AuthenticationCallback&& onComplete) -> void
 	{
 		spdlog::debug("Authenticating user {}", username);
 
 		if (isLoggedIn(username))
 		{
 			spdlog::debug("Username is already logged in");
-			return Login::AuthenticationResult::AlreadyLoggedIn;
+			onComplete(Login::AuthenticationResult::AlreadyLoggedIn);
+			return;
 		}
 
 		auto query     = nlohmann::json::parse("{\"username\": \"" + username + "\"}");
@@ -63,7 +65,8 @@ namespace Server
 		if (!optResult.has_value())
 		{
 			spdlog::debug("User does not exist");
-			return Login::AuthenticationResult::InvalidUsername;
+			onComplete(Login::AuthenticationResult::InvalidUsername);
+			return;
 		}
 
 		auto salt = std::string();
@@ -73,8 +76,6 @@ namespace Server
 			salt.push_back(value.get<std::uint8_t>());
 		}
 
-		auto hashedPassword = hashString(password, salt);
-
 		auto remotePassword = std::string();
 
 		for (const auto& value : optResult->at("password"))
@@ -82,13 +83,31 @@ namespace Server
 			remotePassword.push_back(value.get<std::uint8_t>());
 		}
 
-		if (hashedPassword != remotePassword)
-		{
-			spdlog::debug("Invalid password");
-			return Login::AuthenticationResult::InvalidPassword;
-		}
-
-		return Login::AuthenticationResult::Valid;
+		// Hashing takes long enough to stall every other client's messages, so only the database lookup happens on the main thread
+		jobSystem.run([this, &jobSystem, username, password, salt = std::move(salt), remotePassword = std::move(remotePassword),
+		               onComplete = std::move(onComplete)]() mutable {
+			auto hashedPassword = hashString(password, salt);
+			auto result         = hashedPassword == remotePassword ? Login::AuthenticationResult::Valid : Login::AuthenticationResult::InvalidPassword;
+
+			jobSystem.runOnMainThread([this, username = std::move(username), result, onComplete = std::move(onComplete)]() {
+				if (result == Login::AuthenticationResult::InvalidPassword)
+				{
+					spdlog::debug("Invalid password");
+					onComplete(result);
+					return;
+				}
+
+				// Another connection may have logged in as the same user while the password was being hashed
+				if (isLoggedIn(username))
+				{
+					spdlog::debug("Username is already logged in");
+					onComplete(Login::AuthenticationResult::AlreadyLoggedIn);
+					return;
+				}
+
+				onComplete(result);
+			});
+		});
 	}
 
 	auto LoginManager::isLoggedIn(const std::string& username) -> bool
@@ -1,5 +1,7 @@
 #pragma once
 #include "Database/DatabaseManager.hpp"
+#include <Common/Util/JobSystem.hpp>
+#include <functional>
 #include <unordered_set>
 
 namespace Server
@@ -29,6 +31,8 @@ namespace Server
 			InvalidPassword,
 			AlreadyLoggedIn
 		};
+
+		using AuthenticationCallback = std::function<void(AuthenticationResult)>;
 	} // namespace Login
 
 	/**
@@ -55,13 +59,16 @@ namespace Server
 		auto createUser(const std::string& username, const std::string& password) -> Login::CreateResult;
 
 		/**
-		 * \brief Check whether a username and password combination are valid in the database
+		 * \brief Check whether a username and password combination are valid in the database. The user is looked up straight away, but
+		 * the password is hashed on the job system, as Argon2 is slow on purpose, and the result is handed back on the main thread
 		 *
 		 * \param username The username the user is trying to log in with
 		 * \param password The unhashed password the user is trying to log in with
-		 * \return Login::AuthenticationResult An AuthenticationResult which encodes the result of the operation
+		 * \param jobSystem The job system to hash the password on, whose main thread is the one calling this
+		 * \param onComplete Called on the main thread with the result, possibly before this returns
 		 */
-		auto authenticate(const std::string& username, const std::string& password) -> Login::AuthenticationResult;
+		auto authenticate(const std::string& username, const std::string& password, Common::Util::JobSystem& jobSystem,
+		                  Login::AuthenticationCallback&& onComplete) -> void;
 
 		/**
 		 * \brief Get whether a username is already logged in
@@ -94,7 +101,7 @@ namespace Server
 		 * \param salt The salt to use to hash the string
 		 * \return std::string The hashed string
 		 */
-		auto hashString(const std::string& input, const std::string& salt) -> std::string;
+		static auto hashString(const std::string& input, const std::string& salt) -> std::string;
 
 		DatabaseManager& m_databaseManager;
 		std::unordered_set<std::uint32_t> m_usersLoggedIn;
@@ -1,13 +1,77 @@
 #include "Server/Server.hpp"
+#include "Zone/ZoneServer.hpp"
 #include "Version.hpp"
 #include <spdlog/spdlog.h>
+#include <string>
+#include <string_view>
 
 auto main(int argc, char** argv) -> int
 {
 	spdlog::set_level(spdlog::level::debug);
 
 	spdlog::info("Server version {}.{}.{}", Server::Version::getMajor(), Server::Version::getMinor(), Server::Version::getPatch());
-	auto server = Server::Server(std::filesystem::path(argv[0]).parent_path());
+
+	auto options = Server::Options();
+	for (auto i = 1; i < argc; ++i)
+	{
+		auto argument = std::string_view(argv[i]);
+		if (argument == "--network-thread")
+		{
+			options.networkThread = true;
+		}
+		else if (argument == "--tick-rate" && i + 1 < argc)
+		{
+			options.tickRate = std::stoul(argv[++i]);
+		}
+		else if (argument == "--shards" && i + 1 < argc)
+		{
+			options.shardCount = std::stoul(argv[++i]);
+		}
+		else if (argument == "--workers" && i + 1 < argc)
+		{
+			options.workerCount = std::stoul(argv[++i]);
+		}
+		else if (argument == "--zones" && i + 1 < argc)
+		{
+			options.zoneCount = std::stoul(argv[++i]);
+		}
+		else if (argument == "--zone" && i + 1 < argc)
+		{
+			options.zoneIndex = std::stoul(argv[++i]);
+		}
+		else if (argument == "--ipc-dir" && i + 1 < argc)
+		{
+			options.ipcDirectory = argv[++i];
+		}
+		else if (argument == "--dictionaries" && i + 1 < argc)
+		{
+			options.dictionaryDirectory = argv[++i];
+		}
+		else if (argument == "--capture-samples" && i + 1 < argc)
+		{
+			options.capturedSamples = std::stoul(argv[++i]);
+		}
+		else
+		{
+			spdlog::warn("Ignoring unknown argument {}", argument);
+		}
+	}
+
+	// A zone only simulates the world, so it has no clients, database or shell of its own
+	if (options.zoneIndex.has_value())
+	{
+		if (*options.zoneIndex >= options.zoneCount)
+		{
+			spdlog::error("--zone must be given with --zones, and be less than it");
+			return 1;
+		}
+
+		auto zone = Server::ZoneServer(options);
+		zone.run();
+		return 0;
+	}
+
+	auto server = Server::Server(std::filesystem::path(argv[0]).parent_path(), options);
 	server.run();
 
 	return 0;
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Network/SendScheduler.hpp"
+#include "Network/TokenBucket.hpp"
+#include "SFML/Network/TcpSocket.hpp"
+#include <Common/Network/FrameAssembler.hpp>
+#include <Common/Network/GatherBuffer.hpp>
+#include <Common/Network/HeaderCodec.hpp>
+#include <Common/Network/ReliableEndpoint.hpp>
+#include <memory>
+#include <optional>
+
+namespace Server
+{
+
+	/**
+	 * \struct AddressLimits Connection.hpp "Network/Connection.hpp"
+	 * \brief The rate limits shared by every connection from one address
+	 */
+	struct AddressLimits
+	{
+		TokenBucket connections;
+		TokenBucket messages;
+		TokenBucket bytes;
+
+		// Connections from the address which are still open
+		std::size_t connectionCount = 0;
+	};
+
+	/**
+	 * \struct Connection Connection.hpp "Network/Connection.hpp"
+	 * \brief Contains the data used to communicate with a client. Only touched by the thread which owns the sockets
+	 */
+	struct Connection
+	{
+		std::unique_ptr<sf::TcpSocket> tcpSocket = nullptr;
+		std::uint64_t lastMessageIdentifier      = 0;
+		std::uint16_t udpPort                    = 0;
+
+		// Every client's messages are numbered on their own, so the gap between two the client is sent is never more than the messages
+		// it was sent in between, which the low bits sent on plain UDP rely on
+		std::uint64_t lastSentIdentifier = 0;
+
+		Common::Network::FrameAssembler frameAssembler;
+
+		// Encodes and decodes the client's message headers. The server switches to the agreed version once it has told the client
+		Common::Network::HeaderCodec headerCodec;
+		std::uint8_t agreedHeaderVersion = Common::Network::COMPACT_HEADER_VERSION;
+
+		// Packs datagrams for the client and tracks which of them have been acknowledged
+		Common::Network::ReliableEndpoint endpoint;
+
+		// Messages waiting for the client's send budget, and the budget itself
+		SendScheduler scheduler;
+		TokenBucket sendBudget;
+		bool hasScheduled = false;
+
+		// TCP messages packed for the client which haven't been written yet
+		Common::Network::GatherBuffer tcpOutbound;
+		bool hasOutbound = false;
+
+		// Set while the socket's send buffer is full, until the reactor reports it has room again
+		bool writeBlocked = false;
+
+		// Set while the client's backlog is too long for it to be sent anything unreliable, and since when it's been too long to keep up
+		bool shedding = false;
+		std::optional<sf::Time> stalledSince;
+
+		// The limits on what the client may send, on its own and together with every other client at the same address
+		AddressLimits* addressLimits = nullptr;
+		TokenBucket messageLimit;
+		TokenBucket byteLimit;
+
+		// Set while the client's socket is left unread because it went over its limits
+		bool throttled = false;
+
+		// Connections which haven't authenticated count towards the pending limit, and are closed if they take too long
+		sf::Time acceptedAt;
+		bool authenticated = false;
+	};
+
+} // namespace Server
\ No newline at end of file
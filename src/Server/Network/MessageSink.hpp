@@ -0,0 +1,98 @@
+#pragma once
+
+#include <Common/Network/Message.hpp>
+#include <Common/Network/MessageData.hpp>
+#include <Common/Network/MessageType.hpp>
+#include <Common/Network/Protocol.hpp>
+#include <entt/entity/entity.hpp>
+#include <span>
+
+namespace Server
+{
+
+	/**
+	 * \struct MessageRecipient MessageSink.hpp "Network/MessageSink.hpp"
+	 * \brief One of the clients a broadcast goes to, and how it goes to them
+	 */
+	struct MessageRecipient
+	{
+		entt::entity entityID;
+		Common::Network::Protocol protocol;
+		entt::entity subject = entt::null;
+		float priority       = 1.F;
+	};
+
+	/**
+	 * \class MessageSink MessageSink.hpp "Network/MessageSink.hpp"
+	 * \brief Somewhere the world's simulation can send messages to clients, without knowing how they reach them
+	 *
+	 * Implemented by the NetworkManager, which owns the clients' sockets, and by a zone server, which passes the messages on to the
+	 * gateway which does. Every function must be safe to call from any thread, as each shard pushes from its own
+	 */
+	class MessageSink
+	{
+	public:
+		virtual ~MessageSink() = default;
+
+		/**
+		 * \brief Push a message to a specific client
+		 *
+		 * \param protocol The protocol to send the message over
+		 * \param type The type of message to send
+		 * \param entityID The ID of the client to send the message to
+		 * \param data The data to send to the client
+		 */
+		virtual auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, Common::Network::MessageData& data) -> void = 0;
+
+		/**
+		 * \brief Push a message to a specific client, sharing an already packed payload
+		 *
+		 * \param protocol The protocol to send the message over
+		 * \param type The type of message to send
+		 * \param entityID The ID of the client to send the message to
+		 * \param payload The payload to send to the client, which may be shared with other messages
+		 */
+		virtual auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, const Common::Network::SharedPayload& payload) -> void = 0;
+
+		/**
+		 * \brief Push a message about an entity to a specific client
+		 *
+		 * \param protocol The protocol to send the message over
+		 * \param type The type of message to send
+		 * \param entityID The ID of the client to send the message to
+		 * \param data The data to send to the client
+		 * \param subject The entity the message is about
+		 * \param priority How much the message matters to this client, which scales the priority of its type
+		 */
+		virtual auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, Common::Network::MessageData& data, entt::entity subject, float priority) -> void = 0;
+
+		/**
+		 * \brief Push a message about an entity to a specific client, sharing an already packed payload
+		 *
+		 * \param protocol The protocol to send the message over
+		 * \param type The type of message to send
+		 * \param entityID The ID of the client to send the message to
+		 * \param payload The payload to send to the client, which may be shared with other messages
+		 * \param subject The entity the message is about
+		 * \param priority How much the message matters to this client, which scales the priority of its type
+		 */
+		virtual auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, const Common::Network::SharedPayload& payload, entt::entity subject, float priority) -> void = 0;
+
+		/**
+		 * \brief Push the same message to many clients. The payload is packed once and shared between them, however the sink passes
+		 * it on
+		 *
+		 * \param type The type of message to send
+		 * \param recipients The clients to send the message to
+		 * \param data The data to send to every client
+		 */
+		virtual auto pushBroadcast(Common::Network::MessageType type, std::span<const MessageRecipient> recipients, Common::Network::MessageData& data) -> void = 0;
+
+		/**
+		 * \brief Send what's been pushed now, rather than whenever the sink would next get to it
+		 *
+		 */
+		virtual auto wake() -> void = 0;
+	};
+
+} // namespace Server
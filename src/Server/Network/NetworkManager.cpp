@@ -1,15 +1,71 @@
 #include "Network/NetworkManager.hpp"
 #include "Server/Server.hpp"
+#include <algorithm>
+#include <cstring>
+#include <span>
 
 namespace Server
 {
 
+	// Reactor tokens for the server's own sockets. Client sockets use their entity ID as their token
+	const auto LISTENER_TOKEN = Common::Network::SocketReactor::INTERRUPT_TOKEN - 1;
+	const auto UDP_TOKEN      = Common::Network::SocketReactor::INTERRUPT_TOKEN - 2;
+
+	auto getClientToken(const entt::entity entityID) -> std::uint64_t
+	{
+		return static_cast<std::uint64_t>(static_cast<std::uint32_t>(entityID));
+	}
+
+	/**
+	 * \brief Append a message to an outbound buffer as a frame, followed by its shared payload if it has one
+	 *
+	 * \param buffer The buffer to append the frame to
+	 * \param packed The packed and encrypted message, or just its header if it has a shared payload
+	 * \param payload The message's shared payload, which may be empty
+	 */
+	auto appendFrame(Common::Network::GatherBuffer& buffer, const std::vector<std::uint8_t>& packed, const Common::Network::SharedPayload& payload) -> void
+	{
+		auto prefix = Common::Network::FrameAssembler::makePrefix(packed.size() + (payload ? payload->size() : 0));
+		buffer.append(prefix.data(), prefix.size());
+		buffer.append(packed.data(), packed.size());
+		buffer.append(payload);
+	}
+
+	/**
+	 * \brief Turn a per-tick send budget into the rate its token bucket refills at, holding at most one tick's worth
+	 */
+	auto getSendLimit(const SendBudget& budget) -> RateLimit
+	{
+		if (budget.bytesPerTick == 0 || budget.tickLength == sf::Time::Zero)
+		{
+			return {};
+		}
+
+		auto bytesPerTick = static_cast<double>(budget.bytesPerTick);
+		return {bytesPerTick / budget.tickLength.asSeconds(), bytesPerTick};
+	}
+
+	auto makeEndpoint(const sf::IpAddress address, const std::uint16_t port) -> Common::Network::EndpointAddress
+	{
+		return Common::Network::EndpointAddress::fromIPv4(address.toInteger(), port);
+	}
+
 	NetworkManager::NetworkManager(Server& server) :
-	    Manager(server)
+	    Manager(server),
+	    m_receivePool(Common::Network::MAX_DATAGRAM_LENGTH)
 	{
+		// Movement goes first, as stale movement is what players notice. Bulk world state can wait for a quieter tick
+		m_messagePriorities[Common::Network::MessageType::Server_Snapshot]      = 4.F;
+		m_messagePriorities[Common::Network::MessageType::Server_InputState]    = 4.F;
+		m_messagePriorities[Common::Network::MessageType::Server_CreateEntity]  = 2.F;
+		m_messagePriorities[Common::Network::MessageType::Server_DestroyEntity] = 2.F;
+		m_messagePriorities[Common::Network::MessageType::Server_WorldState]    = 0.5F;
 	}
 
-	NetworkManager::~NetworkManager() = default;
+	NetworkManager::~NetworkManager()
+	{
+		stopIOThread();
+	}
 
 	auto NetworkManager::init() -> bool
 	{
@@ -37,20 +93,68 @@ namespace Server
 				return false;
 		}
 
-		m_socketSelector.add(m_udpSocket);
-		m_socketSelector.add(m_tcpListener);
+		// The reactor is edge-triggered, so every socket it watches must be drained without blocking
+		m_udpSocket.setBlocking(false);
+		m_tcpListener.setBlocking(false);
+		m_reactor.add(m_udpSocket, UDP_TOKEN);
+		m_reactor.add(m_tcpListener, LISTENER_TOKEN);
 		return true;
 	}
 
+	auto NetworkManager::startIOThread() -> void
+	{
+		if (m_ioThread.joinable())
+		{
+			return;
+		}
+
+		spdlog::debug("Starting the network I/O thread");
+		m_ioThreadRunning = true;
+		m_ioThread        = std::thread(&NetworkManager::runIOThread, this);
+	}
+
+	auto NetworkManager::configureCompression(const std::filesystem::path& dictionaryDirectory, const std::size_t capturedSamples) -> void
+	{
+		m_compressor.useDefaultPolicies();
+		m_compressor.setCaptureLimit(capturedSamples);
+
+		auto loaded = m_compressor.loadDictionaries(dictionaryDirectory);
+		spdlog::debug("Loaded {} compression dictionaries from {}", loaded, dictionaryDirectory.string());
+	}
+
+	auto NetworkManager::saveCompressionDictionaries(const std::filesystem::path& dictionaryDirectory) -> std::size_t
+	{
+		return m_compressor.saveDictionaries(dictionaryDirectory);
+	}
+
+	auto NetworkManager::stopIOThread() -> void
+	{
+		if (!m_ioThread.joinable())
+		{
+			return;
+		}
+
+		m_ioThreadRunning = false;
+		m_reactor.interrupt();
+		m_ioThread.join();
+		spdlog::debug("Stopped the network I/O thread");
+	}
+
 	auto NetworkManager::shutdown() -> void
 	{
-		for (const auto entity : server.registry.view<Client>())
+		// Take the sockets back from the I/O thread, if there is one
+		stopIOThread();
+
+		processCommands();
+		for (const auto& [entityID, connection] : m_connections)
 		{
-			markForDisconnect(entity);
+			m_clientsPendingDisconnection.emplace_back(entityID);
 		}
 		disconnectClients();
+		processConnectionEvents();
+		m_pendingSockets.clear();
 
-		m_socketSelector.clear();
+		m_reactor.clear();
 		m_udpSocket.unbind();
 		m_tcpListener.close();
 	}
@@ -65,194 +169,652 @@ namespace Server
 		return m_messageQueue.clearInbound();
 	}
 
+	auto NetworkManager::getMessages(std::vector<Common::Network::Message>& messages) -> void
+	{
+		m_messageQueue.clearInbound(messages);
+	}
+
 	auto NetworkManager::pushMessage(const Common::Network::Protocol protocol, const Common::Network::MessageType type, const entt::entity entityID, Common::Network::MessageData& data) -> void
 	{
-		auto message = Common::Network::Message();
-		message.data = data;
+		pushMessage(protocol, type, entityID, data, entt::null, 1.F);
+	}
 
-		message.header.protocol   = protocol;
-		message.header.entityID   = entityID;
-		message.header.identifier = getNextMessageIdentifier();
-		message.header.type       = type;
+	auto NetworkManager::pushMessage(const Common::Network::Protocol protocol, const Common::Network::MessageType type, const entt::entity entityID, const Common::Network::SharedPayload& payload) -> void
+	{
+		pushMessage(protocol, type, entityID, payload, entt::null, 1.F);
+	}
+
+	auto NetworkManager::pushMessage(const Common::Network::Protocol protocol, const Common::Network::MessageType type, const entt::entity entityID, Common::Network::MessageData& data, const entt::entity subject, const float priority) -> void
+	{
+		auto message     = Common::Network::Message();
+		message.data     = data;
+		message.subject  = subject;
+		message.priority = priority;
+
+		message.header.protocol = protocol;
+		message.header.entityID = entityID;
+		message.header.type     = type;
 
 		m_messageQueue.pushOutbound(std::move(message));
 	}
 
+	auto NetworkManager::pushMessage(const Common::Network::Protocol protocol, const Common::Network::MessageType type, const entt::entity entityID, const Common::Network::SharedPayload& payload, const entt::entity subject, const float priority) -> void
+	{
+		auto message          = Common::Network::Message();
+		message.sharedPayload = payload;
+		message.subject       = subject;
+		message.priority      = priority;
+
+		message.header.protocol = protocol;
+		message.header.entityID = entityID;
+		message.header.type     = type;
+
+		m_messageQueue.pushOutbound(std::move(message));
+	}
+
+	auto NetworkManager::pushBroadcast(const Common::Network::MessageType type, const std::span<const MessageRecipient> recipients, Common::Network::MessageData& data) -> void
+	{
+		if (recipients.empty())
+		{
+			return;
+		}
+
+		auto payload = Common::Network::Message::makeSharedPayload(data);
+		for (const auto& recipient : recipients)
+		{
+			pushMessage(recipient.protocol, type, recipient.entityID, payload, recipient.subject, recipient.priority);
+		}
+	}
+
 	auto NetworkManager::pushMessage(const Common::Network::Protocol protocol, const Common::Network::MessageType type, Common::Network::MessageData& data) -> void
 	{
+		// Every client gets the same payload, so only the headers are per-client
+		auto payload = Common::Network::Message::makeSharedPayload(data);
 		for (const auto entity : server.registry.view<Client>())
 		{
-			pushMessage(protocol, type, entity, data);
+			pushMessage(protocol, type, entity, payload);
 		}
 	}
 
-	auto NetworkManager::update(const sf::Time maxSelectorWaitTime = sf::milliseconds(50)) -> void
+	auto NetworkManager::update(const sf::Time maxWaitTime = sf::milliseconds(50)) -> void
 	{
-		// Disconnect any clients awaiting disconnection
-		disconnectClients();
+		if (m_ioThread.joinable())
+		{
+			// Wake the I/O thread so it sends this tick's messages straight away, then wait for something to be received
+			m_reactor.interrupt();
+
+			auto lock = std::unique_lock<std::mutex>(m_inboundMutex);
+			m_inboundCondition.wait_for(lock, std::chrono::microseconds(maxWaitTime.asMicroseconds()), [&]() {
+				return m_inboundReady;
+			});
+			m_inboundReady = false;
+		}
+		else
+		{
+			poll(maxWaitTime);
+		}
+
+		processConnectionEvents();
+	}
 
-		// Clear out the outbound queue
-		auto outboundQueue = m_messageQueue.clearOutbound();
-		for (auto& message : outboundQueue)
+	auto NetworkManager::wake() -> void
+	{
+		m_reactor.interrupt();
+	}
+
+	auto NetworkManager::runIOThread() -> void
+	{
+		// The I/O thread is woken by the simulation thread whenever there's something to send, so this only bounds shutdown latency
+		const auto IO_WAIT_TIME = sf::milliseconds(100);
+
+		while (m_ioThreadRunning)
 		{
-			switch (message.header.protocol)
+			if (poll(IO_WAIT_TIME))
 			{
-				case Common::Network::Protocol::TCP:
-					sendTCP(message);
-					break;
-				case Common::Network::Protocol::UDP:
-					sendUDP(message);
-					break;
+				{
+					auto lock      = std::scoped_lock<std::mutex>(m_inboundMutex);
+					m_inboundReady = true;
+				}
+				m_inboundCondition.notify_one();
 			}
 		}
+	}
+
+	auto NetworkManager::poll(const sf::Time maxWaitTime) -> bool
+	{
+		// Take the outbound queue before applying commands, so that every client it addresses has already been adopted
+		m_messageQueue.clearOutbound(m_outboundMessages);
+		processCommands();
+
+		m_pollSyscalls        = 0;
+		auto datagramSyscalls = m_datagramBatcher.getSyscallCount();
+		m_now                 = m_admissionClock.getElapsedTime();
+
+		for (auto& message : m_outboundMessages)
+		{
+			scheduleMessage(message);
+		}
+		m_outboundMessages.clear();
+
+		// sendUDP and sendTCP only pack messages into each client's endpoint and outbound buffer, so this tick's traffic goes out in as few
+		// datagrams, writes and system calls as possible
+		sendScheduledMessages();
+		flushOutbound();
+		m_datagramBatcher.flush(m_udpSocket);
+		applyBackpressure();
+
+		// Disconnect any clients awaiting disconnection, now that they've been sent their last messages
+		expireConnections();
+		auto closedConnections = disconnectClients();
+
+		// Sockets deferred by the last wakeup are still ready but won't be reported again, so don't block if there are any. Neither
+		// are throttled sockets, so don't block past the point the next of them may be read again
+		auto readySockets = std::move(m_deferredSockets);
+		m_deferredSockets.clear();
+		auto throttledWaitTime = releaseThrottledSockets(readySockets);
+
+		auto waitTime = maxWaitTime;
+		if (!readySockets.empty())
+		{
+			waitTime = sf::Time::Zero;
+		}
+		else if (throttledWaitTime != sf::Time::Zero)
+		{
+			waitTime = std::min(waitTime, throttledWaitTime);
+		}
 
-		// Wait up to maxSelectorWaitTime for a socket to be ready to receive something
-		if (m_socketSelector.wait(maxSelectorWaitTime))
+		// Wait up to maxWaitTime for a socket to be ready to receive something, then service only the sockets that are. Sockets which
+		// have room for writes held back earlier get them straight away
+		auto resumedWrites = false;
+		for (const auto& event : m_reactor.wait(waitTime))
 		{
-			if (m_socketSelector.isReady(m_tcpListener))
+			if (event.writable)
 			{
-				// Handle a new TCP connection
-				acceptNewConnection();
+				resumedWrites = resumeWrites(event.token) || resumedWrites;
 			}
-			else if (m_socketSelector.isReady(m_udpSocket))
+			if (event.readable || event.hangup)
 			{
-				// Handle UDP data
-				receiveUDP();
+				readySockets.emplace_back(event.token);
 			}
-			else
+		}
+		m_pollSyscalls += 1;
+
+		if (resumedWrites)
+		{
+			flushTCP();
+		}
+
+		m_metrics.wakeups += 1;
+		m_wakeupClock.restart();
+		m_wakeupBytes = 0;
+		m_now         = m_admissionClock.getElapsedTime();
+
+		for (auto iterator = readySockets.begin(); iterator != readySockets.end(); ++iterator)
+		{
+			if (isBudgetExhausted())
+			{
+				// Carry the rest over to the next wakeup rather than blowing the tick budget
+				m_deferredSockets.insert(m_deferredSockets.end(), iterator, readySockets.end());
+				m_metrics.exhaustedWakeups += 1;
+				break;
+			}
+
+			if (!serviceSocket(*iterator))
 			{
-				for (const auto entity : server.registry.view<Client>())
+				m_deferredSockets.emplace_back(*iterator);
+			}
+		}
+
+		m_metrics.deferredSockets += m_deferredSockets.size();
+		m_metrics.pendingDeferredSockets = m_deferredSockets.size();
+
+		m_pollSyscalls += m_datagramBatcher.getSyscallCount() - datagramSyscalls;
+		m_metrics.syscalls += m_pollSyscalls;
+		m_metrics.lastWakeupSyscalls = m_pollSyscalls;
+		m_metrics.droppedDatagrams   = m_datagramBatcher.getDroppedCount();
+
+		return closedConnections || !readySockets.empty();
+	}
+
+	auto NetworkManager::setReceiveBudget(const ReceiveBudget budget) -> void
+	{
+		m_receiveBudget = budget;
+	}
+
+	auto NetworkManager::setSendBudget(const SendBudget& budget) -> void
+	{
+		m_sendBudget = budget;
+	}
+
+	auto NetworkManager::setMessagePriority(const Common::Network::MessageType type, const float priority) -> void
+	{
+		m_messagePriorities[type] = priority;
+	}
+
+	auto NetworkManager::setAdmissionPolicy(const AdmissionPolicy& policy) -> void
+	{
+		m_admissionPolicy = policy;
+	}
+
+	auto NetworkManager::setBackpressurePolicy(const BackpressurePolicy& policy) -> void
+	{
+		m_backpressurePolicy = policy;
+	}
+
+	auto NetworkManager::getMetrics() const -> const NetworkMetrics&
+	{
+		return m_metrics;
+	}
+
+	auto NetworkManager::getBacklogs() const -> std::vector<ClientBacklog>
+	{
+		auto lock = std::scoped_lock<std::mutex>(m_backlogMutex);
+		return m_publishedBacklogs;
+	}
+
+	auto NetworkManager::logMetrics() const -> void
+	{
+		spdlog::info("Wakeups: {} ({} ran out of budget)", m_metrics.wakeups.load(), m_metrics.exhaustedWakeups.load());
+		spdlog::info("Deferred sockets: {} ({} pending)", m_metrics.deferredSockets.load(), m_metrics.pendingDeferredSockets.load());
+		spdlog::info("Accepted connections: {} ({} pending authentication)", m_metrics.acceptedConnections.load(), m_metrics.pendingConnections.load());
+		spdlog::info("Refused connections: {} over their address's rate, {} shed over the pending limit, {} expired before authenticating", m_metrics.rejectedConnections.load(), m_metrics.shedConnections.load(), m_metrics.expiredConnections.load());
+		spdlog::info("Throttled: {} TCP reads postponed ({} sockets waiting), {} datagrams dropped", m_metrics.throttledReads.load(), m_metrics.throttledConnections.load(), m_metrics.throttledDatagrams.load());
+		spdlog::info("Received: {} messages, {} bytes", m_metrics.receivedMessages.load(), m_metrics.receivedBytes.load());
+
+		auto wakeups = std::max<std::uint64_t>(m_metrics.wakeups.load(), 1);
+		spdlog::info("Socket system calls: {} ({:.1f} per wakeup, {} last wakeup)", m_metrics.syscalls.load(), static_cast<double>(m_metrics.syscalls.load()) / static_cast<double>(wakeups), m_metrics.lastWakeupSyscalls.load());
+		spdlog::info("Dropped outgoing datagrams: {}", m_metrics.droppedDatagrams.load());
+		spdlog::info("Sent: {} messages in {} datagrams and {} TCP writes", m_metrics.sentMessages.load(), m_metrics.sentDatagrams.load(), m_metrics.tcpWrites.load());
+		spdlog::info("Scheduled messages: {} deferred over a send budget, {} waiting", m_metrics.deferredMessages.load(), m_metrics.scheduledMessages.load());
+		spdlog::info("Backlog: {} bytes waiting (largest {}), {} clients shedding, {} messages shed, {} TCP writes blocked, {} clients disconnected for not keeping up", m_metrics.backlogBytes.load(), m_metrics.largestBacklog.load(), m_metrics.backloggedConnections.load(), m_metrics.shedMessages.load(), m_metrics.blockedWrites.load(), m_metrics.stalledConnections.load());
+		spdlog::info("Resent reliable messages: {}", m_metrics.resentMessages.load());
+		spdlog::info("Receive buffers: {} pooled ({} free), {} too long for the pool", m_receivePool.getAllocatedCount(), m_receivePool.getAvailableCount(), m_receivePool.getOversizedCount());
+
+		for (const auto& [type, statistics] : m_compressor.getStatistics())
+		{
+			auto ratio          = statistics.bytesOut == 0 ? 1.0 : static_cast<double>(statistics.bytesIn) / static_cast<double>(statistics.bytesOut);
+			auto compressCost   = statistics.bytesIn == 0 ? 0.0 : static_cast<double>(statistics.compressNanoseconds) / static_cast<double>(statistics.bytesIn);
+			auto decompressCost = statistics.decompressedBytes == 0 ? 0.0 : static_cast<double>(statistics.decompressNanoseconds) / static_cast<double>(statistics.decompressedBytes);
+			spdlog::info("Compression of message type {}: {} / {} compressed, {} -> {} bytes ({:.2f}x), {:.2f} ns/byte to compress, {:.2f} ns/byte to decompress", static_cast<Common::Network::MessageType_t>(type), statistics.compressed, statistics.attempted, statistics.bytesIn, statistics.bytesOut, ratio, compressCost, decompressCost);
+		}
+
+		auto bufferStatistics = Common::Network::BufferPool::get().getStatistics();
+		spdlog::info("Send buffers: {} hits, {} misses ({} free), {} too long for the pool, {} discarded", bufferStatistics.hits, bufferStatistics.misses, bufferStatistics.available, bufferStatistics.oversized, bufferStatistics.discarded);
+	}
+
+	auto NetworkManager::processConnectionEvents() -> void
+	{
+		for (const auto& event : m_connectionEvents.clear())
+		{
+			switch (event.type)
+			{
+				case ConnectionEvent::Type::Accepted:
 				{
-					auto& client = server.registry.get<Client>(entity);
-					if (m_socketSelector.isReady(*client.tcpSocket))
+					auto entityID = server.registry.create();
+					server.registry.emplace<Client>(entityID);
+					m_commands.push(Command{Command::Type::Adopt, entityID, event.pendingID});
+					spdlog::debug("Connection {} is client {}", event.pendingID, static_cast<std::uint32_t>(entityID));
+
+					// The client is sent their ID once they've connected, along with the header version they'll use from then on
+				}
+				break;
+				case ConnectionEvent::Type::Closed:
+					if (server.registry.valid(event.entityID))
 					{
-						receiveTCP(entity, client);
+						server.registry.destroy(event.entityID);
 					}
-				}
+					break;
 			}
 		}
 	}
 
-	auto generateIdentifier(sf::IpAddress address, std::uint16_t port) -> std::uint64_t
+	auto NetworkManager::processCommands() -> void
 	{
-		std::uint64_t identifier = 0x00;
-		identifier |= static_cast<std::uint64_t>(address.toInteger()) << sizeof(std::uint32_t);
-		identifier |= static_cast<std::uint64_t>(port);
-		return identifier;
+		for (const auto& command : m_commands.clear())
+		{
+			switch (command.type)
+			{
+				case Command::Type::Adopt:
+					adoptConnection(command.pendingID, command.entityID);
+					break;
+				case Command::Type::SetUdpPort:
+				{
+					auto iterator = m_connections.find(command.entityID);
+					if (iterator == m_connections.end())
+					{
+						spdlog::warn("Tried to find client {} but they do not exist", static_cast<std::uint32_t>(command.entityID));
+						break;
+					}
+
+					auto& connection = iterator->second;
+
+					// Replaces the endpoint the client was mapped from before, if any
+					auto remoteAddress = connection.tcpSocket->getRemoteAddress().value();
+					if (!m_endpoints.insert(makeEndpoint(remoteAddress, command.udpPort), command.entityID))
+					{
+						spdlog::warn("Client {} tried to use {}:{}, which belongs to another client", static_cast<std::uint32_t>(command.entityID), remoteAddress.toString(), command.udpPort);
+					}
+
+					connection.udpPort = command.udpPort;
+					spdlog::debug("Set client {} UDP port to {}", static_cast<std::uint32_t>(command.entityID), command.udpPort);
+					spdlog::debug("Mapping {}:{} to {}", remoteAddress.toString(), command.udpPort, static_cast<std::uint32_t>(command.entityID));
+
+					// The client switches once it reads the reply to Client_Connect, and sends nothing but that request before then
+					connection.headerCodec.setDecodingVersion(command.headerVersion);
+					connection.agreedHeaderVersion = command.headerVersion;
+				}
+				break;
+				case Command::Type::Authenticate:
+				{
+					auto iterator = m_connections.find(command.entityID);
+					if (iterator != m_connections.end() && !iterator->second.authenticated)
+					{
+						iterator->second.authenticated = true;
+						m_pendingConnectionCount -= 1;
+						m_metrics.pendingConnections = m_pendingConnectionCount;
+					}
+				}
+				break;
+				case Command::Type::Disconnect:
+					m_clientsPendingDisconnection.emplace_back(command.entityID);
+					break;
+			}
+		}
 	}
 
 	auto NetworkManager::resolveClientID(sf::IpAddress ipAddress, std::uint16_t port) -> std::optional<entt::entity>
 	{
-		std::uint64_t identifier = generateIdentifier(ipAddress, port);
-		auto iterator            = m_clientIPMap.find(identifier);
-		if (iterator == m_clientIPMap.end())
+		auto entityID = m_endpoints.find(makeEndpoint(ipAddress, port));
+		if (entityID == entt::null)
 		{
 			return {};
 		}
 
-		return {iterator->second};
+		return {entityID};
 	}
 
-	auto NetworkManager::setClientUdpPort(entt::entity entityID, std::uint16_t udpPort) -> void
+	auto NetworkManager::setClientUdpPort(entt::entity entityID, std::uint16_t udpPort, std::uint8_t headerVersion) -> void
 	{
 		if (!server.registry.all_of<Client>(entityID))
 		{
 			spdlog::warn("Tried to find client {} but they do not exist", static_cast<std::uint32_t>(entityID));
+			return;
 		}
 
-		auto& client = server.registry.get<Client>(entityID);
-
-		auto originalIdentifier = generateIdentifier(*client.tcpSocket->getRemoteAddress(), client.udpPort);
-		m_clientIPMap.erase(originalIdentifier);
+		auto agreedVersion = Common::Network::negotiateHeaderVersion(headerVersion);
+		m_commands.push(Command{Command::Type::SetUdpPort, entityID, 0, udpPort, agreedVersion});
 
-		client.udpPort     = udpPort;
-		auto newIdentifier = generateIdentifier(client.tcpSocket->getRemoteAddress().value(), udpPort);
-		m_clientIPMap.emplace(newIdentifier, entityID);
-		spdlog::debug("Set client {} UDP port to {}", static_cast<std::uint32_t>(entityID), udpPort);
-		spdlog::debug("Mapping identifier {} ({}:{}) to {}", newIdentifier, client.tcpSocket->getRemoteAddress()->toString(), udpPort, static_cast<std::uint32_t>(entityID));
-
-		// Send the client back their client ID
+		// Send the client back their client ID, and the header version to switch to
 		auto data = Common::Network::MessageData();
-		data << entityID;
+		data << entityID << agreedVersion;
 		pushMessage(Common::Network::Protocol::TCP, Common::Network::MessageType::Server_SetClientID, entityID, data);
 	}
 
+	auto NetworkManager::markAuthenticated(const entt::entity entityID) -> void
+	{
+		m_commands.push(Command{Command::Type::Authenticate, entityID});
+	}
+
 	auto NetworkManager::markForDisconnect(entt::entity entityID) -> void
 	{
-		m_clientsPendingDisconnection.emplace_back(entityID);
+		m_commands.push(Command{Command::Type::Disconnect, entityID});
 	}
 
-	auto NetworkManager::acceptNewConnection() -> void
+	auto NetworkManager::serviceSocket(const std::uint64_t token) -> bool
 	{
-		auto tcpSocket = std::make_unique<sf::TcpSocket>();
+		if (token == LISTENER_TOKEN)
+		{
+			// Handle new TCP connections
+			return acceptNewConnections();
+		}
 
-		// Initialise the client sockets
-		auto status = m_tcpListener.accept(*tcpSocket);
-		switch (status)
+		if (token == UDP_TOKEN)
 		{
-			case sf::Socket::Status::Done:
+			// Handle UDP data
+			return receiveUDP();
+		}
+
+		// Handle TCP data from a client, whose entity ID is the token
+		auto iterator = m_connections.find(static_cast<entt::entity>(token));
+		if (iterator != m_connections.end())
+		{
+			return receiveTCP(iterator->first, iterator->second);
+		}
+
+		// The client has gone, so there's nothing left to drain
+		return true;
+	}
+
+	auto NetworkManager::isBudgetExhausted() const -> bool
+	{
+		return m_wakeupBytes >= m_receiveBudget.maxBytes || m_wakeupClock.getElapsedTime() >= m_receiveBudget.maxTime;
+	}
+
+	auto NetworkManager::getAddressLimits(const std::uint32_t address) -> AddressLimits&
+	{
+		auto [iterator, inserted] = m_addressLimits.try_emplace(address);
+		if (inserted)
+		{
+			iterator->second.connections = TokenBucket(m_admissionPolicy.connectionsPerAddress, m_now);
+			iterator->second.messages    = TokenBucket(m_admissionPolicy.messagesPerAddress, m_now);
+			iterator->second.bytes       = TokenBucket(m_admissionPolicy.bytesPerAddress, m_now);
+		}
+		else
+		{
+			iterator->second.connections.refill(m_now);
+		}
+		return iterator->second;
+	}
+
+	auto NetworkManager::isThrottled(Connection& connection) -> bool
+	{
+		connection.messageLimit.refill(m_now);
+		connection.byteLimit.refill(m_now);
+		connection.addressLimits->messages.refill(m_now);
+		connection.addressLimits->bytes.refill(m_now);
+
+		return !connection.messageLimit.hasTokens() || !connection.byteLimit.hasTokens() || !connection.addressLimits->messages.hasTokens() || !connection.addressLimits->bytes.hasTokens();
+	}
+
+	auto NetworkManager::chargeReceived(Connection& connection, const std::size_t messages, const std::size_t bytes) -> void
+	{
+		connection.messageLimit.take(static_cast<double>(messages));
+		connection.byteLimit.take(static_cast<double>(bytes));
+		connection.addressLimits->messages.take(static_cast<double>(messages));
+		connection.addressLimits->bytes.take(static_cast<double>(bytes));
+	}
+
+	auto NetworkManager::releaseThrottledSockets(std::vector<std::uint64_t>& readySockets) -> sf::Time
+	{
+		auto waitTime = sf::Time::Zero;
+		auto retained = std::size_t(0);
+		for (const auto token : m_throttledSockets)
+		{
+			auto iterator = m_connections.find(static_cast<entt::entity>(token));
+			if (iterator == m_connections.end())
 			{
-				auto entityID = server.registry.create();
-				auto& client  = server.registry.emplace<Client>(entityID);
+				continue;
+			}
 
-				client.tcpSocket = std::move(tcpSocket);
-				m_socketSelector.add(*client.tcpSocket);
+			auto& connection = iterator->second;
+			if (!isThrottled(connection))
+			{
+				connection.throttled = false;
+				readySockets.emplace_back(token);
+				continue;
+			}
 
-				// Success
-				auto clientAddress = client.tcpSocket->getRemoteAddress().value();
-				spdlog::debug("Accepted a new connection from {} as client {}", clientAddress.toString(), static_cast<std::uint32_t>(entityID));
+			// Whichever limit takes longest to pay off decides when the socket may be read again
+			auto untilTokens = std::max({connection.messageLimit.getTimeUntilTokens(), connection.byteLimit.getTimeUntilTokens(), connection.addressLimits->messages.getTimeUntilTokens(), connection.addressLimits->bytes.getTimeUntilTokens()});
+			waitTime         = (waitTime == sf::Time::Zero) ? untilTokens : std::min(waitTime, untilTokens);
+			m_throttledSockets[retained++] = token;
+		}
 
-				auto data = Common::Network::MessageData();
-				data << entityID;
-				pushMessage(Common::Network::Protocol::TCP, Common::Network::MessageType::Server_SetClientID, entityID, data);
+		m_throttledSockets.resize(retained);
+		m_metrics.throttledConnections = retained;
+		return waitTime;
+	}
+
+	auto NetworkManager::expireConnections() -> void
+	{
+		// Only worth checking now and then, as the limits involved are measured in seconds
+		const auto EXPIRY_INTERVAL = sf::seconds(1);
+		if (m_now - m_lastExpiry < EXPIRY_INTERVAL)
+		{
+			return;
+		}
+		m_lastExpiry = m_now;
+
+		for (const auto& [entityID, connection] : m_connections)
+		{
+			if (!connection.authenticated && m_now - connection.acceptedAt > m_admissionPolicy.authenticationTimeout)
+			{
+				spdlog::debug("Client {} took too long to authenticate", static_cast<std::uint32_t>(entityID));
+				m_clientsPendingDisconnection.emplace_back(entityID);
+				m_metrics.expiredConnections += 1;
+			}
+		}
+
+		// An address is only forgotten once it could connect again as if it never had
+		for (auto iterator = m_addressLimits.begin(); iterator != m_addressLimits.end();)
+		{
+			auto& limits = iterator->second;
+			limits.connections.refill(m_now);
+			if (limits.connectionCount == 0 && limits.connections.isFull())
+			{
+				iterator = m_addressLimits.erase(iterator);
+			}
+			else
+			{
+				++iterator;
 			}
-			break;
-			default:
-				spdlog::warn("TCP listener failed to accept a connection");
-				return;
 		}
 	}
 
-	auto NetworkManager::closeConnection(entt::entity entityID) -> void
+	auto NetworkManager::acceptNewConnections() -> bool
 	{
-		spdlog::debug("Closing connection {}", static_cast<std::uint32_t>(entityID));
+		auto acceptedCount = std::size_t(0);
+		while (!isBudgetExhausted() && acceptedCount < m_admissionPolicy.maxAcceptsPerWakeup)
+		{
+			auto tcpSocket = std::make_unique<sf::TcpSocket>();
+
+			// Initialise the client sockets
+			auto status = m_tcpListener.accept(*tcpSocket);
+			m_pollSyscalls += 1;
+			switch (status)
+			{
+				case sf::Socket::Status::Done:
+				{
+					acceptedCount += 1;
+
+					// Connections refused here are closed as the socket goes out of scope, before the simulation thread hears of them
+					auto clientAddress = tcpSocket->getRemoteAddress().value();
+					auto& limits       = getAddressLimits(clientAddress.toInteger());
+					if (!limits.connections.tryTake(1.0))
+					{
+						spdlog::debug("Refused a connection from {}, which is connecting too often", clientAddress.toString());
+						m_metrics.rejectedConnections += 1;
+						break;
+					}
 
-		if (!server.registry.valid(entityID))
+					if (m_pendingConnectionCount >= m_admissionPolicy.maxPendingConnections)
+					{
+						spdlog::debug("Shed a connection from {}, as {} connections are waiting to authenticate", clientAddress.toString(), m_pendingConnectionCount);
+						m_metrics.shedConnections += 1;
+						break;
+					}
+
+					// Success, but the simulation thread has to create the client's entity before we can talk to them
+					auto pendingID = ++m_lastPendingID;
+					tcpSocket->setBlocking(false);
+					spdlog::debug("Accepted a new connection from {} as connection {}", clientAddress.toString(), pendingID);
+
+					limits.connectionCount += 1;
+					m_pendingConnectionCount += 1;
+					m_metrics.pendingConnections = m_pendingConnectionCount;
+
+					m_pendingSockets.emplace(pendingID, PendingSocket{std::move(tcpSocket), &limits, m_now});
+					m_connectionEvents.push(ConnectionEvent{ConnectionEvent::Type::Accepted, entt::null, pendingID});
+					m_metrics.acceptedConnections += 1;
+				}
+				break;
+				case sf::Socket::Status::NotReady:
+					// The accept backlog is empty
+					return true;
+				default:
+					spdlog::warn("TCP listener failed to accept a connection");
+					return true;
+			}
+		}
+
+		return false;
+	}
+
+	auto NetworkManager::adoptConnection(const std::uint64_t pendingID, const entt::entity entityID) -> void
+	{
+		auto iterator = m_pendingSockets.find(pendingID);
+		if (iterator == m_pendingSockets.end())
 		{
-			spdlog::warn("Attempted to close connection {} but the entity is not valid", static_cast<std::uint32_t>(entityID));
+			spdlog::warn("Tried to adopt connection {} but it does not exist", pendingID);
 			return;
 		}
 
-		if (!server.registry.all_of<Client>(entityID))
+		auto& connection         = m_connections[entityID];
+		connection.tcpSocket     = std::move(iterator->second.tcpSocket);
+		connection.addressLimits = iterator->second.addressLimits;
+		connection.acceptedAt    = iterator->second.acceptedAt;
+		connection.messageLimit  = TokenBucket(m_admissionPolicy.messagesPerConnection, m_now);
+		connection.byteLimit     = TokenBucket(m_admissionPolicy.bytesPerConnection, m_now);
+		connection.sendBudget    = TokenBucket(getSendLimit(m_sendBudget), m_now);
+		m_pendingSockets.erase(iterator);
+
+		// Anything the client sent before now is reported as soon as the socket is registered
+		m_reactor.add(*connection.tcpSocket, getClientToken(entityID), true);
+	}
+
+	auto NetworkManager::closeConnection(entt::entity entityID) -> void
+	{
+		spdlog::debug("Closing connection {}", static_cast<std::uint32_t>(entityID));
+
+		auto connectionIterator = m_connections.find(entityID);
+		if (connectionIterator == m_connections.end())
 		{
 			spdlog::warn("Attempted to close connection {} but it does not exist", static_cast<std::uint32_t>(entityID));
 			return;
 		}
 
 		// Disconnect the client
-		auto& client = server.registry.get<Client>(entityID);
-		m_socketSelector.remove(*client.tcpSocket);
-		client.tcpSocket->disconnect();
+		auto& connection = connectionIterator->second;
+		m_reactor.remove(*connection.tcpSocket);
+		connection.tcpSocket->disconnect();
 
-		auto ipMapIterator = std::find_if(m_clientIPMap.begin(), m_clientIPMap.end(), [&](const std::pair<std::uint64_t, entt::entity> element) {
-			return element.second == entityID;
-		});
-		if (ipMapIterator != m_clientIPMap.end())
+		m_endpoints.erase(entityID);
+
+		connection.addressLimits->connectionCount -= 1;
+		if (!connection.authenticated)
 		{
-			m_clientIPMap.erase(ipMapIterator);
+			m_pendingConnectionCount -= 1;
+			m_metrics.pendingConnections = m_pendingConnectionCount;
 		}
 
-		server.registry.destroy(entityID);
+		m_connections.erase(connectionIterator);
+		m_connectionEvents.push(ConnectionEvent{ConnectionEvent::Type::Closed, entityID});
 		spdlog::debug("Connection closed successfully");
 	}
 
-	auto NetworkManager::disconnectClients() -> void
+	auto NetworkManager::disconnectClients() -> bool
 	{
+		if (m_clientsPendingDisconnection.empty())
+		{
+			return false;
+		}
+
 		for (const auto entityID : m_clientsPendingDisconnection)
 		{
 			closeConnection(entityID);
 		}
 		m_clientsPendingDisconnection.clear();
+		return true;
 	}
 
 	auto NetworkManager::validateIncomingMessage(const entt::entity entityID, Common::Network::MessageHeader& header) -> bool
@@ -263,158 +825,502 @@ namespace Server
 			return false;
 		}
 
-		if (!server.registry.all_of<Client>(entityID))
+		auto iterator = m_connections.find(entityID);
+		if (iterator == m_connections.end())
 		{
 			// Client doesn't exist in the server's client map
 			return false;
 		}
 
-		auto& client = server.registry.get<Client>(entityID);
-		if (client.lastMessageIdentifier > header.identifier)
+		// Only plain UDP can arrive out of order or twice. TCP is a stream and can't, while sequenced messages are ordered and
+		// deduplicated on their own channel by the client's endpoint instead
+		if (header.protocol != Common::Network::Protocol::UDP)
+		{
+			return true;
+		}
+
+		auto& connection = iterator->second;
+		if (connection.lastMessageIdentifier > header.identifier)
 		{
 			// Message is out-of-date
 			return false;
 		}
 
 		// Update the last message identifier because we have a newer message
-		client.lastMessageIdentifier = header.identifier;
+		connection.lastMessageIdentifier = header.identifier;
 
 		return true;
 	}
 
-	auto NetworkManager::getNextMessageIdentifier() -> std::uint64_t
-	{
-		return ++m_currentMessageIdentifier;
-	}
-
-	auto NetworkManager::sendUDP(Common::Network::Message& message) -> void
+	auto NetworkManager::scheduleMessage(Common::Network::Message& message) -> void
 	{
-		if (!server.registry.valid(message.header.entityID))
+		auto iterator = m_connections.find(message.header.entityID);
+		if (iterator == m_connections.end())
 		{
+			if (message.header.protocol != Common::Network::Protocol::TCP)
+			{
+				spdlog::warn("Tried to send a message to a client ({}) but they don't exist", static_cast<std::uint32_t>(message.header.entityID));
+			}
 			return;
 		}
 
-		if (!server.registry.all_of<Client>(message.header.entityID))
+		auto& connection = iterator->second;
+
+		// A client too far behind is only sent what it can't do without, as anything unreliable will be superseded anyway
+		const auto protocol = message.header.protocol;
+		if (connection.shedding && protocol != Common::Network::Protocol::TCP && !Common::Network::isReliable(protocol))
 		{
-			spdlog::warn("Tried to send a message to a client ({}) but they don't exist", static_cast<std::uint32_t>(message.header.entityID));
+			m_metrics.shedMessages += 1;
 			return;
 		}
 
-		auto& client                = server.registry.get<Client>(message.header.entityID);
-		sf::IpAddress remoteAddress = client.tcpSocket->getRemoteAddress().value();
-		std::uint16_t remotePort    = client.udpPort;
+		// Compressed now rather than when packed, as a payload shared by many clients is only compressed once if they follow one another.
+		// Clients which haven't switched to a header with message flags yet can't be told the payload is compressed
+		if (connection.headerCodec.getEncodingVersion() >= Common::Network::COMPRESSED_HEADER_VERSION)
+		{
+			m_compressor.compress(message);
+		}
+
+		auto typePriority = m_messagePriorities.find(message.header.type);
+		auto weight       = message.priority * (typePriority == m_messagePriorities.end() ? 1.F : typePriority->second);
+		connection.scheduler.push(std::move(message), weight);
 
-		auto buffer = message.pack();
-		m_cryptographer.encrypt(buffer);
+		if (!connection.hasScheduled)
+		{
+			connection.hasScheduled = true;
+			m_connectionsWithScheduled.emplace_back(iterator->first);
+		}
+	}
 
-		auto status = m_udpSocket.send(buffer.data(), buffer.size(), remoteAddress, remotePort);
+	auto NetworkManager::sendScheduledMessages() -> void
+	{
+		// Priorities grow by a message's weight for every tick it waits, however often the sockets are polled
+		auto ticks      = m_sendBudget.tickLength == sf::Time::Zero ? 1.F : (m_now - m_lastScheduled) / m_sendBudget.tickLength;
+		m_lastScheduled = m_now;
 
-		switch (status)
+		auto connectionsWithScheduled = std::move(m_connectionsWithScheduled);
+		m_connectionsWithScheduled.clear();
+
+		auto waitingCount = std::size_t(0);
+		for (const auto entityID : connectionsWithScheduled)
 		{
-			case sf::Socket::Status::Done:
-				// Success
-				break;
-			default:
-				spdlog::warn("Failed to send UDP packet to {}:{}", remoteAddress.toString(), remotePort);
+			auto iterator = m_connections.find(entityID);
+			if (iterator == m_connections.end())
+			{
+				continue;
+			}
+
+			auto& connection = iterator->second;
+			connection.scheduler.age(ticks);
+			connection.sendBudget.refill(m_now);
+
+			m_scheduledMessages.clear();
+			connection.scheduler.take(connection.sendBudget, m_scheduledMessages);
+			for (auto& message : m_scheduledMessages)
+			{
+				if (message.header.protocol == Common::Network::Protocol::TCP)
+				{
+					sendTCP(message, connection);
+				}
+				else
+				{
+					sendUDP(message, connection);
+				}
+			}
+
+			// Whatever didn't fit waits for the next poll, with its priority still growing
+			connection.hasScheduled = !connection.scheduler.empty();
+			if (connection.hasScheduled)
+			{
+				waitingCount += connection.scheduler.size();
+				m_metrics.deferredMessages += connection.scheduler.size();
+				m_connectionsWithScheduled.emplace_back(entityID);
+			}
 		}
+		m_scheduledMessages.clear();
+		m_metrics.scheduledMessages = waitingCount;
 	}
 
-	auto NetworkManager::receiveUDP() -> void
+	auto NetworkManager::sendUDP(Common::Network::Message& message, Connection& connection) -> void
 	{
-		std::optional<sf::IpAddress> remoteAddress;
-		std::uint16_t remotePort = 0;
+		// The sequence number is part of the header, so it has to be stamped before the message is packed
+		connection.endpoint.stampHeader(message.header);
+		auto packed = packMessage(message, connection);
+		connection.endpoint.send(message.header.protocol, std::move(packed), message.sharedPayload);
+		m_metrics.sentMessages += 1;
+	}
 
-		auto buffer        = std::array<std::uint8_t, Common::Network::MAX_MESSAGE_LENGTH>();
-		std::size_t length = 0;
+	auto NetworkManager::packMessage(Common::Network::Message& message, Connection& connection) -> std::vector<std::uint8_t>
+	{
+		// Given out as the message is sent rather than when it was pushed, as the scheduler may send messages in a different order, and
+		// the client drops plain UDP with an identifier older than the last it read
+		message.header.identifier = ++connection.lastSentIdentifier;
+
+		// A shared payload is gathered straight from the shared buffer when the message is sent, so only the header is packed
+		auto packed = message.sharedPayload ? message.packHeader(connection.headerCodec) : message.pack(connection.headerCodec);
+		m_cryptographer.encrypt(packed);
+		return packed;
+	}
 
-		auto status = m_udpSocket.receive(buffer.data(), Common::Network::MAX_MESSAGE_LENGTH, length, remoteAddress, remotePort);
-		if (status != sf::Socket::Status::Done)
+	auto NetworkManager::markOutbound(const entt::entity entityID, Connection& connection) -> void
+	{
+		if (!connection.hasOutbound)
 		{
-			spdlog::warn("Dropped UDP packet");
+			connection.hasOutbound = true;
+			m_connectionsWithOutbound.emplace_back(entityID);
 		}
+	}
 
-		auto optClientID = resolveClientID(*remoteAddress, remotePort);
-		if (!optClientID.has_value())
+	auto NetworkManager::flushOutbound() -> void
+	{
+		// Every endpoint is flushed, even without new messages, as it may have reliable messages to resend or acknowledgements to send
+		for (auto& [entityID, connection] : m_connections)
 		{
-			spdlog::warn("Received a packet from a client that the server doesn't recognise ({}:{})", remoteAddress->toString(), remotePort);
-			return;
+			auto resentCount = connection.endpoint.getResentCount();
+			auto datagrams   = connection.endpoint.flush();
+			m_metrics.resentMessages += connection.endpoint.getResentCount() - resentCount;
+			if (datagrams.empty())
+			{
+				continue;
+			}
+
+			auto remoteAddress = connection.tcpSocket->getRemoteAddress();
+			if (!remoteAddress.has_value())
+			{
+				continue;
+			}
+
+			for (auto& datagram : datagrams)
+			{
+				m_datagramBatcher.queue(std::move(datagram), *remoteAddress, connection.udpPort);
+				m_metrics.sentDatagrams += 1;
+			}
 		}
 
-		auto vBuffer = std::vector<std::uint8_t>(buffer.data(), buffer.data() + length);
-		m_cryptographer.decryptFromRemote(vBuffer);
+		flushTCP();
+	}
 
-		auto message = Common::Network::Message();
-		message.unpack(vBuffer);
+	auto NetworkManager::flushTCP() -> void
+	{
+		auto connectionsWithOutbound = std::move(m_connectionsWithOutbound);
+		m_connectionsWithOutbound.clear();
 
-		if (validateIncomingMessage(*optClientID, message.header))
+		for (const auto entityID : connectionsWithOutbound)
 		{
-			m_messageQueue.pushInbound(std::move(message));
+			auto iterator = m_connections.find(entityID);
+			if (iterator == m_connections.end())
+			{
+				continue;
+			}
+
+			// A client whose socket is full keeps its messages until the reactor says there's room, which marks it again
+			auto& connection       = iterator->second;
+			connection.hasOutbound = false;
+			if (connection.tcpOutbound.empty() || connection.writeBlocked)
+			{
+				continue;
+			}
+
+			// Everything the client is owed over TCP goes out in a single gathering write, and whatever doesn't fit is kept, even if
+			// that's part of a frame, so the stream picks up where it left off
+			auto sent   = std::size_t(0);
+			auto status = connection.tcpOutbound.send(*connection.tcpSocket, sent);
+			connection.tcpOutbound.consume(sent);
+			m_pollSyscalls += 1;
+			m_metrics.tcpWrites += 1;
+			switch (status)
+			{
+				case sf::Socket::Status::Done:
+					break;
+				case sf::Socket::Status::NotReady:
+				case sf::Socket::Status::Partial:
+					m_metrics.blockedWrites += 1;
+					if (Common::Network::SocketReactor::REPORTS_WRITABLE)
+					{
+						connection.writeBlocked = true;
+					}
+					else
+					{
+						markOutbound(entityID, connection);
+					}
+					break;
+				case sf::Socket::Status::Disconnected:
+					m_clientsPendingDisconnection.emplace_back(entityID);
+					break;
+				default:
+					spdlog::warn("Failed to send TCP packet");
+					connection.tcpOutbound.clear();
+			}
 		}
 	}
 
-	auto NetworkManager::sendTCP(Common::Network::Message& message) -> void
+	auto NetworkManager::resumeWrites(const std::uint64_t token) -> bool
 	{
-		if (!server.registry.valid(message.header.entityID))
+		auto iterator = m_connections.find(static_cast<entt::entity>(token));
+		if (iterator == m_connections.end() || !iterator->second.writeBlocked)
 		{
-			return;
+			return false;
 		}
 
-		if (!server.registry.all_of<Client>(message.header.entityID))
+		auto& connection        = iterator->second;
+		connection.writeBlocked = false;
+		if (connection.tcpOutbound.empty())
 		{
-			return;
+			return false;
 		}
 
-		auto& client = server.registry.get<Client>(message.header.entityID);
-		auto& socket = client.tcpSocket;
+		markOutbound(iterator->first, connection);
+		return true;
+	}
 
-		auto buffer = message.pack();
-		m_cryptographer.encrypt(buffer);
+	auto NetworkManager::applyBackpressure() -> void
+	{
+		auto backloggedCount = std::size_t(0);
+		auto backlogBytes    = std::size_t(0);
+		auto largestBacklog  = std::size_t(0);
+		m_backlogs.clear();
 
-		auto status = socket->send(buffer.data(), buffer.size());
-		switch (status)
+		for (auto& [entityID, connection] : m_connections)
 		{
-			case sf::Socket::Status::Done:
-				// Success
-				break;
-			case sf::Socket::Status::Disconnected:
-				markForDisconnect(message.header.entityID);
-				break;
-			default:
-				spdlog::warn("Failed to send TCP packet");
+			auto backlog = connection.tcpOutbound.size() + connection.scheduler.getByteCount();
+			if (backlog == 0)
+			{
+				connection.shedding = false;
+				connection.stalledSince.reset();
+				continue;
+			}
+
+			backlogBytes += backlog;
+			largestBacklog = std::max(largestBacklog, backlog);
+			m_backlogs.emplace_back(ClientBacklog{entityID, connection.tcpOutbound.size(), connection.scheduler.size(), connection.scheduler.getByteCount()});
+
+			// Shedding carries on until the backlog is well under the mark, so a client hovering around it isn't flipped every poll
+			auto shedding = backlog > m_backpressurePolicy.sheddingBacklog || (connection.shedding && backlog > m_backpressurePolicy.sheddingBacklog / 2);
+			if (shedding && !connection.shedding)
+			{
+				spdlog::debug("Client {} has fallen {} bytes behind, so its unreliable messages are being dropped", static_cast<std::uint32_t>(entityID), backlog);
+				m_metrics.shedMessages += connection.scheduler.dropUnreliable();
+			}
+			connection.shedding = shedding;
+			backloggedCount += shedding ? 1 : 0;
+
+			if (backlog <= m_backpressurePolicy.disconnectBacklog)
+			{
+				connection.stalledSince.reset();
+			}
+			else if (!connection.stalledSince.has_value())
+			{
+				connection.stalledSince = m_now;
+			}
+			else if (m_now - *connection.stalledSince >= m_backpressurePolicy.stallTimeout)
+			{
+				spdlog::warn("Client {} isn't keeping up with what it's sent ({} bytes behind)", static_cast<std::uint32_t>(entityID), backlog);
+				m_clientsPendingDisconnection.emplace_back(entityID);
+				m_metrics.stalledConnections += 1;
+				connection.stalledSince.reset();
+			}
 		}
+
+		m_metrics.backloggedConnections = backloggedCount;
+		m_metrics.backlogBytes          = backlogBytes;
+		m_metrics.largestBacklog        = largestBacklog;
+
+		auto lock = std::scoped_lock<std::mutex>(m_backlogMutex);
+		std::swap(m_publishedBacklogs, m_backlogs);
 	}
 
-	auto NetworkManager::receiveTCP(entt::entity entityID, Client& client) -> void
+	auto NetworkManager::receiveUDP() -> bool
 	{
-		static auto buffer = std::array<std::uint8_t, Common::Network::MAX_MESSAGE_LENGTH>();
-		std::size_t length = 0;
-
-		auto status = client.tcpSocket->receive(buffer.data(), buffer.size(), length);
-		switch (status)
+		while (!isBudgetExhausted())
 		{
-			case sf::Socket::Status::Done:
+			const auto& datagrams = m_datagramBatcher.receive(m_udpSocket);
+			if (datagrams.empty())
 			{
-				auto vBuffer = std::vector<std::uint8_t>(buffer.data(), buffer.data() + length);
-				m_cryptographer.decryptFromRemote(vBuffer);
+				// The socket has been drained
+				return true;
+			}
+
+			for (const auto& datagram : datagrams)
+			{
+				m_wakeupBytes += datagram.length;
+				m_metrics.receivedBytes += datagram.length;
+
+				auto optClientID = resolveClientID(datagram.address, datagram.port);
+				if (!optClientID.has_value())
+				{
+					spdlog::warn("Received a packet from a client that the server doesn't recognise ({}:{})", datagram.address.toString(), datagram.port);
+					continue;
+				}
+
+				auto iterator = m_connections.find(*optClientID);
+				if (iterator == m_connections.end())
+				{
+					continue;
+				}
+
+				// Datagrams over the client's limits are dropped unread, and anything reliable in them is resent later
+				if (isThrottled(iterator->second))
+				{
+					m_metrics.throttledDatagrams += 1;
+					continue;
+				}
+
+				// The packet header carries the client's acknowledgements, and duplicate datagrams are dropped here
+				auto& endpoint = iterator->second.endpoint;
+				auto offset    = endpoint.receivePacket(datagram.data, datagram.length);
+				if (!offset.has_value())
+				{
+					continue;
+				}
+
+				// The rest of the datagram is copied once into a pooled buffer, which the messages in it read their data from
+				auto buffer = m_receivePool.acquire(datagram.length - *offset);
+				std::memcpy(buffer.data(), datagram.data + *offset, buffer.size());
+
+				// After the packet header, a datagram holds zero or more framed messages
+				m_deliveredMessages.clear();
+				auto frameCount  = std::size_t(0);
+				auto frameOffset = std::size_t(0);
+				while (auto frame = Common::Network::FrameAssembler::readFrame(buffer.data(), buffer.size(), frameOffset))
+				{
+					frameCount += 1;
+
+					auto messageOffset = static_cast<std::size_t>(frame->data() - buffer.data());
+					m_cryptographer.decryptFromRemote(std::span<std::uint8_t>(buffer.data() + messageOffset, frame->size()));
+
+					auto message = Common::Network::Message();
+					if (!message.unpack(buffer, messageOffset, frame->size(), iterator->second.headerCodec, Common::Network::Protocol::UDP))
+					{
+						continue;
+					}
 
-				auto message = Common::Network::Message();
-				message.unpack(vBuffer);
+					if (!m_compressor.decompress(message))
+					{
+						spdlog::warn("Dropped compressed message from client {} which couldn't be decompressed", static_cast<std::uint32_t>(*optClientID));
+						continue;
+					}
 
-				// Special case because setting ports is hard
-				if (message.header.type == Common::Network::MessageType::Client_Connect)
+					if (validateIncomingMessage(*optClientID, message.header))
+					{
+						endpoint.receiveMessage(std::move(message), m_deliveredMessages);
+					}
+				}
+
+				chargeReceived(iterator->second, frameCount, datagram.length);
+
+				for (auto& message : m_deliveredMessages)
 				{
-					message.header.entityID = entityID;
+					m_messageQueue.pushInbound(std::move(message));
+					m_metrics.receivedMessages += 1;
 				}
+			}
+		}
+
+		return false;
+	}
 
-				m_messageQueue.pushInbound(std::move(message));
+	auto NetworkManager::sendTCP(Common::Network::Message& message, Connection& connection) -> void
+	{
+		auto packed = packMessage(message, connection);
+		appendFrame(connection.tcpOutbound, packed, message.sharedPayload);
+		Common::Network::BufferPool::get().release(std::move(packed));
+		markOutbound(message.header.entityID, connection);
+		m_metrics.sentMessages += 1;
+
+		// The reply to Client_Connect is the last message the client reads with the header version both sides started with
+		if (message.header.type == Common::Network::MessageType::Server_SetClientID)
+		{
+			connection.headerCodec.setEncodingVersion(connection.agreedHeaderVersion);
+		}
+	}
+
+	auto NetworkManager::receiveTCP(entt::entity entityID, Connection& connection) -> bool
+	{
+		while (!isBudgetExhausted())
+		{
+			// A client over its limits is left unread, so the kernel buffers what it sends and TCP slows it down
+			if (connection.throttled)
+			{
+				return true;
+			}
+
+			if (isThrottled(connection))
+			{
+				connection.throttled = true;
+				m_throttledSockets.emplace_back(getClientToken(entityID));
+				m_metrics.throttledReads += 1;
+				return true;
 			}
-			break;
-			case sf::Socket::Status::Disconnected:
-				markForDisconnect(entityID);
+
+			std::size_t length = 0;
+
+			auto status = connection.tcpSocket->receive(m_tcpReceiveBuffer.data(), m_tcpReceiveBuffer.size(), length);
+			m_pollSyscalls += 1;
+			switch (status)
+			{
+				case sf::Socket::Status::Done:
+				{
+					m_wakeupBytes += length;
+					m_metrics.receivedBytes += length;
+
+					// A read may hold any number of messages, and may end part way through one
+					auto frameCount = std::size_t(0);
+					connection.frameAssembler.append(m_tcpReceiveBuffer.data(), length);
+					while (auto frame = connection.frameAssembler.nextView())
+					{
+						frameCount += 1;
+
+						// Each frame is copied once out of the stream into a pooled buffer, which its message reads its data from
+						auto buffer = m_receivePool.acquire(frame->size());
+						std::memcpy(buffer.data(), frame->data(), frame->size());
+						m_cryptographer.decryptFromRemote(std::span<std::uint8_t>(buffer.data(), buffer.size()));
+
+						auto message = Common::Network::Message();
+						if (!message.unpack(buffer, 0, buffer.size(), connection.headerCodec, Common::Network::Protocol::TCP))
+						{
+							spdlog::warn("Dropped TCP message from client {} with a malformed header", static_cast<std::uint32_t>(entityID));
+							continue;
+						}
+
+						if (!m_compressor.decompress(message))
+						{
+							spdlog::warn("Dropped compressed TCP message from client {} which couldn't be decompressed", static_cast<std::uint32_t>(entityID));
+							continue;
+						}
+
+						// Special case because setting ports is hard
+						if (message.header.type == Common::Network::MessageType::Client_Connect)
+						{
+							message.header.entityID = entityID;
+						}
+
+						m_messageQueue.pushInbound(std::move(message));
+						m_metrics.receivedMessages += 1;
+					}
+
+					chargeReceived(connection, frameCount, length);
+
+					if (connection.frameAssembler.isCorrupt())
+					{
+						spdlog::warn("Client {} sent a malformed TCP stream", static_cast<std::uint32_t>(entityID));
+						m_clientsPendingDisconnection.emplace_back(entityID);
+						return true;
+					}
+				}
 				break;
-			default:
-				spdlog::warn("Dropped TCP packet");
+				case sf::Socket::Status::NotReady:
+					// The socket has been drained
+					return true;
+				case sf::Socket::Status::Disconnected:
+					m_clientsPendingDisconnection.emplace_back(entityID);
+					return true;
+				default:
+					spdlog::warn("Dropped TCP packet");
+					return true;
+			}
 		}
+
+		return false;
 	}
 
 } // namespace Server
\ No newline at end of file
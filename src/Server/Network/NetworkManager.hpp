@@ -2,13 +2,20 @@
 
 #include "Common/Network/Crypto.hpp"
 #include "Network/Client.hpp"
+#include "Network/Connection.hpp"
+#include "Network/MessageSink.hpp"
+#include "Network/NetworkMetrics.hpp"
 #include "Server/Manager.hpp"
 #include <Common/Network.hpp>
-#include <SFML/Network/SocketSelector.hpp>
 #include <SFML/Network/TcpListener.hpp>
 #include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Clock.hpp>
+#include <atomic>
+#include <condition_variable>
 #include <entt/entity/entity.hpp>
 #include <list>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 
 namespace Server
@@ -16,8 +23,12 @@ namespace Server
 	/**
 	 * \class NetworkManager
 	 * \brief Manages communication with all clients
+	 *
+	 * The sockets and per-client connection state are owned by whichever thread polls them: the simulation thread, from update,
+	 * or a dedicated I/O thread once startIOThread has been called. The simulation thread only talks to that side through the
+	 * message queue, a queue of commands, and a queue of connection events.
 	 */
-	class NetworkManager : public Manager
+	class NetworkManager : public Manager, public MessageSink
 	{
 	public:
 		/**
@@ -41,6 +52,30 @@ namespace Server
 		 */
 		auto init() -> bool;
 
+		/**
+		 * \brief Hand the sockets to a dedicated I/O thread, which receives, decodes and sends messages continuously
+		 *
+		 */
+		auto startIOThread() -> void;
+
+		/**
+		 * \brief Compress large messages to clients which can decompress them, using any dictionaries in a directory
+		 *
+		 * Call this before the I/O thread is started
+		 *
+		 * \param dictionaryDirectory The directory to load dictionaries from
+		 * \param capturedSamples How many payloads of each compressed message type to keep for training dictionaries
+		 */
+		auto configureCompression(const std::filesystem::path& dictionaryDirectory, std::size_t capturedSamples) -> void;
+
+		/**
+		 * \brief Train dictionaries from the payloads captured so far, and save them for the server and clients to load on their next start
+		 *
+		 * \param dictionaryDirectory The directory to save the dictionaries in
+		 * \return std::size_t The number of dictionaries saved
+		 */
+		auto saveCompressionDictionaries(const std::filesystem::path& dictionaryDirectory) -> std::size_t;
+
 		/**
 		 * \brief Shut down the network manager and terminate all connections
 		 *
@@ -48,11 +83,74 @@ namespace Server
 		auto shutdown() -> void;
 
 		/**
-		 * \brief Receive any messages from clients, send any message in the outbound queue, and disconnect any clients pending disconnection
+		 * \brief Receive any messages from clients, send any message in the outbound queue, and disconnect any clients pending disconnection.
+		 * If the I/O thread is running, this only hands it the outbound queue and waits for inbound messages
 		 *
-		 * \param maxSelectorWaitTime The maximum amount of time to wait to receive a message from a client
+		 * \param maxWaitTime The maximum amount of time to wait to receive a message from a client
 		 */
-		auto update(sf::Time maxSelectorWaitTime) -> void;
+		auto update(sf::Time maxWaitTime) -> void;
+
+		/**
+		 * \brief Wake whichever thread polls the sockets, so messages pushed from another thread are sent without waiting for the next update.
+		 * Safe to call from any thread
+		 *
+		 */
+		auto wake() -> void override;
+
+		/**
+		 * \brief Set how much receiving a single update may do. Ready sockets left over when it runs out are serviced first on the next update.
+		 * Must be called before the I/O thread is started
+		 *
+		 * \param budget The new receive budget
+		 */
+		auto setReceiveBudget(ReceiveBudget budget) -> void;
+
+		/**
+		 * \brief Set how much each client may be sent per tick. Must be called before the I/O thread is started
+		 *
+		 * \param budget The new send budget
+		 */
+		auto setSendBudget(const SendBudget& budget) -> void;
+
+		/**
+		 * \brief Set how urgently messages of a type are sent, relative to the other messages waiting for the same client.
+		 * Must be called before the I/O thread is started
+		 *
+		 * \param type The message type
+		 * \param priority How much a message of the type gains in priority for every tick it waits. Types without one have 1
+		 */
+		auto setMessagePriority(Common::Network::MessageType type, float priority) -> void;
+
+		/**
+		 * \brief Set the limits on how much clients may send and how fast they may connect. Must be called before the I/O thread is started
+		 *
+		 * \param policy The new admission policy
+		 */
+		auto setAdmissionPolicy(const AdmissionPolicy& policy) -> void;
+
+		/**
+		 * \brief Set how much may be left waiting for a client before it's sent less, and then disconnected.
+		 * Must be called before the I/O thread is started
+		 *
+		 * \param policy The new backpressure policy
+		 */
+		auto setBackpressurePolicy(const BackpressurePolicy& policy) -> void;
+
+		/**
+		 * \brief Get the counters describing the work the network manager has done
+		 */
+		[[nodiscard]] auto getMetrics() const -> const NetworkMetrics&;
+
+		/**
+		 * \brief Get what's waiting to be sent to each client with a backlog, as of the last poll. Safe to call from any thread
+		 */
+		[[nodiscard]] auto getBacklogs() const -> std::vector<ClientBacklog>;
+
+		/**
+		 * \brief Write the network manager's counters to the log
+		 *
+		 */
+		auto logMetrics() const -> void;
 
 		/**
 		 * \brief Get the next message in the inbound queue
@@ -68,6 +166,13 @@ namespace Server
 		 */
 		auto getMessages() -> std::vector<Common::Network::Message>;
 
+		/**
+		 * \brief Move all the messages in the inbound queue into a vector, and clear it. The vector's storage is reused by the queue
+		 *
+		 * \param messages The vector to move the messages into, whose previous contents are discarded
+		 */
+		auto getMessages(std::vector<Common::Network::Message>& messages) -> void;
+
 		/**
 		 * \brief Push a message into the outbound queue, to a specific client
 		 *
@@ -76,10 +181,54 @@ namespace Server
 		 * \param entityID The ID of the client to send the message to
 		 * \param data The data to send to the client
 		 */
-		auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, Common::Network::MessageData& data) -> void;
+		auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, Common::Network::MessageData& data) -> void override;
 
 		/**
-		 * \brief Push a message into the outbound queue, to all connected clients
+		 * \brief Push a message into the outbound queue, to a specific client, sharing an already packed payload
+		 *
+		 * \param protocol The protocol to send the message over
+		 * \param type The type of message to send
+		 * \param entityID The ID of the client to send the message to
+		 * \param payload The payload to send to the client, which may be shared with other messages
+		 */
+		auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, const Common::Network::SharedPayload& payload) -> void override;
+
+		/**
+		 * \brief Push a message about an entity into the outbound queue, to a specific client
+		 *
+		 * \param protocol The protocol to send the message over
+		 * \param type The type of message to send
+		 * \param entityID The ID of the client to send the message to
+		 * \param data The data to send to the client
+		 * \param subject The entity the message is about
+		 * \param priority How much the message matters to this client, which scales the priority of its type
+		 */
+		auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, Common::Network::MessageData& data, entt::entity subject, float priority) -> void override;
+
+		/**
+		 * \brief Push a message about an entity into the outbound queue, to a specific client, sharing an already packed payload
+		 *
+		 * \param protocol The protocol to send the message over
+		 * \param type The type of message to send
+		 * \param entityID The ID of the client to send the message to
+		 * \param payload The payload to send to the client, which may be shared with other messages
+		 * \param subject The entity the message is about
+		 * \param priority How much the message matters to this client, which scales the priority of its type
+		 */
+		auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, const Common::Network::SharedPayload& payload, entt::entity subject, float priority) -> void override;
+
+		/**
+		 * \brief Push the same message into the outbound queue, to many clients. The data is packed once and shared between them
+		 *
+		 * \param type The type of message to send
+		 * \param recipients The clients to send the message to
+		 * \param data The data to send to every client
+		 */
+		auto pushBroadcast(Common::Network::MessageType type, std::span<const MessageRecipient> recipients, Common::Network::MessageData& data) -> void override;
+
+		/**
+		 * \brief Push a message into the outbound queue, to all connected clients. The data is packed once and shared between them.
+		 * Only call this from the simulation thread, as it reads the server's registry
 		 *
 		 * \param protocol The protocol to send the message over
 		 * \param type The type of message to send
@@ -88,21 +237,20 @@ namespace Server
 		auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, Common::Network::MessageData& data) -> void;
 
 		/**
-		 * \brief Resolve a client's ID based on their IP address and port
+		 * \brief Set the UDP port and header version used to communicate with a client, and send them their client ID
 		 *
-		 * \param ipAddress The remote address of the client
-		 * \param port The port the client used to send the message
-		 * \return std::optional<entt::entity> An optional which may contain the ID of the client, if they could be resolved
+		 * \param entityID The ID of the client
+		 * \param udpPort The UDP port to use to communicate
+		 * \param headerVersion The newest header version the client can speak
 		 */
-		auto resolveClientID(sf::IpAddress ipAddress, std::uint16_t port) -> std::optional<entt::entity>;
+		auto setClientUdpPort(entt::entity entityID, std::uint16_t udpPort, std::uint8_t headerVersion) -> void;
 
 		/**
-		 * \brief Set the UDP port used to communicate with a client
+		 * \brief Let the network manager know a client has authenticated, so they no longer count as a pending connection
 		 *
 		 * \param entityID The ID of the client
-		 * \param udpPort The UDP port to use to communicate
 		 */
-		auto setClientUdpPort(entt::entity entityID, std::uint16_t udpPort) -> void;
+		auto markAuthenticated(entt::entity entityID) -> void;
 
 		/**
 		 * \brief Designates a client to be disconnected
@@ -112,6 +260,56 @@ namespace Server
 		auto markForDisconnect(entt::entity entityID) -> void;
 
 	private:
+		/**
+		 * \struct Command
+		 * \brief A request from the simulation thread for the side which owns the sockets
+		 */
+		struct Command
+		{
+			enum class Type
+			{
+				Adopt,
+				SetUdpPort,
+				Authenticate,
+				Disconnect
+			};
+
+			Type type;
+			entt::entity entityID   = entt::null;
+			std::uint64_t pendingID = 0;
+			std::uint16_t udpPort   = 0;
+
+			std::uint8_t headerVersion = Common::Network::COMPACT_HEADER_VERSION;
+		};
+
+		/**
+		 * \struct ConnectionEvent
+		 * \brief A notification from the side which owns the sockets for the simulation thread
+		 */
+		struct ConnectionEvent
+		{
+			enum class Type
+			{
+				Accepted,
+				Closed
+			};
+
+			Type type;
+			entt::entity entityID   = entt::null;
+			std::uint64_t pendingID = 0;
+		};
+
+		/**
+		 * \struct PendingSocket
+		 * \brief A connection which has been accepted, waiting for the simulation thread to create its client
+		 */
+		struct PendingSocket
+		{
+			std::unique_ptr<sf::TcpSocket> tcpSocket;
+			AddressLimits* addressLimits = nullptr;
+			sf::Time acceptedAt;
+		};
+
 		/**
 		 * \brief Generate a new client ID
 		 *
@@ -120,10 +318,115 @@ namespace Server
 		auto generateClientID() -> entt::entity;
 
 		/**
-		 * \brief Accept a connection as a new client
+		 * \brief Create client entities for accepted connections and destroy the entities of closed ones. Runs on the simulation thread
+		 *
+		 */
+		auto processConnectionEvents() -> void;
+
+		/**
+		 * \brief Stop the I/O thread if it's running, and wait for it to finish
 		 *
 		 */
-		auto acceptNewConnection() -> void;
+		auto stopIOThread() -> void;
+
+		/**
+		 * \brief The body of the I/O thread
+		 *
+		 */
+		auto runIOThread() -> void;
+
+		/**
+		 * \brief Apply commands from the simulation thread, send the outbound queue, and receive from every ready socket
+		 *
+		 * \param maxWaitTime The maximum amount of time to wait for a socket to become ready
+		 * \return true Any socket was serviced or connection closed
+		 * \return false Nothing happened before the wait timed out
+		 */
+		auto poll(sf::Time maxWaitTime) -> bool;
+
+		/**
+		 * \brief Apply any commands pushed by the simulation thread
+		 *
+		 */
+		auto processCommands() -> void;
+
+		/**
+		 * \brief Resolve a client's ID based on their IP address and port
+		 *
+		 * \param ipAddress The remote address of the client
+		 * \param port The port the client used to send the message
+		 * \return std::optional<entt::entity> An optional which may contain the ID of the client, if they could be resolved
+		 */
+		auto resolveClientID(sf::IpAddress ipAddress, std::uint16_t port) -> std::optional<entt::entity>;
+
+		/**
+		 * \brief Drain a socket reported as ready by the reactor
+		 *
+		 * \param token The reactor token of the socket
+		 * \return true The socket was drained
+		 * \return false The receive budget ran out before the socket was drained
+		 */
+		auto serviceSocket(std::uint64_t token) -> bool;
+
+		/**
+		 * \brief Check whether the current update has used up its receive budget
+		 */
+		[[nodiscard]] auto isBudgetExhausted() const -> bool;
+
+		/**
+		 * \brief Get the limits shared by every connection from an address, starting them afresh if the address has none
+		 *
+		 * \param address The address, as an integer
+		 */
+		auto getAddressLimits(std::uint32_t address) -> AddressLimits&;
+
+		/**
+		 * \brief Check whether a client has sent all it may for now
+		 *
+		 * \param connection The client's connection
+		 * \return true The client, or its address, is over its limits
+		 * \return false The client may send more
+		 */
+		auto isThrottled(Connection& connection) -> bool;
+
+		/**
+		 * \brief Take what a client sent from its limits, and those of its address
+		 *
+		 * \param connection The client's connection
+		 * \param messages The number of messages received
+		 * \param bytes The number of bytes received
+		 */
+		auto chargeReceived(Connection& connection, std::size_t messages, std::size_t bytes) -> void;
+
+		/**
+		 * \brief Move the throttled sockets which may be read again into the ready sockets
+		 *
+		 * \param readySockets The sockets to service this wakeup
+		 * \return sf::Time How long until the next throttled socket may be read, or sf::Time::Zero if none are left
+		 */
+		auto releaseThrottledSockets(std::vector<std::uint64_t>& readySockets) -> sf::Time;
+
+		/**
+		 * \brief Close connections which have taken too long to authenticate, and forget addresses nobody is connected from
+		 *
+		 */
+		auto expireConnections() -> void;
+
+		/**
+		 * \brief Accept every pending connection, and let the simulation thread know about them
+		 *
+		 * \return true The accept backlog was drained
+		 * \return false The receive budget ran out before the backlog was drained
+		 */
+		auto acceptNewConnections() -> bool;
+
+		/**
+		 * \brief Start communicating with an accepted connection as a client
+		 *
+		 * \param pendingID The ID the connection was given when it was accepted
+		 * \param entityID The ID of the client
+		 */
+		auto adoptConnection(std::uint64_t pendingID, entt::entity entityID) -> void;
 
 		/**
 		 * \brief Close the connection with a client
@@ -135,13 +438,10 @@ namespace Server
 		/**
 		 * \brief Disconnect any clients awaiting disconnection
 		 *
+		 * \return true Any connection was closed
+		 * \return false There were no clients awaiting disconnection
 		 */
-		auto disconnectClients() -> void;
-
-		/**
-		 * \brief Get the identifier the next message should be sent with
-		 */
-		auto getNextMessageIdentifier() -> std::uint64_t;
+		auto disconnectClients() -> bool;
 
 		/**
 		 * \brief Check whether an incoming message is valid or not
@@ -154,44 +454,156 @@ namespace Server
 		auto validateIncomingMessage(entt::entity entityID, Common::Network::MessageHeader& header) -> bool;
 
 		/**
-		 * \brief Send a message using the UDP socket
+		 * \brief Queue an outbound message with its client's scheduler
+		 *
+		 * \param message The message to send
+		 */
+		auto scheduleMessage(Common::Network::Message& message) -> void;
+
+		/**
+		 * \brief Send each client as many of their scheduled messages as their budget allows, most urgent first
+		 *
+		 */
+		auto sendScheduledMessages() -> void;
+
+		/**
+		 * \brief Pack a message into its client's endpoint, which sends it on the channel given by its protocol
 		 *
 		 * \param message The message to send
+		 * \param connection The connection of the client the message is sent to
 		 */
-		auto sendUDP(Common::Network::Message& message) -> void;
+		auto sendUDP(Common::Network::Message& message, Connection& connection) -> void;
 
 		/**
-		 * \brief Receive a message using the UDP socket, and push it into the inbound message queue
+		 * \brief Receive every pending message on the UDP socket, and push them into the inbound message queue
 		 *
+		 * \return true The socket was drained
+		 * \return false The receive budget ran out before the socket was drained
 		 */
-		auto receiveUDP() -> void;
+		auto receiveUDP() -> bool;
 
 		/**
-		 * \brief Send a message using a TCP socket
+		 * \brief Pack a message into its client's next TCP write
 		 *
 		 * \param message The message to send
+		 * \param connection The connection of the client the message is sent to
 		 */
-		auto sendTCP(Common::Network::Message& message) -> void;
+		auto sendTCP(Common::Network::Message& message, Connection& connection) -> void;
 
 		/**
-		 * \brief Receive a message from a specific client using their TCP socket
+		 * \brief Give a message its identifier, then pack and encrypt it, leaving out its shared payload if it has one
+		 *
+		 * \param message The message to pack
+		 * \param connection The connection of the client the message is sent to
+		 * \return std::vector<std::uint8_t> The packed message
+		 */
+		auto packMessage(Common::Network::Message& message, Connection& connection) -> std::vector<std::uint8_t>;
+
+		/**
+		 * \brief Remember that a client has outbound messages to be flushed
+		 *
+		 * \param entityID The ID of the client
+		 * \param connection The client's connection
+		 */
+		auto markOutbound(entt::entity entityID, Connection& connection) -> void;
+
+		/**
+		 * \brief Write out every client's outbound messages, as datagrams from their endpoint queued with the batcher and a single TCP write each
+		 *
+		 */
+		auto flushOutbound() -> void;
+
+		/**
+		 * \brief Write as much of each client's unwritten TCP messages as their sockets will take, keeping the rest for later
+		 *
+		 */
+		auto flushTCP() -> void;
+
+		/**
+		 * \brief Let a client's unwritten TCP messages be written again, now that the reactor has reported its socket has room
+		 *
+		 * \param token The reactor token of the socket
+		 * \return true The client had messages waiting for the socket
+		 * \return false Nothing was waiting
+		 */
+		auto resumeWrites(std::uint64_t token) -> bool;
+
+		/**
+		 * \brief Measure every client's backlog, shedding what can be dropped and disconnecting clients which aren't keeping up
+		 *
+		 */
+		auto applyBackpressure() -> void;
+
+		/**
+		 * \brief Receive every pending message from a specific client using their TCP socket
 		 *
 		 * \param entityID The ID of the client to receive the message from
-		 * \param client The client data
+		 * \param connection The client's connection
+		 * \return true The socket was drained
+		 * \return false The receive budget ran out before the socket was drained
 		 */
-		auto receiveTCP(entt::entity entityID, Client& client) -> void;
+		auto receiveTCP(entt::entity entityID, Connection& connection) -> bool;
 
-		sf::SocketSelector m_socketSelector;
+		// Owned by whichever thread polls the sockets
+		Common::Network::SocketReactor m_reactor;
+		Common::Network::PayloadCompressor m_compressor;
 		sf::TcpListener m_tcpListener;
 		sf::UdpSocket m_udpSocket;
 
-		std::unordered_map<std::uint64_t, entt::entity> m_clientIPMap;
+		std::unordered_map<entt::entity, Connection> m_connections;
+		std::unordered_map<std::uint64_t, PendingSocket> m_pendingSockets;
+		std::uint64_t m_lastPendingID = 0;
+
+		Common::Network::EndpointTable m_endpoints;
 		std::list<entt::entity> m_clientsPendingDisconnection;
+		std::vector<std::uint64_t> m_deferredSockets;
+
+		ReceiveBudget m_receiveBudget;
+		AdmissionPolicy m_admissionPolicy;
+		BackpressurePolicy m_backpressurePolicy;
+		std::unordered_map<std::uint32_t, AddressLimits> m_addressLimits;
+		std::vector<std::uint64_t> m_throttledSockets;
+		std::size_t m_pendingConnectionCount = 0;
+		sf::Clock m_admissionClock;
+		sf::Time m_now;
+		sf::Time m_lastExpiry;
+		sf::Clock m_wakeupClock;
+		std::size_t m_wakeupBytes    = 0;
+		std::uint64_t m_pollSyscalls = 0;
+
+		std::array<std::uint8_t, Common::Network::MAX_MESSAGE_LENGTH> m_tcpReceiveBuffer = {};
+
+		Common::Network::DatagramBatcher m_datagramBatcher;
+		std::vector<Common::Network::Message> m_deliveredMessages;
+		std::vector<entt::entity> m_connectionsWithOutbound;
+		std::vector<Common::Network::Message> m_outboundMessages;
+
+		SendBudget m_sendBudget;
+		std::unordered_map<Common::Network::MessageType, float> m_messagePriorities;
+		std::vector<entt::entity> m_connectionsWithScheduled;
+		std::vector<Common::Network::Message> m_scheduledMessages;
+		sf::Time m_lastScheduled;
 
 		Common::Network::PublicKeyCryptographer m_cryptographer;
 
-		Common::Network::MessageQueue<Common::Network::Message> m_messageQueue;
-		std::uint64_t m_currentMessageIdentifier = 0;
+		// Shared between the simulation thread and the I/O thread
+		Common::Network::ReceiveBufferPool m_receivePool;
+		Common::Network::MessageQueue<Common::Network::Message, Common::Util::DoubleBufferedQueue> m_messageQueue;
+		Common::Util::ThreadSafeQueue<Command> m_commands;
+		Common::Util::ThreadSafeQueue<ConnectionEvent> m_connectionEvents;
+		NetworkMetrics m_metrics;
+
+		// The backlogs measured by the last poll, and the ones being measured
+		mutable std::mutex m_backlogMutex;
+		std::vector<ClientBacklog> m_publishedBacklogs;
+		std::vector<ClientBacklog> m_backlogs;
+
+		std::thread m_ioThread;
+		std::atomic<bool> m_ioThreadRunning = false;
+		std::mutex m_inboundMutex;
+		std::condition_variable m_inboundCondition;
+		bool m_inboundReady = false;
+
 	};
 
 } // namespace Server
\ No newline at end of file
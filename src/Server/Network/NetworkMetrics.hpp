@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Network/TokenBucket.hpp"
+#include <SFML/System/Time.hpp>
+#include <atomic>
+#include <cstdint>
+#include <entt/entity/entity.hpp>
+
+namespace Server
+{
+
+	/**
+	 * \struct ReceiveBudget NetworkMetrics.hpp "Network/NetworkMetrics.hpp"
+	 * \brief Limits how much receiving a single NetworkManager wakeup may do before deferring the remaining sockets
+	 */
+	struct ReceiveBudget
+	{
+		sf::Time maxTime     = sf::milliseconds(10);
+		std::size_t maxBytes = 4 << 20;
+	};
+
+	/**
+	 * \struct AdmissionPolicy NetworkMetrics.hpp "Network/NetworkMetrics.hpp"
+	 * \brief Limits how much any one client, or any one address, can make the NetworkManager do
+	 *
+	 * Connections which go over their message or byte rate over TCP aren't read from until they've earned enough to continue,
+	 * leaving the rest in the kernel, while datagrams over the rate are dropped
+	 */
+	struct AdmissionPolicy
+	{
+		/// \brief New connections accepted from one address
+		RateLimit connectionsPerAddress = {1.0, 10.0};
+
+		/// \brief Messages and bytes received from one connection, over TCP and UDP combined
+		RateLimit messagesPerConnection = {200.0, 400.0};
+		RateLimit bytesPerConnection    = {64.0 * 1024.0, 256.0 * 1024.0};
+
+		/// \brief Messages and bytes received from every connection from one address combined
+		RateLimit messagesPerAddress = {1'000.0, 2'000.0};
+		RateLimit bytesPerAddress    = {512.0 * 1024.0, 2'048.0 * 1024.0};
+
+		/// \brief Connections which haven't authenticated yet. Connections accepted past this are closed straight away
+		std::size_t maxPendingConnections = 256;
+
+		/// \brief Connections accepted in one wakeup, after which the rest of the backlog waits for the next
+		std::size_t maxAcceptsPerWakeup = 64;
+
+		/// \brief How long a connection may take to authenticate before it's closed
+		sf::Time authenticationTimeout = sf::seconds(30);
+	};
+
+	/**
+	 * \struct BackpressurePolicy NetworkMetrics.hpp "Network/NetworkMetrics.hpp"
+	 * \brief Limits how much can be left waiting for a client which isn't taking what it's sent
+	 *
+	 * A client's backlog is every byte waiting for it, both the messages held back by its send budget and what's been packed for its
+	 * TCP socket but not yet written
+	 */
+	struct BackpressurePolicy
+	{
+		/// \brief Past this backlog, messages to the client which aren't sent reliably are dropped, until it's back under half of this
+		std::size_t sheddingBacklog = 256 * 1024;
+
+		/// \brief Clients whose backlog stays past this for longer than stallTimeout are disconnected, as they aren't catching up
+		std::size_t disconnectBacklog = 1024 * 1024;
+		sf::Time stallTimeout         = sf::seconds(5);
+	};
+
+	/**
+	 * \struct ClientBacklog NetworkMetrics.hpp "Network/NetworkMetrics.hpp"
+	 * \brief What's waiting to be sent to one client
+	 */
+	struct ClientBacklog
+	{
+		entt::entity entityID = entt::null;
+
+		/// \brief Bytes packed for the client's TCP socket which it hasn't taken yet
+		std::size_t unwrittenBytes = 0;
+
+		/// \brief Messages held back by the client's send budget, and the bytes they'll be charged
+		std::size_t scheduledMessages = 0;
+		std::size_t scheduledBytes    = 0;
+	};
+
+	/**
+	 * \struct NetworkMetrics NetworkMetrics.hpp "Network/NetworkMetrics.hpp"
+	 * \brief Counters describing the work done by the NetworkManager since it was started.
+	 * Written by whichever thread polls the sockets, so they can be read from any thread
+	 */
+	struct NetworkMetrics
+	{
+		std::atomic<std::uint64_t> wakeups                = 0;
+		std::atomic<std::uint64_t> exhaustedWakeups       = 0;
+		std::atomic<std::uint64_t> deferredSockets        = 0;
+		std::atomic<std::uint64_t> pendingDeferredSockets = 0;
+		std::atomic<std::uint64_t> acceptedConnections    = 0;
+		std::atomic<std::uint64_t> rejectedConnections    = 0;
+		std::atomic<std::uint64_t> shedConnections        = 0;
+		std::atomic<std::uint64_t> pendingConnections     = 0;
+		std::atomic<std::uint64_t> expiredConnections     = 0;
+		std::atomic<std::uint64_t> throttledReads         = 0;
+		std::atomic<std::uint64_t> throttledDatagrams     = 0;
+		std::atomic<std::uint64_t> throttledConnections   = 0;
+		std::atomic<std::uint64_t> receivedMessages       = 0;
+		std::atomic<std::uint64_t> receivedBytes          = 0;
+		std::atomic<std::uint64_t> droppedDatagrams       = 0;
+		std::atomic<std::uint64_t> sentMessages           = 0;
+		std::atomic<std::uint64_t> deferredMessages       = 0;
+		std::atomic<std::uint64_t> scheduledMessages      = 0;
+		std::atomic<std::uint64_t> sentDatagrams          = 0;
+		std::atomic<std::uint64_t> resentMessages         = 0;
+		std::atomic<std::uint64_t> tcpWrites              = 0;
+		std::atomic<std::uint64_t> blockedWrites          = 0;
+		std::atomic<std::uint64_t> shedMessages           = 0;
+		std::atomic<std::uint64_t> stalledConnections     = 0;
+		std::atomic<std::uint64_t> backloggedConnections  = 0;
+		std::atomic<std::uint64_t> backlogBytes           = 0;
+		std::atomic<std::uint64_t> largestBacklog         = 0;
+		std::atomic<std::uint64_t> syscalls               = 0;
+		std::atomic<std::uint64_t> lastWakeupSyscalls     = 0;
+	};
+
+} // namespace Server
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include "Network/SendScheduler.hpp"
+#include <algorithm>
+
+namespace Server
+{
+
+	auto SendScheduler::push(Common::Network::Message&& message, const float weight) -> void
+	{
+		auto key                  = getStreamKey(message);
+		auto [iterator, inserted] = m_streamIndices.try_emplace(key, m_streams.size());
+		if (inserted)
+		{
+			auto& stream = m_streams.emplace_back();
+			stream.key   = key;
+			if (!m_spareEntries.empty())
+			{
+				stream.entries = std::move(m_spareEntries.back());
+				m_spareEntries.pop_back();
+			}
+		}
+
+		// A message arriving at the front of a stream is worth a tick's wait straight away, so it can go out this tick
+		auto& stream = m_streams[iterator->second];
+		if (stream.head == stream.entries.size())
+		{
+			stream.priority = std::max(stream.priority, weight);
+		}
+
+		m_size += 1;
+		m_byteCount += getCost(message);
+		stream.entries.emplace_back(Entry{std::move(message), weight});
+	}
+
+	auto SendScheduler::age(const float ticks) -> void
+	{
+		for (auto& stream : m_streams)
+		{
+			if (stream.head < stream.entries.size())
+			{
+				stream.priority += stream.entries[stream.head].weight * ticks;
+			}
+		}
+	}
+
+	auto SendScheduler::take(TokenBucket& budget, std::vector<Common::Network::Message>& messages) -> void
+	{
+		m_order.clear();
+		for (auto i = std::size_t(0); i < m_streams.size(); ++i)
+		{
+			m_order.emplace_back(i);
+		}
+		std::sort(m_order.begin(), m_order.end(), [&](const std::size_t left, const std::size_t right) {
+			return m_streams[left].priority > m_streams[right].priority;
+		});
+
+		// Every stream sends one message a pass, so a stream with a long backlog can't use up the budget ahead of everything else
+		auto sent = true;
+		while (sent && budget.hasTokens())
+		{
+			sent = false;
+			for (const auto index : m_order)
+			{
+				if (!budget.hasTokens())
+				{
+					break;
+				}
+
+				auto& stream = m_streams[index];
+				if (stream.head == stream.entries.size())
+				{
+					continue;
+				}
+
+				auto& message = stream.entries[stream.head].message;
+				auto cost     = getCost(message);
+				budget.take(static_cast<double>(cost));
+				messages.emplace_back(std::move(message));
+				stream.head += 1;
+				stream.priority = 0.F;
+				m_size -= 1;
+				m_byteCount -= cost;
+				sent = true;
+			}
+		}
+
+		removeEmptyStreams();
+	}
+
+	auto SendScheduler::dropUnreliable() -> std::size_t
+	{
+		auto dropped = std::size_t(0);
+		for (auto& stream : m_streams)
+		{
+			if (stream.head == stream.entries.size())
+			{
+				continue;
+			}
+
+			// Streams are split by protocol, so a stream is either all reliable or not at all
+			const auto protocol = stream.entries[stream.head].message.header.protocol;
+			if (protocol == Common::Network::Protocol::TCP || Common::Network::isReliable(protocol))
+			{
+				continue;
+			}
+
+			for (auto i = stream.head; i < stream.entries.size(); ++i)
+			{
+				m_byteCount -= getCost(stream.entries[i].message);
+			}
+			dropped += stream.entries.size() - stream.head;
+			stream.head = stream.entries.size();
+		}
+
+		m_size -= dropped;
+		removeEmptyStreams();
+		return dropped;
+	}
+
+	auto SendScheduler::size() const -> std::size_t
+	{
+		return m_size;
+	}
+
+	auto SendScheduler::getByteCount() const -> std::size_t
+	{
+		return m_byteCount;
+	}
+
+	auto SendScheduler::empty() const -> bool
+	{
+		return m_size == 0;
+	}
+
+	auto SendScheduler::getStreamKey(const Common::Network::Message& message) -> std::uint64_t
+	{
+		const auto protocol = message.header.protocol;
+		auto key            = static_cast<std::uint64_t>(protocol) << 48;
+		if (protocol == Common::Network::Protocol::TCP || protocol == Common::Network::Protocol::ReliableOrdered)
+		{
+			return key;
+		}
+
+		key |= static_cast<std::uint64_t>(message.header.type) << 32;
+		key |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(message.subject));
+		return key;
+	}
+
+	auto SendScheduler::getCost(const Common::Network::Message& message) -> std::size_t
+	{
+		// Charged for the longest the header could be, as the message isn't packed until it's sent
+		return sizeof(Common::Network::MessageHeader) + message.getPayloadSize();
+	}
+
+	auto SendScheduler::removeEmptyStreams() -> void
+	{
+		for (auto i = std::size_t(0); i < m_streams.size();)
+		{
+			auto& stream = m_streams[i];
+			if (stream.head < stream.entries.size())
+			{
+				// Drop the messages already taken from the front, once they're most of the stream
+				if (stream.head > stream.entries.size() / 2)
+				{
+					stream.entries.erase(stream.entries.begin(), stream.entries.begin() + static_cast<std::ptrdiff_t>(stream.head));
+					stream.head = 0;
+				}
+				++i;
+				continue;
+			}
+
+			stream.entries.clear();
+			m_spareEntries.emplace_back(std::move(stream.entries));
+			m_streamIndices.erase(stream.key);
+
+			// Fill the gap with the last stream
+			if (i != m_streams.size() - 1)
+			{
+				stream                      = std::move(m_streams.back());
+				m_streamIndices[stream.key] = i;
+			}
+			m_streams.pop_back();
+		}
+	}
+
+} // namespace Server
\ No newline at end of file
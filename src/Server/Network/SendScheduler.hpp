@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Network/TokenBucket.hpp"
+#include <Common/Network/Message.hpp>
+#include <SFML/System/Time.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Server
+{
+
+	/**
+	 * \struct SendBudget SendScheduler.hpp "Network/SendScheduler.hpp"
+	 * \brief How many bytes of new messages each client may be sent per tick. A budget of zero bytes means there's no limit
+	 */
+	struct SendBudget
+	{
+		std::size_t bytesPerTick = 16 * 1024;
+		sf::Time tickLength      = sf::milliseconds(50);
+	};
+
+	/**
+	 * \class SendScheduler SendScheduler.hpp "Network/SendScheduler.hpp"
+	 * \brief Decides which of the messages waiting for one client are sent next, within the client's send budget
+	 *
+	 * Messages wait in streams. TCP and ReliableOrdered messages each share one stream, as the client has to read them in the order
+	 * they were pushed, while the other protocols get a stream per message type and subject entity. Every stream has a priority
+	 * accumulator, which grows by the weight of its first message for every tick it waits, so important messages go first while
+	 * unimportant ones still go eventually. Streams send a message each in order of priority, and go round again until the budget runs
+	 * out, and each stream which sent anything starts accumulating again from nothing. Messages are only deferred, never dropped, unless
+	 * dropUnreliable is called. As plain UDP messages can leave in a different order to the one they were pushed in, they're given
+	 * their identifiers as they're sent rather than when they're pushed
+	 */
+	class SendScheduler
+	{
+	public:
+		/**
+		 * \brief Queue a message to be sent
+		 *
+		 * \param message The message
+		 * \param weight How much the message's stream gains in priority for each tick the message waits at its front
+		 */
+		auto push(Common::Network::Message&& message, float weight) -> void;
+
+		/**
+		 * \brief Add the priority the waiting streams have gained
+		 *
+		 * \param ticks How many ticks have passed since the streams were last aged
+		 */
+		auto age(float ticks) -> void;
+
+		/**
+		 * \brief Take the messages to send now, in the order they should be sent, until the budget runs out
+		 *
+		 * \param budget The client's send budget, which is charged for every message taken. The last message taken may leave it in debt
+		 * \param messages The messages are appended to this
+		 */
+		auto take(TokenBucket& budget, std::vector<Common::Network::Message>& messages) -> void;
+
+		/**
+		 * \brief Drop every waiting message which isn't sent reliably, as a later one will take its place
+		 *
+		 * \return std::size_t The number of messages dropped
+		 */
+		auto dropUnreliable() -> std::size_t;
+
+		/**
+		 * \brief Gets the number of messages waiting
+		 */
+		[[nodiscard]] auto size() const -> std::size_t;
+
+		/**
+		 * \brief Gets the number of bytes the waiting messages will be charged
+		 */
+		[[nodiscard]] auto getByteCount() const -> std::size_t;
+
+		/**
+		 * \brief Check whether no messages are waiting
+		 */
+		[[nodiscard]] auto empty() const -> bool;
+
+	private:
+		struct Entry
+		{
+			Common::Network::Message message;
+			float weight = 1.F;
+		};
+
+		struct Stream
+		{
+			std::uint64_t key = 0;
+			std::vector<Entry> entries;
+			std::size_t head = 0;
+			float priority   = 0.F;
+		};
+
+		/**
+		 * \brief Gets the key of the stream a message waits in
+		 */
+		[[nodiscard]] static auto getStreamKey(const Common::Network::Message& message) -> std::uint64_t;
+
+		/**
+		 * \brief Gets the number of bytes a message is charged against the budget
+		 */
+		[[nodiscard]] static auto getCost(const Common::Network::Message& message) -> std::size_t;
+
+		/**
+		 * \brief Forget the streams which have nothing left to send, keeping their storage for new streams
+		 */
+		auto removeEmptyStreams() -> void;
+
+		std::vector<Stream> m_streams;
+		std::unordered_map<std::uint64_t, std::size_t> m_streamIndices;
+		std::vector<std::vector<Entry>> m_spareEntries;
+		std::vector<std::size_t> m_order;
+		std::size_t m_size      = 0;
+		std::size_t m_byteCount = 0;
+	};
+
+} // namespace Server
\ No newline at end of file
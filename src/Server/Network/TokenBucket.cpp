@@ -0,0 +1,62 @@
+#include "Network/TokenBucket.hpp"
+#include <algorithm>
+
+namespace Server
+{
+
+	TokenBucket::TokenBucket(const RateLimit& limit, const sf::Time now) :
+	    m_limit(limit),
+	    m_tokens(limit.burst),
+	    m_lastRefill(now)
+	{
+	}
+
+	auto TokenBucket::refill(const sf::Time now) -> void
+	{
+		if (now <= m_lastRefill)
+		{
+			return;
+		}
+
+		m_tokens     = std::min(m_limit.burst, m_tokens + (now - m_lastRefill).asSeconds() * m_limit.perSecond);
+		m_lastRefill = now;
+	}
+
+	auto TokenBucket::take(const double tokens) -> void
+	{
+		m_tokens -= tokens;
+	}
+
+	auto TokenBucket::tryTake(const double tokens) -> bool
+	{
+		if (m_limit.perSecond > 0.0 && m_tokens < tokens)
+		{
+			return false;
+		}
+
+		m_tokens -= tokens;
+		return true;
+	}
+
+	auto TokenBucket::hasTokens() const -> bool
+	{
+		return m_limit.perSecond <= 0.0 || m_tokens > 0.0;
+	}
+
+	auto TokenBucket::isFull() const -> bool
+	{
+		return m_limit.perSecond <= 0.0 || m_tokens >= m_limit.burst;
+	}
+
+	auto TokenBucket::getTimeUntilTokens() const -> sf::Time
+	{
+		if (hasTokens())
+		{
+			return sf::Time::Zero;
+		}
+
+		// Just past the point of paying off the debt, so the bucket definitely has something to give by then
+		return sf::seconds(static_cast<float>(-m_tokens / m_limit.perSecond)) + sf::microseconds(1);
+	}
+
+} // namespace Server
\ No newline at end of file
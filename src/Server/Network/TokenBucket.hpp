@@ -0,0 +1,86 @@
+#pragma once
+
+#include <SFML/System/Time.hpp>
+
+namespace Server
+{
+
+	/**
+	 * \struct RateLimit TokenBucket.hpp "Network/TokenBucket.hpp"
+	 * \brief How fast a TokenBucket refills, and how much it holds. A rate of zero means there's no limit
+	 */
+	struct RateLimit
+	{
+		double perSecond = 0.0;
+		double burst     = 0.0;
+	};
+
+	/**
+	 * \class TokenBucket TokenBucket.hpp "Network/TokenBucket.hpp"
+	 * \brief Limits the rate of something, while letting short bursts through
+	 *
+	 * Tokens are added at a steady rate up to the burst size. Taking tokens may leave the bucket in debt, as work which has
+	 * already been done (like reading from a socket) can't be refused, and the bucket then has nothing to give until it's paid off
+	 */
+	class TokenBucket
+	{
+	public:
+		/**
+		 * \brief Construct a bucket with no limit
+		 *
+		 */
+		TokenBucket() = default;
+
+		/**
+		 * \brief Construct a full bucket
+		 *
+		 * \param limit How fast the bucket refills, and how much it holds
+		 * \param now The current time
+		 */
+		TokenBucket(const RateLimit& limit, sf::Time now);
+
+		/**
+		 * \brief Add the tokens earned since the bucket was last refilled
+		 *
+		 * \param now The current time
+		 */
+		auto refill(sf::Time now) -> void;
+
+		/**
+		 * \brief Take tokens, going into debt if there aren't enough
+		 *
+		 * \param tokens The number of tokens to take
+		 */
+		auto take(double tokens) -> void;
+
+		/**
+		 * \brief Take tokens only if there are enough
+		 *
+		 * \param tokens The number of tokens to take
+		 * \return true The tokens were taken
+		 * \return false There weren't enough tokens, and none were taken
+		 */
+		auto tryTake(double tokens) -> bool;
+
+		/**
+		 * \brief Check whether the bucket has any tokens to give
+		 */
+		[[nodiscard]] auto hasTokens() const -> bool;
+
+		/**
+		 * \brief Check whether the bucket has refilled completely, so forgetting it would change nothing
+		 */
+		[[nodiscard]] auto isFull() const -> bool;
+
+		/**
+		 * \brief Gets how long until the bucket has tokens to give again
+		 */
+		[[nodiscard]] auto getTimeUntilTokens() const -> sf::Time;
+
+	private:
+		RateLimit m_limit;
+		double m_tokens = 0.0;
+		sf::Time m_lastRefill;
+	};
+
+} // namespace Server
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "Replication/InterestManager.hpp"
+#include "Network/Client.hpp"
+#include <Common/Game/WorldEntity.hpp>
+#include <Common/Input/InputState.hpp>
+#include <cmath>
+
+namespace Server
+{
+
+	/// \brief The distance at which a message about an entity matters half as much to a client as one about the client itself
+	const auto PRIORITY_FALLOFF_DISTANCE = 256.F;
+
+	InterestManager::InterestManager(entt::registry& registry, MessageSink& messageSink) :
+	    m_registry(registry),
+	    m_messageSink(messageSink)
+	{
+	}
+
+	auto InterestManager::update() -> void
+	{
+		for (const auto entity : m_registry.view<Common::Game::WorldEntityPosition>())
+		{
+			auto& worldPosition = m_registry.get<Common::Game::WorldEntityPosition>(entity);
+			m_grid.update(entity, worldPosition.instanceID, worldPosition.position, m_registry.all_of<Client>(entity));
+		}
+
+		// Anything which wasn't updated has left the world
+		m_grid.sweep();
+		sendEvents();
+	}
+
+	auto InterestManager::remove(const entt::entity entity) -> void
+	{
+		m_grid.remove(entity);
+		sendEvents();
+	}
+
+	auto InterestManager::pushMessage(const Common::Network::Protocol protocol, const Common::Network::MessageType type, const entt::entity entity, Common::Network::MessageData& data) -> void
+	{
+		const auto& subscribers = m_grid.getSubscribers(entity);
+		if (subscribers.empty())
+		{
+			return;
+		}
+
+		auto recipients = std::vector<MessageRecipient>();
+		recipients.reserve(subscribers.size());
+		for (const auto clientID : subscribers)
+		{
+			recipients.emplace_back(MessageRecipient{clientID, protocol, entity, getPriority(clientID, entity)});
+		}
+		m_messageSink.pushBroadcast(type, recipients, data);
+	}
+
+	auto InterestManager::getVisibleEntities(const entt::entity clientID, std::vector<entt::entity>& entities) const -> void
+	{
+		m_grid.getVisibleEntities(clientID, entities);
+	}
+
+	auto InterestManager::getPriority(const entt::entity clientID, const entt::entity entity) const -> float
+	{
+		const auto* clientPosition = m_registry.try_get<Common::Game::WorldEntityPosition>(clientID);
+		const auto* entityPosition = m_registry.try_get<Common::Game::WorldEntityPosition>(entity);
+		if (clientPosition == nullptr || entityPosition == nullptr)
+		{
+			return 1.F;
+		}
+
+		auto offset = entityPosition->position - clientPosition->position;
+		return 1.F / (1.F + std::hypot(offset.x, offset.y) / PRIORITY_FALLOFF_DISTANCE);
+	}
+
+	auto InterestManager::sendEvents() -> void
+	{
+		for (const auto& event : m_grid.takeEvents())
+		{
+			auto data = Common::Network::MessageData();
+			data << event.entity;
+
+			if (!event.isEnter)
+			{
+				m_messageSink.pushMessage(Common::Network::Protocol::ReliableOrdered, Common::Network::MessageType::Server_DestroyEntity, event.subscriber, data);
+				continue;
+			}
+
+			if (!m_registry.valid(event.entity))
+			{
+				continue;
+			}
+
+			Common::Game::serialiseWorldEntity(m_registry, event.entity, data);
+			auto priority = getPriority(event.subscriber, event.entity);
+			m_messageSink.pushMessage(Common::Network::Protocol::ReliableOrdered, Common::Network::MessageType::Server_CreateEntity, event.subscriber, data, event.entity, priority);
+
+			// Input state is only broadcast when it changes, so the client needs the current state to predict the entity's movement
+			if (const auto* inputState = m_registry.try_get<Common::Input::InputState>(event.entity))
+			{
+				auto inputData = Common::Network::MessageData();
+				inputData << event.entity << *inputState;
+				m_messageSink.pushMessage(Common::Network::Protocol::ReliableOrdered, Common::Network::MessageType::Server_InputState, event.subscriber, inputData, event.entity, priority);
+			}
+		}
+	}
+
+} // namespace Server
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Network/MessageSink.hpp"
+#include <Common/World/InterestGrid.hpp>
+#include <entt/entity/registry.hpp>
+#include <vector>
+
+namespace Server
+{
+
+	/**
+	 * \class InterestManager InterestManager.hpp "Replication/InterestManager.hpp"
+	 * \brief Keeps an InterestGrid in step with the world entities, so messages about an entity only reach the clients near it
+	 *
+	 * Each client in the world subscribes to the cells around its own entity. When an entity comes into view the client is sent
+	 * Server_CreateEntity and its input state, and when it goes out of view, Server_DestroyEntity.
+	 */
+	class InterestManager
+	{
+	public:
+		/**
+		 * \brief Construct a new Interest Manager object
+		 *
+		 * \param registry The registry containing the world entities
+		 * \param messageSink Where to send messages to clients
+		 */
+		InterestManager(entt::registry& registry, MessageSink& messageSink);
+
+		/**
+		 * \brief Move every world entity to its current cell, and tell clients about the entities coming into and going out of view
+		 *
+		 */
+		auto update() -> void;
+
+		/**
+		 * \brief Remove an entity from the world straight away, telling every client which could see it
+		 *
+		 * \param entity The entity to remove
+		 */
+		auto remove(entt::entity entity) -> void;
+
+		/**
+		 * \brief Push a message into the outbound queue, to every client which can see an entity. The data is packed once and
+		 * shared between them
+		 *
+		 * \param protocol The protocol to send the message over
+		 * \param type The type of message to send
+		 * \param entity The entity the message is about
+		 * \param data The data to send to the clients
+		 */
+		auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entity, Common::Network::MessageData& data) -> void;
+
+		/**
+		 * \brief Get every entity a client can see, including its own
+		 *
+		 * \param clientID The ID of the client
+		 * \param entities The entities are appended to this
+		 */
+		auto getVisibleEntities(entt::entity clientID, std::vector<entt::entity>& entities) const -> void;
+
+	private:
+		/**
+		 * \brief Weigh how much a message about an entity matters to a client, by how far the entity is from them
+		 *
+		 * \param clientID The ID of the client
+		 * \param entity The entity the message is about
+		 * \return float 1 for the client's own entity, falling towards 0 with distance
+		 */
+		[[nodiscard]] auto getPriority(entt::entity clientID, entt::entity entity) const -> float;
+
+		/**
+		 * \brief Send the messages for every event raised by the grid since the last call
+		 *
+		 */
+		auto sendEvents() -> void;
+
+		entt::registry& m_registry;
+		MessageSink& m_messageSink;
+		Common::World::InterestGrid m_grid;
+	};
+
+} // namespace Server
\ No newline at end of file
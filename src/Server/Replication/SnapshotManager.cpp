@@ -0,0 +1,172 @@
+#include "Replication/SnapshotManager.hpp"
+#include "Network/Client.hpp"
+#include <Common/Game/WorldEntity.hpp>
+#include <algorithm>
+
+namespace Server
+{
+
+	SnapshotManager::SnapshotManager(entt::registry& registry, MessageSink& messageSink, const InterestManager& interestManager) :
+	    m_registry(registry),
+	    m_messageSink(messageSink),
+	    m_interestManager(interestManager)
+	{
+	}
+
+	auto SnapshotManager::update() -> void
+	{
+		for (const auto clientID : m_registry.view<Client, Common::Game::WorldEntityPosition>())
+		{
+			auto& clientSnapshots = m_registry.get_or_emplace<Replication::ClientSnapshots>(clientID);
+
+			// Clients only see the entities in the cells around them
+			m_visibleEntities.clear();
+			m_interestManager.getVisibleEntities(clientID, m_visibleEntities);
+
+			auto snapshot = Common::Game::Snapshot();
+			snapshot.id   = clientSnapshots.nextSnapshotID++;
+			for (const auto entity : m_visibleEntities)
+			{
+				// The grid is only updated periodically, so it may still hold entities which have since been destroyed
+				if (!m_registry.valid(entity))
+				{
+					continue;
+				}
+
+				const auto* position = m_registry.try_get<Common::Game::WorldEntityPosition>(entity);
+				const auto* stats    = m_registry.try_get<Common::Game::WorldEntityStats>(entity);
+				if (position != nullptr && stats != nullptr)
+				{
+					// Positions are remembered as the client will receive them, so deltas from them are exact
+					snapshot.entities.emplace(entity, Common::Game::EntitySnapshot{position->quantised(), *stats});
+				}
+			}
+
+			sendSnapshot(clientID, clientSnapshots, snapshot);
+			clientSnapshots.history.store(std::move(snapshot));
+		}
+	}
+
+	auto SnapshotManager::sendSnapshot(const entt::entity clientID, const Replication::ClientSnapshots& clientSnapshots, Common::Game::Snapshot& snapshot) -> void
+	{
+		// Leaves plenty of room below MAX_MESSAGE_LENGTH for the entry which crosses the limit
+		const auto MAX_SNAPSHOT_LENGTH = Common::Network::MAX_MESSAGE_LENGTH / 4;
+		const auto EMPTY_SNAPSHOT      = Common::Game::Snapshot();
+
+		// Without an acknowledged snapshot that's still remembered, everything is sent in full
+		const auto* baseline = clientSnapshots.history.find(clientSnapshots.acknowledgedSnapshotID);
+		if (baseline == nullptr)
+		{
+			baseline = &EMPTY_SNAPSHOT;
+		}
+
+		m_entries.clear();
+		for (const auto& [entity, entitySnapshot] : snapshot.entities)
+		{
+			auto iterator = baseline->entities.find(entity);
+			if (iterator == baseline->entities.end())
+			{
+				m_entries.emplace_back(entity, Common::Game::SnapshotEntry::Created);
+			}
+			else if (iterator->second != entitySnapshot)
+			{
+				m_entries.emplace_back(entity, Common::Game::SnapshotEntry::Updated);
+			}
+			else
+			{
+				++m_unchangedEntries;
+			}
+		}
+		for (const auto& [entity, entitySnapshot] : baseline->entities)
+		{
+			if (!snapshot.entities.contains(entity))
+			{
+				m_entries.emplace_back(entity, Common::Game::SnapshotEntry::Destroyed);
+			}
+		}
+
+		// Entities are sent in order so each ID can be sent as the difference from the one before it
+		std::sort(m_entries.begin(), m_entries.end());
+
+		auto data = Common::Network::MessageData();
+		data << snapshot.id << baseline->id;
+
+		auto writer         = Common::Network::BitWriter(data);
+		auto previousEntity = std::int64_t(0);
+		for (const auto& [entity, entry] : m_entries)
+		{
+			if (data.size() >= MAX_SNAPSHOT_LENGTH)
+			{
+				// The client will still have the baseline state of anything left out, so the snapshot has to say the same
+				auto iterator = baseline->entities.find(entity);
+				if (iterator == baseline->entities.end())
+				{
+					snapshot.entities.erase(entity);
+				}
+				else
+				{
+					snapshot.entities.insert_or_assign(entity, iterator->second);
+				}
+				++m_deferredEntries;
+				continue;
+			}
+
+			writer.writeBool(true);
+			writer.writeSignedVarint(static_cast<std::uint32_t>(entity) - previousEntity);
+			writer.writeEnum(entry, Common::Game::SNAPSHOT_ENTRY_BITS);
+			previousEntity = static_cast<std::uint32_t>(entity);
+
+			switch (entry)
+			{
+				case Common::Game::SnapshotEntry::Created:
+					writer.flush();
+					Common::Game::serialiseWorldEntity(m_registry, entity, data);
+					++m_createdEntries;
+					break;
+				case Common::Game::SnapshotEntry::Updated:
+				{
+					auto& entitySnapshot = snapshot.entities.at(entity);
+					auto& baselineEntity = baseline->entities.at(entity);
+					entitySnapshot.position.serialiseDelta(baselineEntity.position, writer);
+					entitySnapshot.stats.serialiseDelta(baselineEntity.stats, writer);
+					++m_updatedEntries;
+				}
+				break;
+				case Common::Game::SnapshotEntry::Destroyed:
+					++m_destroyedEntries;
+					break;
+			}
+		}
+
+		// Each entry is preceded by a set bit, and the entries are terminated by a clear one
+		writer.writeBool(false);
+		writer.flush();
+
+		m_sentBytes += data.size();
+		++m_sentSnapshots;
+		m_messageSink.pushMessage(Common::Network::Protocol::UnreliableSequenced, Common::Network::MessageType::Server_Snapshot, clientID, data);
+	}
+
+	auto SnapshotManager::acknowledge(const entt::entity clientID, const std::uint32_t snapshotID) -> void
+	{
+		auto* clientSnapshots = m_registry.try_get<Replication::ClientSnapshots>(clientID);
+		if (clientSnapshots == nullptr)
+		{
+			return;
+		}
+
+		// Only move the baseline forward, and only to a snapshot that's still remembered
+		if (snapshotID > clientSnapshots->acknowledgedSnapshotID && clientSnapshots->history.find(snapshotID) != nullptr)
+		{
+			clientSnapshots->acknowledgedSnapshotID = snapshotID;
+		}
+	}
+
+	auto SnapshotManager::logMetrics() const -> void
+	{
+		auto snapshots = std::max<std::uint64_t>(m_sentSnapshots, 1);
+		spdlog::info("Snapshots: {} sent, {} bytes ({:.1f} per snapshot)", m_sentSnapshots, m_sentBytes, static_cast<double>(m_sentBytes) / static_cast<double>(snapshots));
+		spdlog::info("Snapshot entries: {} created, {} updated, {} destroyed, {} unchanged, {} deferred", m_createdEntries, m_updatedEntries, m_destroyedEntries, m_unchangedEntries, m_deferredEntries);
+	}
+
+} // namespace Server
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Network/MessageSink.hpp"
+#include "Replication/InterestManager.hpp"
+#include <Common/Game/Snapshot.hpp>
+#include <entt/entity/registry.hpp>
+#include <utility>
+#include <vector>
+
+namespace Server
+{
+
+	namespace Replication
+	{
+		/**
+		 * \struct ClientSnapshots SnapshotManager.hpp "Replication/SnapshotManager.hpp"
+		 * \brief The snapshots sent to a client, attached to the client's entity once it's in the world
+		 */
+		struct ClientSnapshots
+		{
+			std::uint32_t nextSnapshotID         = 1;
+			std::uint32_t acknowledgedSnapshotID = 0;
+			Common::Game::SnapshotHistory history;
+		};
+	} // namespace Replication
+
+	/**
+	 * \class SnapshotManager SnapshotManager.hpp "Replication/SnapshotManager.hpp"
+	 * \brief Replicates the world to each client as a series of snapshots
+	 *
+	 * Each snapshot is encoded relative to the latest one the client has acknowledged: entities the client doesn't have yet are
+	 * sent in full, and entities it does have are sent as just the component fields which have changed, or not at all if none have.
+	 * Snapshots are sent unreliably, as a lost one is superseded by the next, which is still relative to a snapshot the client has.
+	 */
+	class SnapshotManager
+	{
+	public:
+		/**
+		 * \brief Construct a new Snapshot Manager object
+		 *
+		 * \param registry The registry containing the world entities
+		 * \param messageSink Where to send snapshots to clients
+		 * \param interestManager The interest manager deciding which entities each client can see
+		 */
+		SnapshotManager(entt::registry& registry, MessageSink& messageSink, const InterestManager& interestManager);
+
+		/**
+		 * \brief Take a snapshot of the world and send it to every client in it
+		 *
+		 */
+		auto update() -> void;
+
+		/**
+		 * \brief Record that a client has received a snapshot, so later snapshots can be encoded relative to it
+		 *
+		 * \param clientID The ID of the client
+		 * \param snapshotID The ID of the snapshot the client received
+		 */
+		auto acknowledge(entt::entity clientID, std::uint32_t snapshotID) -> void;
+
+		/**
+		 * \brief Log how many snapshots have been sent and what they contained
+		 *
+		 */
+		auto logMetrics() const -> void;
+
+	private:
+		/**
+		 * \brief Write a snapshot relative to the client's latest acknowledged snapshot, and send it to them.
+		 * Entities left out because the message is full are reverted to their baseline state in the snapshot
+		 *
+		 * \param clientID The ID of the client
+		 * \param clientSnapshots The snapshots sent to the client
+		 * \param snapshot The snapshot to send
+		 */
+		auto sendSnapshot(entt::entity clientID, const Replication::ClientSnapshots& clientSnapshots, Common::Game::Snapshot& snapshot) -> void;
+
+		entt::registry& m_registry;
+		MessageSink& m_messageSink;
+		const InterestManager& m_interestManager;
+
+		std::vector<entt::entity> m_visibleEntities;
+		std::vector<std::pair<entt::entity, Common::Game::SnapshotEntry>> m_entries;
+
+		std::uint64_t m_sentSnapshots    = 0;
+		std::uint64_t m_sentBytes        = 0;
+		std::uint64_t m_createdEntries   = 0;
+		std::uint64_t m_updatedEntries   = 0;
+		std::uint64_t m_destroyedEntries = 0;
+		std::uint64_t m_unchangedEntries = 0;
+		std::uint64_t m_deferredEntries  = 0;
+	};
+
+} // namespace Server
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Common/Util/JobSystem.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+namespace Server
+{
+
+	/**
+	 * \struct Options Options.hpp "Server/Options.hpp"
+	 * \brief Settings chosen when the server is started
+	 */
+	struct Options
+	{
+		bool networkThread = false;
+
+		/// \brief How many times a second the simulation thread and every shard tick
+		std::uint32_t tickRate = 20;
+
+		/// \brief How many shards the world's instances are split between, each simulated on its own thread
+		std::size_t shardCount = 1;
+
+		/// \brief How many worker threads the job system has, which run the shards' systems alongside each other and hash passwords, one
+		/// fewer than the hardware has by default
+		std::size_t workerCount = Common::Util::JobSystem::getDefaultWorkerCount();
+
+		/// \brief How many zone processes the world's instances are split between. When set without a zone index, the server is a gateway
+		/// which owns the clients' connections and leaves the world to the zones
+		std::size_t zoneCount = 0;
+
+		/// \brief Which zone to simulate. When set, the server is a zone process, which connects to the gateway instead of to clients
+		std::optional<std::size_t> zoneIndex;
+
+		/// \brief Where the gateway listens for its zones
+		std::filesystem::path ipcDirectory = "/tmp/mmorpg";
+
+		/// \brief Where compression dictionaries are loaded from, and where dictionaries trained by the traindict command are saved
+		std::filesystem::path dictionaryDirectory = "dictionaries";
+
+		/// \brief How many payloads of each compressed message type to keep for training dictionaries
+		std::size_t capturedSamples = 0;
+	};
+
+} // namespace Server
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "Server.hpp"
+#include "Server/WorldSystems.hpp"
+#include "Zone/ZoneManager.hpp"
 #include <Common/Game.hpp>
 #include <nlohmann/json.hpp>
 
@@ -8,18 +10,18 @@ namespace Server
 #define SYSTEM_FN(NAME) auto system##NAME(Server& server, const sf::Time deltaTime)->void
 #define HANDLER_FN(NAME) auto handler##NAME(Common::Network::Message& message, Server& server)->void
 
-	auto writePlayerToDatabase(entt::entity entity, entt::registry& registry, DatabaseManager& databaseManager) -> void
+	auto writePlayerToDatabase(const EntityTransfer& entity, DatabaseManager& databaseManager) -> void
 	{
-		auto& name     = registry.get<Common::Game::WorldEntityName>(entity);
-		auto& position = registry.get<Common::Game::WorldEntityPosition>(entity);
-		auto& stats    = registry.get<Common::Game::WorldEntityStats>(entity);
+		const auto& name     = entity.world.name;
+		const auto& position = entity.world.position;
+		const auto& stats    = entity.world.stats;
 
 		auto jsSkills = nlohmann::json();
 		jsSkills.emplace("melee", 0);
 		jsSkills.emplace("ranged", 0);
 
 		auto jsWorldPosition = nlohmann::json();
-		jsWorldPosition.emplace("instance", 0);
+		jsWorldPosition.emplace("instance", position.instanceID);
 		jsWorldPosition.emplace("position", std::array<float, 2>{position.position.x, position.position.y});
 
 		auto jsStats = nlohmann::json();
@@ -35,125 +37,24 @@ namespace Server
 		databaseManager.replace("rockworld_testing", "players", nlohmann::json::parse("{\"name\": \"" + name.name + "\"}"), query);
 	}
 
-	SYSTEM_FN(DatabaseSync)
-	{
-		for (const auto entity : server.registry.view<Common::Game::WorldEntityPosition>())
-		{
-			spdlog::debug("Syncing {} to the database the database", static_cast<std::uint32_t>(entity));
-			writePlayerToDatabase(entity, server.registry, server.databaseManager);
-		}
-	}
-
-	SYSTEM_FN(PlayerMovement)
-	{
-		auto fDt = deltaTime.asSeconds();
-
-		auto view = server.registry.view<Common::Game::WorldEntityPosition, Common::Input::InputState>();
-		for (const auto entity : view)
-		{
-			auto& worldPositionComponent = server.registry.get<Common::Game::WorldEntityPosition>(entity);
-			auto& inputComponent         = server.registry.get<Common::Input::InputState>(entity);
-
-			sf::Vector2f delta{0.0F, 0.0F};
-			if (inputComponent.forwards)
-			{
-				delta.y -= 200.0F * fDt;
-			}
-			if (inputComponent.backwards)
-			{
-				delta.y += 200.0F * fDt;
-			}
-			if (inputComponent.left)
-			{
-				delta.x -= 200.0F * fDt;
-			}
-			if (inputComponent.right)
-			{
-				delta.x += 200.0F * fDt;
-			}
-
-			worldPositionComponent.position += delta;
-		}
-	}
-
-	SYSTEM_FN(BroadcastMovement)
+	auto loadPlayer(const entt::entity entityID, const std::string& username, DatabaseManager& databaseManager) -> EntityTransfer
 	{
-		for (const auto entity : server.registry.view<Common::Game::WorldEntityPosition, Common::Input::InputState>())
-		{
-			auto& inputState = server.registry.get<Common::Input::InputState>(entity);
-			if (inputState.changed)
-			{
-				auto data = Common::Network::MessageData();
-				data << entity << inputState;
-				server.networkManager.pushMessage(Common::Network::Protocol::UDP, Common::Network::MessageType::Server_InputState, data);
-				inputState.changed = false;
-			}
-		}
-	}
-
-	HANDLER_FN(Connect)
-	{
-		auto udpPort = std::uint16_t(0);
-		message.data >> udpPort;
-		server.networkManager.setClientUdpPort(message.header.entityID, udpPort);
-	}
-
-	HANDLER_FN(Disconnect)
-	{
-		auto data = Common::Network::MessageData();
-		data << message.header.entityID;
-		server.networkManager.pushMessage(Common::Network::Protocol::UDP, Common::Network::MessageType::Server_DestroyEntity, data);
-		server.networkManager.pushMessage(Common::Network::Protocol::TCP, Common::Network::MessageType::Server_Disconnect, message.header.entityID, data);
-		server.networkManager.markForDisconnect(message.header.entityID);
-
-		if (server.registry.all_of<Common::Game::WorldEntityPosition>(message.header.entityID))
-		{
-			auto& name     = server.registry.get<Common::Game::WorldEntityName>(message.header.entityID);
-			auto& position = server.registry.get<Common::Game::WorldEntityPosition>(message.header.entityID);
-			auto& stats    = server.registry.get<Common::Game::WorldEntityStats>(message.header.entityID);
+		auto player            = EntityTransfer();
+		player.entityID        = entityID;
+		player.isClient        = true;
+		player.inputState      = Common::Input::InputState();
+		player.world.name.name = username;
 
-			spdlog::debug("Syncing {} to the database", name.name);
-			writePlayerToDatabase(message.header.entityID, server.registry, server.databaseManager);
-		}
-
-		if (server.registry.all_of<Login::UserData>(message.header.entityID))
-		{
-			server.loginManager.logout(server.registry.get<Login::UserData>(message.header.entityID).username);
-		}
-	}
-
-	HANDLER_FN(Command)
-	{
-		auto command = std::string(static_cast<char*>(message.data.data()), message.data.size());
-		server.commandShell.parseMessage(command);
-	}
-
-	HANDLER_FN(Spawn)
-	{
-		if (server.registry.all_of<Common::Game::WorldEntityPosition>(message.header.entityID))
-		{
-			return;
-		}
-
-		auto username = server.registry.get<Login::UserData>(message.header.entityID).username;
-
-		spdlog::debug("Creating a player for {}", username);
-
-		server.registry.emplace_or_replace<Common::Input::InputState>(message.header.entityID);
-		Common::Game::createWorldEntity(server.registry, message.header.entityID, {});
-		auto& worldEntityName = server.registry.get<Common::Game::WorldEntityName>(message.header.entityID);
-		worldEntityName.name  = username;
-
-		auto optPlayerData = server.databaseManager.get("rockworld_testing", "players", nlohmann::json::parse("{\"name\": \"" + username + "\"}"));
+		auto optPlayerData = databaseManager.get("rockworld_testing", "players", nlohmann::json::parse("{\"name\": \"" + username + "\"}"));
 		if (optPlayerData.has_value())
 		{
-			spdlog::debug("Player {} already exists on the database - fetching", worldEntityName.name);
+			spdlog::debug("Player {} already exists on the database - fetching", username);
 			auto jsWorldPosition = optPlayerData->at("world_position");
 			auto jsStats         = optPlayerData->at("stats");
 			auto jsSkills        = optPlayerData->at("skills");
 
-			auto& worldEntityPosition = server.registry.get<Common::Game::WorldEntityPosition>(message.header.entityID);
-			auto& worldEntityStats    = server.registry.get<Common::Game::WorldEntityStats>(message.header.entityID);
+			auto& worldEntityPosition = player.world.position;
+			auto& worldEntityStats    = player.world.stats;
 
 			worldEntityPosition.instanceID = jsWorldPosition.at("instance").get<std::uint32_t>();
 			worldEntityPosition.position.x = jsWorldPosition.at("position").at(0).get<float>();
@@ -169,7 +70,7 @@ namespace Server
 		}
 		else
 		{
-			spdlog::debug("Player {} does not exist on the database - inserting", worldEntityName.name);
+			spdlog::debug("Player {} does not exist on the database - inserting", username);
 			auto query = nlohmann::json::parse(
 			    R"(
 			{
@@ -188,80 +89,96 @@ namespace Server
 			}
 				)");
 			query.emplace("name", username);
-			server.databaseManager.insert("rockworld_testing", "players", query);
+			databaseManager.insert("rockworld_testing", "players", query);
 		}
 
-		auto data = Common::Network::MessageData();
-		data << message.header.entityID;
-		Common::Game::serialiseWorldEntity(server.registry, message.header.entityID, data);
-		server.networkManager.pushMessage(Common::Network::Protocol::UDP, Common::Network::MessageType::Server_CreateEntity, data);
+		return player;
 	}
 
-	HANDLER_FN(Action)
+	SYSTEM_FN(DatabaseSync)
 	{
-		auto action = Common::Input::Action();
-		message.data >> action;
+		server.world->saveAll();
+	}
 
-		if (!server.registry.all_of<Common::Input::InputState>(message.header.entityID))
+	SYSTEM_FN(SaveEntities)
+	{
+		// Taken before the saved entities, so anything saved before an entity was lost is written before it's loaded again
+		auto lostEntities = std::vector<entt::entity>();
+		server.world->takeLostEntities(lostEntities);
+
+		// The world hands over copies of the entities to save, as the database belongs to this thread
+		auto entities = std::vector<EntityTransfer>();
+		server.world->takeSavedEntities(entities);
+		for (const auto& entity : entities)
 		{
-			return;
+			if (entity.isClient)
+			{
+				spdlog::debug("Syncing {} to the database", entity.world.name.name);
+				writePlayerToDatabase(entity, server.databaseManager);
+			}
 		}
 
-		auto& inputState   = server.registry.get<Common::Input::InputState>(message.header.entityID);
-		inputState.changed = true;
-		switch (action.type)
+		for (const auto entity : lostEntities)
 		{
-			case Common::Input::ActionType::MoveForward:
-			{
-				inputState.forwards = (action.state == Common::Input::Action::State::Begin);
-			}
-			break;
-			case Common::Input::ActionType::MoveBackward:
-			{
-				inputState.backwards = (action.state == Common::Input::Action::State::Begin);
-			}
-			break;
-			case Common::Input::ActionType::StrafeLeft:
-			{
-				inputState.left = (action.state == Common::Input::Action::State::Begin);
-			}
-			break;
-			case Common::Input::ActionType::StrafeRight:
+			if (server.registry.valid(entity) && server.registry.all_of<Login::UserData>(entity))
 			{
-				inputState.right = (action.state == Common::Input::Action::State::Begin);
+				auto& username = server.registry.get<Login::UserData>(entity).username;
+				spdlog::warn("{} dropped out of the world, so is being loaded again from the database", username);
+				server.world->spawn(loadPlayer(entity, username, server.databaseManager));
 			}
-			break;
-			default:
-				break;
 		}
 	}
 
-	HANDLER_FN(GetWorldState)
+	HANDLER_FN(Connect)
+	{
+		auto udpPort = std::uint16_t(0);
+		message.data >> udpPort;
+
+		// A request without a version keeps the client on the one every peer starts with
+		auto headerVersion = Common::Network::COMPACT_HEADER_VERSION;
+		if (message.data.remaining() >= sizeof(headerVersion))
+		{
+			message.data >> headerVersion;
+		}
+
+		server.networkManager.setClientUdpPort(message.header.entityID, udpPort, headerVersion);
+	}
+
+	HANDLER_FN(Disconnect)
 	{
-		auto tileIdentifier = std::uint32_t(0);
-		message.data >> tileIdentifier;
+		// Whatever simulates the entity tells the clients which could see it that it's gone, then hands it back to be saved
+		server.world->despawn(message.header.entityID);
 
-		// Emplace the count at position 0, then serialise entities into it
-		auto data       = Common::Network::MessageData();
-		auto entityList = std::vector<entt::entity>();
+		auto data = Common::Network::MessageData();
+		data << message.header.entityID;
+		server.networkManager.pushMessage(Common::Network::Protocol::TCP, Common::Network::MessageType::Server_Disconnect, message.header.entityID, data);
+		server.networkManager.markForDisconnect(message.header.entityID);
 
-		for (const auto entity : server.registry.view<Common::Game::WorldEntityPosition>())
+		if (server.registry.all_of<Login::UserData>(message.header.entityID))
 		{
-			auto& worldPositionComponent = server.registry.get<Common::Game::WorldEntityPosition>(entity);
-			if (worldPositionComponent.instanceID == tileIdentifier)
-			{
-				entityList.emplace_back(entity);
-			}
+			server.loginManager.logout(server.registry.get<Login::UserData>(message.header.entityID).username);
 		}
+	}
+
+	HANDLER_FN(Command)
+	{
+		auto command = std::string(static_cast<char*>(message.data.data()), message.data.size());
+		server.commandShell.parseMessage(command);
+	}
 
-		data << std::uint32_t(entityList.size());
-		for (const auto entity : entityList)
+	HANDLER_FN(Spawn)
+	{
+		if (server.world->isSpawned(message.header.entityID))
 		{
-			data << entity;
-			Common::Game::serialiseWorldEntity(server.registry, entity, data);
+			return;
 		}
 
-		server.networkManager.pushMessage(Common::Network::Protocol::UDP, Common::Network::MessageType::Server_WorldState, data);
+		auto username = server.registry.get<Login::UserData>(message.header.entityID).username;
+
+		spdlog::debug("Creating a player for {}", username);
+
+		// The shard owning the player's instance sends them their entity once it's in the world
+		server.world->spawn(loadPlayer(message.header.entityID, username, server.databaseManager));
 	}
 
 	HANDLER_FN(Authenticate)
@@ -271,46 +188,68 @@ namespace Server
 
 		message.data >> username >> password;
 
-		auto data = Common::Network::MessageData();
-
-		auto loggedInResult = server.loginManager.isLoggedIn(username);
-		if (loggedInResult)
-		{
-			data << static_cast<std::uint8_t>(Login::AuthenticationResult::AlreadyLoggedIn);
-		}
-		else
-		{
-			auto authResult = server.loginManager.authenticate(username, password);
-			data << static_cast<std::uint8_t>(authResult);
+		auto entityID = message.header.entityID;
+		server.loginManager.authenticate(username, password, server.jobSystem, [&server, entityID, username](const Login::AuthenticationResult result) {
+			// The client may have disconnected while its password was being hashed
+			if (!server.registry.valid(entityID))
+			{
+				return;
+			}
 
-			if (authResult == Login::AuthenticationResult::Valid)
+			if (result == Login::AuthenticationResult::Valid)
 			{
-				server.registry.emplace<Login::UserData>(message.header.entityID, Login::UserData{username});
+				server.registry.emplace<Login::UserData>(entityID, Login::UserData{username});
 				server.loginManager.login(username);
+				server.networkManager.markAuthenticated(entityID);
 			}
-		}
 
-		server.networkManager.pushMessage(Common::Network::Protocol::TCP, Common::Network::MessageType::Server_Authenticate, message.header.entityID, data);
+			auto data = Common::Network::MessageData();
+			data << static_cast<std::uint8_t>(result);
+			server.networkManager.pushMessage(Common::Network::Protocol::TCP, Common::Network::MessageType::Server_Authenticate, entityID, data);
+		});
 	}
 
-
 #undef SYSTEM_FN
 #undef HANDLER_FN
 
-	Server::Server(const std::filesystem::path& executableDirectory) :
+	Server::Server(const std::filesystem::path& executableDirectory, const Options& options) :
 	    databaseManager(),
 	    loginManager(databaseManager),
-	    networkManager(*this)
+	    networkManager(*this),
+	    jobSystem(options.workerCount),
+	    m_scheduler(TickScheduler::getTickLength(options.tickRate))
 	{
 		loginManager.createUser("admin", "password");
 
-		m_clock.restart();
 		networkManager.init();
+		networkManager.configureCompression(executableDirectory / options.dictionaryDirectory, options.capturedSamples);
+		if (options.networkThread)
+		{
+			networkManager.startIOThread();
+		}
 
-		addSystem(systemPlayerMovement, sf::milliseconds(50));
-		addSystem(systemBroadcastMovement, sf::milliseconds(50));
+		addSystem(systemSaveEntities);
 		addSystem(systemDatabaseSync, sf::seconds(300));
 
+		// A gateway leaves the world to its zone processes, and only passes them the messages their shards handle
+		if (options.zoneCount > 0)
+		{
+			auto zoneManager = std::make_unique<ZoneManager>(networkManager, options.zoneCount, options.ipcDirectory);
+			for (const auto messageType : WORLD_MESSAGE_TYPES)
+			{
+				zoneManager->addRoutedType(messageType);
+			}
+			zoneManager->start();
+			world = std::move(zoneManager);
+		}
+		else
+		{
+			auto shardManager = std::make_unique<ShardManager>(networkManager, options.shardCount, jobSystem);
+			addWorldSystems(*shardManager);
+			shardManager->start(m_scheduler.getTickLength());
+			world = std::move(shardManager);
+		}
+
 		using MT
 		    = Common::Network::MessageType;
 		addMessageHandler(MT::Client_Connect, handlerConnect);
@@ -320,17 +259,46 @@ namespace Server
 		addMessageHandler(MT::Command, handlerCommand);
 
 		addMessageHandler(MT::Client_Spawn, handlerSpawn);
-		addMessageHandler(MT::Client_Action, handlerAction);
-		addMessageHandler(MT::Client_GetWorldState, handlerGetWorldState);
 
 		commandShell.registerCommand("terminate", [&](std::vector<std::string> tokens) {
 			m_serverShouldExit = true;
 			return;
 		});
+
+		commandShell.registerCommand("netstats", [&](std::vector<std::string> tokens) {
+			networkManager.logMetrics();
+			world->logMetrics();
+		});
+
+		commandShell.registerCommand("tickstats", [&](std::vector<std::string> tokens) {
+			m_scheduler.logMetrics("Server");
+			world->logMetrics();
+		});
+
+		commandShell.registerCommand("transfer", [&](std::vector<std::string> tokens) {
+			if (tokens.size() < 3)
+			{
+				spdlog::warn("Usage: transfer <entity> <instance>");
+				return;
+			}
+
+			auto entityID   = static_cast<entt::entity>(std::stoul(tokens[1]));
+			auto instanceID = static_cast<std::uint32_t>(std::stoul(tokens[2]));
+			if (!world->requestTransfer(entityID, instanceID))
+			{
+				spdlog::warn("Entity {} isn't in the world", tokens[1]);
+			}
+		});
+
+		commandShell.registerCommand("traindict", [&, dictionaryDirectory = executableDirectory / options.dictionaryDirectory](std::vector<std::string> tokens) {
+			auto saved = networkManager.saveCompressionDictionaries(dictionaryDirectory);
+			spdlog::info("Saved {} compression dictionaries to {}, which are used once the server and clients are restarted", saved, dictionaryDirectory.string());
+		});
 	}
 
 	Server::~Server()
 	{
+		world->stop();
 		networkManager.shutdown();
 	}
 
@@ -367,46 +335,22 @@ namespace Server
 
 	auto Server::run() -> void
 	{
-		const auto MAX_UPDATES_PER_SECOND = 20;
-		const auto MIN_UPDATE_TIME        = sf::milliseconds(1000 / MAX_UPDATES_PER_SECOND);
-		auto timeToNextSystemFire         = sf::Time::Zero;
-
+		m_scheduler.reset();
 		while (!m_serverShouldExit)
 		{
-			auto deltaTime = m_clock.restart();
-			parseMessages();
-
-			for (auto& system : m_systems)
+			// Every due tick is run, up to the catch-up limit, each simulating exactly one tick length
+			auto dueTicks = m_scheduler.getDueTicks();
+			for (auto i = std::size_t(0); i < dueTicks && !m_serverShouldExit; ++i)
 			{
-				// The system is set to fire at every update, so fire it
-				if (system.firingInterval == sf::Time::Zero)
-				{
-					system.callback(*this, deltaTime);
-				}
-				// The system is set to fire on an interval
-				else
-				{
-					system.timeToNextFire -= deltaTime;
-					// The system is due to fire, so fire the system and reset it's counter
-					if (system.timeToNextFire.asMilliseconds() <= 0)
-					{
-						system.callback(*this, system.firingInterval - system.timeToNextFire);
-						system.timeToNextFire = system.firingInterval;
-					}
-					// The system is not due to fire, so see if it's next to fire and set the timeToNextSystemFire accordingly
-					else if (system.timeToNextFire < timeToNextSystemFire)
-					{
-						timeToNextSystemFire = system.timeToNextFire;
-					}
-				}
+				m_scheduler.beginTick();
+				jobSystem.runMainThreadJobs();
+				parseMessages();
+				updateSystems();
+				m_scheduler.endTick();
 			}
 
-			// Use the socket selector to stall the server until the next system needs to fire
-			if (timeToNextSystemFire < MIN_UPDATE_TIME)
-			{
-				timeToNextSystemFire = MIN_UPDATE_TIME;
-			}
-			networkManager.update(timeToNextSystemFire);
+			// Service the network until the next tick is due
+			networkManager.update(m_scheduler.getTimeUntilNextTick());
 		}
 	}
 
@@ -415,15 +359,42 @@ namespace Server
 		m_serverShouldExit = shouldExit;
 	}
 
+	auto Server::updateSystems() -> void
+	{
+		const auto tickLength = m_scheduler.getTickLength();
+		for (auto& system : m_systems)
+		{
+			// The system is set to fire at every tick, so fire it
+			if (system.firingInterval == sf::Time::Zero)
+			{
+				system.callback(*this, tickLength);
+				continue;
+			}
+
+			// The system fires on an interval, and always simulates exactly that much time. What's left over counts towards the next
+			// firing, so the interval doesn't drift when it isn't a whole number of ticks
+			system.timeSinceLastFire += tickLength;
+			if (system.timeSinceLastFire >= system.firingInterval)
+			{
+				system.callback(*this, system.firingInterval);
+				system.timeSinceLastFire -= system.firingInterval;
+			}
+		}
+	}
+
 	auto Server::parseMessages() -> void
 	{
-		auto messages = networkManager.getMessages();
-		for (auto& message : messages)
+		networkManager.getMessages(m_inboundMessages);
+		for (auto& message : m_inboundMessages)
 		{
 			if (m_messageHandlers.contains(message.header.type))
 			{
 				m_messageHandlers.at(message.header.type)(message, *this);
 			}
+			else
+			{
+				world->route(message);
+			}
 		}
 	}
 
@@ -3,11 +3,15 @@
 #include "Database/DatabaseManager.hpp"
 #include "Login/LoginManager.hpp"
 #include "Network/NetworkManager.hpp"
+#include "Server/Options.hpp"
+#include "Server/TickScheduler.hpp"
+#include "Server/World.hpp"
 #include "Shell/CommandShell.hpp"
 #include "entt/entity/fwd.hpp"
 #include <Common/Network.hpp>
-#include <SFML/System/Clock.hpp>
+#include <Common/Util/JobSystem.hpp>
 #include <entt/entity/registry.hpp>
+#include <memory>
 
 namespace Server
 {
@@ -20,6 +24,9 @@ namespace Server
 	/**
 	 * \class Server::Server Server.hpp "Server/Server.hpp"
 	 * \brief Manages and updates the global state of the server
+	 *
+	 * The server's own registry and systems hold what's global to a client's session, such as its login, on the simulation thread. The
+	 * world itself is simulated by the shards, each on its own thread, or when the server is a gateway, by zone processes behind it
 	 */
 	class Server
 	{
@@ -27,8 +34,10 @@ namespace Server
 		/**
 		 * \brief Construct a new Server object
 		 *
+		 * \param executableDirectory The directory containing the server executable
+		 * \param options The settings the server was started with
 		 */
-		Server(const std::filesystem::path& executableDirectory);
+		Server(const std::filesystem::path& executableDirectory, const Options& options = {});
 		/**
 		 * \brief Destroy the Server object
 		 *
@@ -36,7 +45,8 @@ namespace Server
 		~Server();
 
 		/**
-		 * \brief Run the server's main loop until set to exit
+		 * \brief Run the server's main loop until set to exit. Systems are updated once per tick, at the tick rate the server was started
+		 * with, and the network is serviced while waiting for the next
 		 *
 		 */
 		auto run() -> void;
@@ -48,7 +58,7 @@ namespace Server
 		auto setShouldExit(bool shouldExit) -> void;
 
 		/**
-		 * \brief Attach a system to the server, to be updated every cycle of the main loop
+		 * \brief Attach a system to the server, to be updated every tick
 		 *
 		 * \param system The system to attach to the server
 		 */
@@ -58,7 +68,7 @@ namespace Server
 		 * \brief Attach a system to the server, to be updated at a specific interval
 		 *
 		 * \param system The system to attach to the server
-		 * \param updateInterval How often the system should be updated
+		 * \param updateInterval How often the system should be updated. Each firing lands on a tick, but they average out to the interval
 		 */
 		auto addSystem(SystemFunction&& system, sf::Time updateInterval) -> void;
 
@@ -69,7 +79,7 @@ namespace Server
 		auto clearSystems() -> void;
 
 		/**
-		 * \brief Register a message handler with the server
+		 * \brief Register a message handler with the server, which runs on the simulation thread
 		 *
 		 * \param messageType The type of message the handler should accept
 		 * \param handlerFunction The function to be called when a message of the given type is received
@@ -88,22 +98,27 @@ namespace Server
 		CommandShell commandShell;
 		NetworkManager networkManager;
 		entt::registry registry;
+		// Declared before the world, so it outlives the shards running their systems on it
+		Common::Util::JobSystem jobSystem;
+		std::unique_ptr<World> world;
 
 	private:
 		auto parseMessages() -> void;
+		auto updateSystems() -> void;
 
 		struct SystemWrapper
 		{
 			sf::Time firingInterval;
-			sf::Time timeToNextFire;
+			sf::Time timeSinceLastFire;
 			SystemFunction callback;
 		};
 
 		std::vector<SystemWrapper> m_systems;
 		std::unordered_map<Common::Network::MessageType, MessageHandlerFunction> m_messageHandlers;
+		std::vector<Common::Network::Message> m_inboundMessages;
 
 		bool m_serverShouldExit = false;
-		sf::Clock m_clock;
+		TickScheduler m_scheduler;
 	};
 
 } // namespace Server
\ No newline at end of file
@@ -0,0 +1,367 @@
+#include "Server/Shard.hpp"
+#include "Network/Client.hpp"
+#include "Server/ShardManager.hpp"
+#include <algorithm>
+#include <string>
+
+namespace Server
+{
+
+	Shard::Shard(const std::size_t index, ShardManager& shardManager, MessageSink& messageSink, Common::Util::JobSystem& jobSystem) :
+	    messageSink(messageSink),
+	    interestManager(registry, messageSink),
+	    snapshotManager(registry, messageSink, interestManager),
+	    jobSystem(jobSystem),
+	    m_index(index),
+	    m_shardManager(shardManager)
+	{
+	}
+
+	Shard::~Shard()
+	{
+		stop();
+	}
+
+	auto Shard::addSystem(const ShardSystemFunction& system, const SystemAccess& access, const sf::Time updateInterval) -> void
+	{
+		// The system runs after every system added before it which it conflicts with
+		auto stage = std::size_t(0);
+		for (const auto& other : m_systems)
+		{
+			if (access.conflictsWith(other.access))
+			{
+				stage = std::max(stage, other.stage + 1);
+			}
+		}
+
+		// Systems running at the same time may look up the same storage, which mustn't be created while they do
+		access.assureStorage(registry);
+
+		m_systems.emplace_back(SystemWrapper{updateInterval, sf::Time::Zero, system, access, stage});
+		m_stageCount = std::max(m_stageCount, stage + 1);
+	}
+
+	auto Shard::start(const sf::Time tickLength) -> void
+	{
+		if (m_thread.joinable())
+		{
+			return;
+		}
+
+		m_scheduler = TickScheduler(tickLength);
+		m_running   = true;
+		m_thread     = std::thread(&Shard::run, this);
+	}
+
+	auto Shard::stop() -> void
+	{
+		{
+			auto lock = std::scoped_lock<std::mutex>(m_wakeMutex);
+			m_running = false;
+		}
+		m_wakeCondition.notify_one();
+
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+
+		// Despawns and saves pushed while the thread was finishing its last tick would otherwise never reach the database
+		processCommands();
+	}
+
+	auto Shard::pushMessage(Common::Network::Message&& message) -> void
+	{
+		m_messages.push(std::move(message));
+	}
+
+	auto Shard::spawn(EntityTransfer&& transfer) -> void
+	{
+		m_commands.push(Command{Command::Type::Spawn, std::move(transfer)});
+	}
+
+	auto Shard::adopt(EntityTransfer&& transfer) -> void
+	{
+		m_commands.push(Command{Command::Type::Adopt, std::move(transfer)});
+	}
+
+	auto Shard::despawn(const entt::entity entityID) -> void
+	{
+		auto command              = Command{Command::Type::Despawn};
+		command.transfer.entityID = entityID;
+		m_commands.push(std::move(command));
+	}
+
+	auto Shard::save() -> void
+	{
+		m_commands.push(Command{Command::Type::Save});
+	}
+
+	auto Shard::requestTransfer(const entt::entity entityID, const std::uint32_t instanceID) -> void
+	{
+		auto command              = Command{Command::Type::Transfer};
+		command.transfer.entityID = entityID;
+		command.instanceID        = instanceID;
+		m_commands.push(std::move(command));
+	}
+
+	auto Shard::requestMetrics() -> void
+	{
+		m_commands.push(Command{Command::Type::LogMetrics});
+	}
+
+	auto Shard::transfer(const entt::entity entityID, const std::uint32_t instanceID) -> bool
+	{
+		auto* position = registry.try_get<Common::Game::WorldEntityPosition>(entityID);
+		if (position == nullptr)
+		{
+			return false;
+		}
+
+		// The interest grid keeps instances apart, so moving within the shard is just a change of position
+		auto isLocal = m_shardManager.isLocalInstance(instanceID);
+		if (isLocal && &m_shardManager.getShard(instanceID) == this)
+		{
+			position->instanceID = instanceID;
+			return true;
+		}
+
+		// Nobody else will tell a client leaving the shard that the entities it could see are gone
+		if (registry.all_of<Client>(entityID))
+		{
+			m_visibleEntities.clear();
+			interestManager.getVisibleEntities(entityID, m_visibleEntities);
+			for (const auto entity : m_visibleEntities)
+			{
+				if (entity != entityID)
+				{
+					auto data = Common::Network::MessageData();
+					data << entity;
+					messageSink.pushMessage(Common::Network::Protocol::ReliableOrdered, Common::Network::MessageType::Server_DestroyEntity, entityID, data);
+				}
+			}
+		}
+
+		auto extracted = extractEntity(entityID);
+		extracted->world.position.instanceID = instanceID;
+
+		// Another zone owns the instance, so the gateway hands the entity to it. Its snapshots refer to entities which won't exist there
+		if (!isLocal)
+		{
+			extracted->snapshots.reset();
+			m_shardManager.handOff(std::move(*extracted));
+			spdlog::debug("Handing entity {} from shard {} to another zone, in instance {}", static_cast<std::uint32_t>(entityID), m_index, instanceID);
+			return true;
+		}
+
+		// Queued with the other shard before it's recorded as the owner, so nothing routed to it can arrive before the entity does
+		auto& shard = m_shardManager.getShard(instanceID);
+		shard.adopt(std::move(*extracted));
+		m_shardManager.setOwner(entityID, shard);
+		spdlog::debug("Moved entity {} from shard {} to shard {}, in instance {}", static_cast<std::uint32_t>(entityID), m_index, shard.getIndex(), instanceID);
+		return true;
+	}
+
+	auto Shard::getIndex() const -> std::size_t
+	{
+		return m_index;
+	}
+
+	auto Shard::run() -> void
+	{
+		m_scheduler.reset();
+		while (m_running)
+		{
+			auto dueTicks = m_scheduler.getDueTicks();
+			for (auto i = std::size_t(0); i < dueTicks; ++i)
+			{
+				m_scheduler.beginTick();
+				tick();
+				m_scheduler.endTick();
+			}
+
+			// Send what these ticks pushed now, rather than whenever the sockets are next polled
+			if (dueTicks > 0)
+			{
+				messageSink.wake();
+			}
+
+			auto lock = std::unique_lock<std::mutex>(m_wakeMutex);
+			m_wakeCondition.wait_until(lock, m_scheduler.getNextDeadline(), [&]() {
+				return !m_running;
+			});
+		}
+	}
+
+	auto Shard::tick() -> void
+	{
+		const auto tickLength = m_scheduler.getTickLength();
+
+		processCommands();
+		parseMessages();
+
+		for (auto stage = std::size_t(0); stage < m_stageCount; ++stage)
+		{
+			// Interval systems always simulate exactly their interval, carrying what's left over to the next firing
+			m_stageTasks.clear();
+			for (auto& system : m_systems)
+			{
+				if (system.stage != stage)
+				{
+					continue;
+				}
+
+				auto deltaTime = tickLength;
+				if (system.firingInterval != sf::Time::Zero)
+				{
+					system.timeSinceLastFire += tickLength;
+					if (system.timeSinceLastFire < system.firingInterval)
+					{
+						continue;
+					}
+
+					deltaTime = system.firingInterval;
+					system.timeSinceLastFire -= system.firingInterval;
+				}
+
+				m_stageTasks.emplace_back([this, &system, deltaTime]() {
+					system.callback(*this, deltaTime);
+				});
+			}
+
+			if (m_stageTasks.empty())
+			{
+				continue;
+			}
+
+			// The first system runs on the shard's thread, which then helps with the rest until the stage is done
+			auto group = Common::Util::JobGroup();
+			for (auto i = std::size_t(1); i < m_stageTasks.size(); ++i)
+			{
+				jobSystem.run(group, std::move(m_stageTasks[i]));
+			}
+			m_stageTasks.front()();
+			jobSystem.wait(group);
+		}
+	}
+
+	auto Shard::processCommands() -> void
+	{
+		for (auto& command : m_commands.clear())
+		{
+			switch (command.type)
+			{
+				case Command::Type::Spawn:
+				{
+					auto entityID = command.transfer.entityID;
+					emplaceEntity(std::move(command.transfer));
+
+					// Other clients are sent the entity when it comes into their view, on the next interest update
+					auto data = Common::Network::MessageData();
+					data << entityID;
+					Common::Game::serialiseWorldEntity(registry, entityID, data);
+					messageSink.pushMessage(Common::Network::Protocol::ReliableOrdered, Common::Network::MessageType::Server_CreateEntity, entityID, data);
+				}
+				break;
+				case Command::Type::Adopt:
+					emplaceEntity(std::move(command.transfer));
+					break;
+				case Command::Type::Despawn:
+					if (auto extracted = extractEntity(command.transfer.entityID))
+					{
+						m_shardManager.pushSavedEntity(std::move(*extracted));
+					}
+					break;
+				case Command::Type::Save:
+					for (const auto entityID : registry.view<Client, Common::Game::WorldEntityPosition>())
+					{
+						m_shardManager.pushSavedEntity(copyEntity(entityID));
+					}
+					break;
+				case Command::Type::Transfer:
+					transfer(command.transfer.entityID, command.instanceID);
+					break;
+				case Command::Type::LogMetrics:
+					spdlog::info("Shard {}: {} entities", m_index, registry.view<Common::Game::WorldEntityPosition>().size_hint());
+					snapshotManager.logMetrics();
+					m_scheduler.logMetrics("Shard " + std::to_string(m_index));
+					break;
+			}
+		}
+	}
+
+	auto Shard::parseMessages() -> void
+	{
+		m_messages.drainInto(m_inboundMessages);
+		for (auto& message : m_inboundMessages)
+		{
+			// Messages routed here just before their client moved to another shard find nothing to act on, and are dropped by the handler
+			if (const auto* handler = m_shardManager.getMessageHandler(message.header.type))
+			{
+				(*handler)(message, *this);
+			}
+		}
+	}
+
+	auto Shard::emplaceEntity(EntityTransfer&& transfer) -> void
+	{
+		auto entityID = registry.create(transfer.entityID);
+		if (entityID != transfer.entityID)
+		{
+			spdlog::warn("Shard {} already holds an entity with ID {}", m_index, static_cast<std::uint32_t>(transfer.entityID));
+			registry.destroy(entityID);
+			return;
+		}
+
+		Common::Game::createWorldEntity(registry, entityID, transfer.world);
+		if (transfer.isClient)
+		{
+			registry.emplace<Client>(entityID);
+		}
+		if (transfer.inputState.has_value())
+		{
+			registry.emplace<Common::Input::InputState>(entityID, *transfer.inputState);
+		}
+		if (transfer.snapshots.has_value())
+		{
+			registry.emplace<Replication::ClientSnapshots>(entityID, std::move(*transfer.snapshots));
+		}
+	}
+
+	auto Shard::copyEntity(const entt::entity entityID) -> EntityTransfer
+	{
+		auto transfer           = EntityTransfer();
+		transfer.entityID       = entityID;
+		transfer.isClient       = registry.all_of<Client>(entityID);
+		transfer.world.name     = registry.get<Common::Game::WorldEntityName>(entityID);
+		transfer.world.type     = registry.get<Common::Game::WorldEntityType>(entityID);
+		transfer.world.position = registry.get<Common::Game::WorldEntityPosition>(entityID);
+		transfer.world.stats    = registry.get<Common::Game::WorldEntityStats>(entityID);
+
+		if (const auto* inputState = registry.try_get<Common::Input::InputState>(entityID))
+		{
+			transfer.inputState = *inputState;
+		}
+		return transfer;
+	}
+
+	auto Shard::extractEntity(const entt::entity entityID) -> std::optional<EntityTransfer>
+	{
+		if (!registry.valid(entityID) || !registry.all_of<Common::Game::WorldEntityPosition>(entityID))
+		{
+			return {};
+		}
+
+		auto transfer = copyEntity(entityID);
+		if (auto* snapshots = registry.try_get<Replication::ClientSnapshots>(entityID))
+		{
+			transfer.snapshots = std::move(*snapshots);
+		}
+
+		// Clients which could see the entity are sent Server_DestroyEntity
+		interestManager.remove(entityID);
+		registry.destroy(entityID);
+		return transfer;
+	}
+
+} // namespace Server
\ No newline at end of file
@@ -0,0 +1,278 @@
+#pragma once
+
+#include "Network/MessageSink.hpp"
+#include "Replication/InterestManager.hpp"
+#include "Replication/SnapshotManager.hpp"
+#include "Server/SystemAccess.hpp"
+#include "Server/TickScheduler.hpp"
+#include "Server/World.hpp"
+#include <Common/Util/DoubleBufferedQueue.hpp>
+#include <Common/Util/JobSystem.hpp>
+#include <Common/Util/ThreadSafeQueue.hpp>
+#include <SFML/System/Time.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <entt/entity/registry.hpp>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace Server
+{
+
+	class Shard;
+	class ShardManager;
+
+	using ShardMessageHandlerFunction = std::function<void(Common::Network::Message&, Shard&)>;
+	using ShardSystemFunction         = std::function<void(Shard& shard, sf::Time deltaTime)>;
+
+	/**
+	 * \class Shard Shard.hpp "Server/Shard.hpp"
+	 * \brief Simulates the entities in some of the world's instances, in its own registry and on its own thread
+	 *
+	 * Entities keep the ID they were given by the server's registry, so a client's entity has the same ID in whichever shard holds it.
+	 * Anything touching the shard's registry, interest or snapshots must run on the shard's thread, so everything else reaches the shard
+	 * through its command and message queues, which it empties at the start of every tick. Moving an entity to an instance owned by another
+	 * shard removes it from this shard's registry and hands its components to the other shard, which adopts it on its next tick, or to the
+	 * shard manager to hand to another zone if no shard in this process owns the instance
+	 *
+	 * Systems are split into stages when they're added, each system going in the stage after the last one holding a system it conflicts
+	 * with. The systems in a stage run at the same time on the job system, and each stage waits for the one before it
+	 */
+	class Shard
+	{
+	public:
+		/**
+		 * \brief Construct a new Shard object
+		 *
+		 * \param index The shard's position in its ShardManager
+		 * \param shardManager The shard manager which owns the shard
+		 * \param messageSink Where messages to clients are pushed
+		 * \param jobSystem The job system the shard's systems run on
+		 */
+		Shard(std::size_t index, ShardManager& shardManager, MessageSink& messageSink, Common::Util::JobSystem& jobSystem);
+
+		/**
+		 * \brief Destroy the Shard object, stopping its thread if it's running
+		 *
+		 */
+		~Shard();
+
+		Shard(const Shard&)                    = delete;
+		auto operator=(const Shard&) -> Shard& = delete;
+
+		/**
+		 * \brief Attach a system to the shard, to be updated on the shard's thread at a specific interval. Only call this before the shard is started
+		 *
+		 * \param system The system to attach
+		 * \param access What the system reads and writes, which decides what it may run alongside
+		 * \param updateInterval How often the system should be updated, or zero for every tick
+		 */
+		auto addSystem(const ShardSystemFunction& system, const SystemAccess& access, sf::Time updateInterval) -> void;
+
+		/**
+		 * \brief Run a function over every entity with some components, splitting them between the job system's threads if there are
+		 * enough. Only call this from a system which has declared access to the components, and which doesn't create or destroy entities
+		 *
+		 * \tparam Component The components the entities must have, which are passed to the function after the entity
+		 * \param function The function, which must only touch the entity it's given
+		 */
+		template <typename... Component, typename Function>
+		auto parallelEach(Function&& function) -> void
+		{
+			// Fewer entities than this aren't worth handing to another thread
+			const auto MIN_CHUNK_SIZE = std::size_t(256);
+
+			auto view     = registry.view<Component...>();
+			auto entities = std::vector<entt::entity>(view.begin(), view.end());
+			jobSystem.parallelFor(entities.size(), MIN_CHUNK_SIZE, [&](const std::size_t begin, const std::size_t end) {
+				for (auto i = begin; i < end; ++i)
+				{
+					function(entities[i], registry.get<Component>(entities[i])...);
+				}
+			});
+		}
+
+		/**
+		 * \brief Start ticking the shard on its own thread
+		 *
+		 * \param tickLength How much time each tick simulates, and how far apart their deadlines are
+		 */
+		auto start(sf::Time tickLength) -> void;
+
+		/**
+		 * \brief Stop the shard's thread, and wait for it to finish. Commands pushed before it stopped are still applied, so nothing waiting
+		 * to be saved is lost
+		 *
+		 */
+		auto stop() -> void;
+
+		/**
+		 * \brief Queue a message for the shard's handlers. Safe to call from any thread
+		 *
+		 * \param message The message, from a client whose entity the shard owns
+		 */
+		auto pushMessage(Common::Network::Message&& message) -> void;
+
+		/**
+		 * \brief Add a new client's entity to the shard, and send the client the entity. Safe to call from any thread
+		 *
+		 * \param transfer The entity's components
+		 */
+		auto spawn(EntityTransfer&& transfer) -> void;
+
+		/**
+		 * \brief Add an entity moved from another shard. Safe to call from any thread
+		 *
+		 * \param transfer The entity's components
+		 */
+		auto adopt(EntityTransfer&& transfer) -> void;
+
+		/**
+		 * \brief Remove an entity from the world, handing its components to the shard manager to be saved. Safe to call from any thread
+		 *
+		 * \param entityID The ID of the entity
+		 */
+		auto despawn(entt::entity entityID) -> void;
+
+		/**
+		 * \brief Hand copies of every client entity's components to the shard manager to be saved. Safe to call from any thread
+		 *
+		 */
+		auto save() -> void;
+
+		/**
+		 * \brief Move an entity to another instance on the shard's next tick. Safe to call from any thread
+		 *
+		 * \param entityID The ID of the entity
+		 * \param instanceID The instance to move the entity to
+		 */
+		auto requestTransfer(entt::entity entityID, std::uint32_t instanceID) -> void;
+
+		/**
+		 * \brief Write the shard's counters to the log on the shard's next tick. Safe to call from any thread
+		 *
+		 */
+		auto requestMetrics() -> void;
+
+		/**
+		 * \brief Move an entity to another instance, handing it to the shard which owns the instance if that isn't this one, or to
+		 * the shard manager if no shard in this process does. Only call this from the shard's thread
+		 *
+		 * \param entityID The ID of the entity
+		 * \param instanceID The instance to move the entity to
+		 * \return true The entity has been moved
+		 * \return false The shard doesn't hold the entity
+		 */
+		auto transfer(entt::entity entityID, std::uint32_t instanceID) -> bool;
+
+		/**
+		 * \brief Gets the shard's position in its ShardManager
+		 */
+		[[nodiscard]] auto getIndex() const -> std::size_t;
+
+		entt::registry registry;
+		MessageSink& messageSink;
+		InterestManager interestManager;
+		SnapshotManager snapshotManager;
+		Common::Util::JobSystem& jobSystem;
+
+	private:
+		/**
+		 * \struct Command
+		 * \brief A request from another thread for the shard's thread
+		 */
+		struct Command
+		{
+			enum class Type
+			{
+				Spawn,
+				Adopt,
+				Despawn,
+				Save,
+				Transfer,
+				LogMetrics
+			};
+
+			Type type;
+			EntityTransfer transfer;
+			std::uint32_t instanceID = 0;
+		};
+
+		struct SystemWrapper
+		{
+			sf::Time firingInterval;
+			sf::Time timeSinceLastFire;
+			ShardSystemFunction callback;
+			SystemAccess access;
+			std::size_t stage = 0;
+		};
+
+		/**
+		 * \brief The body of the shard's thread
+		 *
+		 */
+		auto run() -> void;
+
+		/**
+		 * \brief Apply commands, handle messages, and update every system which is due
+		 *
+		 */
+		auto tick() -> void;
+
+		/**
+		 * \brief Apply every command pushed since the last tick
+		 *
+		 */
+		auto processCommands() -> void;
+
+		/**
+		 * \brief Pass every message pushed since the last tick to its handler
+		 *
+		 */
+		auto parseMessages() -> void;
+
+		/**
+		 * \brief Create an entity in the shard's registry from the components it was moved with
+		 *
+		 * \param transfer The entity's components
+		 */
+		auto emplaceEntity(EntityTransfer&& transfer) -> void;
+
+		/**
+		 * \brief Copy an entity's components out of the shard's registry
+		 *
+		 * \param entityID The ID of the entity, which the shard must hold
+		 * \return EntityTransfer The entity's components
+		 */
+		auto copyEntity(entt::entity entityID) -> EntityTransfer;
+
+		/**
+		 * \brief Take an entity out of the shard's registry, telling the clients which could see it, and the client itself, that it's gone
+		 *
+		 * \param entityID The ID of the entity
+		 * \return std::optional<EntityTransfer> The entity's components, if the shard held it
+		 */
+		auto extractEntity(entt::entity entityID) -> std::optional<EntityTransfer>;
+
+		std::size_t m_index;
+		ShardManager& m_shardManager;
+
+		std::vector<SystemWrapper> m_systems;
+		std::size_t m_stageCount = 0;
+		std::vector<Common::Util::JobSystem::Job> m_stageTasks;
+		Common::Util::ThreadSafeQueue<Command> m_commands;
+		Common::Util::DoubleBufferedQueue<Common::Network::Message> m_messages;
+		std::vector<Common::Network::Message> m_inboundMessages;
+		std::vector<entt::entity> m_visibleEntities;
+
+		std::thread m_thread;
+		std::atomic<bool> m_running = false;
+		std::mutex m_wakeMutex;
+		std::condition_variable m_wakeCondition;
+		TickScheduler m_scheduler;
+	};
+
+} // namespace Server
\ No newline at end of file
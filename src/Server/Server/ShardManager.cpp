@@ -0,0 +1,227 @@
+#include "Server/ShardManager.hpp"
+#include <algorithm>
+#include <mutex>
+
+namespace Server
+{
+
+	ShardManager::ShardManager(MessageSink& messageSink, const std::size_t shardCount, Common::Util::JobSystem& jobSystem)
+	{
+		for (auto i = std::size_t(0); i < std::max(shardCount, std::size_t(1)); ++i)
+		{
+			m_shards.emplace_back(std::make_unique<Shard>(i, *this, messageSink, jobSystem));
+		}
+	}
+
+	ShardManager::~ShardManager()
+	{
+		stop();
+	}
+
+	auto ShardManager::addSystem(const ShardSystemFunction& system, const sf::Time updateInterval) -> void
+	{
+		addSystem(system, SystemAccess(), updateInterval);
+	}
+
+	auto ShardManager::addSystem(const ShardSystemFunction& system, const SystemAccess& access, const sf::Time updateInterval) -> void
+	{
+		for (auto& shard : m_shards)
+		{
+			shard->addSystem(system, access, updateInterval);
+		}
+	}
+
+	auto ShardManager::addMessageHandler(const Common::Network::MessageType messageType, ShardMessageHandlerFunction&& handlerFunction) -> void
+	{
+		auto [pair, success] = m_messageHandlers.emplace(messageType, std::forward<ShardMessageHandlerFunction>(handlerFunction));
+		if (!success)
+		{
+			spdlog::debug("Tried to add a shard message handler but one already exists for {:X}", static_cast<std::uint32_t>(messageType));
+		}
+	}
+
+	auto ShardManager::setZone(const std::size_t zoneIndex, const std::size_t zoneCount) -> void
+	{
+		m_zoneCount = std::max(zoneCount, std::size_t(1));
+		m_zoneIndex = zoneIndex % m_zoneCount;
+	}
+
+	auto ShardManager::start(const sf::Time tickLength) -> void
+	{
+		spdlog::debug("Starting {} shards", m_shards.size());
+		for (auto& shard : m_shards)
+		{
+			shard->start(tickLength);
+		}
+	}
+
+	auto ShardManager::stop() -> void
+	{
+		for (auto& shard : m_shards)
+		{
+			shard->stop();
+		}
+	}
+
+	auto ShardManager::route(Common::Network::Message& message) -> bool
+	{
+		if (!m_messageHandlers.contains(message.header.type))
+		{
+			return false;
+		}
+
+		auto lock     = std::shared_lock<std::shared_mutex>(m_ownersMutex);
+		auto iterator = m_owners.find(message.header.entityID);
+		if (iterator != m_owners.end())
+		{
+			m_shards[iterator->second]->pushMessage(std::move(message));
+		}
+		return true;
+	}
+
+	auto ShardManager::spawn(EntityTransfer&& transfer) -> bool
+	{
+		auto& shard = getShard(transfer.world.position.instanceID);
+
+		// The shard has the entity queued before anything is routed to it
+		auto lock = std::unique_lock<std::shared_mutex>(m_ownersMutex);
+		if (m_owners.contains(transfer.entityID))
+		{
+			return false;
+		}
+
+		m_owners.emplace(transfer.entityID, shard.getIndex());
+		shard.spawn(std::move(transfer));
+		return true;
+	}
+
+	auto ShardManager::adopt(EntityTransfer&& transfer) -> bool
+	{
+		auto& shard = getShard(transfer.world.position.instanceID);
+
+		auto lock = std::unique_lock<std::shared_mutex>(m_ownersMutex);
+		if (m_owners.contains(transfer.entityID))
+		{
+			return false;
+		}
+
+		m_owners.emplace(transfer.entityID, shard.getIndex());
+		shard.adopt(std::move(transfer));
+		return true;
+	}
+
+	auto ShardManager::despawn(const entt::entity entityID) -> void
+	{
+		auto lock     = std::unique_lock<std::shared_mutex>(m_ownersMutex);
+		auto iterator = m_owners.find(entityID);
+		if (iterator == m_owners.end())
+		{
+			return;
+		}
+
+		m_shards[iterator->second]->despawn(entityID);
+		m_owners.erase(iterator);
+	}
+
+	auto ShardManager::requestTransfer(const entt::entity entityID, const std::uint32_t instanceID) -> bool
+	{
+		auto lock     = std::shared_lock<std::shared_mutex>(m_ownersMutex);
+		auto iterator = m_owners.find(entityID);
+		if (iterator == m_owners.end())
+		{
+			return false;
+		}
+
+		m_shards[iterator->second]->requestTransfer(entityID, instanceID);
+		return true;
+	}
+
+	auto ShardManager::isSpawned(const entt::entity entityID) const -> bool
+	{
+		auto lock = std::shared_lock<std::shared_mutex>(m_ownersMutex);
+		return m_owners.contains(entityID);
+	}
+
+	auto ShardManager::saveAll() -> void
+	{
+		for (auto& shard : m_shards)
+		{
+			shard->save();
+		}
+	}
+
+	auto ShardManager::takeSavedEntities(std::vector<EntityTransfer>& entities) -> void
+	{
+		m_savedEntities.drainInto(entities);
+	}
+
+	auto ShardManager::takeLostEntities(std::vector<entt::entity>& entities) -> void
+	{
+		entities.clear();
+	}
+
+	auto ShardManager::takeHandoffs(std::vector<EntityTransfer>& entities) -> void
+	{
+		m_handoffs.drainInto(entities);
+	}
+
+	auto ShardManager::logMetrics() const -> void
+	{
+		for (const auto& shard : m_shards)
+		{
+			shard->requestMetrics();
+		}
+	}
+
+	auto ShardManager::isLocalInstance(const std::uint32_t instanceID) const -> bool
+	{
+		return instanceID % m_zoneCount == m_zoneIndex;
+	}
+
+	auto ShardManager::getShard(const std::uint32_t instanceID) -> Shard&
+	{
+		// Every instance here has the same remainder by the zone count, so divide it out to use every shard
+		return *m_shards[(instanceID / m_zoneCount) % m_shards.size()];
+	}
+
+	auto ShardManager::setOwner(const entt::entity entityID, const Shard& shard) -> void
+	{
+		// The entity may have been despawned while it was being handed over, in which case the new shard is asked to despawn it too
+		auto lock     = std::unique_lock<std::shared_mutex>(m_ownersMutex);
+		auto iterator = m_owners.find(entityID);
+		if (iterator == m_owners.end())
+		{
+			m_shards[shard.getIndex()]->despawn(entityID);
+			return;
+		}
+
+		iterator->second = shard.getIndex();
+	}
+
+	auto ShardManager::handOff(EntityTransfer&& transfer) -> void
+	{
+		// As with a move between shards, an entity despawned while it was being handed over is saved rather than moved
+		auto lock     = std::unique_lock<std::shared_mutex>(m_ownersMutex);
+		auto iterator = m_owners.find(transfer.entityID);
+		if (iterator == m_owners.end())
+		{
+			m_savedEntities.push(std::move(transfer));
+			return;
+		}
+
+		m_owners.erase(iterator);
+		m_handoffs.push(std::move(transfer));
+	}
+
+	auto ShardManager::pushSavedEntity(EntityTransfer&& transfer) -> void
+	{
+		m_savedEntities.push(std::move(transfer));
+	}
+
+	auto ShardManager::getMessageHandler(const Common::Network::MessageType messageType) const -> const ShardMessageHandlerFunction*
+	{
+		auto iterator = m_messageHandlers.find(messageType);
+		return iterator == m_messageHandlers.end() ? nullptr : &iterator->second;
+	}
+
+} // namespace Server
\ No newline at end of file
@@ -0,0 +1,235 @@
+#pragma once
+
+#include "Server/Shard.hpp"
+#include <Common/Network/MessageType.hpp>
+#include <Common/Util/ThreadSafeQueue.hpp>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Server
+{
+
+	/**
+	 * \class ShardManager ShardManager.hpp "Server/ShardManager.hpp"
+	 * \brief Splits the world's instances between shards, and routes messages and requests to the shard which owns each entity
+	 *
+	 * Instances are spread over the shards by their ID, so an instance always lives in the same shard. In a zone process, only the
+	 * instances belonging to the zone are simulated here, and entities moving to any other instance are queued to be handed over. Which
+	 * shard holds each entity is kept in a table guarded by a shared lock, which the simulation thread reads for every message it routes
+	 * and a shard writes whenever it hands an entity to another. Entities handed back by the shards to be saved are queued for the
+	 * simulation thread, which owns the database
+	 */
+	class ShardManager : public World
+	{
+	public:
+		/**
+		 * \brief Construct a new Shard Manager object
+		 *
+		 * \param messageSink Where the shards push messages to clients
+		 * \param shardCount The number of shards to split the instances between, at least one
+		 * \param jobSystem The job system the shards run their systems on, which must outlive the shard manager
+		 */
+		ShardManager(MessageSink& messageSink, std::size_t shardCount, Common::Util::JobSystem& jobSystem);
+
+		/**
+		 * \brief Destroy the Shard Manager object, stopping every shard
+		 *
+		 */
+		~ShardManager() override;
+
+		ShardManager(const ShardManager&)                    = delete;
+		auto operator=(const ShardManager&) -> ShardManager& = delete;
+
+		/**
+		 * \brief Attach a system to every shard, which runs on its own, as it hasn't said what it reads and writes. Only call this before
+		 * the shards are started
+		 *
+		 * \param system The system to attach
+		 * \param updateInterval How often the system should be updated, or zero for every tick
+		 */
+		auto addSystem(const ShardSystemFunction& system, sf::Time updateInterval = sf::Time::Zero) -> void;
+
+		/**
+		 * \brief Attach a system to every shard, which may run alongside the systems it doesn't conflict with. Only call this before
+		 * the shards are started
+		 *
+		 * \param system The system to attach
+		 * \param access What the system reads and writes
+		 * \param updateInterval How often the system should be updated, or zero for every tick
+		 */
+		auto addSystem(const ShardSystemFunction& system, const SystemAccess& access, sf::Time updateInterval = sf::Time::Zero) -> void;
+
+		/**
+		 * \brief Register a handler for a message type, which runs on the shard holding the client which sent the message.
+		 * Only call this before the shards are started
+		 *
+		 * \param messageType The type of message the handler should accept
+		 * \param handlerFunction The function to be called when a message of the given type is received
+		 */
+		auto addMessageHandler(Common::Network::MessageType messageType, ShardMessageHandlerFunction&& handlerFunction) -> void;
+
+		/**
+		 * \brief Only simulate the instances belonging to one zone of several. Only call this before the shards are started
+		 *
+		 * \param zoneIndex The zone this process simulates
+		 * \param zoneCount The number of zones the instances are split between
+		 */
+		auto setZone(std::size_t zoneIndex, std::size_t zoneCount) -> void;
+
+		/**
+		 * \brief Start ticking every shard on its own thread
+		 *
+		 * \param tickLength How much time each tick simulates, and how far apart their deadlines are
+		 */
+		auto start(sf::Time tickLength) -> void;
+
+		/**
+		 * \brief Stop every shard, and wait for their threads to finish
+		 *
+		 */
+		auto stop() -> void override;
+
+		/**
+		 * \brief Pass a message to the shard holding the client which sent it, if its type is handled by the shards
+		 *
+		 * \param message The message
+		 * \return true The message's type is handled by the shards, so it has been passed on, or dropped if its client isn't in the world
+		 * \return false No shard handles the message's type
+		 */
+		auto route(Common::Network::Message& message) -> bool override;
+
+		/**
+		 * \brief Put a new client's entity in the world, in the shard which owns its instance
+		 *
+		 * \param transfer The entity's components
+		 * \return true The entity has been handed to its shard
+		 * \return false The entity is already in the world
+		 */
+		auto spawn(EntityTransfer&& transfer) -> bool override;
+
+		/**
+		 * \brief Put an entity handed over by another zone in the world, without sending the client its own entity again
+		 *
+		 * \param transfer The entity's components
+		 * \return true The entity has been handed to its shard
+		 * \return false The entity is already in the world
+		 */
+		auto adopt(EntityTransfer&& transfer) -> bool;
+
+		/**
+		 * \brief Take an entity out of the world. Its components are queued to be saved once its shard has removed it
+		 *
+		 * \param entityID The ID of the entity
+		 */
+		auto despawn(entt::entity entityID) -> void override;
+
+		/**
+		 * \brief Ask the shard holding an entity to move it to another instance
+		 *
+		 * \param entityID The ID of the entity
+		 * \param instanceID The instance to move the entity to
+		 * \return true The request has been passed to the entity's shard
+		 * \return false The entity isn't in the world
+		 */
+		auto requestTransfer(entt::entity entityID, std::uint32_t instanceID) -> bool override;
+
+		/**
+		 * \brief Check whether an entity is in the world
+		 *
+		 * \param entityID The ID of the entity
+		 */
+		[[nodiscard]] auto isSpawned(entt::entity entityID) const -> bool override;
+
+		/**
+		 * \brief Ask every shard to queue copies of their clients' entities to be saved
+		 *
+		 */
+		auto saveAll() -> void override;
+
+		/**
+		 * \brief Take every entity the shards have queued to be saved
+		 *
+		 * \param entities The vector to move the entities into, whose previous contents are discarded
+		 */
+		auto takeSavedEntities(std::vector<EntityTransfer>& entities) -> void override;
+
+		/**
+		 * \brief Entities are never lost between shards in the same process, so this only clears the vector
+		 *
+		 * \param entities The vector to clear
+		 */
+		auto takeLostEntities(std::vector<entt::entity>& entities) -> void override;
+
+		/**
+		 * \brief Take every entity the shards have handed over to be simulated by another zone
+		 *
+		 * \param entities The vector to move the entities into, whose previous contents are discarded
+		 */
+		auto takeHandoffs(std::vector<EntityTransfer>& entities) -> void;
+
+		/**
+		 * \brief Ask every shard to write its counters to the log
+		 *
+		 */
+		auto logMetrics() const -> void override;
+
+		/**
+		 * \brief Check whether an instance is simulated by this process
+		 *
+		 * \param instanceID The ID of the instance
+		 */
+		[[nodiscard]] auto isLocalInstance(std::uint32_t instanceID) const -> bool;
+
+		/**
+		 * \brief Gets the shard which owns an instance, which must be simulated by this process
+		 *
+		 * \param instanceID The ID of the instance
+		 */
+		[[nodiscard]] auto getShard(std::uint32_t instanceID) -> Shard&;
+
+		/**
+		 * \brief Record which shard now holds an entity. Called by the shard handing the entity over, once the other shard has it queued
+		 *
+		 * \param entityID The ID of the entity
+		 * \param shard The shard which holds the entity
+		 */
+		auto setOwner(entt::entity entityID, const Shard& shard) -> void;
+
+		/**
+		 * \brief Queue an entity moving to an instance in another zone to be handed over, and forget it. Called by the shard which
+		 * held the entity, once it has been removed
+		 *
+		 * \param transfer The entity's components
+		 */
+		auto handOff(EntityTransfer&& transfer) -> void;
+
+		/**
+		 * \brief Queue an entity's components to be saved by the simulation thread. Safe to call from any thread
+		 *
+		 * \param transfer The entity's components
+		 */
+		auto pushSavedEntity(EntityTransfer&& transfer) -> void;
+
+		/**
+		 * \brief Gets the handler the shards run for a message type, or nullptr if they don't handle it
+		 *
+		 * \param messageType The type of message
+		 */
+		[[nodiscard]] auto getMessageHandler(Common::Network::MessageType messageType) const -> const ShardMessageHandlerFunction*;
+
+	private:
+		std::vector<std::unique_ptr<Shard>> m_shards;
+		std::unordered_map<Common::Network::MessageType, ShardMessageHandlerFunction> m_messageHandlers;
+		std::size_t m_zoneIndex = 0;
+		std::size_t m_zoneCount = 1;
+
+		mutable std::shared_mutex m_ownersMutex;
+		std::unordered_map<entt::entity, std::size_t> m_owners;
+
+		Common::Util::ThreadSafeQueue<EntityTransfer> m_savedEntities;
+		Common::Util::ThreadSafeQueue<EntityTransfer> m_handoffs;
+	};
+
+} // namespace Server
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "Server/SystemAccess.hpp"
+#include <algorithm>
+
+namespace Server
+{
+
+	namespace
+	{
+		auto intersects(const std::vector<entt::id_type>& first, const std::vector<entt::id_type>& second) -> bool
+		{
+			return std::any_of(first.begin(), first.end(), [&](const auto id) {
+				return std::find(second.begin(), second.end(), id) != second.end();
+			});
+		}
+	} // namespace
+
+	auto SystemAccess::conflictsWith(const SystemAccess& other) const -> bool
+	{
+		if (isExclusive() || other.isExclusive())
+		{
+			return true;
+		}
+
+		return intersects(m_writes, other.m_writes) || intersects(m_writes, other.m_reads) || intersects(m_reads, other.m_writes);
+	}
+
+	auto SystemAccess::isExclusive() const -> bool
+	{
+		return m_reads.empty() && m_writes.empty();
+	}
+
+	auto SystemAccess::assureStorage(entt::registry& registry) const -> void
+	{
+		for (const auto assure : m_components)
+		{
+			assure(registry);
+		}
+	}
+
+} // namespace Server
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <entt/core/type_info.hpp>
+#include <entt/entity/registry.hpp>
+#include <vector>
+
+namespace Server
+{
+
+	/**
+	 * \class SystemAccess SystemAccess.hpp "Server/SystemAccess.hpp"
+	 * \brief Declares which components, and which state outside the registry, a system reads and writes
+	 *
+	 * Two systems conflict if either writes something the other reads or writes, and conflicting systems always run in the order they were
+	 * added. Systems which don't conflict may run at the same time. A system with no declared access is exclusive, so conflicts with
+	 * everything. A system may change the components it writes, including adding or removing them, but mustn't create or destroy entities
+	 */
+	class SystemAccess
+	{
+	public:
+		/**
+		 * \brief Construct a System Access object, which is exclusive until something is declared
+		 *
+		 */
+		SystemAccess() = default;
+
+		/**
+		 * \brief Declare components the system reads
+		 *
+		 * \tparam Component The types of the components
+		 */
+		template <typename... Component>
+		auto read() -> SystemAccess&
+		{
+			(m_reads.emplace_back(entt::type_hash<Component>::value()), ...);
+			(m_components.emplace_back(&assure<Component>), ...);
+			return *this;
+		}
+
+		/**
+		 * \brief Declare components the system writes, or adds to or removes from entities
+		 *
+		 * \tparam Component The types of the components
+		 */
+		template <typename... Component>
+		auto write() -> SystemAccess&
+		{
+			(m_writes.emplace_back(entt::type_hash<Component>::value()), ...);
+			(m_components.emplace_back(&assure<Component>), ...);
+			return *this;
+		}
+
+		/**
+		 * \brief Declare state outside the registry which the system reads, such as a manager it queries
+		 *
+		 * \tparam Resource The types of the state
+		 */
+		template <typename... Resource>
+		auto readResource() -> SystemAccess&
+		{
+			(m_reads.emplace_back(entt::type_hash<Resource>::value()), ...);
+			return *this;
+		}
+
+		/**
+		 * \brief Declare state outside the registry which the system changes
+		 *
+		 * \tparam Resource The types of the state
+		 */
+		template <typename... Resource>
+		auto writeResource() -> SystemAccess&
+		{
+			(m_writes.emplace_back(entt::type_hash<Resource>::value()), ...);
+			return *this;
+		}
+
+		/**
+		 * \brief Check whether two systems can't run at the same time
+		 *
+		 * \param other The other system's access
+		 */
+		[[nodiscard]] auto conflictsWith(const SystemAccess& other) const -> bool;
+
+		/**
+		 * \brief Check whether the system hasn't declared anything, so conflicts with every other system
+		 */
+		[[nodiscard]] auto isExclusive() const -> bool;
+
+		/**
+		 * \brief Create the storage for every declared component which doesn't have any yet. Looking up storage which exists doesn't
+		 * change the registry, but creating it does, so this has to happen before systems using the registry run at the same time
+		 *
+		 * \param registry The registry the system runs on
+		 */
+		auto assureStorage(entt::registry& registry) const -> void;
+
+	private:
+		using AssureFunction = void (*)(entt::registry&);
+
+		template <typename Component>
+		static auto assure(entt::registry& registry) -> void
+		{
+			static_cast<void>(registry.storage<Component>());
+		}
+
+		std::vector<entt::id_type> m_reads;
+		std::vector<entt::id_type> m_writes;
+		std::vector<AssureFunction> m_components;
+	};
+
+} // namespace Server
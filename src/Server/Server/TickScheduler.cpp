@@ -0,0 +1,115 @@
+#include "Server/TickScheduler.hpp"
+#include <algorithm>
+
+namespace Server
+{
+
+	namespace
+	{
+		auto toTime(const TickScheduler::Clock::duration duration) -> sf::Time
+		{
+			return sf::microseconds(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+		}
+
+		auto toMilliseconds(const sf::Time time) -> double
+		{
+			return static_cast<double>(time.asMicroseconds()) / 1000.0;
+		}
+	} // namespace
+
+	TickScheduler::TickScheduler(const sf::Time tickLength, const std::size_t maxCatchUpTicks) :
+	    m_tickLength(std::chrono::microseconds(std::max<std::int64_t>(tickLength.asMicroseconds(), 1))),
+	    m_maxCatchUpTicks(std::max(maxCatchUpTicks, std::size_t(1))),
+	    m_nextDeadline(Clock::now())
+	{
+	}
+
+	auto TickScheduler::getTickLength(const std::uint32_t tickRate) -> sf::Time
+	{
+		return sf::microseconds(1'000'000 / std::max<std::int64_t>(tickRate, 1));
+	}
+
+	auto TickScheduler::reset() -> void
+	{
+		m_nextDeadline = Clock::now();
+	}
+
+	auto TickScheduler::getDueTicks() -> std::size_t
+	{
+		auto now = Clock::now();
+		if (now < m_nextDeadline)
+		{
+			return 0;
+		}
+
+		auto lateness = now - m_nextDeadline;
+		auto jitter   = toTime(lateness);
+		++m_metrics.wakeups;
+		m_metrics.totalJitter += jitter;
+		m_metrics.maxJitter = std::max(m_metrics.maxJitter, jitter);
+
+		// Every whole tick length the loop is behind by is another tick which is due
+		auto dueTicks = static_cast<std::size_t>(lateness / m_tickLength) + 1;
+		if (dueTicks > m_maxCatchUpTicks)
+		{
+			auto skippedTicks = dueTicks - m_maxCatchUpTicks;
+			m_metrics.skippedTicks += skippedTicks;
+			m_nextDeadline += m_tickLength * static_cast<Clock::rep>(skippedTicks);
+			dueTicks = m_maxCatchUpTicks;
+		}
+		return dueTicks;
+	}
+
+	auto TickScheduler::beginTick() -> void
+	{
+		m_tickStart = Clock::now();
+	}
+
+	auto TickScheduler::endTick() -> void
+	{
+		auto duration = toTime(Clock::now() - m_tickStart);
+		++m_metrics.ticks;
+		m_metrics.totalDuration += duration;
+		m_metrics.maxDuration = std::max(m_metrics.maxDuration, duration);
+		if (duration > getTickLength())
+		{
+			++m_metrics.overruns;
+		}
+
+		m_nextDeadline += m_tickLength;
+	}
+
+	auto TickScheduler::getTickLength() const -> sf::Time
+	{
+		return toTime(m_tickLength);
+	}
+
+	auto TickScheduler::getNextDeadline() const -> TimePoint
+	{
+		return m_nextDeadline;
+	}
+
+	auto TickScheduler::getTimeUntilNextTick() const -> sf::Time
+	{
+		auto remaining = m_nextDeadline - Clock::now();
+		if (remaining <= Clock::duration::zero())
+		{
+			return sf::Time::Zero;
+		}
+		return sf::milliseconds(static_cast<std::int32_t>(std::chrono::ceil<std::chrono::milliseconds>(remaining).count()));
+	}
+
+	auto TickScheduler::getMetrics() const -> const TickMetrics&
+	{
+		return m_metrics;
+	}
+
+	auto TickScheduler::logMetrics(const std::string_view name) const -> void
+	{
+		auto ticks   = std::max<std::uint64_t>(m_metrics.ticks, 1);
+		auto wakeups = std::max<std::uint64_t>(m_metrics.wakeups, 1);
+		spdlog::info("{} ticks: {} run at {:.1f} ms, {} overran, {} skipped. Duration {:.2f} ms mean, {:.2f} ms max", name, m_metrics.ticks, toMilliseconds(getTickLength()), m_metrics.overruns, m_metrics.skippedTicks, toMilliseconds(m_metrics.totalDuration) / static_cast<double>(ticks), toMilliseconds(m_metrics.maxDuration));
+		spdlog::info("{} jitter: {:.3f} ms mean, {:.3f} ms max, over {} wakeups", name, toMilliseconds(m_metrics.totalJitter) / static_cast<double>(wakeups), toMilliseconds(m_metrics.maxJitter), m_metrics.wakeups);
+	}
+
+} // namespace Server
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <SFML/System/Time.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Server
+{
+
+	/// \brief The most ticks run back to back to catch up after a stall. Any more are skipped, rather than spiralling further behind
+	const std::size_t MAX_CATCH_UP_TICKS = 5;
+
+	/**
+	 * \struct TickMetrics TickScheduler.hpp "Server/TickScheduler.hpp"
+	 * \brief Counters kept by a TickScheduler about how well it's keeping up
+	 */
+	struct TickMetrics
+	{
+		std::uint64_t ticks = 0;
+
+		/// \brief Ticks which took longer than the tick length to run
+		std::uint64_t overruns = 0;
+
+		/// \brief Ticks dropped because more than the catch-up limit were due at once
+		std::uint64_t skippedTicks = 0;
+
+		sf::Time totalDuration = sf::Time::Zero;
+		sf::Time maxDuration   = sf::Time::Zero;
+
+		/// \brief How late the loop woke for the first tick it was due to run, accumulated over every wakeup which ran one
+		std::uint64_t wakeups = 0;
+		sf::Time totalJitter  = sf::Time::Zero;
+		sf::Time maxJitter    = sf::Time::Zero;
+	};
+
+	/**
+	 * \class TickScheduler TickScheduler.hpp "Server/TickScheduler.hpp"
+	 * \brief Runs a simulation loop at a fixed tick rate, so every tick advances the simulation by exactly the tick length
+	 *
+	 * Each tick has a deadline, one tick length after the last, measured from when the scheduler was reset rather than from when the
+	 * previous tick happened to start, so the rate doesn't drift. The time between the next deadline and now is the loop's accumulator:
+	 * every tick length of it is a tick which is due. Up to MAX_CATCH_UP_TICKS are run back to back after a stall, and the rest skipped.
+	 * Everything but getNextDeadline and getTimeUntilNextTick must be called from the loop's own thread
+	 */
+	class TickScheduler
+	{
+	public:
+		using Clock     = std::chrono::steady_clock;
+		using TimePoint = Clock::time_point;
+
+		/**
+		 * \brief Construct a new Tick Scheduler object
+		 *
+		 * \param tickLength How much time each tick simulates, which must be more than zero
+		 * \param maxCatchUpTicks The most ticks run back to back to catch up, at least one
+		 */
+		explicit TickScheduler(sf::Time tickLength = sf::milliseconds(50), std::size_t maxCatchUpTicks = MAX_CATCH_UP_TICKS);
+
+		/**
+		 * \brief Get the length of a tick at a rate
+		 *
+		 * \param tickRate The number of ticks a second, at least one
+		 */
+		[[nodiscard]] static auto getTickLength(std::uint32_t tickRate) -> sf::Time;
+
+		/**
+		 * \brief Make the first tick due now, and forget any ticks which were due before
+		 *
+		 */
+		auto reset() -> void;
+
+		/**
+		 * \brief Count the ticks which are due, skipping any past the catch-up limit
+		 *
+		 * \return std::size_t The number of ticks to run now, each followed by a call to beginTick and endTick
+		 */
+		auto getDueTicks() -> std::size_t;
+
+		/**
+		 * \brief Mark the start of a due tick
+		 *
+		 */
+		auto beginTick() -> void;
+
+		/**
+		 * \brief Mark the end of a tick, recording how long it took, and move the deadline on to the next tick
+		 *
+		 */
+		auto endTick() -> void;
+
+		/**
+		 * \brief Get how much time each tick simulates
+		 */
+		[[nodiscard]] auto getTickLength() const -> sf::Time;
+
+		/**
+		 * \brief Get when the next tick is due, to sleep until
+		 */
+		[[nodiscard]] auto getNextDeadline() const -> TimePoint;
+
+		/**
+		 * \brief Get how long to wait for the next tick, rounded up to a whole millisecond, as that's as finely as socket waits can be
+		 * timed. Waking late by less than a millisecond is cheaper than spinning on waits which time out early
+		 */
+		[[nodiscard]] auto getTimeUntilNextTick() const -> sf::Time;
+
+		/**
+		 * \brief Get the counters kept since the scheduler was constructed
+		 */
+		[[nodiscard]] auto getMetrics() const -> const TickMetrics&;
+
+		/**
+		 * \brief Write the scheduler's counters to the log
+		 *
+		 * \param name What the scheduler runs, to tell its counters apart from those of others
+		 */
+		auto logMetrics(std::string_view name) const -> void;
+
+	private:
+		Clock::duration m_tickLength;
+		std::size_t m_maxCatchUpTicks;
+
+		TimePoint m_nextDeadline;
+		TimePoint m_tickStart;
+		TickMetrics m_metrics;
+	};
+
+} // namespace Server
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Replication/SnapshotManager.hpp"
+#include <Common/Game/WorldEntity.hpp>
+#include <Common/Input/InputState.hpp>
+#include <Common/Network/Message.hpp>
+#include <entt/entity/entity.hpp>
+#include <optional>
+#include <vector>
+
+namespace Server
+{
+
+	/**
+	 * \struct EntityTransfer World.hpp "Server/World.hpp"
+	 * \brief Everything the world holds about an entity, moved out of one shard's registry and into another's
+	 */
+	struct EntityTransfer
+	{
+		entt::entity entityID = entt::null;
+		bool isClient         = false;
+
+		Common::Game::WorldEntityData world;
+		std::optional<Common::Input::InputState> inputState;
+
+		// Carried along so the client's next snapshot is still relative to one it has, and removes what it could see before.
+		// Only moved between shards in the same process
+		std::optional<Replication::ClientSnapshots> snapshots;
+	};
+
+	/**
+	 * \class World World.hpp "Server/World.hpp"
+	 * \brief Where the server puts its clients' entities to be simulated
+	 *
+	 * The world is either simulated by shards in this process, or by zone processes behind this one, in which case this process is
+	 * the gateway which owns the clients' connections. Either way, the simulation thread only reaches the world through this interface
+	 */
+	class World
+	{
+	public:
+		virtual ~World() = default;
+
+		/**
+		 * \brief Stop simulating the world
+		 *
+		 */
+		virtual auto stop() -> void = 0;
+
+		/**
+		 * \brief Pass a message to whatever simulates the client which sent it, if its type is handled by the world
+		 *
+		 * \param message The message
+		 * \return true The message's type is handled by the world, so it has been passed on, or dropped if its client isn't in the world
+		 * \return false The world doesn't handle the message's type
+		 */
+		virtual auto route(Common::Network::Message& message) -> bool = 0;
+
+		/**
+		 * \brief Put a new client's entity in the world, in whatever simulates its instance
+		 *
+		 * \param transfer The entity's components
+		 * \return true The entity has been handed over to be simulated
+		 * \return false The entity is already in the world
+		 */
+		virtual auto spawn(EntityTransfer&& transfer) -> bool = 0;
+
+		/**
+		 * \brief Take an entity out of the world. Its components are queued to be saved once it has been removed
+		 *
+		 * \param entityID The ID of the entity
+		 */
+		virtual auto despawn(entt::entity entityID) -> void = 0;
+
+		/**
+		 * \brief Ask whatever simulates an entity to move it to another instance
+		 *
+		 * \param entityID The ID of the entity
+		 * \param instanceID The instance to move the entity to
+		 * \return true The request has been passed on
+		 * \return false The entity isn't in the world
+		 */
+		virtual auto requestTransfer(entt::entity entityID, std::uint32_t instanceID) -> bool = 0;
+
+		/**
+		 * \brief Check whether an entity is in the world
+		 *
+		 * \param entityID The ID of the entity
+		 */
+		[[nodiscard]] virtual auto isSpawned(entt::entity entityID) const -> bool = 0;
+
+		/**
+		 * \brief Ask for copies of every client's entity to be queued to be saved
+		 *
+		 */
+		virtual auto saveAll() -> void = 0;
+
+		/**
+		 * \brief Take every entity queued to be saved
+		 *
+		 * \param entities The vector to move the entities into, whose previous contents are discarded
+		 */
+		virtual auto takeSavedEntities(std::vector<EntityTransfer>& entities) -> void = 0;
+
+		/**
+		 * \brief Take every entity which has dropped out of the world without being saved, such as when the zone simulating it
+		 * exited, and so has to be loaded and spawned again
+		 *
+		 * \param entities The vector to move the entities' IDs into, whose previous contents are discarded
+		 */
+		virtual auto takeLostEntities(std::vector<entt::entity>& entities) -> void = 0;
+
+		/**
+		 * \brief Write the world's counters to the log
+		 *
+		 */
+		virtual auto logMetrics() const -> void = 0;
+	};
+
+} // namespace Server
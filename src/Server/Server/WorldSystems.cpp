@@ -0,0 +1,168 @@
+#include "Server/WorldSystems.hpp"
+#include "Network/Client.hpp"
+#include <Common/Game.hpp>
+
+namespace Server
+{
+
+#define SHARD_SYSTEM_FN(NAME) auto system##NAME(Shard& shard, const sf::Time deltaTime)->void
+#define SHARD_HANDLER_FN(NAME) auto handler##NAME(Common::Network::Message& message, Shard& shard)->void
+
+	SHARD_SYSTEM_FN(PlayerMovement)
+	{
+		auto fDt = deltaTime.asSeconds();
+
+		// Each entity only moves itself, so a shard with enough of them splits them between the workers
+		shard.parallelEach<Common::Game::WorldEntityPosition, Common::Input::InputState>([fDt](entt::entity /*entity*/, Common::Game::WorldEntityPosition& worldPositionComponent, const Common::Input::InputState& inputComponent) {
+			sf::Vector2f delta{0.0F, 0.0F};
+			if (inputComponent.forwards)
+			{
+				delta.y -= 200.0F * fDt;
+			}
+			if (inputComponent.backwards)
+			{
+				delta.y += 200.0F * fDt;
+			}
+			if (inputComponent.left)
+			{
+				delta.x -= 200.0F * fDt;
+			}
+			if (inputComponent.right)
+			{
+				delta.x += 200.0F * fDt;
+			}
+
+			worldPositionComponent.position += delta;
+		});
+	}
+
+	SHARD_SYSTEM_FN(UpdateInterest)
+	{
+		shard.interestManager.update();
+	}
+
+	SHARD_SYSTEM_FN(BroadcastMovement)
+	{
+		for (const auto entity : shard.registry.view<Common::Game::WorldEntityPosition, Common::Input::InputState>())
+		{
+			auto& inputState = shard.registry.get<Common::Input::InputState>(entity);
+			if (inputState.changed)
+			{
+				auto data = Common::Network::MessageData();
+				data << entity << inputState;
+				shard.interestManager.pushMessage(Common::Network::Protocol::UDP, Common::Network::MessageType::Server_InputState, entity, data);
+				inputState.changed = false;
+			}
+		}
+	}
+
+	SHARD_SYSTEM_FN(ReplicateSnapshots)
+	{
+		shard.snapshotManager.update();
+	}
+
+	SHARD_HANDLER_FN(Action)
+	{
+		auto action = Common::Input::Action();
+		message.data >> action;
+
+		if (!shard.registry.all_of<Common::Input::InputState>(message.header.entityID))
+		{
+			return;
+		}
+
+		auto& inputState   = shard.registry.get<Common::Input::InputState>(message.header.entityID);
+		inputState.changed = true;
+		switch (action.type)
+		{
+			case Common::Input::ActionType::MoveForward:
+			{
+				inputState.forwards = (action.state == Common::Input::Action::State::Begin);
+			}
+			break;
+			case Common::Input::ActionType::MoveBackward:
+			{
+				inputState.backwards = (action.state == Common::Input::Action::State::Begin);
+			}
+			break;
+			case Common::Input::ActionType::StrafeLeft:
+			{
+				inputState.left = (action.state == Common::Input::Action::State::Begin);
+			}
+			break;
+			case Common::Input::ActionType::StrafeRight:
+			{
+				inputState.right = (action.state == Common::Input::Action::State::Begin);
+			}
+			break;
+			default:
+				break;
+		}
+	}
+
+	SHARD_HANDLER_FN(GetWorldState)
+	{
+		auto tileIdentifier = std::uint32_t(0);
+		message.data >> tileIdentifier;
+
+		// Emplace the count at position 0, then serialise entities into it
+		auto data       = Common::Network::MessageData();
+		auto entityList = std::vector<entt::entity>();
+
+		for (const auto entity : shard.registry.view<Common::Game::WorldEntityPosition>())
+		{
+			auto& worldPositionComponent = shard.registry.get<Common::Game::WorldEntityPosition>(entity);
+			if (worldPositionComponent.instanceID == tileIdentifier)
+			{
+				entityList.emplace_back(entity);
+			}
+		}
+
+		data << std::uint32_t(entityList.size());
+		for (const auto entity : entityList)
+		{
+			data << entity;
+			Common::Game::serialiseWorldEntity(shard.registry, entity, data);
+		}
+
+		// Sent to every client in the shard, as the clients elsewhere belong to other shards
+		auto recipients = std::vector<MessageRecipient>();
+		for (const auto clientID : shard.registry.view<Client>())
+		{
+			recipients.emplace_back(MessageRecipient{clientID, Common::Network::Protocol::ReliableOrdered});
+		}
+		shard.messageSink.pushBroadcast(Common::Network::MessageType::Server_WorldState, recipients, data);
+	}
+
+	SHARD_HANDLER_FN(SnapshotAck)
+	{
+		auto snapshotID = std::uint32_t(0);
+		message.data >> snapshotID;
+		shard.snapshotManager.acknowledge(message.header.entityID, snapshotID);
+	}
+
+#undef SHARD_SYSTEM_FN
+#undef SHARD_HANDLER_FN
+
+	auto addWorldSystems(ShardManager& shardManager) -> void
+	{
+		using Common::Game::WorldEntityName;
+		using Common::Game::WorldEntityPosition;
+		using Common::Game::WorldEntityStats;
+		using Common::Game::WorldEntityType;
+		using Common::Input::InputState;
+
+		// Broadcasting input and replicating snapshots both follow the interest update, but touch different state, so run together
+		shardManager.addSystem(systemPlayerMovement, SystemAccess().read<InputState>().write<WorldEntityPosition>());
+		shardManager.addSystem(systemUpdateInterest, SystemAccess().read<Client, WorldEntityPosition, WorldEntityName, WorldEntityType, WorldEntityStats, InputState>().writeResource<InterestManager>());
+		shardManager.addSystem(systemBroadcastMovement, SystemAccess().read<WorldEntityPosition>().write<InputState>().readResource<InterestManager>());
+		shardManager.addSystem(systemReplicateSnapshots, SystemAccess().read<Client, WorldEntityPosition, WorldEntityName, WorldEntityType, WorldEntityStats>().write<Replication::ClientSnapshots>().readResource<InterestManager>().writeResource<SnapshotManager>());
+
+		using MT
+		    = Common::Network::MessageType;
+		shardManager.addMessageHandler(MT::Client_Action, handlerAction);
+		shardManager.addMessageHandler(MT::Client_GetWorldState, handlerGetWorldState);
+		shardManager.addMessageHandler(MT::Client_SnapshotAck, handlerSnapshotAck);
+	}
+
+} // namespace Server
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Server/ShardManager.hpp"
+#include <Common/Network/MessageType.hpp>
+#include <array>
+
+namespace Server
+{
+
+	/// \brief The message types handled by the shards simulating the world, which a gateway passes on to its zones
+	inline constexpr auto WORLD_MESSAGE_TYPES = std::array{
+	    Common::Network::MessageType::Client_Action,
+	    Common::Network::MessageType::Client_GetWorldState,
+	    Common::Network::MessageType::Client_SnapshotAck};
+
+	/**
+	 * \brief Attach the systems which simulate the world to a shard manager, and the handlers for every type in WORLD_MESSAGE_TYPES.
+	 * Shared by a server simulating the world itself and a zone server simulating part of it
+	 *
+	 * \param shardManager The shard manager, which mustn't have been started yet
+	 */
+	auto addWorldSystems(ShardManager& shardManager) -> void;
+
+} // namespace Server
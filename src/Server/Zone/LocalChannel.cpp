@@ -0,0 +1,177 @@
+#include "Zone/LocalChannel.hpp"
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <utility>
+
+namespace Server
+{
+
+	LocalChannel::LocalChannel(const int descriptor) :
+	    m_descriptor(descriptor)
+	{
+	}
+
+	LocalChannel::~LocalChannel()
+	{
+		close();
+	}
+
+	LocalChannel::LocalChannel(LocalChannel&& other) noexcept :
+	    m_descriptor(std::exchange(other.m_descriptor, -1)),
+	    m_assembler(std::move(other.m_assembler)),
+	    m_unwritten(std::move(other.m_unwritten)),
+	    m_writeOffset(std::exchange(other.m_writeOffset, 0))
+	{
+	}
+
+	auto LocalChannel::operator=(LocalChannel&& other) noexcept -> LocalChannel&
+	{
+		if (this != &other)
+		{
+			close();
+			m_descriptor  = std::exchange(other.m_descriptor, -1);
+			m_assembler   = std::move(other.m_assembler);
+			m_unwritten   = std::move(other.m_unwritten);
+			m_writeOffset = std::exchange(other.m_writeOffset, 0);
+		}
+		return *this;
+	}
+
+	auto LocalChannel::connect(const std::filesystem::path& path) -> bool
+	{
+		close();
+
+		auto address       = sockaddr_un();
+		address.sun_family = AF_UNIX;
+		auto pathString    = path.string();
+		if (pathString.size() >= sizeof(address.sun_path))
+		{
+			spdlog::error("The socket path {} is too long", pathString);
+			return false;
+		}
+		std::memcpy(address.sun_path, pathString.c_str(), pathString.size() + 1);
+
+		m_descriptor = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		if (m_descriptor < 0)
+		{
+			return false;
+		}
+
+		// Connecting to a Unix socket completes straight away, or fails if nothing is listening or its backlog is full
+		if (::connect(m_descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+		{
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	auto LocalChannel::send(const std::span<const std::uint8_t> frame) -> void
+	{
+		auto prefix = Common::Network::FrameAssembler::makePrefix(frame.size());
+		m_unwritten.insert(m_unwritten.end(), prefix.begin(), prefix.end());
+		m_unwritten.insert(m_unwritten.end(), frame.begin(), frame.end());
+	}
+
+	auto LocalChannel::flush() -> bool
+	{
+		while (isOpen() && m_writeOffset < m_unwritten.size())
+		{
+			auto written = ::send(m_descriptor, m_unwritten.data() + m_writeOffset, m_unwritten.size() - m_writeOffset, MSG_NOSIGNAL);
+			if (written < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				if (errno == EAGAIN || errno == EWOULDBLOCK)
+				{
+					break;
+				}
+
+				close();
+				return false;
+			}
+			m_writeOffset += static_cast<std::size_t>(written);
+		}
+
+		// Drop what's been written once it makes up most of the buffer, so it doesn't grow without bound
+		if (m_writeOffset == m_unwritten.size())
+		{
+			m_unwritten.clear();
+			m_writeOffset = 0;
+		}
+		else if (m_writeOffset >= m_unwritten.size() / 2)
+		{
+			m_unwritten.erase(m_unwritten.begin(), m_unwritten.begin() + static_cast<std::ptrdiff_t>(m_writeOffset));
+			m_writeOffset = 0;
+		}
+		return isOpen();
+	}
+
+	auto LocalChannel::receive(std::vector<std::vector<std::uint8_t>>& frames) -> bool
+	{
+		auto buffer = std::array<std::uint8_t, 1 << 16>();
+		auto closed = false;
+		while (isOpen())
+		{
+			auto received = ::recv(m_descriptor, buffer.data(), buffer.size(), 0);
+			if (received > 0)
+			{
+				m_assembler.append(buffer.data(), static_cast<std::size_t>(received));
+				continue;
+			}
+			if (received < 0 && errno == EINTR)
+			{
+				continue;
+			}
+
+			closed = received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+			break;
+		}
+
+		// Frames which arrived before the other end went away are still handed over
+		while (auto frame = m_assembler.next())
+		{
+			frames.emplace_back(std::move(*frame));
+		}
+
+		if (closed || m_assembler.isCorrupt())
+		{
+			close();
+		}
+		return isOpen();
+	}
+
+	auto LocalChannel::close() -> void
+	{
+		if (m_descriptor >= 0)
+		{
+			::close(m_descriptor);
+			m_descriptor = -1;
+		}
+		m_assembler.clear();
+		m_unwritten.clear();
+		m_writeOffset = 0;
+	}
+
+	auto LocalChannel::isOpen() const -> bool
+	{
+		return m_descriptor >= 0;
+	}
+
+	auto LocalChannel::hasUnwritten() const -> bool
+	{
+		return m_writeOffset < m_unwritten.size();
+	}
+
+	auto LocalChannel::getDescriptor() const -> int
+	{
+		return m_descriptor;
+	}
+
+} // namespace Server
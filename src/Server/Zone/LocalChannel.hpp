@@ -0,0 +1,111 @@
+#pragma once
+
+#include <Common/Network/FrameAssembler.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace Server
+{
+
+	/// \brief The longest frame a local channel carries, which is much longer than a client message so an entity's components always fit
+	const std::size_t MAX_LOCAL_FRAME_LENGTH = 1 << 20;
+
+	/**
+	 * \class LocalChannel LocalChannel.hpp "Zone/LocalChannel.hpp"
+	 * \brief A non-blocking Unix domain stream socket between two processes on the same machine, carrying length-prefixed frames
+	 *
+	 * Frames are buffered until they're flushed, and whatever the socket won't take yet is kept for the next flush, so sending never
+	 * blocks. Received bytes are split back into frames with a FrameAssembler
+	 */
+	class LocalChannel
+	{
+	public:
+		/**
+		 * \brief Construct a Local Channel object which isn't connected to anything
+		 *
+		 */
+		LocalChannel() = default;
+
+		/**
+		 * \brief Construct a Local Channel object over a socket which is already connected
+		 *
+		 * \param descriptor The socket, which must be non-blocking. The channel closes it
+		 */
+		explicit LocalChannel(int descriptor);
+
+		/**
+		 * \brief Destroy the Local Channel object, closing its socket
+		 *
+		 */
+		~LocalChannel();
+
+		LocalChannel(const LocalChannel&)                    = delete;
+		auto operator=(const LocalChannel&) -> LocalChannel& = delete;
+
+		LocalChannel(LocalChannel&& other) noexcept;
+		auto operator=(LocalChannel&& other) noexcept -> LocalChannel&;
+
+		/**
+		 * \brief Connect to a socket another process is listening on, closing any previous connection
+		 *
+		 * \param path The path of the socket
+		 * \return true The channel is connected
+		 * \return false Nothing is listening at the path
+		 */
+		auto connect(const std::filesystem::path& path) -> bool;
+
+		/**
+		 * \brief Queue a frame to be written on the next flush
+		 *
+		 * \param frame The frame, without its length prefix
+		 */
+		auto send(std::span<const std::uint8_t> frame) -> void;
+
+		/**
+		 * \brief Write as much of what's queued as the socket will take
+		 *
+		 * \return true The channel is still open
+		 * \return false The other end has gone, and the channel has been closed
+		 */
+		auto flush() -> bool;
+
+		/**
+		 * \brief Read everything the socket has, and take every complete frame
+		 *
+		 * \param frames The vector to append the frames to
+		 * \return true The channel is still open
+		 * \return false The other end has gone or sent something which isn't a frame, and the channel has been closed
+		 */
+		auto receive(std::vector<std::vector<std::uint8_t>>& frames) -> bool;
+
+		/**
+		 * \brief Close the socket, discarding anything which hasn't been written or taken as a frame
+		 *
+		 */
+		auto close() -> void;
+
+		/**
+		 * \brief Check whether the channel is connected
+		 */
+		[[nodiscard]] auto isOpen() const -> bool;
+
+		/**
+		 * \brief Check whether anything queued is still waiting to be written
+		 */
+		[[nodiscard]] auto hasUnwritten() const -> bool;
+
+		/**
+		 * \brief Get the socket, to wait on it
+		 */
+		[[nodiscard]] auto getDescriptor() const -> int;
+
+	private:
+		int m_descriptor = -1;
+		Common::Network::FrameAssembler m_assembler{MAX_LOCAL_FRAME_LENGTH};
+		std::vector<std::uint8_t> m_unwritten;
+		std::size_t m_writeOffset = 0;
+	};
+
+} // namespace Server
@@ -0,0 +1,90 @@
+#include "Zone/LocalListener.hpp"
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Server
+{
+
+	LocalListener::~LocalListener()
+	{
+		close();
+	}
+
+	auto LocalListener::listen(const std::filesystem::path& path) -> bool
+	{
+		close();
+
+		auto address       = sockaddr_un();
+		address.sun_family = AF_UNIX;
+		auto pathString    = path.string();
+		if (pathString.size() >= sizeof(address.sun_path))
+		{
+			spdlog::error("The socket path {} is too long", pathString);
+			return false;
+		}
+		std::memcpy(address.sun_path, pathString.c_str(), pathString.size() + 1);
+
+		auto error = std::error_code();
+		std::filesystem::create_directories(path.parent_path(), error);
+		std::filesystem::remove(path, error);
+
+		m_descriptor = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		if (m_descriptor < 0)
+		{
+			spdlog::error("Failed to create a socket to listen at {} (errno {})", pathString, errno);
+			return false;
+		}
+
+		if (::bind(m_descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(m_descriptor, SOMAXCONN) != 0)
+		{
+			spdlog::error("Failed to listen at {} (errno {})", pathString, errno);
+			::close(m_descriptor);
+			m_descriptor = -1;
+			return false;
+		}
+
+		m_path = path;
+		return true;
+	}
+
+	auto LocalListener::accept() -> std::optional<LocalChannel>
+	{
+		if (m_descriptor < 0)
+		{
+			return {};
+		}
+
+		auto descriptor = ::accept4(m_descriptor, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		while (descriptor < 0 && errno == EINTR)
+		{
+			descriptor = ::accept4(m_descriptor, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		}
+
+		if (descriptor < 0)
+		{
+			return {};
+		}
+		return LocalChannel(descriptor);
+	}
+
+	auto LocalListener::close() -> void
+	{
+		if (m_descriptor >= 0)
+		{
+			::close(m_descriptor);
+			m_descriptor = -1;
+
+			auto error = std::error_code();
+			std::filesystem::remove(m_path, error);
+		}
+	}
+
+	auto LocalListener::getDescriptor() const -> int
+	{
+		return m_descriptor;
+	}
+
+} // namespace Server
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Zone/LocalChannel.hpp"
+#include <filesystem>
+#include <optional>
+
+namespace Server
+{
+
+	/**
+	 * \class LocalListener LocalListener.hpp "Zone/LocalListener.hpp"
+	 * \brief A non-blocking Unix domain socket which other processes on the same machine connect to
+	 */
+	class LocalListener
+	{
+	public:
+		LocalListener() = default;
+
+		/**
+		 * \brief Destroy the Local Listener object, closing its socket and removing it from the filesystem
+		 *
+		 */
+		~LocalListener();
+
+		LocalListener(const LocalListener&)                    = delete;
+		auto operator=(const LocalListener&) -> LocalListener& = delete;
+
+		/**
+		 * \brief Start listening at a path, replacing any socket left there by a process which didn't exit cleanly
+		 *
+		 * \param path The path of the socket, whose directory is created if it doesn't exist
+		 * \return true The listener is listening
+		 * \return false The socket couldn't be created
+		 */
+		auto listen(const std::filesystem::path& path) -> bool;
+
+		/**
+		 * \brief Accept the next pending connection
+		 *
+		 * \return std::optional<LocalChannel> An optional which may contain the connection, empty if nothing is waiting
+		 */
+		auto accept() -> std::optional<LocalChannel>;
+
+		/**
+		 * \brief Stop listening, and remove the socket from the filesystem
+		 *
+		 */
+		auto close() -> void;
+
+		/**
+		 * \brief Get the socket, to wait on it
+		 */
+		[[nodiscard]] auto getDescriptor() const -> int;
+
+	private:
+		int m_descriptor = -1;
+		std::filesystem::path m_path;
+	};
+
+} // namespace Server
@@ -0,0 +1,53 @@
+#include "Zone/LocalPoller.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace Server
+{
+
+	LocalPoller::LocalPoller() :
+	    m_interruptDescriptor(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+	{
+		if (m_interruptDescriptor < 0)
+		{
+			spdlog::error("Failed to create an eventfd (errno {})", errno);
+		}
+	}
+
+	LocalPoller::~LocalPoller()
+	{
+		if (m_interruptDescriptor >= 0)
+		{
+			close(m_interruptDescriptor);
+		}
+	}
+
+	auto LocalPoller::add(const int descriptor, const bool watchWritable) -> void
+	{
+		if (descriptor >= 0)
+		{
+			m_descriptors.emplace_back(pollfd{descriptor, static_cast<short>(POLLIN | (watchWritable ? POLLOUT : 0)), 0});
+		}
+	}
+
+	auto LocalPoller::wait(const sf::Time timeout) -> void
+	{
+		m_descriptors.emplace_back(pollfd{m_interruptDescriptor, POLLIN, 0});
+		::poll(m_descriptors.data(), m_descriptors.size(), static_cast<int>(timeout.asMilliseconds()));
+		m_descriptors.clear();
+
+		// Reset the eventfd counter, so it only wakes the next wait if it's interrupted again
+		auto counter = std::uint64_t(0);
+		(void)read(m_interruptDescriptor, &counter, sizeof(counter));
+	}
+
+	auto LocalPoller::interrupt() const -> void
+	{
+		auto counter = std::uint64_t(1);
+		(void)write(m_interruptDescriptor, &counter, sizeof(counter));
+	}
+
+} // namespace Server
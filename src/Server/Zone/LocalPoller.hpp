@@ -0,0 +1,63 @@
+#pragma once
+
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+using pollfd_t = struct pollfd;
+
+namespace Server
+{
+
+	/**
+	 * \class LocalPoller LocalPoller.hpp "Zone/LocalPoller.hpp"
+	 * \brief Waits until any of a handful of descriptors is ready, or until another thread interrupts it
+	 *
+	 * Only used for the few Unix sockets between a gateway and its zones, so it's a plain poll over the descriptors given for each
+	 * wait. The caller reads every descriptor afterwards until it would block, rather than asking which were ready
+	 */
+	class LocalPoller
+	{
+	public:
+		/**
+		 * \brief Construct a new Local Poller object
+		 *
+		 */
+		LocalPoller();
+
+		/**
+		 * \brief Destroy the Local Poller object
+		 *
+		 */
+		~LocalPoller();
+
+		LocalPoller(const LocalPoller&)                    = delete;
+		auto operator=(const LocalPoller&) -> LocalPoller& = delete;
+
+		/**
+		 * \brief Watch a descriptor during the next wait
+		 *
+		 * \param descriptor The descriptor. Ignored if it's negative
+		 * \param watchWritable Also wake when the descriptor can be written to, for a socket with writes waiting
+		 */
+		auto add(int descriptor, bool watchWritable = false) -> void;
+
+		/**
+		 * \brief Wait until a watched descriptor is ready, the poller is interrupted, or the timeout expires, then forget the descriptors
+		 *
+		 * \param timeout The maximum amount of time to wait
+		 */
+		auto wait(sf::Time timeout) -> void;
+
+		/**
+		 * \brief Wake up a call to wait which is in progress on another thread, or make the next call return immediately.
+		 * Safe to call from any thread
+		 *
+		 */
+		auto interrupt() const -> void;
+
+	private:
+		int m_interruptDescriptor = -1;
+		std::vector<pollfd_t> m_descriptors;
+	};
+
+} // namespace Server
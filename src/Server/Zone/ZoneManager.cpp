@@ -0,0 +1,463 @@
+#include "Zone/ZoneManager.hpp"
+#include "Zone/ZoneProtocol.hpp"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+namespace Server
+{
+
+	ZoneManager::ZoneManager(NetworkManager& networkManager, const std::size_t zoneCount, const std::filesystem::path& ipcDirectory) :
+	    m_networkManager(networkManager),
+	    m_socketPath(ipcDirectory / "gateway.sock"),
+	    m_zones(std::max(zoneCount, std::size_t(1))),
+	    m_connected(std::max(zoneCount, std::size_t(1)))
+	{
+	}
+
+	ZoneManager::~ZoneManager()
+	{
+		stop();
+	}
+
+	auto ZoneManager::addRoutedType(const Common::Network::MessageType messageType) -> void
+	{
+		m_routedTypes.emplace(messageType);
+	}
+
+	auto ZoneManager::start() -> void
+	{
+		if (m_thread.joinable())
+		{
+			return;
+		}
+
+		if (!m_listener.listen(m_socketPath))
+		{
+			spdlog::error("Zones won't be able to connect, so nothing will be simulated");
+		}
+		spdlog::info("Waiting for {} zones to connect to {}", m_zones.size(), m_socketPath.string());
+
+		m_running = true;
+		m_thread  = std::thread(&ZoneManager::run, this);
+	}
+
+	auto ZoneManager::stop() -> void
+	{
+		m_running = false;
+		m_poller.interrupt();
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+
+		for (auto& zone : m_zones)
+		{
+			zone.channel.close();
+		}
+		m_greetingChannels.clear();
+		m_listener.close();
+	}
+
+	auto ZoneManager::route(Common::Network::Message& message) -> bool
+	{
+		if (!m_routedTypes.contains(message.header.type))
+		{
+			return false;
+		}
+
+		auto lock     = std::shared_lock<std::shared_mutex>(m_ownersMutex);
+		auto iterator = m_owners.find(message.header.entityID);
+		if (iterator == m_owners.end() || !m_connected[iterator->second])
+		{
+			return true;
+		}
+
+		auto frame = beginZoneFrame(ZoneFrameType::Message);
+		frame << message.header.entityID << static_cast<std::uint8_t>(message.header.protocol) << static_cast<Common::Network::MessageType_t>(message.header.type);
+		writeZonePayload(frame, {message.getPayloadData(), message.getPayloadSize()});
+		pushCommand(iterator->second, std::move(frame), false);
+		return true;
+	}
+
+	auto ZoneManager::spawn(EntityTransfer&& transfer) -> bool
+	{
+		auto zoneIndex = getZoneIndex(transfer.world.position.instanceID);
+
+		auto lock = std::unique_lock<std::shared_mutex>(m_ownersMutex);
+		if (m_owners.contains(transfer.entityID))
+		{
+			return false;
+		}
+
+		if (!m_connected[zoneIndex])
+		{
+			spdlog::debug("Entity {} will be spawned once zone {} connects", static_cast<std::uint32_t>(transfer.entityID), zoneIndex);
+		}
+
+		m_owners.emplace(transfer.entityID, zoneIndex);
+		auto frame = beginZoneFrame(ZoneFrameType::Spawn);
+		frame << transfer;
+		pushCommand(zoneIndex, std::move(frame), true);
+		return true;
+	}
+
+	auto ZoneManager::despawn(const entt::entity entityID) -> void
+	{
+		auto lock     = std::unique_lock<std::shared_mutex>(m_ownersMutex);
+		auto iterator = m_owners.find(entityID);
+		if (iterator == m_owners.end())
+		{
+			return;
+		}
+
+		auto frame = beginZoneFrame(ZoneFrameType::Despawn);
+		frame << entityID;
+		pushCommand(iterator->second, std::move(frame), true);
+		m_owners.erase(iterator);
+	}
+
+	auto ZoneManager::requestTransfer(const entt::entity entityID, const std::uint32_t instanceID) -> bool
+	{
+		auto lock     = std::shared_lock<std::shared_mutex>(m_ownersMutex);
+		auto iterator = m_owners.find(entityID);
+		if (iterator == m_owners.end())
+		{
+			return false;
+		}
+
+		auto frame = beginZoneFrame(ZoneFrameType::Transfer);
+		frame << entityID << instanceID;
+		pushCommand(iterator->second, std::move(frame), false);
+		return true;
+	}
+
+	auto ZoneManager::isSpawned(const entt::entity entityID) const -> bool
+	{
+		auto lock = std::shared_lock<std::shared_mutex>(m_ownersMutex);
+		return m_owners.contains(entityID);
+	}
+
+	auto ZoneManager::saveAll() -> void
+	{
+		for (auto i = std::size_t(0); i < m_zones.size(); ++i)
+		{
+			pushCommand(i, beginZoneFrame(ZoneFrameType::Save), false);
+		}
+	}
+
+	auto ZoneManager::takeSavedEntities(std::vector<EntityTransfer>& entities) -> void
+	{
+		m_savedEntities.drainInto(entities);
+	}
+
+	auto ZoneManager::takeLostEntities(std::vector<entt::entity>& entities) -> void
+	{
+		m_lostEntities.drainInto(entities);
+	}
+
+	auto ZoneManager::logMetrics() const -> void
+	{
+		auto entityCounts = std::vector<std::size_t>(m_zones.size());
+		{
+			auto lock = std::shared_lock<std::shared_mutex>(m_ownersMutex);
+			for (const auto& [entityID, zoneIndex] : m_owners)
+			{
+				++entityCounts[zoneIndex];
+			}
+		}
+
+		for (auto i = std::size_t(0); i < m_zones.size(); ++i)
+		{
+			spdlog::info("Zone {}: {}, {} entities", i, m_connected[i] ? "connected" : "waiting to connect", entityCounts[i]);
+			pushCommand(i, beginZoneFrame(ZoneFrameType::LogMetrics), false);
+		}
+	}
+
+	auto ZoneManager::run() -> void
+	{
+		while (m_running)
+		{
+			m_poller.add(m_listener.getDescriptor());
+			for (const auto& channel : m_greetingChannels)
+			{
+				m_poller.add(channel.getDescriptor());
+			}
+			for (const auto& zone : m_zones)
+			{
+				m_poller.add(zone.channel.getDescriptor(), zone.channel.hasUnwritten());
+			}
+			m_poller.wait(sf::seconds(1));
+
+			acceptZones();
+			std::erase_if(m_greetingChannels, [&](LocalChannel& channel) {
+				return greetZone(channel);
+			});
+
+			for (auto i = std::size_t(0); i < m_zones.size(); ++i)
+			{
+				auto& zone = m_zones[i];
+				if (!zone.channel.isOpen())
+				{
+					continue;
+				}
+
+				m_receivedFrames.clear();
+				auto isOpen = zone.channel.receive(m_receivedFrames);
+				for (auto& bytes : m_receivedFrames)
+				{
+					auto frame = Common::Network::MessageData(std::move(bytes));
+					handleFrame(i, frame);
+				}
+
+				if (!isOpen || !zone.channel.isOpen())
+				{
+					loseZone(i);
+				}
+			}
+
+			processCommands();
+
+			for (auto i = std::size_t(0); i < m_zones.size(); ++i)
+			{
+				if (m_zones[i].channel.isOpen() && !m_zones[i].channel.flush())
+				{
+					loseZone(i);
+				}
+			}
+
+			// Send what the zones pushed now, rather than whenever the sockets are next polled
+			if (m_pushedOutbound)
+			{
+				m_networkManager.wake();
+				m_pushedOutbound = false;
+			}
+		}
+	}
+
+	auto ZoneManager::acceptZones() -> void
+	{
+		while (auto channel = m_listener.accept())
+		{
+			m_greetingChannels.emplace_back(std::move(*channel));
+		}
+	}
+
+	auto ZoneManager::greetZone(LocalChannel& channel) -> bool
+	{
+		m_receivedFrames.clear();
+		auto isOpen = channel.receive(m_receivedFrames);
+		if (m_receivedFrames.empty())
+		{
+			return !isOpen;
+		}
+
+		auto hello        = Common::Network::MessageData(std::move(m_receivedFrames.front()));
+		auto version      = std::uint16_t(0);
+		auto zoneIndex    = std::uint32_t(0);
+		auto zoneCount    = std::uint32_t(0);
+		auto isValidHello = false;
+		try
+		{
+			isValidHello = readZoneFrameType(hello) == ZoneFrameType::Hello;
+			if (isValidHello)
+			{
+				hello >> version >> zoneIndex >> zoneCount;
+			}
+		}
+		catch (const std::out_of_range&)
+		{
+			isValidHello = false;
+		}
+
+		if (!isValidHello || version != ZONE_PROTOCOL_VERSION || zoneCount != m_zones.size() || zoneIndex >= m_zones.size())
+		{
+			spdlog::warn("Turned away a zone which said it was zone {} of {}, speaking version {}. Expected one of {} zones, speaking version {}", zoneIndex, zoneCount, version, m_zones.size(), ZONE_PROTOCOL_VERSION);
+			return true;
+		}
+
+		auto& zone = m_zones[zoneIndex];
+		if (zone.channel.isOpen())
+		{
+			spdlog::warn("Turned away a second zone {}, as one is already connected", zoneIndex);
+			return true;
+		}
+
+		zone.channel            = std::move(channel);
+		m_connected[zoneIndex] = true;
+		spdlog::info("Zone {} connected, and has {} frames waiting for it", zoneIndex, zone.waitingFrames.size());
+
+		for (auto& frame : zone.waitingFrames)
+		{
+			zone.channel.send(getZoneFrameBytes(frame));
+		}
+		zone.waitingFrames.clear();
+
+		// Whatever the zone sent straight after saying hello
+		for (auto i = std::size_t(1); i < m_receivedFrames.size(); ++i)
+		{
+			auto frame = Common::Network::MessageData(std::move(m_receivedFrames[i]));
+			handleFrame(zoneIndex, frame);
+		}
+		if (!isOpen)
+		{
+			loseZone(zoneIndex);
+		}
+		return true;
+	}
+
+	auto ZoneManager::handleFrame(const std::size_t zoneIndex, Common::Network::MessageData& frame) -> void
+	{
+		// Zones are trusted, but a frame which runs short means the zone and the gateway disagree about the protocol
+		try
+		{
+			auto type = readZoneFrameType(frame);
+			if (!type.has_value())
+			{
+				spdlog::warn("Zone {} sent a frame of an unknown type", zoneIndex);
+				return;
+			}
+
+			switch (*type)
+			{
+				case ZoneFrameType::Outbound:
+				{
+					auto entityID    = entt::entity(entt::null);
+					auto protocol    = std::uint8_t(0);
+					auto messageType = Common::Network::MessageType_t(0);
+					auto subject     = entt::entity(entt::null);
+					auto priority    = 1.F;
+					frame >> entityID >> protocol >> messageType >> subject >> priority;
+
+					auto payload = Common::Network::Message::makeSharedPayload(readZonePayload(frame));
+					m_networkManager.pushMessage(static_cast<Common::Network::Protocol>(protocol), static_cast<Common::Network::MessageType>(messageType), entityID, payload, subject, priority);
+					m_pushedOutbound = true;
+				}
+				break;
+				case ZoneFrameType::Broadcast:
+				{
+					auto messageType    = Common::Network::MessageType_t(0);
+					auto recipientCount = std::uint32_t(0);
+					frame >> messageType >> recipientCount;
+
+					m_recipients.clear();
+					for (auto i = std::uint32_t(0); i < recipientCount; ++i)
+					{
+						auto& recipient = m_recipients.emplace_back(MessageRecipient{entt::null, Common::Network::Protocol::TCP});
+						auto protocol   = std::uint8_t(0);
+						frame >> recipient.entityID >> protocol >> recipient.subject >> recipient.priority;
+						recipient.protocol = static_cast<Common::Network::Protocol>(protocol);
+					}
+
+					// Packed once for every recipient, as it was in the zone
+					auto payload = Common::Network::Message::makeSharedPayload(readZonePayload(frame));
+					for (const auto& recipient : m_recipients)
+					{
+						m_networkManager.pushMessage(recipient.protocol, static_cast<Common::Network::MessageType>(messageType), recipient.entityID, payload, recipient.subject, recipient.priority);
+					}
+					m_pushedOutbound = true;
+				}
+				break;
+				case ZoneFrameType::Saved:
+				{
+					auto transfer = EntityTransfer();
+					frame >> transfer;
+					m_savedEntities.push(std::move(transfer));
+				}
+				break;
+				case ZoneFrameType::Handoff:
+				{
+					auto transfer = EntityTransfer();
+					frame >> transfer;
+
+					// An entity despawned while it was being handed over is saved rather than moved
+					auto lock     = std::unique_lock<std::shared_mutex>(m_ownersMutex);
+					auto iterator = m_owners.find(transfer.entityID);
+					if (iterator == m_owners.end())
+					{
+						m_savedEntities.push(std::move(transfer));
+						break;
+					}
+
+					iterator->second = getZoneIndex(transfer.world.position.instanceID);
+					spdlog::debug("Handing entity {} from zone {} to zone {}", static_cast<std::uint32_t>(transfer.entityID), zoneIndex, iterator->second);
+
+					auto adopt = beginZoneFrame(ZoneFrameType::Adopt);
+					adopt << transfer;
+					sendToZone(iterator->second, adopt, true);
+				}
+				break;
+				case ZoneFrameType::Goodbye:
+					spdlog::info("Zone {} is exiting", zoneIndex);
+					break;
+				default:
+					spdlog::warn("Zone {} sent a frame only the gateway sends", zoneIndex);
+					break;
+			}
+		}
+		catch (const std::out_of_range&)
+		{
+			spdlog::warn("Zone {} sent a frame which ran short, so it's being disconnected", zoneIndex);
+			m_zones[zoneIndex].channel.close();
+		}
+	}
+
+	auto ZoneManager::processCommands() -> void
+	{
+		for (auto& command : m_commands.clear())
+		{
+			sendToZone(command.zoneIndex, command.frame, command.waitForZone);
+		}
+	}
+
+	auto ZoneManager::sendToZone(const std::size_t zoneIndex, Common::Network::MessageData& frame, const bool waitForZone) -> void
+	{
+		auto& zone = m_zones[zoneIndex];
+		if (zone.channel.isOpen())
+		{
+			zone.channel.send(getZoneFrameBytes(frame));
+		}
+		else if (waitForZone)
+		{
+			zone.waitingFrames.emplace_back(std::move(frame));
+		}
+	}
+
+	auto ZoneManager::pushCommand(const std::size_t zoneIndex, Common::Network::MessageData&& frame, const bool waitForZone) const -> void
+	{
+		m_commands.push(Command{zoneIndex, std::move(frame), waitForZone});
+		m_poller.interrupt();
+	}
+
+	auto ZoneManager::loseZone(const std::size_t zoneIndex) -> void
+	{
+		m_zones[zoneIndex].channel.close();
+		m_connected[zoneIndex] = false;
+
+		auto lostCount = std::size_t(0);
+		{
+			auto lock = std::unique_lock<std::shared_mutex>(m_ownersMutex);
+			for (auto iterator = m_owners.begin(); iterator != m_owners.end();)
+			{
+				if (iterator->second == zoneIndex)
+				{
+					m_lostEntities.push(entt::entity(iterator->first));
+					iterator = m_owners.erase(iterator);
+					++lostCount;
+				}
+				else
+				{
+					++iterator;
+				}
+			}
+		}
+
+		spdlog::warn("Zone {} disconnected, losing {} entities", zoneIndex, lostCount);
+	}
+
+	auto ZoneManager::getZoneIndex(const std::uint32_t instanceID) const -> std::size_t
+	{
+		return instanceID % m_zones.size();
+	}
+
+} // namespace Server
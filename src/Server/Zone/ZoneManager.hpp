@@ -0,0 +1,260 @@
+#pragma once
+
+#include "Network/NetworkManager.hpp"
+#include "Server/World.hpp"
+#include "Zone/LocalChannel.hpp"
+#include "Zone/LocalListener.hpp"
+#include "Zone/LocalPoller.hpp"
+#include <Common/Util/ThreadSafeQueue.hpp>
+#include <atomic>
+#include <filesystem>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Server
+{
+
+	/**
+	 * \class ZoneManager ZoneManager.hpp "Zone/ZoneManager.hpp"
+	 * \brief Leaves the world to zone processes on the same machine, making this server a gateway which only owns the clients'
+	 * connections, their sessions and the database
+	 *
+	 * Instances are spread over the zones by their ID, as the shards within a zone spread them further. Zones connect to a Unix socket
+	 * in the IPC directory and say which zone they are, and the sockets are serviced on the zone manager's own thread. Messages from
+	 * clients are passed on to the zone simulating their entity, and messages the zones send back are pushed to the network manager.
+	 *
+	 * Spawns, adoptions and despawns for a zone which isn't connected wait for it to connect. When a zone goes away, every entity it
+	 * held is reported as lost, so the server can load it again from the database and spawn it once the zone is back, while its client
+	 * stays connected to the gateway. A zone which exits cleanly sends back every entity it held to be saved first.
+	 */
+	class ZoneManager : public World
+	{
+	public:
+		/**
+		 * \brief Construct a new Zone Manager object
+		 *
+		 * \param networkManager The network manager messages from the zones are pushed to
+		 * \param zoneCount The number of zones the instances are split between, at least one
+		 * \param ipcDirectory The directory the socket zones connect to is created in
+		 */
+		ZoneManager(NetworkManager& networkManager, std::size_t zoneCount, const std::filesystem::path& ipcDirectory);
+
+		/**
+		 * \brief Destroy the Zone Manager object, disconnecting every zone
+		 *
+		 */
+		~ZoneManager() override;
+
+		ZoneManager(const ZoneManager&)                    = delete;
+		auto operator=(const ZoneManager&) -> ZoneManager& = delete;
+
+		/**
+		 * \brief Pass messages of a type on to the zones. Only call this before the zone manager is started
+		 *
+		 * \param messageType The type of message the zones handle
+		 */
+		auto addRoutedType(Common::Network::MessageType messageType) -> void;
+
+		/**
+		 * \brief Start listening for zones, and servicing them on the zone manager's own thread
+		 *
+		 */
+		auto start() -> void;
+
+		/**
+		 * \brief Stop the zone manager's thread, and disconnect every zone. The zones keep whatever they hold until they exit
+		 *
+		 */
+		auto stop() -> void override;
+
+		/**
+		 * \brief Pass a message to the zone simulating the client which sent it, if its type is handled by the zones
+		 *
+		 * \param message The message
+		 * \return true The message's type is handled by the zones, so it has been passed on, or dropped if its client isn't in the world
+		 * or its zone isn't connected
+		 * \return false The zones don't handle the message's type
+		 */
+		auto route(Common::Network::Message& message) -> bool override;
+
+		/**
+		 * \brief Put a new client's entity in the world, in the zone which owns its instance
+		 *
+		 * \param transfer The entity's components
+		 * \return true The entity has been handed to its zone, or will be once it connects
+		 * \return false The entity is already in the world
+		 */
+		auto spawn(EntityTransfer&& transfer) -> bool override;
+
+		/**
+		 * \brief Take an entity out of the world. Its components are queued to be saved once its zone has removed it
+		 *
+		 * \param entityID The ID of the entity
+		 */
+		auto despawn(entt::entity entityID) -> void override;
+
+		/**
+		 * \brief Ask the zone holding an entity to move it to another instance, which may be in another zone
+		 *
+		 * \param entityID The ID of the entity
+		 * \param instanceID The instance to move the entity to
+		 * \return true The request has been passed to the entity's zone
+		 * \return false The entity isn't in the world
+		 */
+		auto requestTransfer(entt::entity entityID, std::uint32_t instanceID) -> bool override;
+
+		/**
+		 * \brief Check whether an entity is in the world
+		 *
+		 * \param entityID The ID of the entity
+		 */
+		[[nodiscard]] auto isSpawned(entt::entity entityID) const -> bool override;
+
+		/**
+		 * \brief Ask every connected zone to send back copies of their clients' entities to be saved
+		 *
+		 */
+		auto saveAll() -> void override;
+
+		/**
+		 * \brief Take every entity the zones have sent back to be saved
+		 *
+		 * \param entities The vector to move the entities into, whose previous contents are discarded
+		 */
+		auto takeSavedEntities(std::vector<EntityTransfer>& entities) -> void override;
+
+		/**
+		 * \brief Take every entity which was in a zone when it went away
+		 *
+		 * \param entities The vector to move the entities' IDs into, whose previous contents are discarded
+		 */
+		auto takeLostEntities(std::vector<entt::entity>& entities) -> void override;
+
+		/**
+		 * \brief Log which zones are connected and how many entities each holds, and ask each to log its own counters
+		 *
+		 */
+		auto logMetrics() const -> void override;
+
+	private:
+		/**
+		 * \struct Command
+		 * \brief A frame from the simulation thread, to be sent to a zone by the zone manager's thread
+		 */
+		struct Command
+		{
+			std::size_t zoneIndex = 0;
+			Common::Network::MessageData frame;
+
+			// Frames which change what a zone holds wait for it to connect. Anything else is dropped if it isn't connected
+			bool waitForZone = false;
+		};
+
+		/**
+		 * \struct Zone
+		 * \brief The connection to a zone, owned by the zone manager's thread
+		 */
+		struct Zone
+		{
+			LocalChannel channel;
+			std::vector<Common::Network::MessageData> waitingFrames;
+		};
+
+		/**
+		 * \brief The body of the zone manager's thread
+		 *
+		 */
+		auto run() -> void;
+
+		/**
+		 * \brief Accept every zone waiting to connect. They aren't given a slot until they've said which zone they are
+		 *
+		 */
+		auto acceptZones() -> void;
+
+		/**
+		 * \brief Read the Hello frame from a zone which has just connected, and give it the slot it asks for if it's free
+		 *
+		 * \param channel The zone's connection
+		 * \return true The zone has said which zone it is, or been turned away, so the connection no longer needs watching
+		 * \return false The zone hasn't said anything yet
+		 */
+		auto greetZone(LocalChannel& channel) -> bool;
+
+		/**
+		 * \brief Handle a frame sent by a zone
+		 *
+		 * \param zoneIndex The index of the zone
+		 * \param frame The frame
+		 */
+		auto handleFrame(std::size_t zoneIndex, Common::Network::MessageData& frame) -> void;
+
+		/**
+		 * \brief Send frames pushed by the simulation thread
+		 *
+		 */
+		auto processCommands() -> void;
+
+		/**
+		 * \brief Send a frame to a zone, or hold it until the zone connects
+		 *
+		 * \param zoneIndex The index of the zone
+		 * \param frame The frame
+		 * \param waitForZone Whether to hold the frame if the zone isn't connected, rather than drop it
+		 */
+		auto sendToZone(std::size_t zoneIndex, Common::Network::MessageData& frame, bool waitForZone) -> void;
+
+		/**
+		 * \brief Queue a frame for the zone manager's thread to send to a zone
+		 *
+		 * \param zoneIndex The index of the zone
+		 * \param frame The frame
+		 * \param waitForZone Whether to hold the frame if the zone isn't connected, rather than drop it
+		 */
+		auto pushCommand(std::size_t zoneIndex, Common::Network::MessageData&& frame, bool waitForZone) const -> void;
+
+		/**
+		 * \brief Forget a zone which has gone away, reporting every entity it held as lost
+		 *
+		 * \param zoneIndex The index of the zone
+		 */
+		auto loseZone(std::size_t zoneIndex) -> void;
+
+		/**
+		 * \brief Gets the zone which owns an instance
+		 *
+		 * \param instanceID The ID of the instance
+		 */
+		[[nodiscard]] auto getZoneIndex(std::uint32_t instanceID) const -> std::size_t;
+
+		NetworkManager& m_networkManager;
+		std::filesystem::path m_socketPath;
+		std::unordered_set<Common::Network::MessageType> m_routedTypes;
+
+		// Owned by the zone manager's thread
+		LocalListener m_listener;
+		LocalPoller m_poller;
+		std::vector<Zone> m_zones;
+		std::vector<LocalChannel> m_greetingChannels;
+		std::vector<std::vector<std::uint8_t>> m_receivedFrames;
+		std::vector<MessageRecipient> m_recipients;
+		bool m_pushedOutbound = false;
+
+		// Which zone holds each entity, read by the simulation thread and changed by both threads
+		mutable std::shared_mutex m_ownersMutex;
+		std::unordered_map<entt::entity, std::size_t> m_owners;
+		std::vector<std::atomic<bool>> m_connected;
+
+		// Pushed to when logging metrics too, which doesn't otherwise change the zone manager
+		mutable Common::Util::ThreadSafeQueue<Command> m_commands;
+		Common::Util::ThreadSafeQueue<EntityTransfer> m_savedEntities;
+		Common::Util::ThreadSafeQueue<entt::entity> m_lostEntities;
+
+		std::thread m_thread;
+		std::atomic<bool> m_running = false;
+	};
+
+} // namespace Server
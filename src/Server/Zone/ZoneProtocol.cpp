@@ -0,0 +1,88 @@
+#include "Zone/ZoneProtocol.hpp"
+#include <cstring>
+#include <utility>
+
+namespace Server
+{
+
+	auto beginZoneFrame(const ZoneFrameType type) -> Common::Network::MessageData
+	{
+		auto frame = Common::Network::MessageData();
+		frame << static_cast<std::uint8_t>(type);
+		return frame;
+	}
+
+	auto getZoneFrameBytes(const Common::Network::MessageData& frame) -> std::span<const std::uint8_t>
+	{
+		return {static_cast<const std::uint8_t*>(frame.data()), frame.size()};
+	}
+
+	auto readZoneFrameType(Common::Network::MessageData& frame) -> std::optional<ZoneFrameType>
+	{
+		if (frame.remaining() < sizeof(std::uint8_t))
+		{
+			return {};
+		}
+
+		auto type = std::uint8_t(0);
+		frame >> type;
+		if (type > static_cast<std::uint8_t>(ZoneFrameType::LogMetrics))
+		{
+			return {};
+		}
+		return static_cast<ZoneFrameType>(type);
+	}
+
+	auto writeZonePayload(Common::Network::MessageData& frame, const std::span<const std::uint8_t> payload) -> void
+	{
+		auto offset = frame.size();
+		frame.resize(offset + payload.size());
+		if (!payload.empty())
+		{
+			std::memcpy(static_cast<std::uint8_t*>(frame.data()) + offset, payload.data(), payload.size());
+		}
+	}
+
+	auto readZonePayload(Common::Network::MessageData& frame) -> std::vector<std::uint8_t>
+	{
+		const auto* bytes = static_cast<const std::uint8_t*>(std::as_const(frame).data());
+		return {bytes + frame.size() - frame.remaining(), bytes + frame.size()};
+	}
+
+	auto operator<<(Common::Network::MessageData& data, const EntityTransfer& transfer) -> Common::Network::MessageData&
+	{
+		// The components only serialise themselves from a mutable reference
+		auto world = transfer.world;
+
+		data << transfer.entityID << transfer.isClient;
+		world.position.serialise(data);
+		world.type.serialise(data);
+		world.name.serialise(data);
+		world.stats.serialise(data);
+
+		data << transfer.inputState.has_value();
+		if (transfer.inputState.has_value())
+		{
+			data << *transfer.inputState;
+		}
+		return data;
+	}
+
+	auto operator>>(Common::Network::MessageData& data, EntityTransfer& transfer) -> Common::Network::MessageData&
+	{
+		data >> transfer.entityID >> transfer.isClient;
+		transfer.world.position.deserialise(data);
+		transfer.world.type.deserialise(data);
+		transfer.world.name.deserialise(data);
+		transfer.world.stats.deserialise(data);
+
+		auto hasInputState = false;
+		data >> hasInputState;
+		if (hasInputState)
+		{
+			data >> transfer.inputState.emplace();
+		}
+		return data;
+	}
+
+} // namespace Server
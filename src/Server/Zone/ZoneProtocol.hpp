@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Server/World.hpp"
+#include <Common/Network/MessageData.hpp>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Server
+{
+
+	/// \brief Sent by a zone when it connects. A gateway turns away zones which speak a different version
+	const std::uint16_t ZONE_PROTOCOL_VERSION = 2;
+
+	/**
+	 * \brief The frames sent between a gateway and its zones. Each starts with its type, followed by:
+	 *
+	 * Zone to gateway:
+	 * - Hello: the protocol version, the zone's index and the number of zones, sent once when the zone connects
+	 * - Goodbye: nothing. The zone is exiting, and every entity it held has been sent back as Saved
+	 * - Outbound: a message for a client, as the recipient, protocol, type, subject, priority and payload
+	 * - Broadcast: a message for many clients, as the type, the number of recipients, each recipient's ID, protocol, subject and
+	 *   priority, and the payload they all share
+	 * - Saved: an entity to write to the database, which is no longer in the world if it was despawned
+	 * - Handoff: an entity moving to an instance in another zone, which the zone has already removed
+	 *
+	 * Gateway to zone:
+	 * - Message: a message from a client, as the sender, protocol, type and payload
+	 * - Spawn: a new client's entity, which the zone sends its own entity
+	 * - Adopt: an entity handed over by another zone
+	 * - Despawn: the ID of an entity leaving the world
+	 * - Save: nothing. Every client's entity is to be sent back as Saved
+	 * - Transfer: the ID of an entity, and the instance to move it to
+	 * - LogMetrics: nothing. The zone writes its counters to its own log
+	 */
+	enum class ZoneFrameType : std::uint8_t
+	{
+		Hello,
+		Goodbye,
+		Outbound,
+		Broadcast,
+		Saved,
+		Handoff,
+		Message,
+		Spawn,
+		Adopt,
+		Despawn,
+		Save,
+		Transfer,
+		LogMetrics
+	};
+
+	/**
+	 * \brief Start a frame, to have its fields written after the type
+	 *
+	 * \param type The type of frame
+	 * \return Common::Network::MessageData The frame, holding only its type
+	 */
+	auto beginZoneFrame(ZoneFrameType type) -> Common::Network::MessageData;
+
+	/**
+	 * \brief Get the bytes of a frame, to be sent over a LocalChannel
+	 *
+	 * \param frame The frame
+	 */
+	auto getZoneFrameBytes(const Common::Network::MessageData& frame) -> std::span<const std::uint8_t>;
+
+	/**
+	 * \brief Read the type of a received frame, leaving its fields to be read
+	 *
+	 * \param frame The frame
+	 * \return std::optional<ZoneFrameType> An optional which may contain the type, empty if the frame doesn't have a known one
+	 */
+	auto readZoneFrameType(Common::Network::MessageData& frame) -> std::optional<ZoneFrameType>;
+
+	/**
+	 * \brief Write a payload as the last field of a frame
+	 *
+	 * \param frame The frame
+	 * \param payload The payload
+	 */
+	auto writeZonePayload(Common::Network::MessageData& frame, std::span<const std::uint8_t> payload) -> void;
+
+	/**
+	 * \brief Read the payload at the end of a frame
+	 *
+	 * \param frame The frame, with every field before the payload already read
+	 * \return std::vector<std::uint8_t> The payload
+	 */
+	auto readZonePayload(Common::Network::MessageData& frame) -> std::vector<std::uint8_t>;
+
+	auto operator<<(Common::Network::MessageData& data, const EntityTransfer& transfer) -> Common::Network::MessageData&;
+	auto operator>>(Common::Network::MessageData& data, EntityTransfer& transfer) -> Common::Network::MessageData&;
+
+} // namespace Server
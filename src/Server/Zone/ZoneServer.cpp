@@ -0,0 +1,278 @@
+#include "Zone/ZoneServer.hpp"
+#include "Server/TickScheduler.hpp"
+#include "Server/WorldSystems.hpp"
+#include "Zone/ZoneProtocol.hpp"
+#include <SFML/System/Clock.hpp>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace Server
+{
+
+	namespace
+	{
+		std::atomic<bool> exitRequested = false;
+
+		auto requestExit(int /*signal*/) -> void
+		{
+			exitRequested = true;
+		}
+	} // namespace
+
+	ZoneServer::ZoneServer(const Options& options) :
+	    m_zoneIndex(options.zoneIndex.value_or(0)),
+	    m_zoneCount(options.zoneCount),
+	    m_tickRate(options.tickRate),
+	    m_socketPath(options.ipcDirectory / "gateway.sock"),
+	    m_jobSystem(options.workerCount),
+	    m_shardManager(*this, options.shardCount, m_jobSystem)
+	{
+		m_shardManager.setZone(m_zoneIndex, m_zoneCount);
+		addWorldSystems(m_shardManager);
+	}
+
+	ZoneServer::~ZoneServer()
+	{
+		m_shardManager.stop();
+	}
+
+	auto ZoneServer::run() -> void
+	{
+		std::signal(SIGINT, requestExit);
+		std::signal(SIGTERM, requestExit);
+
+		if (!connect())
+		{
+			return;
+		}
+
+		m_shardManager.start(TickScheduler::getTickLength(m_tickRate));
+
+		while (!exitRequested)
+		{
+			m_poller.add(m_channel.getDescriptor(), m_channel.hasUnwritten());
+			m_poller.wait(sf::seconds(1));
+
+			m_receivedFrames.clear();
+			auto isOpen = m_channel.receive(m_receivedFrames);
+			for (auto& bytes : m_receivedFrames)
+			{
+				auto frame = Common::Network::MessageData(std::move(bytes));
+				handleFrame(frame);
+			}
+
+			sendQueuedFrames();
+			if (!isOpen || !m_channel.flush())
+			{
+				spdlog::error("Lost the gateway, so zone {} is exiting. The gateway will hand its entities to the next zone {} to connect", m_zoneIndex, m_zoneIndex);
+				m_shardManager.stop();
+				return;
+			}
+		}
+
+		shutdown();
+	}
+
+	auto ZoneServer::pushMessage(const Common::Network::Protocol protocol, const Common::Network::MessageType type, const entt::entity entityID, Common::Network::MessageData& data) -> void
+	{
+		pushMessage(protocol, type, entityID, data, entt::null, 1.F);
+	}
+
+	auto ZoneServer::pushMessage(const Common::Network::Protocol protocol, const Common::Network::MessageType type, const entt::entity entityID, const Common::Network::SharedPayload& payload) -> void
+	{
+		pushMessage(protocol, type, entityID, payload, entt::null, 1.F);
+	}
+
+	auto ZoneServer::pushMessage(const Common::Network::Protocol protocol, const Common::Network::MessageType type, const entt::entity entityID, Common::Network::MessageData& data, const entt::entity subject, const float priority) -> void
+	{
+		const auto& constData = std::as_const(data);
+		pushOutbound(protocol, type, entityID, {static_cast<const std::uint8_t*>(constData.data()), constData.size()}, subject, priority);
+	}
+
+	auto ZoneServer::pushMessage(const Common::Network::Protocol protocol, const Common::Network::MessageType type, const entt::entity entityID, const Common::Network::SharedPayload& payload, const entt::entity subject, const float priority) -> void
+	{
+		pushOutbound(protocol, type, entityID, *payload, subject, priority);
+	}
+
+	auto ZoneServer::pushBroadcast(const Common::Network::MessageType type, const std::span<const MessageRecipient> recipients, Common::Network::MessageData& data) -> void
+	{
+		if (recipients.empty())
+		{
+			return;
+		}
+
+		auto frame = beginZoneFrame(ZoneFrameType::Broadcast);
+		frame << static_cast<Common::Network::MessageType_t>(type) << static_cast<std::uint32_t>(recipients.size());
+		for (const auto& recipient : recipients)
+		{
+			frame << recipient.entityID << static_cast<std::uint8_t>(recipient.protocol) << recipient.subject << recipient.priority;
+		}
+
+		const auto& constData = std::as_const(data);
+		writeZonePayload(frame, {static_cast<const std::uint8_t*>(constData.data()), constData.size()});
+		m_outboundFrames.push(std::move(frame));
+	}
+
+	auto ZoneServer::wake() -> void
+	{
+		m_poller.interrupt();
+	}
+
+	auto ZoneServer::connect() -> bool
+	{
+		spdlog::info("Zone {} of {} connecting to the gateway at {}", m_zoneIndex, m_zoneCount, m_socketPath.string());
+		while (!m_channel.connect(m_socketPath))
+		{
+			if (exitRequested)
+			{
+				return false;
+			}
+			std::this_thread::sleep_for(std::chrono::seconds(1));
+		}
+
+		auto hello = beginZoneFrame(ZoneFrameType::Hello);
+		hello << ZONE_PROTOCOL_VERSION << static_cast<std::uint32_t>(m_zoneIndex) << static_cast<std::uint32_t>(m_zoneCount);
+		m_channel.send(getZoneFrameBytes(hello));
+		m_channel.flush();
+
+		spdlog::info("Zone {} connected to the gateway", m_zoneIndex);
+		return true;
+	}
+
+	auto ZoneServer::handleFrame(Common::Network::MessageData& frame) -> void
+	{
+		try
+		{
+			auto type = readZoneFrameType(frame);
+			if (!type.has_value())
+			{
+				spdlog::warn("The gateway sent a frame of an unknown type");
+				return;
+			}
+
+			switch (*type)
+			{
+				case ZoneFrameType::Message:
+				{
+					auto message     = Common::Network::Message();
+					auto protocol    = std::uint8_t(0);
+					auto messageType = Common::Network::MessageType_t(0);
+					frame >> message.header.entityID >> protocol >> messageType;
+
+					message.header.protocol = static_cast<Common::Network::Protocol>(protocol);
+					message.header.type     = static_cast<Common::Network::MessageType>(messageType);
+					message.data            = Common::Network::MessageData(readZonePayload(frame));
+					m_shardManager.route(message);
+				}
+				break;
+				case ZoneFrameType::Spawn:
+				case ZoneFrameType::Adopt:
+				{
+					auto transfer = EntityTransfer();
+					frame >> transfer;
+
+					auto entityID = transfer.entityID;
+					auto isPlaced = *type == ZoneFrameType::Spawn ? m_shardManager.spawn(std::move(transfer)) : m_shardManager.adopt(std::move(transfer));
+					if (!isPlaced)
+					{
+						spdlog::warn("Zone {} was given entity {}, which it already holds", m_zoneIndex, static_cast<std::uint32_t>(entityID));
+					}
+				}
+				break;
+				case ZoneFrameType::Despawn:
+				{
+					auto entityID = entt::entity(entt::null);
+					frame >> entityID;
+					m_shardManager.despawn(entityID);
+				}
+				break;
+				case ZoneFrameType::Save:
+					m_shardManager.saveAll();
+					break;
+				case ZoneFrameType::Transfer:
+				{
+					auto entityID   = entt::entity(entt::null);
+					auto instanceID = std::uint32_t(0);
+					frame >> entityID >> instanceID;
+					m_shardManager.requestTransfer(entityID, instanceID);
+				}
+				break;
+				case ZoneFrameType::LogMetrics:
+					m_shardManager.logMetrics();
+					break;
+				default:
+					spdlog::warn("The gateway sent a frame only zones send");
+					break;
+			}
+		}
+		catch (const std::out_of_range&)
+		{
+			spdlog::warn("The gateway sent a frame which ran short");
+		}
+	}
+
+	auto ZoneServer::pushOutbound(const Common::Network::Protocol protocol, const Common::Network::MessageType type, const entt::entity entityID, const std::span<const std::uint8_t> payload, const entt::entity subject, const float priority) -> void
+	{
+		auto frame = beginZoneFrame(ZoneFrameType::Outbound);
+		frame << entityID << static_cast<std::uint8_t>(protocol) << static_cast<Common::Network::MessageType_t>(type) << subject << priority;
+		writeZonePayload(frame, payload);
+		m_outboundFrames.push(std::move(frame));
+	}
+
+	auto ZoneServer::sendQueuedFrames() -> void
+	{
+		m_shardManager.takeSavedEntities(m_transfers);
+		for (const auto& transfer : m_transfers)
+		{
+			auto frame = beginZoneFrame(ZoneFrameType::Saved);
+			frame << transfer;
+			m_channel.send(getZoneFrameBytes(frame));
+		}
+
+		m_shardManager.takeHandoffs(m_transfers);
+		for (const auto& transfer : m_transfers)
+		{
+			auto frame = beginZoneFrame(ZoneFrameType::Handoff);
+			frame << transfer;
+			m_channel.send(getZoneFrameBytes(frame));
+		}
+
+		m_outboundFrames.drainInto(m_frames);
+		for (const auto& frame : m_frames)
+		{
+			m_channel.send(getZoneFrameBytes(frame));
+		}
+	}
+
+	auto ZoneServer::shutdown() -> void
+	{
+		const auto FLUSH_TIMEOUT = sf::seconds(5);
+
+		// Stopping the shards applies the save, so every entity is queued to go back before the goodbye
+		spdlog::info("Zone {} is exiting, handing its entities back to the gateway", m_zoneIndex);
+		m_shardManager.saveAll();
+		m_shardManager.stop();
+		sendQueuedFrames();
+
+		auto goodbye = beginZoneFrame(ZoneFrameType::Goodbye);
+		m_channel.send(getZoneFrameBytes(goodbye));
+
+		auto clock = sf::Clock();
+		while (m_channel.flush() && m_channel.hasUnwritten() && clock.getElapsedTime() < FLUSH_TIMEOUT)
+		{
+			m_poller.add(m_channel.getDescriptor(), true);
+			m_poller.wait(FLUSH_TIMEOUT - clock.getElapsedTime());
+		}
+
+		if (m_channel.hasUnwritten())
+		{
+			spdlog::error("Zone {} couldn't hand everything back to the gateway before exiting", m_zoneIndex);
+		}
+		m_channel.close();
+	}
+
+} // namespace Server
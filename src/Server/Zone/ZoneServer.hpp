@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Network/MessageSink.hpp"
+#include "Server/Options.hpp"
+#include "Server/ShardManager.hpp"
+#include "Zone/LocalChannel.hpp"
+#include "Zone/LocalPoller.hpp"
+#include <Common/Util/JobSystem.hpp>
+#include <Common/Util/ThreadSafeQueue.hpp>
+#include <filesystem>
+#include <vector>
+
+namespace Server
+{
+
+	/**
+	 * \class ZoneServer ZoneServer.hpp "Zone/ZoneServer.hpp"
+	 * \brief Simulates one zone's share of the world's instances for a gateway on the same machine
+	 *
+	 * The zone has shards of its own, the same as a server which simulates the whole world, but instead of owning the clients'
+	 * connections it's handed their messages and entities by the gateway over a Unix socket, and sends everything meant for a client
+	 * back the same way. Entities moving to an instance in another zone are handed back to the gateway to pass on.
+	 *
+	 * A zone which is asked to exit sends every entity it holds back to be saved first, so it can be restarted without losing
+	 * anything. A zone which loses the gateway exits too, as the gateway will have given its entities to whichever zone connects next.
+	 */
+	class ZoneServer : public MessageSink
+	{
+	public:
+		/**
+		 * \brief Construct a new Zone Server object
+		 *
+		 * \param options The settings the zone was started with, which must include its zone index
+		 */
+		ZoneServer(const Options& options);
+
+		/**
+		 * \brief Destroy the Zone Server object
+		 *
+		 */
+		~ZoneServer() override;
+
+		ZoneServer(const ZoneServer&)                    = delete;
+		auto operator=(const ZoneServer&) -> ZoneServer& = delete;
+
+		/**
+		 * \brief Connect to the gateway, waiting for it if it isn't up yet, and simulate the zone until the process is interrupted or
+		 * the gateway goes away
+		 *
+		 */
+		auto run() -> void;
+
+		auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, Common::Network::MessageData& data) -> void override;
+		auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, const Common::Network::SharedPayload& payload) -> void override;
+		auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, Common::Network::MessageData& data, entt::entity subject, float priority) -> void override;
+		auto pushMessage(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, const Common::Network::SharedPayload& payload, entt::entity subject, float priority) -> void override;
+
+		/**
+		 * \brief Pass a message for many clients on to the gateway as a single frame, holding the payload once
+		 *
+		 * \param type The type of message
+		 * \param recipients The clients to send the message to
+		 * \param data The data to send to every client
+		 */
+		auto pushBroadcast(Common::Network::MessageType type, std::span<const MessageRecipient> recipients, Common::Network::MessageData& data) -> void override;
+
+		/**
+		 * \brief Wake the zone's main loop, so messages pushed by the shards are sent to the gateway straight away
+		 *
+		 */
+		auto wake() -> void override;
+
+	private:
+		/**
+		 * \brief Connect to the gateway and say which zone this is, retrying until it's up or the process is interrupted
+		 *
+		 * \return true The zone is connected
+		 * \return false The process was interrupted first
+		 */
+		auto connect() -> bool;
+
+		/**
+		 * \brief Handle a frame sent by the gateway
+		 *
+		 * \param frame The frame
+		 */
+		auto handleFrame(Common::Network::MessageData& frame) -> void;
+
+		/**
+		 * \brief Queue a frame for a client message pushed by a shard
+		 *
+		 * \param protocol The protocol to send the message over
+		 * \param type The type of message
+		 * \param entityID The ID of the client to send the message to
+		 * \param payload The message's payload
+		 * \param subject The entity the message is about
+		 * \param priority How much the message matters to the client
+		 */
+		auto pushOutbound(Common::Network::Protocol protocol, Common::Network::MessageType type, entt::entity entityID, std::span<const std::uint8_t> payload, entt::entity subject, float priority) -> void;
+
+		/**
+		 * \brief Send the gateway every entity the shards have handed back to be saved or moved to another zone, and every queued frame
+		 *
+		 */
+		auto sendQueuedFrames() -> void;
+
+		/**
+		 * \brief Hand every entity back to the gateway to be saved, and wait a little while for it all to be written
+		 *
+		 */
+		auto shutdown() -> void;
+
+		std::size_t m_zoneIndex;
+		std::size_t m_zoneCount;
+		std::uint32_t m_tickRate;
+		std::filesystem::path m_socketPath;
+
+		LocalChannel m_channel;
+		LocalPoller m_poller;
+		std::vector<std::vector<std::uint8_t>> m_receivedFrames;
+		std::vector<EntityTransfer> m_transfers;
+		std::vector<Common::Network::MessageData> m_frames;
+
+		// Pushed to by every shard
+		Common::Util::ThreadSafeQueue<Common::Network::MessageData> m_outboundFrames;
+
+		// Declared before the shards, so it outlives them
+		Common::Util::JobSystem m_jobSystem;
+		ShardManager m_shardManager;
+	};
+
+} // namespace Server
@@ -0,0 +1,42 @@
+#pragma once
+
+namespace Benchmark
+{
+
+	/**
+	 * \brief Measure the cost of a socket wakeup as the number of idle connections grows
+	 *
+	 */
+	auto runReactorBenchmark() -> void;
+
+	/**
+	 * \brief Measure the cost of fanning a broadcast out to many clients
+	 *
+	 */
+	auto runBroadcastBenchmark() -> void;
+
+	/**
+	 * \brief Measure the bytes sent per tick to keep players up to date, with and without area-of-interest filtering
+	 *
+	 */
+	auto runInterestBenchmark() -> void;
+
+	/**
+	 * \brief Measure the cost of passing values between threads through each kind of queue, as the number of producers grows
+	 *
+	 */
+	auto runQueueBenchmark() -> void;
+
+	/**
+	 * \brief Measure the cost of resolving which client sent a datagram, and of forgetting a client's endpoint, at server scale
+	 *
+	 */
+	auto runEndpointBenchmark() -> void;
+
+	/**
+	 * \brief Measure how the job system scales from one thread to every hardware thread, over a CPU bound range and over many tiny jobs
+	 *
+	 */
+	auto runJobBenchmark() -> void;
+
+} // namespace Benchmark
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "Benchmarks.hpp"
+#include <Common/Network/HeaderCodec.hpp>
+#include <Common/Network/Message.hpp>
+#include <chrono>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+namespace Benchmark
+{
+
+	const auto BROADCAST_ITERATIONS = 50;
+
+	/**
+	 * \brief Build a broadcast payload of roughly the given size
+	 */
+	auto makePayload(const std::size_t size) -> Common::Network::MessageData
+	{
+		auto data = Common::Network::MessageData();
+		for (auto i = std::size_t(0); i < size / sizeof(std::uint32_t); ++i)
+		{
+			data << static_cast<std::uint32_t>(i);
+		}
+		return data;
+	}
+
+	/**
+	 * \brief Time fanning a broadcast out the way NetworkManager used to, copying and packing the data for every recipient
+	 *
+	 * \return double The mean cost of a broadcast in microseconds
+	 */
+	auto measureCopiedBroadcast(Common::Network::MessageData& data, const std::size_t recipients) -> double
+	{
+		// Every client has its own codec, as the identifier it encodes depends on the last one that client was sent
+		auto codecs = std::vector<Common::Network::HeaderCodec>(recipients);
+
+		auto total = std::chrono::steady_clock::duration::zero();
+		for (auto i = 0; i < BROADCAST_ITERATIONS; ++i)
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			auto buffers = std::vector<std::vector<std::uint8_t>>();
+			buffers.reserve(recipients);
+			for (auto recipient = std::size_t(0); recipient < recipients; ++recipient)
+			{
+				auto message              = Common::Network::Message();
+				message.data              = data;
+				message.header.entityID   = static_cast<entt::entity>(recipient);
+				message.header.identifier = static_cast<std::uint64_t>(i + 1);
+				buffers.emplace_back(message.pack(codecs[recipient]));
+			}
+
+			total += std::chrono::steady_clock::now() - start;
+		}
+
+		return std::chrono::duration<double, std::micro>(total).count() / BROADCAST_ITERATIONS;
+	}
+
+	/**
+	 * \brief Time fanning a broadcast out with one shared payload and a packed header per recipient
+	 *
+	 * \return double The mean cost of a broadcast in microseconds
+	 */
+	auto measureSharedBroadcast(Common::Network::MessageData& data, const std::size_t recipients) -> double
+	{
+		auto codecs = std::vector<Common::Network::HeaderCodec>(recipients);
+
+		auto total = std::chrono::steady_clock::duration::zero();
+		for (auto i = 0; i < BROADCAST_ITERATIONS; ++i)
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			auto payload = Common::Network::Message::makeSharedPayload(data);
+			auto headers = std::vector<std::pair<std::vector<std::uint8_t>, Common::Network::SharedPayload>>();
+			headers.reserve(recipients);
+			for (auto recipient = std::size_t(0); recipient < recipients; ++recipient)
+			{
+				auto message              = Common::Network::Message();
+				message.sharedPayload     = payload;
+				message.header.entityID   = static_cast<entt::entity>(recipient);
+				message.header.identifier = static_cast<std::uint64_t>(i + 1);
+				headers.emplace_back(message.packHeader(codecs[recipient]), message.sharedPayload);
+			}
+
+			total += std::chrono::steady_clock::now() - start;
+		}
+
+		return std::chrono::duration<double, std::micro>(total).count() / BROADCAST_ITERATIONS;
+	}
+
+	auto runBroadcastBenchmark() -> void
+	{
+		const auto RECIPIENTS = std::size_t(2'000);
+
+		for (const auto payloadSize : {std::size_t(64), std::size_t(512), std::size_t(4'096)})
+		{
+			auto data = makePayload(payloadSize);
+
+			auto copiedCost = measureCopiedBroadcast(data, RECIPIENTS);
+			auto sharedCost = measureSharedBroadcast(data, RECIPIENTS);
+			spdlog::info("{} recipients, {:>5} byte payload | copied {:>9.2f} us/broadcast | shared {:>9.2f} us/broadcast", RECIPIENTS, data.size(), copiedCost, sharedCost);
+		}
+	}
+
+} // namespace Benchmark
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "Benchmarks.hpp"
+#include <Common/Network/EndpointTable.hpp>
+#include <chrono>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <unordered_map>
+#include <vector>
+
+namespace Benchmark
+{
+
+	const auto ENDPOINT_LOOKUPS = std::size_t(2'000'000);
+
+	/**
+	 * \brief Make the endpoints of clients spread over a few thousand addresses, many of them sharing one behind a NAT
+	 */
+	auto makeEndpoints(const std::size_t clients) -> std::vector<std::pair<std::uint32_t, std::uint16_t>>
+	{
+		auto random    = std::mt19937(clients);
+		auto addresses = std::uniform_int_distribution<std::uint32_t>(0x0a000000, 0x0a000fff);
+		auto ports     = std::uniform_int_distribution<std::uint32_t>(1024, 65535);
+
+		auto endpoints = std::vector<std::pair<std::uint32_t, std::uint16_t>>();
+		auto seen      = std::unordered_map<std::uint64_t, bool>();
+		while (endpoints.size() < clients)
+		{
+			auto address = addresses(random);
+			auto port    = static_cast<std::uint16_t>(ports(random));
+			if (seen.emplace((static_cast<std::uint64_t>(address) << 16) | port, true).second)
+			{
+				endpoints.emplace_back(address, port);
+			}
+		}
+		return endpoints;
+	}
+
+	/**
+	 * \brief Time resolving the endpoints of received datagrams, in the order they'd arrive from clients sending at random
+	 *
+	 * \param endpoints The endpoint of every client
+	 * \param resolve Resolves one endpoint, returning the client's index
+	 * \return double The mean cost of a lookup in nanoseconds
+	 */
+	template<typename Resolve>
+	auto measureLookups(const std::vector<std::pair<std::uint32_t, std::uint16_t>>& endpoints, Resolve resolve) -> double
+	{
+		auto random  = std::mt19937(1);
+		auto clients = std::uniform_int_distribution<std::size_t>(0, endpoints.size() - 1);
+		auto order   = std::vector<std::size_t>(ENDPOINT_LOOKUPS);
+		for (auto& index : order)
+		{
+			index = clients(random);
+		}
+
+		auto checksum = std::size_t(0);
+		auto start    = std::chrono::steady_clock::now();
+		for (const auto index : order)
+		{
+			checksum += resolve(endpoints[index].first, endpoints[index].second);
+		}
+		auto elapsed = std::chrono::steady_clock::now() - start;
+
+		if (checksum == 0)
+		{
+			spdlog::warn("Every lookup resolved to the first client");
+		}
+		return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(ENDPOINT_LOOKUPS);
+	}
+
+	auto runEndpointBenchmark() -> void
+	{
+		for (const auto clientCount : {std::size_t(1'000), std::size_t(10'000), std::size_t(50'000)})
+		{
+			auto endpoints = makeEndpoints(clientCount);
+
+			// The map the server used before, keyed on the address and port packed into 48 bits
+			auto map   = std::unordered_map<std::uint64_t, std::uint32_t>();
+			auto table = Common::Network::EndpointTable();
+			for (auto i = std::size_t(0); i < endpoints.size(); ++i)
+			{
+				const auto& [address, port] = endpoints[i];
+				map.emplace((static_cast<std::uint64_t>(address) << 16) | port, static_cast<std::uint32_t>(i));
+				table.insert(Common::Network::EndpointAddress::fromIPv4(address, port), static_cast<entt::entity>(i));
+			}
+
+			auto mapCost = measureLookups(endpoints, [&](std::uint32_t address, std::uint16_t port) {
+				return static_cast<std::size_t>(map.find((static_cast<std::uint64_t>(address) << 16) | port)->second);
+			});
+			auto tableCost = measureLookups(endpoints, [&](std::uint32_t address, std::uint16_t port) {
+				return static_cast<std::size_t>(entt::to_entity(table.find(Common::Network::EndpointAddress::fromIPv4(address, port))));
+			});
+
+			// Removing clients used to search the whole map for their entry
+			auto start = std::chrono::steady_clock::now();
+			for (auto i = std::size_t(0); i < endpoints.size(); ++i)
+			{
+				table.erase(static_cast<entt::entity>(i));
+			}
+			auto eraseCost = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(endpoints.size());
+
+			spdlog::info("{:>6} clients | unordered_map {:>6.1f} ns/lookup | endpoint table {:>6.1f} ns/lookup, {:>6.1f} ns/removal", clientCount, mapCost, tableCost, eraseCost);
+		}
+	}
+
+} // namespace Benchmark
\ No newline at end of file
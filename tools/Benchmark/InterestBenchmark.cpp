@@ -0,0 +1,133 @@
+#include "Benchmarks.hpp"
+#include <Common/Game/WorldEntity.hpp>
+#include <Common/Input/InputState.hpp>
+#include <Common/Network/FrameAssembler.hpp>
+#include <Common/Network/MessageHeader.hpp>
+#include <Common/World/InterestGrid.hpp>
+#include <Common/World/Level.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <entt/entity/registry.hpp>
+#include <random>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+namespace Benchmark
+{
+
+	const auto INTEREST_TICKS    = 100;
+	const auto TICK_SECONDS      = 0.05F;
+	const auto PLAYER_SPEED      = 200.F;
+	const auto INPUT_CHANGE_ODDS = 5;
+
+	struct SimulatedPlayer
+	{
+		entt::entity entity;
+		sf::Vector2f position;
+		sf::Vector2f direction;
+	};
+
+	/**
+	 * \brief Get the number of bytes a message with the given payload takes up on the wire, excluding the datagram it's in
+	 */
+	auto getMessageLength(const Common::Network::MessageData& data) -> std::size_t
+	{
+		return Common::Network::FrameAssembler::PREFIX_LENGTH + sizeof(Common::Network::MessageHeader) + data.size();
+	}
+
+	/**
+	 * \brief Simulate players wandering around a level, changing their input at random, and count the bytes the server would send
+	 * to tell the other players, first by broadcasting to everyone and then by only telling the players who can see them
+	 */
+	auto measureInterest(const std::size_t playerCount) -> void
+	{
+		const auto WORLD_SIZE = static_cast<float>(Common::World::LEVEL_WIDTH * 32);
+
+		// Measure the messages the server sends, using the same serialisation it does
+		auto registry = entt::registry();
+		auto player   = Common::Game::createWorldEntity(registry, {});
+		auto data     = Common::Network::MessageData();
+		data << player;
+		Common::Game::serialiseWorldEntity(registry, player, data);
+		const auto CREATE_LENGTH = getMessageLength(data);
+
+		data = Common::Network::MessageData();
+		data << player << Common::Input::InputState();
+		const auto INPUT_LENGTH = getMessageLength(data);
+
+		data = Common::Network::MessageData();
+		data << player;
+		const auto DESTROY_LENGTH = getMessageLength(data);
+
+		auto randomEngine = std::mt19937(1);
+		auto coordinate   = std::uniform_real_distribution<float>(0.F, WORLD_SIZE);
+		auto angle        = std::uniform_real_distribution<float>(0.F, 6.2831853F);
+
+		auto players = std::vector<SimulatedPlayer>();
+		players.reserve(playerCount);
+		for (auto i = std::size_t(0); i < playerCount; ++i)
+		{
+			players.emplace_back(SimulatedPlayer{static_cast<entt::entity>(i), {coordinate(randomEngine), coordinate(randomEngine)}, {}});
+		}
+
+		auto grid = Common::World::InterestGrid();
+		for (const auto& simulatedPlayer : players)
+		{
+			grid.update(simulatedPlayer.entity, 0, simulatedPlayer.position, true);
+		}
+		grid.takeEvents();
+
+		auto broadcastBytes = std::uint64_t(0);
+		auto interestBytes  = std::uint64_t(0);
+		auto events         = std::uint64_t(0);
+		auto updateTime     = std::chrono::steady_clock::duration::zero();
+
+		for (auto tick = 0; tick < INTEREST_TICKS; ++tick)
+		{
+			auto start = std::chrono::steady_clock::now();
+			for (auto& simulatedPlayer : players)
+			{
+				simulatedPlayer.position.x = std::clamp(simulatedPlayer.position.x + simulatedPlayer.direction.x * PLAYER_SPEED * TICK_SECONDS, 0.F, WORLD_SIZE);
+				simulatedPlayer.position.y = std::clamp(simulatedPlayer.position.y + simulatedPlayer.direction.y * PLAYER_SPEED * TICK_SECONDS, 0.F, WORLD_SIZE);
+				grid.update(simulatedPlayer.entity, 0, simulatedPlayer.position, true);
+			}
+			updateTime += std::chrono::steady_clock::now() - start;
+
+			for (const auto& event : grid.takeEvents())
+			{
+				interestBytes += event.isEnter ? CREATE_LENGTH + INPUT_LENGTH : DESTROY_LENGTH;
+				++events;
+			}
+
+			// Players which change their input have it sent to the others
+			for (auto& simulatedPlayer : players)
+			{
+				if (randomEngine() % INPUT_CHANGE_ODDS != 0)
+				{
+					continue;
+				}
+
+				auto direction            = angle(randomEngine);
+				simulatedPlayer.direction = {std::cos(direction), std::sin(direction)};
+
+				broadcastBytes += playerCount * INPUT_LENGTH;
+				interestBytes += grid.getSubscribers(simulatedPlayer.entity).size() * INPUT_LENGTH;
+			}
+		}
+
+		auto broadcastPerTick = static_cast<double>(broadcastBytes) / INTEREST_TICKS / 1'024.0;
+		auto interestPerTick  = static_cast<double>(interestBytes) / INTEREST_TICKS / 1'024.0;
+		auto updateMicros     = std::chrono::duration<double, std::micro>(updateTime).count() / INTEREST_TICKS;
+		spdlog::info("{:>5} players | broadcast {:>10.1f} KiB/tick | interest {:>8.1f} KiB/tick ({:>5} enter/leave events/tick) | grid update {:>8.1f} us/tick", playerCount, broadcastPerTick, interestPerTick, events / INTEREST_TICKS, updateMicros);
+	}
+
+	auto runInterestBenchmark() -> void
+	{
+		for (const auto playerCount : {std::size_t(100), std::size_t(1'000), std::size_t(5'000)})
+		{
+			measureInterest(playerCount);
+		}
+	}
+
+} // namespace Benchmark
\ No newline at end of file
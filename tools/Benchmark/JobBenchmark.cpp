@@ -0,0 +1,130 @@
+#include "Benchmarks.hpp"
+#include <Common/Util/JobSystem.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <spdlog/spdlog.h>
+#include <thread>
+#include <vector>
+
+namespace Benchmark
+{
+
+	const auto RANGE_SIZE         = std::size_t(1 << 16);
+	const auto RANGE_ITERATIONS   = std::size_t(20);
+	const auto RANGE_CHUNK_SIZE   = std::size_t(256);
+	const auto WORK_PER_INDEX     = std::size_t(200);
+	const auto FAN_OUT_PARENTS    = std::size_t(64);
+	const auto FAN_OUT_CHILDREN   = std::size_t(1024);
+	const auto FAN_OUT_ITERATIONS = std::size_t(10);
+
+	/**
+	 * \brief Time a parallelFor over a CPU bound range, the way a shard runs a system over its entities
+	 *
+	 * \param jobSystem The job system to run on
+	 * \return double The mean time taken to cover the range in milliseconds
+	 */
+	auto measureRange(Common::Util::JobSystem& jobSystem) -> double
+	{
+		auto values = std::vector<double>(RANGE_SIZE);
+
+		auto start = std::chrono::steady_clock::now();
+		for (auto iteration = std::size_t(0); iteration < RANGE_ITERATIONS; ++iteration)
+		{
+			jobSystem.parallelFor(RANGE_SIZE, RANGE_CHUNK_SIZE, [&](const std::size_t begin, const std::size_t end) {
+				for (auto i = begin; i < end; ++i)
+				{
+					auto value = static_cast<double>(i + iteration);
+					for (auto step = std::size_t(0); step < WORK_PER_INDEX; ++step)
+					{
+						value = std::sqrt(value * value + 1.0);
+					}
+					values[i] = value;
+				}
+			});
+		}
+		auto elapsed = std::chrono::steady_clock::now() - start;
+
+		// Keeps the work from being optimised away
+		auto checksum = 0.0;
+		for (const auto value : values)
+		{
+			checksum += value;
+		}
+		spdlog::debug("Range checksum {}", checksum);
+
+		return std::chrono::duration<double, std::milli>(elapsed).count() / static_cast<double>(RANGE_ITERATIONS);
+	}
+
+	/**
+	 * \brief Time jobs which each queue many tiny jobs and wait on them, so most of the work has to be stolen from other workers' deques
+	 *
+	 * \param jobSystem The job system to run on
+	 * \return double The mean cost of running one tiny job in nanoseconds
+	 */
+	auto measureFanOut(Common::Util::JobSystem& jobSystem) -> double
+	{
+		auto counter = std::atomic<std::size_t>(0);
+
+		auto start = std::chrono::steady_clock::now();
+		for (auto iteration = std::size_t(0); iteration < FAN_OUT_ITERATIONS; ++iteration)
+		{
+			auto parents = Common::Util::JobGroup();
+			for (auto parent = std::size_t(0); parent < FAN_OUT_PARENTS; ++parent)
+			{
+				jobSystem.run(parents, [&]() {
+					auto children = Common::Util::JobGroup();
+					for (auto child = std::size_t(0); child < FAN_OUT_CHILDREN; ++child)
+					{
+						jobSystem.run(children, [&]() {
+							counter.fetch_add(1, std::memory_order_relaxed);
+						});
+					}
+					jobSystem.wait(children);
+				});
+			}
+			jobSystem.wait(parents);
+		}
+		auto elapsed = std::chrono::steady_clock::now() - start;
+
+		const auto jobs = FAN_OUT_ITERATIONS * FAN_OUT_PARENTS * (FAN_OUT_CHILDREN + 1);
+		if (counter != FAN_OUT_ITERATIONS * FAN_OUT_PARENTS * FAN_OUT_CHILDREN)
+		{
+			spdlog::warn("Only {} of the fan out's jobs ran", counter.load());
+		}
+
+		return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(jobs);
+	}
+
+	auto runJobBenchmark() -> void
+	{
+		const auto hardwareThreads = std::max(std::thread::hardware_concurrency(), 1U);
+
+		// Doubling up to every hardware thread, counting the thread queueing the work as one
+		auto threadCounts = std::vector<std::size_t>();
+		for (auto threads = std::size_t(1); threads < hardwareThreads; threads *= 2)
+		{
+			threadCounts.emplace_back(threads);
+		}
+		threadCounts.emplace_back(hardwareThreads);
+
+		auto baselineRange = 0.0;
+		for (const auto threads : threadCounts)
+		{
+			auto jobSystem = Common::Util::JobSystem(threads - 1);
+
+			auto rangeTime  = measureRange(jobSystem);
+			auto fanOutCost = measureFanOut(jobSystem);
+			if (threads == 1)
+			{
+				baselineRange = rangeTime;
+			}
+
+			auto speedup    = baselineRange / rangeTime;
+			auto efficiency = speedup / static_cast<double>(threads) * 100.0;
+			spdlog::info("{:>3} threads | parallelFor {:>8.2f} ms | speedup {:>5.2f}x | efficiency {:>5.1f}% | fan out {:>7.1f} ns/job", threads, rangeTime, speedup, efficiency, fanOutCost);
+		}
+	}
+
+} // namespace Benchmark
@@ -0,0 +1,51 @@
+#include "Benchmarks.hpp"
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+auto main(int argc, char** argv) -> int
+{
+	const auto benchmarks = std::vector<std::pair<std::string, std::function<void()>>>{
+	    {"reactor", Benchmark::runReactorBenchmark},
+	    {"broadcast", Benchmark::runBroadcastBenchmark},
+	    {"interest", Benchmark::runInterestBenchmark},
+	    {"queue", Benchmark::runQueueBenchmark},
+	    {"endpoint", Benchmark::runEndpointBenchmark},
+	    {"jobs", Benchmark::runJobBenchmark},
+	};
+
+	auto ranBenchmark = false;
+	for (const auto& [name, benchmark] : benchmarks)
+	{
+		// Run every benchmark if none were named, otherwise only the named ones
+		auto selected = (argc == 1);
+		for (auto i = 1; i < argc; ++i)
+		{
+			selected |= (std::strcmp(argv[i], name.c_str()) == 0);
+		}
+
+		if (selected)
+		{
+			spdlog::info("Running benchmark '{}'", name);
+			benchmark();
+			ranBenchmark = true;
+		}
+	}
+
+	if (!ranBenchmark)
+	{
+		std::cout << "Usage: mmorpg-benchmark [benchmark...]\nAvailable benchmarks:";
+		for (const auto& [name, benchmark] : benchmarks)
+		{
+			std::cout << " " << name;
+		}
+		std::cout << "\n";
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "Benchmarks.hpp"
+#include <Common/Util/DoubleBufferedQueue.hpp>
+#include <Common/Util/MultiProducerQueue.hpp>
+#include <Common/Util/SingleProducerQueue.hpp>
+#include <Common/Util/ThreadSafeQueue.hpp>
+#include <atomic>
+#include <chrono>
+#include <spdlog/spdlog.h>
+#include <thread>
+#include <vector>
+
+namespace Benchmark
+{
+
+	const auto ITEMS_PER_PRODUCER = std::size_t(500'000);
+	const auto RING_CAPACITY      = std::size_t(1 << 14);
+
+	/**
+	 * \brief Time producers pushing into a queue while one consumer drains it, the way the I/O and simulation threads share messages
+	 *
+	 * \param producers The number of producing threads
+	 * \param push Pushes one value, returning false if it has to be tried again
+	 * \param drain Moves every value available onto the end of a vector, returning how many were moved
+	 * \return double The mean cost of passing one value through the queue in nanoseconds
+	 */
+	template<typename Push, typename Drain>
+	auto measureQueue(const std::size_t producers, Push push, Drain drain) -> double
+	{
+		auto started = std::atomic<bool>(false);
+		auto threads = std::vector<std::thread>();
+		for (auto producer = std::size_t(0); producer < producers; ++producer)
+		{
+			threads.emplace_back([&]() {
+				while (!started.load(std::memory_order_acquire))
+				{
+				}
+
+				for (auto i = std::size_t(0); i < ITEMS_PER_PRODUCER; ++i)
+				{
+					while (!push(std::uint64_t(i)))
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+
+		auto received = std::vector<std::uint64_t>();
+		received.reserve(RING_CAPACITY);
+
+		auto expected = producers * ITEMS_PER_PRODUCER;
+		auto count    = std::size_t(0);
+		auto start    = std::chrono::steady_clock::now();
+		started.store(true, std::memory_order_release);
+		while (count < expected)
+		{
+			received.clear();
+			auto drained = drain(received);
+			if (drained == 0)
+			{
+				std::this_thread::yield();
+			}
+			count += drained;
+		}
+		auto elapsed = std::chrono::steady_clock::now() - start;
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(expected);
+	}
+
+	auto runQueueBenchmark() -> void
+	{
+		for (const auto producers : {std::size_t(1), std::size_t(2), std::size_t(4), std::size_t(8)})
+		{
+			auto mutexQueue = Common::Util::ThreadSafeQueue<std::uint64_t>();
+			auto mutexPush  = [&](std::uint64_t value) {
+				mutexQueue.push(std::move(value));
+				return true;
+			};
+			auto mutexDrain = [&](std::vector<std::uint64_t>& values) {
+				mutexQueue.drainInto(values);
+				return values.size();
+			};
+
+			auto doubleBufferedQueue = Common::Util::DoubleBufferedQueue<std::uint64_t>();
+			auto doubleBufferedPush  = [&](std::uint64_t value) {
+				doubleBufferedQueue.push(std::move(value));
+				return true;
+			};
+			auto doubleBufferedDrain = [&](std::vector<std::uint64_t>& values) {
+				doubleBufferedQueue.drainInto(values);
+				return values.size();
+			};
+
+			auto multiProducerQueue = Common::Util::MultiProducerQueue<std::uint64_t>(RING_CAPACITY);
+			auto multiProducerPush  = [&](std::uint64_t value) {
+				return multiProducerQueue.tryPush(std::move(value));
+			};
+			auto multiProducerDrain = [&](std::vector<std::uint64_t>& values) {
+				return multiProducerQueue.drainInto(values);
+			};
+
+			auto mutexCost          = measureQueue(producers, mutexPush, mutexDrain);
+			auto doubleBufferedCost = measureQueue(producers, doubleBufferedPush, doubleBufferedDrain);
+			auto multiProducerCost  = measureQueue(producers, multiProducerPush, multiProducerDrain);
+
+			if (producers > 1)
+			{
+				spdlog::info("{} producers | mutex {:>7.1f} ns/item | double buffered {:>7.1f} ns/item | MPSC ring {:>7.1f} ns/item", producers, mutexCost, doubleBufferedCost, multiProducerCost);
+				continue;
+			}
+
+			// The single producer ring is only safe with one producer
+			auto singleProducerQueue = Common::Util::SingleProducerQueue<std::uint64_t>(RING_CAPACITY);
+			auto singleProducerPush  = [&](std::uint64_t value) {
+				return singleProducerQueue.tryPush(std::move(value));
+			};
+			auto singleProducerDrain = [&](std::vector<std::uint64_t>& values) {
+				return singleProducerQueue.drainInto(values);
+			};
+
+			auto singleProducerCost = measureQueue(producers, singleProducerPush, singleProducerDrain);
+			spdlog::info("{} producer  | mutex {:>7.1f} ns/item | double buffered {:>7.1f} ns/item | MPSC ring {:>7.1f} ns/item | SPSC ring {:>7.1f} ns/item", producers, mutexCost, doubleBufferedCost, multiProducerCost, singleProducerCost);
+		}
+	}
+
+} // namespace Benchmark
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "Benchmarks.hpp"
+#include <Common/Network/SocketReactor.hpp>
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+#if defined(__linux__)
+#	include <sys/resource.h>
+#endif
+
+namespace Benchmark
+{
+
+	/**
+	 * \brief Raise the open file limit as far as we're allowed, since every connection costs two descriptors
+	 *
+	 */
+	auto raiseDescriptorLimit() -> void
+	{
+#if defined(__linux__)
+		auto limit = rlimit();
+		if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+		{
+			limit.rlim_cur = limit.rlim_max;
+			setrlimit(RLIMIT_NOFILE, &limit);
+			spdlog::info("Open file limit is {}", limit.rlim_cur);
+		}
+#endif
+	}
+
+	/**
+	 * \brief A set of loopback connections, of which only the first ever carries any traffic
+	 */
+	struct ConnectionSet
+	{
+		sf::TcpListener listener;
+		std::vector<std::unique_ptr<sf::TcpSocket>> remoteSockets;
+		std::vector<std::unique_ptr<sf::TcpSocket>> localSockets;
+
+		auto open(const std::size_t count) -> bool
+		{
+			if (listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) != sf::Socket::Status::Done)
+			{
+				return false;
+			}
+
+			for (auto i = std::size_t(0); i < count; ++i)
+			{
+				auto remote = std::make_unique<sf::TcpSocket>();
+				auto local  = std::make_unique<sf::TcpSocket>();
+				if (remote->connect(sf::IpAddress::LocalHost, listener.getLocalPort()) != sf::Socket::Status::Done || listener.accept(*local) != sf::Socket::Status::Done)
+				{
+					spdlog::warn("Only managed to open {} / {} connections", i, count);
+					return false;
+				}
+
+				local->setBlocking(false);
+				remoteSockets.emplace_back(std::move(remote));
+				localSockets.emplace_back(std::move(local));
+			}
+
+			return true;
+		}
+
+		auto drain(sf::TcpSocket& socket) -> void
+		{
+			auto buffer        = std::array<std::uint8_t, 64>();
+			std::size_t length = 0;
+			while (socket.receive(buffer.data(), buffer.size(), length) == sf::Socket::Status::Done)
+			{
+			}
+		}
+	};
+
+	const auto WAKEUP_ITERATIONS = 2'000;
+
+	/**
+	 * \brief Time a wakeup of the reactor, including dispatching to the ready socket
+	 *
+	 * \return double The mean wakeup cost in microseconds
+	 */
+	auto measureReactor(ConnectionSet& connections) -> double
+	{
+		auto reactor = Common::Network::SocketReactor();
+		for (auto i = std::size_t(0); i < connections.localSockets.size(); ++i)
+		{
+			reactor.add(*connections.localSockets[i], i);
+		}
+
+		auto total = std::chrono::steady_clock::duration::zero();
+		for (auto i = 0; i < WAKEUP_ITERATIONS; ++i)
+		{
+			auto byte = std::uint8_t(i);
+			(void)connections.remoteSockets.front()->send(&byte, sizeof(byte));
+
+			auto start = std::chrono::steady_clock::now();
+			for (const auto& event : reactor.wait(sf::seconds(1)))
+			{
+				connections.drain(*connections.localSockets[event.token]);
+			}
+			total += std::chrono::steady_clock::now() - start;
+		}
+
+		return std::chrono::duration<double, std::micro>(total).count() / WAKEUP_ITERATIONS;
+	}
+
+	/**
+	 * \brief Time a wakeup of the previous selector-based loop, which scans every connection
+	 *
+	 * \return double The mean wakeup cost in microseconds
+	 */
+	auto measureSelector(ConnectionSet& connections) -> double
+	{
+		auto selector = sf::SocketSelector();
+		for (auto& socket : connections.localSockets)
+		{
+			selector.add(*socket);
+		}
+
+		auto total = std::chrono::steady_clock::duration::zero();
+		for (auto i = 0; i < WAKEUP_ITERATIONS; ++i)
+		{
+			auto byte = std::uint8_t(i);
+			(void)connections.remoteSockets.front()->send(&byte, sizeof(byte));
+
+			auto start = std::chrono::steady_clock::now();
+			if (selector.wait(sf::seconds(1)))
+			{
+				for (auto& socket : connections.localSockets)
+				{
+					if (selector.isReady(*socket))
+					{
+						connections.drain(*socket);
+					}
+				}
+			}
+			total += std::chrono::steady_clock::now() - start;
+		}
+
+		return std::chrono::duration<double, std::micro>(total).count() / WAKEUP_ITERATIONS;
+	}
+
+	auto runReactorBenchmark() -> void
+	{
+		// select() can't watch descriptors at or above FD_SETSIZE, so leave some headroom for the process' own descriptors
+		const auto SELECTOR_LIMIT = std::size_t(900);
+
+		raiseDescriptorLimit();
+
+		for (const auto count : {std::size_t(10), std::size_t(100), std::size_t(1'000), std::size_t(10'000)})
+		{
+			auto connections = ConnectionSet();
+			if (!connections.open(count))
+			{
+				spdlog::warn("Skipping {} connections", count);
+				continue;
+			}
+
+			auto reactorCost = measureReactor(connections);
+			if (count <= SELECTOR_LIMIT)
+			{
+				auto selectorCost = measureSelector(connections);
+				spdlog::info("{:>6} idle connections | reactor {:>8.2f} us/wakeup | selector {:>8.2f} us/wakeup", count, reactorCost, selectorCost);
+			}
+			else
+			{
+				spdlog::info("{:>6} idle connections | reactor {:>8.2f} us/wakeup | selector      n/a (FD_SETSIZE)", count, reactorCost);
+			}
+		}
+	}
+
+} // namespace Benchmark
\ No newline at end of file
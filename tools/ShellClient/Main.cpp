@@ -1,4 +1,6 @@
 #include "Common/Network/MessageType.hpp"
+#include <Common/Network/FrameAssembler.hpp>
+#include <Common/Network/HeaderCodec.hpp>
 #include <Common/Network/Message.hpp>
 #include <Common/Network/ServerProperties.hpp>
 #include <SFML/Network/TcpSocket.hpp>
@@ -20,6 +22,9 @@ auto main() -> int
 	auto shouldExit                 = false;
 	std::uint64_t messageIdentifier = 0;
 
+	// The shell never sends Client_Connect, so stays on the header version every peer starts with
+	auto headerCodec = Common::Network::HeaderCodec();
+
 	while (!shouldExit)
 	{
 		auto userInput = std::string();
@@ -43,8 +48,9 @@ auto main() -> int
 				message.data << static_cast<std::uint8_t>(c);
 			}
 
-			auto buffer = message.pack();
-			status      = socket.send(buffer.data(), buffer.size());
+			auto buffer = message.pack(headerCodec);
+			Common::Network::FrameAssembler::frame(buffer);
+			status = socket.send(buffer.data(), buffer.size());
 
 			switch (status)
 			{